@@ -10,14 +10,18 @@
 
 void PingUpdater::stop()
 {
+    QMutexLocker locker(&mutex);
     servers.clear();
     run = false;
 }
 
 void PingUpdater::addServer(int row, const AddrPair &addr)
 {
-    servers.push_back({row, addr});
-    run = true;
+    {
+        QMutexLocker locker(&mutex);
+        servers.push_back({row, addr});
+        run = true;
+    }
     emit start();
 }
 
@@ -25,26 +29,35 @@ void PingUpdater::process()
 {
     while (run)
     {
-        if (servers.count() == 0)
+        QVector<ServerRow> batch;
+        {
+            QMutexLocker locker(&mutex);
+            batch.swap(servers);
+        }
+
+        if (batch.count() == 0)
         {
             QThread::msleep(1000);
+            QMutexLocker locker(&mutex);
             if (servers.count() == 0)
             {
                 qDebug() << "PingUpdater stopped due to inactivity";
                 run = false;
-                continue;
             }
+            continue;
         }
 
-        ServerRow server = servers.back();
-        servers.pop_back();
-
-        unsigned ping = PingRakNetServer(server.second.first.toLatin1(), server.second.second);
+        // Ping every server that was listed so far at once, the rows listed meanwhile go into the next batch
+        std::vector<RakNetPinger::Address> addresses;
+        addresses.reserve(batch.count());
+        for (const ServerRow &server : batch)
+            addresses.emplace_back(server.second.first.toStdString(), server.second.second);
 
-        qDebug() << "Pong from" << server.second.first + "|" + QString::number(server.second.second)
-                 << ":" << ping << "ms" << "Sizeof servers: " << servers.size();
+        RakNetPinger::Get().Ping(addresses, [this, &batch](size_t index, unsigned int ping) {
+            emit updateModel(batch.at(index).first, ping);
+        });
 
-        emit updateModel(server.first, ping);
+        qDebug() << "Pinged" << batch.count() << "servers";
     }
     emit finished();
 }
@@ -5,6 +5,7 @@
 #ifndef OPENMW_PINGUPDATER_HPP
 #define OPENMW_PINGUPDATER_HPP
 
+#include <QMutex>
 #include <QObject>
 #include <QVector>
 
@@ -23,7 +24,8 @@ signals:
     void updateModel(int row, unsigned ping);
     void finished();
 private:
-    QVector<ServerRow> servers;
+    QMutex mutex;
+    QVector<ServerRow> servers; // Guarded by mutex, rows are added from the GUI thread
     bool run;
 };
 
@@ -4,6 +4,7 @@
 
 #include "QueryClient.hpp"
 #include <RakSleep.h>
+#include <GetTime.h>
 #include <components/openmw-mp/NetworkMessages.hpp>
 #include <iostream>
 #include <components/openmw-mp/Version.hpp>
@@ -13,6 +14,13 @@ using namespace RakNet;
 using namespace std;
 using namespace mwmp;
 
+namespace
+{
+    // Poll often enough not to add latency to every answer, but give up on a master server that doesn't answer
+    const RakNet::TimeMS pollInterval = 10;
+    const RakNet::TimeMS answerTimeout = 10000;
+}
+
 QueryClient::QueryClient()
 {
     peer = RakPeerInterface::GetInstance();
@@ -124,8 +132,15 @@ MASTER_PACKETS QueryClient::GetAnswer(MASTER_PACKETS waitingPacket)
     bool update = true;
     unsigned char pid = 0;
     int id = -1;
+    RakNet::TimeMS start = RakNet::GetTimeMS();
     while (update)
     {
+        if (RakNet::GetTimeMS() - start >= answerTimeout)
+        {
+            qDebug() << "The master server did not answer";
+            break;
+        }
+
         for (packet = peer->Receive(); packet; peer->DeallocatePacket(packet), packet = peer->Receive())
         {
             BitStream data(packet->data, packet->length, false);
@@ -170,7 +185,8 @@ MASTER_PACKETS QueryClient::GetAnswer(MASTER_PACKETS waitingPacket)
                     break;
             }
         }
-        RakSleep(500);
+        if (update)
+            RakSleep(pollInterval);
     }
     return (MASTER_PACKETS)(id);
 }
@@ -199,10 +215,9 @@ ConnectionState QueryClient::Connect()
             }
             case IS_PENDING:
             case IS_CONNECTING:
-                qDebug() << "Pending";
                 break;
         }
-        RakSleep(500);
+        RakSleep(pollInterval);
     }
 }
 
@@ -7,6 +7,8 @@
 #include <RakSleep.h>
 #include <GetTime.h>
 
+#include <algorithm>
+#include <map>
 #include <sstream>
 #include <components/openmw-mp/Version.hpp>
 
@@ -14,52 +16,100 @@
 
 using namespace std;
 
-unsigned int PingRakNetServer(const char *addr, unsigned short port)
+namespace
 {
-    RakNet::Packet *packet;
-    bool done = false;
-    RakNet::TimeMS time = PING_UNREACHABLE;
+    // Don't flood the local network when hundreds of servers are listed
+    const unsigned int pingsPerBurst = 16;
+    const RakNet::TimeMS burstInterval = 10;
+
+    struct PendingPing
+    {
+        size_t index;
+        RakNet::TimeMS sentAt;
+    };
+}
 
+RakNetPinger &RakNetPinger::Get()
+{
+    static RakNetPinger pinger;
+    return pinger;
+}
+
+RakNetPinger::RakNetPinger()
+{
     RakNet::SocketDescriptor socketDescriptor{0, ""};
-    RakNet::RakPeerInterface *peer = RakNet::RakPeerInterface::GetInstance();
+    peer = RakNet::RakPeerInterface::GetInstance();
     peer->Startup(1, &socketDescriptor, 1);
-    if (!peer->Ping(addr, port, false))
-        return time;
-    RakNet::TimeMS start = RakNet::GetTimeMS();
-    while (!done)
+}
+
+RakNetPinger::~RakNetPinger()
+{
+    peer->Shutdown(0);
+    RakNet::RakPeerInterface::DestroyInstance(peer);
+}
+
+void RakNetPinger::Ping(const vector<Address> &servers, const function<void(size_t, unsigned int)> &onPing)
+{
+    lock_guard<std::mutex> lock(mutex);
+
+    // Pongs that came in too late for the previous servers
+    for (RakNet::Packet *packet = peer->Receive(); packet; packet = peer->Receive())
+        peer->DeallocatePacket(packet);
+
+    multimap<RakNet::SystemAddress, PendingPing> pending;
+    size_t next = 0;
+    RakNet::TimeMS lastBurst = RakNet::GetTimeMS();
+
+    while (next < servers.size() || !pending.empty())
     {
         RakNet::TimeMS now = RakNet::GetTimeMS();
-        if (now - start >= PING_UNREACHABLE)
-            break;
+        if (next < servers.size() && (next == 0 || now - lastBurst >= burstInterval))
+        {
+            lastBurst = now;
+            for (unsigned int i = 0; i < pingsPerBurst && next < servers.size(); ++i, ++next)
+            {
+                const Address &server = servers[next];
+                if (peer->Ping(server.first.c_str(), server.second, false))
+                    pending.insert({RakNet::SystemAddress(server.first.c_str(), server.second), {next, now}});
+                else
+                    onPing(next, PING_UNREACHABLE);
+            }
+        }
 
-        packet = peer->Receive();
-        if (!packet)
-            continue;
+        for (RakNet::Packet *packet = peer->Receive(); packet; peer->DeallocatePacket(packet), packet = peer->Receive())
+        {
+            if (packet->data[0] != ID_UNCONNECTED_PONG)
+                continue;
+
+            now = RakNet::GetTimeMS();
+            auto range = pending.equal_range(packet->systemAddress);
+            for (auto it = range.first; it != range.second; ++it)
+                onPing(it->second.index, min<RakNet::TimeMS>(now - it->second.sentAt, PING_UNREACHABLE));
+            pending.erase(range.first, range.second);
+        }
 
-        switch (packet->data[0])
+        now = RakNet::GetTimeMS();
+        for (auto it = pending.begin(); it != pending.end();)
         {
-            case ID_DISCONNECTION_NOTIFICATION:
-            case ID_CONNECTION_LOST:
-                done = true;
-                break;
-            case ID_CONNECTED_PING:
-            case ID_UNCONNECTED_PONG:
+            if (now - it->second.sentAt >= PING_UNREACHABLE)
             {
-                RakNet::BitStream bsIn(&packet->data[1], packet->length, false);
-                bsIn.Read(time);
-                time = now - time;
-                done = true;
-                break;
+                onPing(it->second.index, PING_UNREACHABLE);
+                it = pending.erase(it);
             }
-            default:
-                break;
+            else
+                ++it;
         }
-        peer->DeallocatePacket(packet);
+
+        RakSleep(1);
     }
+}
 
-    peer->Shutdown(0);
-    RakNet::RakPeerInterface::DestroyInstance(peer);
-    return time > PING_UNREACHABLE ? PING_UNREACHABLE : time;
+unsigned int PingRakNetServer(const char *addr, unsigned short port)
+{
+    unsigned int ping = PING_UNREACHABLE;
+    RakNetPinger pinger;
+    pinger.Ping({{addr, port}}, [&ping](size_t, unsigned int result) { ping = result; });
+    return ping;
 }
 
 ServerExtendedData getExtendedData(const char *addr, unsigned short port)
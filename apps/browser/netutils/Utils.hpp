@@ -5,12 +5,45 @@
 #ifndef NEWLAUNCHER_PING_HPP
 #define NEWLAUNCHER_PING_HPP
 
+#include <functional>
+#include <mutex>
 #include <vector>
 #include <string>
 
+namespace RakNet
+{
+    class RakPeerInterface;
+}
 
 #define PING_UNREACHABLE 999
 
+/*
+ * Pings servers with unconnected pings sent from a single peer, so any number of servers can be pinged at once.
+ * Pongs are told apart by the address they come from.
+ */
+class RakNetPinger
+{
+public:
+    typedef std::pair<std::string, unsigned short> Address;
+
+    // The pinger shared by the server list
+    static RakNetPinger &Get();
+
+    RakNetPinger();
+    ~RakNetPinger();
+
+    RakNetPinger(const RakNetPinger&) = delete;
+    RakNetPinger& operator=(const RakNetPinger&) = delete;
+
+    // Calls onPing with the index of each server and its ping, or PING_UNREACHABLE, as soon as it's known
+    void Ping(const std::vector<Address> &servers, const std::function<void(size_t, unsigned int)> &onPing);
+
+private:
+    RakNet::RakPeerInterface *peer;
+    std::mutex mutex;
+};
+
+// Pings a single server from a peer of its own, so it doesn't wait for the server list's pings to finish
 unsigned int PingRakNetServer(const char *addr, unsigned short port);
 
 struct ServerExtendedData
@@ -5,12 +5,15 @@
 #include <map>
 #include <set>
 #include <fstream>
+#include <functional>
+#include <memory>
 #include <cmath>
 
 #include <boost/program_options.hpp>
 
 #include <components/esm/esmreader.hpp>
 #include <components/esm/esmwriter.hpp>
+#include <components/esm/parallelreader.hpp>
 #include <components/esm/records.hpp>
 
 #include "record.hpp"
@@ -27,14 +30,24 @@ struct ESMData
     unsigned int version;
     std::vector<ESM::Header::MasterData> masters;
 
-    std::deque<EsmTool::RecordBase *> mRecords;
-    // Value: (Reference, Deleted flag)
-    std::map<ESM::Cell *, std::deque<std::pair<ESM::CellRef, bool> > > mCellRefs;
     std::map<int, int> mRecordStats;
 
     static const std::set<int> sLabeledRec;
 };
 
+// A record parsed on one of the threads
+struct LoadedRecord
+{
+    ESM::NAME mName;
+    // Null for records of types esmtool doesn't know
+    std::unique_ptr<EsmTool::RecordBase> mRecord;
+    bool mInterested;
+    // Value: (Reference, Deleted flag). Only filled for cells when references are loaded.
+    std::deque<std::pair<ESM::CellRef, bool> > mCellRefs;
+};
+
+typedef std::function<void (LoadedRecord &)> RecordHandler;
+
 static const int sLabeledRecIds[] = {
     ESM::REC_GLOB, ESM::REC_CLAS, ESM::REC_FACT, ESM::REC_RACE, ESM::REC_SOUN,
     ESM::REC_REGN, ESM::REC_BSGN, ESM::REC_LTEX, ESM::REC_STAT, ESM::REC_DOOR,
@@ -55,6 +68,7 @@ struct Arguments
     bool quiet_given;
     bool loadcells_given;
     bool plain_given;
+    unsigned int threads;
 
     std::string mode;
     std::string encoding;
@@ -89,6 +103,9 @@ bool parseOptions (int argc, char** argv, Arguments &info)
          "Only affects dump mode.")
         ("quiet,q", "Supress all record information. Useful for speed tests.")
         ("loadcells,C", "Browse through contents of all cells.")
+        ("threads,j", bpo::value<unsigned int>(&(info.threads))->default_value(0),
+         "Number of threads that parse records, 0 for one per hardware thread. "
+         "Records are always printed and saved in file order.")
 
         ( "encoding,e", bpo::value<std::string>(&(info.encoding))->
           default_value("win1252"),
@@ -203,9 +220,10 @@ bool parseOptions (int argc, char** argv, Arguments &info)
 }
 
 void printRaw(ESM::ESMReader &esm);
-void loadCell(ESM::Cell &cell, ESM::ESMReader &esm, Arguments& info);
+void loadCell(ESM::Cell &cell, ESM::ESMReader &esm, LoadedRecord &loaded);
+void printCellRefs(const LoadedRecord &loaded);
 
-int load(Arguments& info);
+int load(Arguments& info, const RecordHandler &handleRecord = RecordHandler());
 int clone(Arguments& info);
 int comp(Arguments& info);
 
@@ -238,11 +256,8 @@ int main(int argc, char**argv)
     return 0;
 }
 
-void loadCell(ESM::Cell &cell, ESM::ESMReader &esm, Arguments& info)
+void loadCell(ESM::Cell &cell, ESM::ESMReader &esm, LoadedRecord &loaded)
 {
-    bool quiet = (info.quiet_given || info.mode == "clone");
-    bool save = (info.mode == "clone");
-
     // Skip back to the beginning of the reference list
     // FIXME: Changes to the references backend required to support multiple plugins have
     //  almost certainly broken this following line. I'll leave it as is for now, so that
@@ -251,16 +266,20 @@ void loadCell(ESM::Cell &cell, ESM::ESMReader &esm, Arguments& info)
 
     // Loop through all the references
     ESM::CellRef ref;
-    if(!quiet) std::cout << "  References:\n";
-
     bool deleted = false;
     while(cell.getNextRef(esm, ref, deleted))
-    {
-        if (save) {
-            info.data.mCellRefs[&cell].push_back(std::make_pair(ref, deleted));
-        }
+        loaded.mCellRefs.push_back(std::make_pair(ref, deleted));
+}
 
-        if(quiet) continue;
+void printCellRefs(const LoadedRecord &loaded)
+{
+    std::cout << "  References:\n";
+
+    typedef std::deque<std::pair<ESM::CellRef, bool> > RefList;
+    for (RefList::const_iterator it = loaded.mCellRefs.begin(); it != loaded.mCellRefs.end(); ++it)
+    {
+        const ESM::CellRef &ref = it->first;
+        bool deleted = it->second;
 
         std::cout << "    Refnum: " << ref.mRefNum.mIndex << std::endl;
         std::cout << "    ID: '" << ref.mRefID << "'\n";
@@ -299,7 +318,15 @@ void printRaw(ESM::ESMReader &esm)
     }
 }
 
-int load(Arguments& info)
+void readHeader(ESM::ESMReader &esm, ESMData &data)
+{
+    data.author = esm.getAuthor();
+    data.description = esm.getDesc();
+    data.version = esm.getVer();
+    data.masters = esm.getGameFiles();
+}
+
+int load(Arguments& info, const RecordHandler &handleRecord)
 {
     ESM::ESMReader& esm = info.reader;
     ToUTF8::Utf8Encoder encoder (ToUTF8::calculateEncoding(info.encoding));
@@ -325,13 +352,9 @@ int load(Arguments& info)
 
         bool quiet = (info.quiet_given || info.mode == "clone");
         bool loadCells = (info.loadcells_given || info.mode == "clone");
-        bool save = (info.mode == "clone");
 
         esm.open(filename);
-
-        info.data.author = esm.getAuthor();
-        info.data.description = esm.getDesc();
-        info.data.masters = esm.getGameFiles();
+        readHeader(esm, info.data);
 
         if (!quiet)
         {
@@ -347,77 +370,108 @@ int load(Arguments& info)
             }
         }
 
-        // Loop through all records
-        while(esm.hasMoreRecs())
+        esm.close();
+
+        // Records are parsed on several threads, then printed and handled here in file order
+        ESM::ParallelReader reader(filename, info.threads);
+        reader.setEncoding(ToUTF8::calculateEncoding(info.encoding));
+
+        std::function<std::vector<LoadedRecord> (ESM::ESMReader&, size_t)> parse =
+            [&info, loadCells] (ESM::ESMReader& esm, size_t offset)
         {
-            ESM::NAME n = esm.getRecName();
-            uint32_t flags;
-            esm.getRecHeader(flags);
+            std::vector<LoadedRecord> batch;
 
-            EsmTool::RecordBase *record = EsmTool::RecordBase::create(n);
-            if (record == 0)
+            while(esm.hasMoreRecs())
             {
-                if (std::find(skipped.begin(), skipped.end(), n.intval) == skipped.end())
+                batch.push_back(LoadedRecord());
+                LoadedRecord &loaded = batch.back();
+
+                loaded.mName = esm.getRecName();
+                uint32_t flags;
+                esm.getRecHeader(flags);
+
+                loaded.mRecord.reset(EsmTool::RecordBase::create(loaded.mName));
+                if (!loaded.mRecord)
                 {
-                    std::cout << "Skipping " << n.toString() << " records." << std::endl;
-                    skipped.push_back(n.intval);
+                    esm.skipRecord();
+                    continue;
                 }
 
-                esm.skipRecord();
-                if (quiet) break;
-                std::cout << "  Skipping\n";
+                EsmTool::RecordBase *record = loaded.mRecord.get();
+                record->setFlags(static_cast<int>(flags));
+                record->setPrintPlain(info.plain_given);
+                record->load(esm);
 
-                continue;
-            }
+                // Land data is read from the file when it's printed, so its position has to be in the file
+                // rather than in this batch
+                if (record->getType().intval == ESM::REC_LAND)
+                    record->cast<ESM::Land>()->get().mContext.filePos += offset;
 
-            record->setFlags(static_cast<int>(flags));
-            record->setPrintPlain(info.plain_given);
-            record->load(esm);
+                // Is the user interested in this record type?
+                loaded.mInterested = true;
+                if (!info.types.empty())
+                {
+                    std::vector<std::string>::const_iterator match;
+                    match = std::find(info.types.begin(), info.types.end(), loaded.mName.toString());
+                    if (match == info.types.end()) loaded.mInterested = false;
+                }
 
-            // Is the user interested in this record type?
-            bool interested = true;
-            if (!info.types.empty())
-            {
-                std::vector<std::string>::iterator match;
-                match = std::find(info.types.begin(), info.types.end(), n.toString());
-                if (match == info.types.end()) interested = false;
+                if (!info.name.empty() && !Misc::StringUtils::ciEqual(info.name, record->getId()))
+                    loaded.mInterested = false;
+
+                if (record->getType().intval == ESM::REC_CELL && loadCells && loaded.mInterested)
+                {
+                    loadCell(record->cast<ESM::Cell>()->get(), esm, loaded);
+                }
             }
 
-            if (!info.name.empty() && !Misc::StringUtils::ciEqual(info.name, record->getId()))
-                interested = false;
+            return batch;
+        };
 
-            if(!quiet && interested)
+        std::function<bool (std::vector<LoadedRecord>&)> consume =
+            [&info, &skipped, &handleRecord, quiet, loadCells] (std::vector<LoadedRecord>& batch)
+        {
+            for (std::vector<LoadedRecord>::iterator it = batch.begin(); it != batch.end(); ++it)
             {
-                std::cout << "\nRecord: " << n.toString() << " '" << record->getId() << "'\n";
-                record->print();
-            }
+                LoadedRecord &loaded = *it;
+                const ESM::NAME &n = loaded.mName;
 
-            if (record->getType().intval == ESM::REC_CELL && loadCells && interested)
-            {
-                loadCell(record->cast<ESM::Cell>()->get(), esm, info);
-            }
+                if (!loaded.mRecord)
+                {
+                    if (std::find(skipped.begin(), skipped.end(), n.intval) == skipped.end())
+                    {
+                        std::cout << "Skipping " << n.toString() << " records." << std::endl;
+                        skipped.push_back(n.intval);
+                    }
 
-            if (save)
-            {
-                info.data.mRecords.push_back(record);
-            }
-            else
-            {
-                delete record;
+                    if (quiet) return false;
+                    std::cout << "  Skipping\n";
+
+                    continue;
+                }
+
+                if(!quiet && loaded.mInterested)
+                {
+                    std::cout << "\nRecord: " << n.toString() << " '" << loaded.mRecord->getId() << "'\n";
+                    loaded.mRecord->print();
+                }
+
+                if (!quiet && loaded.mRecord->getType().intval == ESM::REC_CELL && loadCells && loaded.mInterested)
+                    printCellRefs(loaded);
+
+                if (handleRecord)
+                    handleRecord(loaded);
+
+                ++info.data.mRecordStats[n.intval];
             }
-            ++info.data.mRecordStats[n.intval];
-        }
+
+            return true;
+        };
+
+        reader.read(parse, consume);
 
     } catch(std::exception &e) {
         std::cout << "\nERROR:\n\n  " << e.what() << std::endl;
-
-        typedef std::deque<EsmTool::RecordBase *> RecStore;
-        RecStore &store = info.data.mRecords;
-        for (RecStore::iterator it = store.begin(); it != store.end(); ++it)
-        {
-            delete *it;
-        }
-        store.clear();
         return 1;
     }
 
@@ -434,38 +488,24 @@ int clone(Arguments& info)
         return 1;
     }
 
-    if (load(info) != 0)
+    // The records are saved while they are loaded, so only a few of them are in memory at a time
+    size_t recordCount;
+    try
     {
-        std::cout << "Failed to load, aborting." << std::endl;
-        return 1;
+        ESM::ESMReader& reader = info.reader;
+        reader.open(info.filename);
+        readHeader(reader, info.data);
+        recordCount = reader.getRecordCount();
+        reader.close();
     }
-
-    size_t recordCount = info.data.mRecords.size();
-
-    int digitCount = 1; // For a nicer output
-    if (recordCount > 0)
-        digitCount = (int)std::log10(recordCount) + 1;
-
-    std::cout << "Loaded " << recordCount << " records:" << std::endl << std::endl;
-
-    int i = 0;
-    typedef std::map<int, int> Stats;
-    Stats &stats = info.data.mRecordStats;
-    for (Stats::iterator it = stats.begin(); it != stats.end(); ++it)
+    catch (std::exception &e)
     {
-        ESM::NAME name;
-        name.intval = it->first;
-        int amount = it->second;
-        std::cout << std::setw(digitCount) << amount << " " << name.toString() << "  ";
-
-        if (++i % 3 == 0)
-            std::cout << std::endl;
+        std::cout << "\nERROR:\n\n  " << e.what() << std::endl;
+        std::cout << "Failed to load, aborting." << std::endl;
+        return 1;
     }
 
-    if (i % 3 != 0)
-        std::cout << std::endl;
-
-    std::cout << std::endl << "Saving records to: " << info.outname << "..." << std::endl;
+    std::cout << "Saving records to: " << info.outname << "..." << std::endl;
 
     ESM::ESMWriter& esm = info.writer;
     ToUTF8::Utf8Encoder encoder (ToUTF8::calculateEncoding(info.encoding));
@@ -481,37 +521,49 @@ int clone(Arguments& info)
     std::fstream save(info.outname.c_str(), std::fstream::out | std::fstream::binary);
     esm.save(save);
 
-    int saved = 0;
-    typedef std::deque<EsmTool::RecordBase *> Records;
-    Records &records = info.data.mRecords;
-    for (Records::iterator it = records.begin(); it != records.end() && i > 0; ++it)
+    size_t saved = 0;
+    int lastPerc = -1;
+    RecordHandler saveRecord = [&] (LoadedRecord &loaded)
     {
-        EsmTool::RecordBase *record = *it;
+        EsmTool::RecordBase *record = loaded.mRecord.get();
         const ESM::NAME& typeName = record->getType();
 
         esm.startRecord(typeName.toString(), record->getFlags());
 
         record->save(esm);
         if (typeName.intval == ESM::REC_CELL) {
-            ESM::Cell *ptr = &record->cast<ESM::Cell>()->get();
-            if (!info.data.mCellRefs[ptr].empty()) {
-                typedef std::deque<std::pair<ESM::CellRef, bool> > RefList;
-                RefList &refs = info.data.mCellRefs[ptr];
-                for (RefList::iterator refIt = refs.begin(); refIt != refs.end(); ++refIt)
-                {
-                    refIt->first.save(esm, refIt->second);
-                }
+            typedef std::deque<std::pair<ESM::CellRef, bool> > RefList;
+            RefList &refs = loaded.mCellRefs;
+            for (RefList::iterator refIt = refs.begin(); refIt != refs.end(); ++refIt)
+            {
+                refIt->first.save(esm, refIt->second);
             }
         }
 
         esm.endRecord(typeName.toString());
 
         saved++;
-        int perc = (int)((saved / (float)recordCount)*100);
-        if (perc % 10 == 0)
+        int perc = recordCount > 0 ? (int)((saved / (float)recordCount)*100) : 100;
+        if (perc % 10 == 0 && perc != lastPerc)
         {
             std::cerr << "\r" << perc << "%";
+            lastPerc = perc;
         }
+    };
+
+    if (load(info, saveRecord) != 0)
+    {
+        std::cout << "Failed to load, aborting." << std::endl;
+        save.close();
+        return 1;
+    }
+
+    // The header was written with the record count of the input file, which also counts the skipped records
+    if (saved != recordCount)
+    {
+        save.seekp(0);
+        esm.setRecordCount(saved);
+        esm.save(save);
     }
 
     std::cout << "\rDone!" << std::endl;
@@ -519,6 +571,29 @@ int clone(Arguments& info)
     esm.close();
     save.close();
 
+    int digitCount = 1; // For a nicer output
+    if (saved > 0)
+        digitCount = (int)std::log10(saved) + 1;
+
+    std::cout << std::endl << "Saved " << saved << " records:" << std::endl << std::endl;
+
+    int i = 0;
+    typedef std::map<int, int> Stats;
+    Stats &stats = info.data.mRecordStats;
+    for (Stats::iterator it = stats.begin(); it != stats.end(); ++it)
+    {
+        ESM::NAME name;
+        name.intval = it->first;
+        int amount = it->second;
+        std::cout << std::setw(digitCount) << amount << " " << name.toString() << "  ";
+
+        if (++i % 3 == 0)
+            std::cout << std::endl;
+    }
+
+    if (i % 3 != 0)
+        std::cout << std::endl;
+
     return 0;
 }
 
@@ -545,19 +620,26 @@ int comp(Arguments& info)
     fileOne.filename = info.filename;
     fileTwo.filename = info.outname;
 
-    if (load(fileOne) != 0)
+    fileOne.threads = info.threads;
+    fileTwo.threads = info.threads;
+
+    // Only the records are counted, so they don't need to be kept in memory
+    size_t recordsOne = 0;
+    size_t recordsTwo = 0;
+
+    if (load(fileOne, [&recordsOne] (LoadedRecord &) { ++recordsOne; }) != 0)
     {
         std::cout << "Failed to load " << info.filename << ", aborting comparison." << std::endl;
         return 1;
     }
 
-    if (load(fileTwo) != 0)
+    if (load(fileTwo, [&recordsTwo] (LoadedRecord &) { ++recordsTwo; }) != 0)
     {
         std::cout << "Failed to load " << info.outname << ", aborting comparison." << std::endl;
         return 1;
     }
 
-    if (fileOne.data.mRecords.size() != fileTwo.data.mRecords.size())
+    if (recordsOne != recordsTwo)
     {
         std::cout << "Not equal, different amount of records." << std::endl;
         return 1;
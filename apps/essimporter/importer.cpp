@@ -9,6 +9,7 @@
 
 #include <components/esm/esmreader.hpp>
 #include <components/esm/esmwriter.hpp>
+#include <components/esm/parallelreader.hpp>
 #include <components/esm/defs.hpp>
 
 #include <components/esm/savedgame.hpp>
@@ -115,30 +116,46 @@ namespace ESSImport
 
     void read(const std::string& filename, File& file)
     {
-        ESM::ESMReader esm;
-        esm.open(filename);
+        // The records are split into subrecords on several threads, and added to the file in order
+        ESM::ParallelReader reader(filename);
 
-        while (esm.hasMoreRecs())
+        std::function<std::vector<File::Record> (ESM::ESMReader&, size_t)> parse =
+            [] (ESM::ESMReader& esm, size_t offset)
         {
-            ESM::NAME n = esm.getRecName();
-            esm.getRecHeader();
+            std::vector<File::Record> records;
 
-            File::Record rec;
-            rec.mName = n.toString();
-            rec.mFileOffset = esm.getFileOffset();
-            while (esm.hasMoreSubs())
+            while (esm.hasMoreRecs())
             {
-                File::Subrecord sub;
-                esm.getSubName();
-                esm.getSubHeader();
-                sub.mFileOffset = esm.getFileOffset();
-                sub.mName = esm.retSubName().toString();
-                sub.mData.resize(esm.getSubSize());
-                esm.getExact(&sub.mData[0], sub.mData.size());
-                rec.mSubrecords.push_back(sub);
+                ESM::NAME n = esm.getRecName();
+                esm.getRecHeader();
+
+                File::Record rec;
+                rec.mName = n.toString();
+                rec.mFileOffset = esm.getFileOffset() + offset;
+                while (esm.hasMoreSubs())
+                {
+                    File::Subrecord sub;
+                    esm.getSubName();
+                    esm.getSubHeader();
+                    sub.mFileOffset = esm.getFileOffset() + offset;
+                    sub.mName = esm.retSubName().toString();
+                    sub.mData.resize(esm.getSubSize());
+                    esm.getExact(&sub.mData[0], sub.mData.size());
+                    rec.mSubrecords.push_back(sub);
+                }
+                records.push_back(rec);
             }
-            file.mRecords.push_back(rec);
-        }
+
+            return records;
+        };
+
+        std::function<bool (std::vector<File::Record>&)> consume = [&file] (std::vector<File::Record>& records)
+        {
+            file.mRecords.insert(file.mRecords.end(), records.begin(), records.end());
+            return true;
+        };
+
+        reader.read(parse, consume);
     }
 
     void Importer::compare()
@@ -5,8 +5,12 @@
 #include <RakPeerInterface.h>
 #include <RakSleep.h>
 #include <BitStream.h>
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <random>
 #include "MasterServer.hpp"
+#include "ServerListSnapshot.hpp"
 
 #include <components/openmw-mp/Master/PacketMasterQuery.hpp>
 #include <components/openmw-mp/Master/PacketMasterUpdate.hpp>
@@ -27,6 +31,15 @@ MasterServer::MasterServer(unsigned short maxConnections, unsigned short port)
     peer->SetMaximumIncomingConnections(maxConnections);
     peer->SetIncomingPassword(TES3MP_MASTERSERVER_PASSW, (int) strlen(TES3MP_MASTERSERVER_PASSW));
     run = false;
+
+    // Zero is what clients that never saw an epoch send
+    random_device randomDevice;
+    snapshotEpoch = uniform_int_distribution<uint32_t>(1, numeric_limits<uint32_t>::max())(randomDevice);
+    snapshotVersion = 0;
+    oldestDelta = 0;
+    serversChanged = false;
+    serversKeptAlive = false;
+    snapshot.reset(new ServerListSnapshot(snapshotEpoch, snapshotVersion, servers, changedIn, removedIn, oldestDelta));
 }
 
 MasterServer::~MasterServer()
@@ -64,7 +77,10 @@ void MasterServer::Thread()
             {
 
                 if (it->second.lastUpdate + 60s <= now)
+                {
+                    ServerRemoved(it->first);
                     servers.erase(it++);
+                }
                 else ++it;
             }
             for(auto id = pendingACKs.begin(); id != pendingACKs.end();)
@@ -80,6 +96,12 @@ void MasterServer::Thread()
             }
         }
 
+        ApplyRestUpdates();
+
+        // Keep-alives only change the time since a server's last update, so they don't have to be published at once
+        if (serversChanged || (serversKeptAlive && now - GetSnapshot()->time >= 10s))
+            PublishSnapshot();
+
         if (packet == nullptr)
             RakSleep(10);
         else
@@ -136,6 +158,7 @@ void MasterServer::Thread()
 
                         auto keepAliveFunc = [&]() {
                             iter->second.lastUpdate = now;
+                            serversKeptAlive = true;
                             pma.SetFunc(PacketMasterAnnounce::FUNCTION_KEEP);
                             pma.Send(packet->systemAddress);
                             pendingACKs[packet->guid] = steady_clock::now();
@@ -145,6 +168,7 @@ void MasterServer::Thread()
                         {
                             if (pma.GetFunc() == PacketMasterAnnounce::FUNCTION_DELETE)
                             {
+                                ServerRemoved(iter->first);
                                 servers.erase(iter);
                                 cout << "Deleted";
                                 pma.Send(packet->systemAddress);
@@ -154,6 +178,7 @@ void MasterServer::Thread()
                             {
                                 cout << "Updated";
                                 iter->second = server;
+                                ServerChanged(iter->first);
                                 keepAliveFunc();
                             }
                             else
@@ -166,6 +191,7 @@ void MasterServer::Thread()
                         {
                             cout << "Added";
                             iter = servers.insert({packet->systemAddress, server}).first;
+                            ServerChanged(iter->first);
                             keepAliveFunc();
                         }
                         else
@@ -230,7 +256,97 @@ void MasterServer::Wait()
     }
 }
 
-MasterServer::ServerMap *MasterServer::GetServers()
+shared_ptr<const ServerListSnapshot> MasterServer::GetSnapshot() const
+{
+    return atomic_load(&snapshot);
+}
+
+void MasterServer::AddServer(const SystemAddress &addr, const SServer &server)
+{
+    lock_guard<mutex> lock(restUpdatesMutex);
+    restUpdates.push_back({RestUpdate::ADD, addr, server});
+}
+
+void MasterServer::UpdateServer(const SystemAddress &addr, const SServer &server)
+{
+    lock_guard<mutex> lock(restUpdatesMutex);
+    restUpdates.push_back({RestUpdate::UPDATE, addr, server});
+}
+
+void MasterServer::KeepServerAlive(const SystemAddress &addr)
+{
+    lock_guard<mutex> lock(restUpdatesMutex);
+    restUpdates.push_back({RestUpdate::KEEP_ALIVE, addr, SServer()});
+}
+
+void MasterServer::ApplyRestUpdates()
+{
+    vector<RestUpdate> updates;
+    {
+        lock_guard<mutex> lock(restUpdatesMutex);
+        updates.swap(restUpdates);
+    }
+
+    for (auto &update : updates)
+    {
+        ServerIter iter = servers.find(update.addr);
+
+        if (update.type == RestUpdate::ADD)
+        {
+            if (iter == servers.end())
+            {
+                servers.insert({update.addr, update.server});
+                ServerChanged(update.addr);
+            }
+        }
+        else if (iter != servers.end())
+        {
+            if (update.type == RestUpdate::UPDATE)
+            {
+                iter->second = update.server;
+                ServerChanged(update.addr);
+            }
+            else
+            {
+                iter->second.lastUpdate = steady_clock::now();
+                serversKeptAlive = true;
+            }
+        }
+    }
+}
+
+void MasterServer::ServerChanged(const SystemAddress &addr)
+{
+    changedIn[addr] = snapshotVersion + 1;
+    removedIn.erase(addr);
+    serversChanged = true;
+}
+
+void MasterServer::ServerRemoved(const SystemAddress &addr)
 {
-    return &servers;
+    changedIn.erase(addr);
+    removedIn[addr] = snapshotVersion + 1;
+    serversChanged = true;
+}
+
+void MasterServer::PublishSnapshot()
+{
+    // Clients asking for changes since before the oldest removal that is forgotten get the whole list instead
+    static const size_t maxRemovedServers = 1000;
+    while (removedIn.size() > maxRemovedServers)
+    {
+        auto oldest = min_element(removedIn.begin(), removedIn.end(), [](const auto &lhs, const auto &rhs) {
+            return lhs.second < rhs.second;
+        });
+        oldestDelta = max(oldestDelta, oldest->second);
+        removedIn.erase(oldest);
+    }
+
+    ++snapshotVersion;
+    shared_ptr<const ServerListSnapshot> published(
+            new ServerListSnapshot(snapshotEpoch, snapshotVersion, servers, changedIn, removedIn, oldestDelta));
+    atomic_store(&snapshot, published);
+
+    serversChanged = false;
+    serversKeptAlive = false;
 }
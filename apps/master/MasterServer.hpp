@@ -7,9 +7,14 @@
 
 #include <thread>
 #include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
 #include <RakPeerInterface.h>
 #include <components/openmw-mp/Master/MasterData.hpp>
 
+class ServerListSnapshot;
+
 class MasterServer
 {
 public:
@@ -37,10 +42,31 @@ public:
     bool isRunning();
     void Wait();
 
-    ServerMap* GetServers();
+    std::shared_ptr<const ServerListSnapshot> GetSnapshot() const;
+
+    // Thread safe, the changes are made by the master thread
+    void AddServer(const RakNet::SystemAddress &addr, const SServer &server);
+    void UpdateServer(const RakNet::SystemAddress &addr, const SServer &server);
+    void KeepServerAlive(const RakNet::SystemAddress &addr);
 
 private:
     void Thread();
+    void ApplyRestUpdates();
+    void ServerChanged(const RakNet::SystemAddress &addr);
+    void ServerRemoved(const RakNet::SystemAddress &addr);
+    void PublishSnapshot();
+
+    struct RestUpdate
+    {
+        enum Type
+        {
+            ADD,
+            UPDATE,
+            KEEP_ALIVE
+        } type;
+        RakNet::SystemAddress addr;
+        SServer server;
+    };
 
 private:
     std::thread tMasterThread;
@@ -49,6 +75,18 @@ private:
     ServerMap servers;
     bool run;
     std::map<RakNet::RakNetGUID, std::chrono::steady_clock::time_point> pendingACKs;
+
+    std::mutex restUpdatesMutex;
+    std::vector<RestUpdate> restUpdates;
+
+    std::shared_ptr<const ServerListSnapshot> snapshot; // Only accessed through std::atomic_load and std::atomic_store
+    std::map<RakNet::SystemAddress, uint64_t> changedIn;
+    std::map<RakNet::SystemAddress, uint64_t> removedIn;
+    uint32_t snapshotEpoch;
+    uint64_t snapshotVersion;
+    uint64_t oldestDelta;
+    bool serversChanged;
+    bool serversKeptAlive;
 };
 
 
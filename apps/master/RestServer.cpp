@@ -3,10 +3,13 @@
 //
 
 #include "RestServer.hpp"
+#include "ServerListSnapshot.hpp"
 
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
 
+#include <limits>
+
 using namespace std;
 using namespace chrono;
 using namespace boost::property_tree;
@@ -34,21 +37,38 @@ inline void ptreeToServer(boost::property_tree::ptree &pt, MasterServer::SServer
     server.SetMaxPlayers(pt.get<unsigned>("max_players"));
 }
 
-inline void queryToStringStream(stringstream &ss, string addr, MasterServer::SServer &query)
+inline void ResponseJson(HttpServer::Response &response, const string &content, const string &etag, bool gzip)
+{
+    response << "HTTP/1.1 200 OK\r\n";
+    response << "Content-Type: application/json\r\n";
+    if (gzip)
+        response << "Content-Encoding: gzip\r\n";
+    response << "ETag: " << etag << "\r\n";
+    response << "Vary: Accept-Encoding\r\n";
+    response << "Content-Length: " << content.length() << "\r\n\r\n" << content;
+}
+
+inline bool ResponseNotModified(HttpServer::Response &response, const HttpServer::Request &request, const string &etag)
+{
+    auto ifNoneMatch = request.header.find("If-None-Match");
+    if (ifNoneMatch == request.header.end() ||
+        (ifNoneMatch->second != "*" && ifNoneMatch->second.find(etag) == string::npos))
+        return false;
+
+    response << "HTTP/1.1 304 Not Modified\r\n";
+    response << "ETag: " << etag << "\r\n";
+    response << "Vary: Accept-Encoding\r\n";
+    response << "Content-Length: 0\r\n\r\n";
+    return true;
+}
+
+inline bool AcceptsGzip(const HttpServer::Request &request)
 {
-    ss <<"\"" << addr << "\":{";
-    ss << "\"modname\": \"" << query.GetGameMode() << "\"" << ", ";
-    ss << "\"passw\": " << (query.GetPassword() ? "true" : "false") << ", ";
-    ss << "\"hostname\": \"" << query.GetName() << "\"" << ", ";
-    ss << "\"query_port\": " << 0 << ", ";
-    ss << "\"last_update\": " << duration_cast<seconds>(steady_clock::now() - query.lastUpdate).count() << ", ";
-    ss << "\"players\": " << query.GetPlayers() << ", ";
-    ss << "\"version\": \"" << query.GetVersion() << "\"" << ", ";
-    ss << "\"max_players\": " << query.GetMaxPlayers();
-    ss << "}";
+    auto acceptEncoding = request.header.find("Accept-Encoding");
+    return acceptEncoding != request.header.end() && acceptEncoding->second.find("gzip") != string::npos;
 }
 
-RestServer::RestServer(unsigned short port, MasterServer::ServerMap *pMap) : serverMap(pMap)
+RestServer::RestServer(unsigned short port, MasterServer *masterServer) : masterServer(masterServer)
 {
     httpServer.config.port = port;
 }
@@ -57,46 +77,62 @@ void RestServer::start()
 {
     static const string ValidIpAddressRegex = "(?:[0-9]{1,3}\\.){3}[0-9]{1,3}";
     static const string ValidPortRegex = "(?:[0-9]{1,4}|[1-5][0-9]{4}|6[0-4][0-9]{3}|65[0-4][0-9]{2}|655[0-2][0-9]|6553[0-5])$";
-    static const string ServersRegex = "^/api/servers(?:/(" + ValidIpAddressRegex + "\\:" + ValidPortRegex + "))?";
+    static const string SinceRegex = "(?:\\?since=([0-9]+)(?:&epoch=([0-9]+))?)?";
+    static const string ServersRegex = "^/api/servers(?:/(" + ValidIpAddressRegex + "\\:" + ValidPortRegex + "))?" + SinceRegex;
 
     httpServer.resource[ServersRegex]["GET"] = [this](auto response, auto request) {
+        auto snapshot = masterServer->GetSnapshot();
+
         if (request->path_match[1].length() > 0)
         {
             try
             {
-                stringstream ss;
-                ss << "{";
                 auto addr = request->path_match[1].str();
                 auto port = (unsigned short)stoi(&(addr[addr.find(':')+1]));
-                queryToStringStream(ss, "server", serverMap->at(RakNet::SystemAddress(addr.c_str(), port)));
-                ss << "}";
-                ResponseStr(*response, ss.str(), "application/json");
+                ResponseStr(*response, snapshot->serverToJson(RakNet::SystemAddress(addr.c_str(), port)), "application/json");
             }
             catch(out_of_range e)
             {
                 *response << response400;
             }
         }
-        else
+        else if (request->path_match[2].length() > 0)
         {
-            static string str;
-
-            //if (updatedCache)
+            uint64_t since;
+            uint32_t epoch = 0;
+            try
             {
-                stringstream ss;
-                ss << "{";
-                ss << "\"list servers\":{";
-                for (auto query = serverMap->begin(); query != serverMap->end(); query++)
+                since = stoull(request->path_match[2].str());
+                if (request->path_match[3].length() > 0)
                 {
-                    queryToStringStream(ss, query->first.ToString(true, ':'), query->second);
-                    if (next(query) != serverMap->end())
-                        ss << ", ";
+                    unsigned long long parsedEpoch = stoull(request->path_match[3].str());
+                    if (parsedEpoch > numeric_limits<uint32_t>::max())
+                        throw out_of_range("epoch");
+                    epoch = (uint32_t) parsedEpoch;
                 }
-                ss << "}}";
-                ResponseStr(*response, ss.str(), "application/json");
-                updatedCache = false;
             }
-            *response << str;
+            catch(out_of_range e)
+            {
+                *response << response400;
+                return;
+            }
+
+            if (ResponseNotModified(*response, *request, snapshot->etag))
+                return;
+
+            // Clients that are too far behind, or saw the list before the master server restarted,
+            // get the whole list, which has no "since"
+            if (snapshot->canListChangesSince(epoch, since))
+                ResponseJson(*response, snapshot->changesSince(since), snapshot->etag, false);
+            else
+                ResponseJson(*response, snapshot->json, snapshot->etag, false);
+        }
+        else
+        {
+            bool gzip = AcceptsGzip(*request);
+            const string &etag = gzip ? snapshot->gzipEtag : snapshot->etag;
+            if (!ResponseNotModified(*response, *request, etag))
+                ResponseJson(*response, gzip ? snapshot->gzipJson : snapshot->json, etag, gzip);
         }
     };
 
@@ -112,8 +148,7 @@ void RestServer::start()
 
             unsigned short port = pt.get<unsigned short>("port");
             server.lastUpdate = steady_clock::now();
-            serverMap->insert({RakNet::SystemAddress(request->remote_endpoint_address.c_str(), port), server});
-            updatedCache = true;
+            masterServer->AddServer(RakNet::SystemAddress(request->remote_endpoint_address.c_str(), port), server);
 
             *response << response201;
         }
@@ -129,9 +164,11 @@ void RestServer::start()
         auto addr = request->path_match[1].str();
         auto port = (unsigned short)stoi(&(addr[addr.find(':')+1]));
 
-        auto query = serverMap->find(RakNet::SystemAddress(request->remote_endpoint_address.c_str(), port));
+        auto snapshot = masterServer->GetSnapshot();
+        RakNet::SystemAddress serverAddr(request->remote_endpoint_address.c_str(), port);
+        auto query = snapshot->servers.find(serverAddr);
 
-        if (query == serverMap->end())
+        if (query == snapshot->servers.end())
         {
             cout << request->remote_endpoint_address + ": Trying to update a non-existent server or without permissions." << endl;
             *response << response400;
@@ -145,30 +182,31 @@ void RestServer::start()
                 ptree pt;
                 read_json(request->content, pt);
 
-                ptreeToServer(pt, query->second);
-
-                updatedCache = true;
+                MasterServer::SServer server = query->second;
+                ptreeToServer(pt, server);
+                server.lastUpdate = steady_clock::now();
+                masterServer->UpdateServer(serverAddr, server);
             }
             catch(exception &e)
             {
                 cout << e.what() << endl;
                 *response << response400;
+                return;
             }
         }
-
-        query->second.lastUpdate = steady_clock::now();
+        else
+            masterServer->KeepServerAlive(serverAddr);
 
         *response << response202;
     };
 
     httpServer.resource["/api/servers/info"]["GET"] = [this](auto response, auto /*request*/) {
+        auto snapshot = masterServer->GetSnapshot();
+
         stringstream ss;
         ss << '{';
-        ss << "\"servers\": " << serverMap->size();
-        unsigned int players = 0;
-        for (auto s : *serverMap)
-            players += s.second.GetPlayers();
-        ss << ", \"players\": " << players;
+        ss << "\"servers\": " << snapshot->servers.size();
+        ss << ", \"players\": " << snapshot->players;
         ss << "}";
 
         ResponseStr(*response, ss.str(), "application/json");
@@ -181,11 +219,6 @@ void RestServer::start()
     httpServer.start();
 }
 
-void RestServer::cacheUpdated()
-{
-    updatedCache = true;
-}
-
 void RestServer::stop()
 {
     httpServer.stop();
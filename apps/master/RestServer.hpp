@@ -15,15 +15,13 @@ typedef SimpleWeb::Server<SimpleWeb::HTTP> HttpServer;
 class RestServer
 {
 public:
-    RestServer(unsigned short port, MasterServer::ServerMap *pMap);
+    RestServer(unsigned short port, MasterServer *masterServer);
     void start();
     void stop();
-    void cacheUpdated();
 
 private:
     HttpServer httpServer;
-    MasterServer::ServerMap *serverMap;
-    bool updatedCache = true;
+    MasterServer *masterServer;
 };
 
 
@@ -0,0 +1,110 @@
+#include "ServerListSnapshot.hpp"
+
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+using namespace std;
+using namespace chrono;
+
+namespace
+{
+    string gzip(const string &data)
+    {
+        string compressed;
+        boost::iostreams::filtering_ostream stream;
+        stream.push(boost::iostreams::gzip_compressor());
+        stream.push(boost::iostreams::back_inserter(compressed));
+        stream.write(data.data(), data.size());
+        stream.reset();
+        return compressed;
+    }
+}
+
+ServerListSnapshot::ServerListSnapshot(uint32_t epoch, uint64_t version, const MasterServer::ServerMap &servers,
+                                       const VersionMap &changedIn, const VersionMap &removedIn, uint64_t oldestDelta)
+    : epoch(epoch), version(version), time(steady_clock::now()), servers(servers), changedIn(changedIn), removedIn(removedIn),
+      oldestDelta(oldestDelta), players(0)
+{
+    stringstream ss;
+    ss << "{";
+    ss << "\"epoch\": " << epoch << ", ";
+    ss << "\"version\": " << version << ", ";
+    ss << "\"list servers\":{";
+    for (auto query = servers.begin(); query != servers.end(); query++)
+    {
+        serverToStream(ss, query->first.ToString(true, ':'), query->second);
+        if (next(query) != servers.end())
+            ss << ", ";
+        players += query->second.GetPlayers();
+    }
+    ss << "}}";
+
+    json = ss.str();
+    gzipJson = gzip(json);
+    etag = "\"" + to_string(epoch) + "-" + to_string(version) + "\"";
+    gzipEtag = "\"" + to_string(epoch) + "-" + to_string(version) + "-gzip\"";
+}
+
+bool ServerListSnapshot::canListChangesSince(uint32_t clientEpoch, uint64_t since) const
+{
+    // Versions start again at 0 when the master server restarts, so a version from another epoch means nothing
+    return clientEpoch == epoch && since >= oldestDelta && since <= version;
+}
+
+string ServerListSnapshot::changesSince(uint64_t since) const
+{
+    stringstream ss;
+    ss << "{";
+    ss << "\"epoch\": " << epoch << ", ";
+    ss << "\"version\": " << version << ", ";
+    ss << "\"since\": " << since << ", ";
+    ss << "\"list servers\":{";
+    bool first = true;
+    for (const auto &changed : changedIn)
+    {
+        if (changed.second <= since)
+            continue;
+        if (!first)
+            ss << ", ";
+        serverToStream(ss, changed.first.ToString(true, ':'), servers.at(changed.first));
+        first = false;
+    }
+    ss << "}, ";
+    ss << "\"removed\":[";
+    first = true;
+    for (const auto &removed : removedIn)
+    {
+        if (removed.second <= since)
+            continue;
+        if (!first)
+            ss << ", ";
+        ss << "\"" << removed.first.ToString(true, ':') << "\"";
+        first = false;
+    }
+    ss << "]}";
+    return ss.str();
+}
+
+string ServerListSnapshot::serverToJson(const RakNet::SystemAddress &addr) const
+{
+    stringstream ss;
+    ss << "{";
+    serverToStream(ss, "server", servers.at(addr));
+    ss << "}";
+    return ss.str();
+}
+
+void ServerListSnapshot::serverToStream(stringstream &ss, const string &key, const MasterServer::SServer &server) const
+{
+    ss << "\"" << key << "\":{";
+    ss << "\"modname\": \"" << server.GetGameMode() << "\"" << ", ";
+    ss << "\"passw\": " << (server.GetPassword() ? "true" : "false") << ", ";
+    ss << "\"hostname\": \"" << server.GetName() << "\"" << ", ";
+    ss << "\"query_port\": " << 0 << ", ";
+    ss << "\"last_update\": " << duration_cast<seconds>(time - server.lastUpdate).count() << ", ";
+    ss << "\"players\": " << server.GetPlayers() << ", ";
+    ss << "\"version\": \"" << server.GetVersion() << "\"" << ", ";
+    ss << "\"max_players\": " << server.GetMaxPlayers();
+    ss << "}";
+}
@@ -0,0 +1,44 @@
+#ifndef NEWMASTERPROTO_SERVERLISTSNAPSHOT_HPP
+#define NEWMASTERPROTO_SERVERLISTSNAPSHOT_HPP
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include "MasterServer.hpp"
+
+/*
+ * An immutable copy of the server list, published by the master thread whenever the list changes.
+ * The REST server answers every request from the latest snapshot without touching the live list,
+ * and the whole list is serialized once per snapshot rather than once per request.
+ */
+class ServerListSnapshot
+{
+public:
+    typedef std::map<RakNet::SystemAddress, uint64_t> VersionMap;
+
+    ServerListSnapshot(uint32_t epoch, uint64_t version, const MasterServer::ServerMap &servers,
+                       const VersionMap &changedIn, const VersionMap &removedIn, uint64_t oldestDelta);
+
+    bool canListChangesSince(uint32_t clientEpoch, uint64_t since) const;
+    std::string changesSince(uint64_t since) const;
+    std::string serverToJson(const RakNet::SystemAddress &addr) const;
+
+    const uint32_t epoch; // Picked at random when the master server starts, since versions start again at 0
+    const uint64_t version;
+    const std::chrono::steady_clock::time_point time;
+    const MasterServer::ServerMap servers;
+    const VersionMap changedIn; // The snapshot version each server was added or last updated in
+    const VersionMap removedIn; // The snapshot version each recently removed server was removed in
+    const uint64_t oldestDelta; // Removals before this version have been forgotten
+    unsigned int players;
+
+    std::string etag;
+    std::string json;
+    std::string gzipEtag;
+    std::string gzipJson;
+
+private:
+    void serverToStream(std::stringstream &ss, const std::string &key, const MasterServer::SServer &server) const;
+};
+
+#endif //NEWMASTERPROTO_SERVERLISTSNAPSHOT_HPP
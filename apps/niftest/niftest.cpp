@@ -61,7 +61,15 @@ void readVFS(VFS::Archive* anArchive,std::string archivePath = "")
             if(isNIF(name))
             {
             //           std::cout << "Decoding: " << name << std::endl;
-                Nif::NIFFile temp_nif(myManager.get(name),archivePath+name);
+                Files::MappedFilePtr mapped = myManager.map(name);
+                if (mapped)
+                {
+                    Nif::NIFFile temp_nif(mapped->data(), mapped->size(), archivePath+name);
+                }
+                else
+                {
+                    Nif::NIFFile temp_nif(myManager.get(name),archivePath+name);
+                }
             }
             else if(isBSA(name))
             {
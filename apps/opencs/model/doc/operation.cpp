@@ -1,15 +1,82 @@
 #include "operation.hpp"
 
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
 #include <string>
 #include <vector>
 
 #include <QTimer>
+#include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
 
 #include "../world/universalid.hpp"
 
 #include "state.hpp"
 #include "stage.hpp"
 
+namespace CSMDoc
+{
+    /// A range of steps of a single stage. Steps of parallel stages are split into several
+    /// shards that run on the thread pool, sequential stages are a single shard performed by
+    /// the operation itself.
+    struct StageShard
+    {
+        Stage *mStage;
+        std::size_t mStageIndex;
+        int mBegin;
+        int mEnd;
+        bool mPooled;
+        Messages mMessages;
+        double mTime; // ms, only used for pooled shards
+        bool mFailed;
+        std::atomic<bool> mDone;
+
+        StageShard (Stage *stage, std::size_t stageIndex, int begin, int end, bool pooled,
+            Message::Severity defaultSeverity)
+        : mStage (stage), mStageIndex (stageIndex), mBegin (begin), mEnd (end), mPooled (pooled),
+          mMessages (defaultSeverity), mTime (0), mFailed (false), mDone (false)
+        {}
+    };
+}
+
+namespace
+{
+    class ShardRunnable : public QRunnable
+    {
+            CSMDoc::StageShard& mShard;
+            const std::atomic<bool>& mAbort;
+
+        public:
+
+            ShardRunnable (CSMDoc::StageShard& shard, const std::atomic<bool>& abort)
+            : mShard (shard), mAbort (abort)
+            {}
+
+            virtual void run()
+            {
+                QElapsedTimer timer;
+                timer.start();
+
+                try
+                {
+                    for (int step = mShard.mBegin; step<mShard.mEnd && !mAbort; ++step)
+                        mShard.mStage->perform (step, mShard.mMessages);
+                }
+                catch (const std::exception& e)
+                {
+                    mShard.mMessages.add (CSMWorld::UniversalId(), e.what(), "",
+                        CSMDoc::Message::Severity_SeriousError);
+                    mShard.mFailed = true;
+                }
+
+                mShard.mTime = timer.nsecsElapsed() / 1000000.0;
+                mShard.mDone = true;
+            }
+    };
+}
+
 void CSMDoc::Operation::prepareStages()
 {
     mCurrentStage = mStages.begin();
@@ -17,25 +84,149 @@ void CSMDoc::Operation::prepareStages()
     mCurrentStepTotal = 0;
     mTotalSteps = 0;
     mError = false;
+    mAbortShards = false;
+    mStageTimes.assign (mStages.size(), 0);
+    mElapsed.start();
 
     for (std::vector<std::pair<Stage *, int> >::iterator iter (mStages.begin()); iter!=mStages.end(); ++iter)
     {
         iter->second = iter->first->setup();
         mTotalSteps += iter->second;
     }
+
+    startShards();
+}
+
+void CSMDoc::Operation::startShards()
+{
+    mShards.clear();
+    mStageUnits.assign (mStages.size(), 0);
+    mNextShard = 0;
+
+    int threads = mThreads>0 ? mThreads : QThread::idealThreadCount();
+    bool parallel = !mOrdered && threads>1;
+
+    if (parallel)
+        mThreadPool->setMaxThreadCount (threads);
+
+    for (std::size_t i = 0; i<mStages.size(); ++i)
+    {
+        Stage *stage = mStages[i].first;
+        int steps = mStages[i].second;
+
+        // The last stage of a finalAlways operation still has to run when aborting.
+        bool final = mFinalAlways && i==mStages.size()-1;
+
+        if (parallel && !final && steps>0 && stage->isParallel())
+        {
+            // several shards per thread, so a few slow records don't keep a thread busy at the end
+            int shardSize = std::max (1, steps / (threads * 4));
+
+            for (int begin = 0; begin<steps; begin += shardSize)
+                mShards.push_back (std::unique_ptr<StageShard> (new StageShard (stage, i, begin,
+                    std::min (begin+shardSize, steps), true, mDefaultSeverity)));
+        }
+        else
+        {
+            mShards.push_back (std::unique_ptr<StageShard> (
+                new StageShard (stage, i, 0, steps, false, mDefaultSeverity)));
+            mStageUnits[i] = mShards.back().get();
+        }
+    }
+
+    for (std::vector<std::unique_ptr<StageShard> >::iterator iter (mShards.begin()); iter!=mShards.end(); ++iter)
+        if ((*iter)->mPooled)
+            mThreadPool->start (new ShardRunnable (**iter, mAbortShards));
+}
+
+bool CSMDoc::Operation::collectShards()
+{
+    while (mNextShard<mShards.size())
+    {
+        StageShard& shard = *mShards[mNextShard];
+
+        bool done = shard.mDone;
+
+        // messages of a pooled shard may only be touched once the shard is done
+        if (shard.mPooled && !done)
+            return false;
+
+        for (Messages::Iterator iter (shard.mMessages.begin()); iter!=shard.mMessages.end(); ++iter)
+            emit reportMessage (*iter, mType);
+
+        shard.mMessages = Messages (mDefaultSeverity);
+
+        if (!done)
+            return false;
+
+        if (shard.mPooled)
+        {
+            mCurrentStepTotal += shard.mEnd - shard.mBegin;
+            mStageTimes[shard.mStageIndex] += shard.mTime;
+
+            if (shard.mFailed)
+                abort();
+        }
+
+        ++mNextShard;
+    }
+
+    return true;
+}
+
+void CSMDoc::Operation::stopShards()
+{
+    mAbortShards = true;
+    mThreadPool->waitForDone();
+
+    // Report whatever has been found by shards that were interrupted.
+    for (; mNextShard<mShards.size(); ++mNextShard)
+    {
+        const Messages& messages = mShards[mNextShard]->mMessages;
+
+        for (Messages::Iterator iter (messages.begin()); iter!=messages.end(); ++iter)
+            emit reportMessage (*iter, mType);
+    }
+
+    mShards.clear();
+    mStageUnits.clear();
+    mNextShard = 0;
+}
+
+void CSMDoc::Operation::reportTiming()
+{
+    for (std::size_t i = 0; i<mStages.size(); ++i)
+    {
+        std::ostringstream stream;
+        stream
+            << mStages[i].first->getName() << ": " << mStages[i].second << " steps in "
+            << std::fixed << std::setprecision (1) << mStageTimes[i] << " ms";
+
+        emit reportMessage (Message (CSMWorld::UniversalId(), stream.str(), "", Message::Severity_Info), mType);
+    }
+
+    std::ostringstream stream;
+    stream << "Total: " << mElapsed.elapsed() << " ms";
+    emit reportMessage (Message (CSMWorld::UniversalId(), stream.str(), "", Message::Severity_Info), mType);
 }
 
 CSMDoc::Operation::Operation (int type, bool ordered, bool finalAlways)
 : mType (type), mStages(std::vector<std::pair<Stage *, int> >()), mCurrentStage(mStages.begin()),
   mCurrentStep(0), mCurrentStepTotal(0), mTotalSteps(0), mOrdered (ordered),
   mFinalAlways (finalAlways), mError(false), mConnected (false), mPrepared (false),
-  mDefaultSeverity (Message::Severity_Error)
+  mDefaultSeverity (Message::Severity_Error), mThreads (1), mReportTiming (false),
+  mAbortShards (false), mNextShard (0)
 {
     mTimer = new QTimer (this);
+    mThreadPool = new QThreadPool (this);
 }
 
 CSMDoc::Operation::~Operation()
 {
+    // shards still running reference the stages
+    mAbortShards = true;
+    mThreadPool->waitForDone();
+
     for (std::vector<std::pair<Stage *, int> >::iterator iter (mStages.begin()); iter!=mStages.end(); ++iter)
         delete iter->first;
 }
@@ -65,6 +256,16 @@ void CSMDoc::Operation::setDefaultSeverity (Message::Severity severity)
     mDefaultSeverity = severity;
 }
 
+void CSMDoc::Operation::setThreads (int threads)
+{
+    mThreads = threads;
+}
+
+void CSMDoc::Operation::setReportTiming (bool report)
+{
+    mReportTiming = report;
+}
+
 bool CSMDoc::Operation::hasError() const
 {
     return mError;
@@ -76,6 +277,7 @@ void CSMDoc::Operation::abort()
         return;
 
     mError = true;
+    mAbortShards = true;
 
     if (mFinalAlways)
     {
@@ -97,39 +299,61 @@ void CSMDoc::Operation::executeStage()
         mPrepared = true;
     }
 
-    Messages messages (mDefaultSeverity);
-
     while (mCurrentStage!=mStages.end())
     {
-        if (mCurrentStep>=mCurrentStage->second)
+        std::size_t index = mCurrentStage - mStages.begin();
+        StageShard *unit = mStageUnits[index];
+
+        if (!unit || mCurrentStep>=mCurrentStage->second)
         {
+            // parallel stages are performed by the thread pool
+            if (unit)
+                unit->mDone = true;
+
             mCurrentStep = 0;
             ++mCurrentStage;
         }
         else
         {
+            QElapsedTimer timer;
+            timer.start();
+
             try
             {
-                mCurrentStage->first->perform (mCurrentStep++, messages);
+                mCurrentStage->first->perform (mCurrentStep++, unit->mMessages);
             }
             catch (const std::exception& e)
             {
-                emit reportMessage (Message (CSMWorld::UniversalId(), e.what(), "", Message::Severity_SeriousError), mType);
+                unit->mMessages.add (CSMWorld::UniversalId(), e.what(), "", Message::Severity_SeriousError);
                 abort();
             }
 
+            mStageTimes[index] += timer.nsecsElapsed() / 1000000.0;
             ++mCurrentStepTotal;
             break;
         }
     }
 
-    emit progress (mCurrentStepTotal, mTotalSteps ? mTotalSteps : 1, mType);
+    bool collected = collectShards();
 
-    for (Messages::Iterator iter (messages.begin()); iter!=messages.end(); ++iter)
-        emit reportMessage (*iter, mType);
+    emit progress (mCurrentStepTotal, mTotalSteps ? mTotalSteps : 1, mType);
 
     if (mCurrentStage==mStages.end())
+    {
+        if (!collected && !mError)
+        {
+            // Only parallel stages are left. Wait for them a bit instead of spinning on the timer.
+            mThreadPool->waitForDone (50);
+            return;
+        }
+
+        stopShards();
+
+        if (mReportTiming)
+            reportTiming();
+
         operationDone();
+    }
 }
 
 void CSMDoc::Operation::operationDone()
@@ -1,11 +1,14 @@
 #ifndef CSM_DOC_OPERATION_H
 #define CSM_DOC_OPERATION_H
 
+#include <atomic>
 #include <vector>
 #include <map>
+#include <memory>
 
 #include <QObject>
 #include <QTimer>
+#include <QElapsedTimer>
 #include <QStringList>
 
 #include "messages.hpp"
@@ -15,9 +18,12 @@ namespace CSMWorld
     class UniversalId;
 }
 
+class QThreadPool;
+
 namespace CSMDoc
 {
     class Stage;
+    struct StageShard;
 
     class Operation : public QObject
     {
@@ -36,9 +42,32 @@ namespace CSMDoc
             QTimer *mTimer;
             bool mPrepared;
             Message::Severity mDefaultSeverity;
+            int mThreads;
+            bool mReportTiming;
+            QThreadPool *mThreadPool;
+            std::atomic<bool> mAbortShards;
+            QElapsedTimer mElapsed;
+
+            // Steps of parallel stages, in stage and step order. Messages are reported in this
+            // order too, no matter which shard finishes first.
+            std::vector<std::unique_ptr<StageShard> > mShards;
+            std::vector<StageShard *> mStageUnits; // shard of sequential stages, 0 for parallel stages
+            std::size_t mNextShard;
+            std::vector<double> mStageTimes; // ms, indexed like mStages
 
             void prepareStages();
 
+            void startShards();
+
+            bool collectShards();
+            ///< Report messages of finished shards.
+            ///
+            /// \return Have all shards been collected?
+
+            void stopShards();
+
+            void reportTiming();
+
         public:
 
             Operation (int type, bool ordered, bool finalAlways = false);
@@ -55,6 +84,19 @@ namespace CSMDoc
             /// \attention Do no call this function while this Operation is running.
             void setDefaultSeverity (Message::Severity severity);
 
+            /// Run parallel stages on \a threads threads, next to the stages that must run
+            /// sequentially. Only used for operations that aren't ordered.
+            ///
+            /// \param threads 0: use one thread per core, 1: run everything on the operation thread
+            ///
+            /// \attention Do no call this function while this Operation is running.
+            void setThreads (int threads);
+
+            /// Report how long each stage took, as info messages at the end of the operation.
+            ///
+            /// \attention Do no call this function while this Operation is running.
+            void setReportTiming (bool report);
+
             bool hasError() const;
 
         signals:
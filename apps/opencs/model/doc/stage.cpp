@@ -1,3 +1,13 @@
 #include "stage.hpp"
 
 CSMDoc::Stage::~Stage() {}
+
+bool CSMDoc::Stage::isParallel() const
+{
+    return false;
+}
+
+std::string CSMDoc::Stage::getName() const
+{
+    return "Unnamed stage";
+}
@@ -23,6 +23,14 @@ namespace CSMDoc
 
             virtual void perform (int stage, Messages& messages) = 0;
             ///< Messages resulting from this stage will be appended to \a messages.
+
+            virtual bool isParallel() const;
+            ///< Can steps of this stage be performed concurrently, with each other and with other
+            /// stages? Only stages that don't modify any data or state of their own in perform()
+            /// may return true. Default: false
+
+            virtual std::string getName() const;
+            ///< Name used when reporting stage timing.
     };
 }
 
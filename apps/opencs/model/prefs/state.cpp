@@ -124,6 +124,12 @@ void CSMPrefs::State::declare()
     declareEnum ("double-c", "Control Double Click", actionEditAndRemove).addValues (reportValues);
     declareEnum ("double-sc", "Shift Control Double Click", actionNone).addValues (reportValues);
     declareBool("ignore-base-records", "Ignore base records in verifier", false);
+    declareInt ("verifier-threads", "Verifier threads", 0).
+        setTooltip ("Number of threads used to run verifier checks that can be performed "
+        "in parallel. 0 uses one thread per core, 1 runs all checks on a single thread.").
+        setRange (0, 64);
+    declareBool ("verifier-timing", "Report verifier timing", false).
+        setTooltip ("Add the time spent in each verifier check to the report.");
 
     declareCategory ("Search & Replace");
     declareInt ("char-before", "Characters before search string", 10).
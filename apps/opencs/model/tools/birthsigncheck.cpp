@@ -48,3 +48,13 @@ void CSMTools::BirthsignCheckStage::perform (int stage, CSMDoc::Messages& messag
 
     /// \todo check data members that can't be edited in the table view
 }
+
+bool CSMTools::BirthsignCheckStage::isParallel() const
+{
+    return true;
+}
+
+std::string CSMTools::BirthsignCheckStage::getName() const
+{
+    return "Birthsigns";
+}
@@ -73,3 +73,13 @@ void CSMTools::ClassCheckStage::perform (int stage, CSMDoc::Messages& messages)
                 ESM::Skill::indexToId (iter->first) + " is listed more than once"));
         }
 }
+
+bool CSMTools::ClassCheckStage::isParallel() const
+{
+    return true;
+}
+
+std::string CSMTools::ClassCheckStage::getName() const
+{
+    return "Classes";
+}
@@ -128,3 +128,13 @@ std::string CSMTools::GmstCheckStage::varTypeToString(ESM::VarType type)
         default: return "unhandled";
     }
 }
+
+bool CSMTools::GmstCheckStage::isParallel() const
+{
+    return true;
+}
+
+std::string CSMTools::GmstCheckStage::getName() const
+{
+    return "Game settings";
+}
@@ -21,6 +21,9 @@ namespace CSMTools
 
         virtual void perform(int stage, CSMDoc::Messages& messages);
         ///< Messages resulting from this stage will be appended to \a messages
+
+        virtual bool isParallel() const;
+        virtual std::string getName() const;
         
     private:
         
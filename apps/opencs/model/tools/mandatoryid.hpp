@@ -32,6 +32,9 @@ namespace CSMTools
 
             virtual void perform (int stage, CSMDoc::Messages& messages);
             ///< Messages resulting from this tage will be appended to \a messages.
+
+            virtual bool isParallel() const;
+            virtual std::string getName() const;
     };
 }
 
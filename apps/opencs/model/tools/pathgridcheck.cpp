@@ -142,3 +142,13 @@ void CSMTools::PathgridCheckStage::perform (int stage, CSMDoc::Messages& message
 
     // TODO: check whether there are disconnected graphs
 }
+
+bool CSMTools::PathgridCheckStage::isParallel() const
+{
+    return true;
+}
+
+std::string CSMTools::PathgridCheckStage::getName() const
+{
+    return "Pathgrids";
+}
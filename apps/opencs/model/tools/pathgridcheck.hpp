@@ -35,6 +35,9 @@ namespace CSMTools
         virtual int setup();
 
         virtual void perform (int stage, CSMDoc::Messages& messages);
+
+        virtual bool isParallel() const;
+        virtual std::string getName() const;
     };
 }
 
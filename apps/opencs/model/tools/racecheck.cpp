@@ -80,3 +80,8 @@ void CSMTools::RaceCheckStage::perform (int stage, CSMDoc::Messages& messages)
     else
         performPerRecord (stage, messages);
 }
+
+std::string CSMTools::RaceCheckStage::getName() const
+{
+    return "Races";
+}
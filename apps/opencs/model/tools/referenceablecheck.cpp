@@ -1022,3 +1022,8 @@ template<typename Tool> void CSMTools::ReferenceableCheckStage::scriptCheck (
             messages.push_back (std::make_pair (someID, someTool.mId + " refers to an unknown script \""+someTool.mScript+"\""));
     }
 }
+
+std::string CSMTools::ReferenceableCheckStage::getName() const
+{
+    return "Objects";
+}
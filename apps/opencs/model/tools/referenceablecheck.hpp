@@ -19,6 +19,8 @@ namespace CSMTools
                 const CSMWorld::IdCollection<ESM::Script>& scripts);
 
             virtual void perform(int stage, CSMDoc::Messages& messages);
+
+            virtual std::string getName() const;
             virtual int setup();
 
         private:
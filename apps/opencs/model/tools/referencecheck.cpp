@@ -108,3 +108,13 @@ int CSMTools::ReferenceCheckStage::setup()
 
     return mReferences.getSize();
 }
+
+bool CSMTools::ReferenceCheckStage::isParallel() const
+{
+    return true;
+}
+
+std::string CSMTools::ReferenceCheckStage::getName() const
+{
+    return "Instances";
+}
@@ -135,3 +135,8 @@ void CSMTools::ScriptCheckStage::perform (int stage, CSMDoc::Messages& messages)
 
     mMessages = 0;
 }
+
+std::string CSMTools::ScriptCheckStage::getName() const
+{
+    return "Scripts";
+}
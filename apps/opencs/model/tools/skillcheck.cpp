@@ -46,3 +46,13 @@ void CSMTools::SkillCheckStage::perform (int stage, CSMDoc::Messages& messages)
     if (skill.mDescription.empty())
         messages.push_back (std::make_pair (id, skill.mId + " has an empty description"));
 }
+
+bool CSMTools::SkillCheckStage::isParallel() const
+{
+    return true;
+}
+
+std::string CSMTools::SkillCheckStage::getName() const
+{
+    return "Skills";
+}
@@ -38,3 +38,13 @@ void CSMTools::SoundCheckStage::perform (int stage, CSMDoc::Messages& messages)
 
     /// \todo check, if the sound file exists
 }
+
+bool CSMTools::SoundCheckStage::isParallel() const
+{
+    return true;
+}
+
+std::string CSMTools::SoundCheckStage::getName() const
+{
+    return "Sounds";
+}
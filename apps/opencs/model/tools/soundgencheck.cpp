@@ -57,3 +57,13 @@ void CSMTools::SoundGenCheckStage::perform(int stage, CSMDoc::Messages &messages
         messages.push_back(std::make_pair(id, "No such sound '" + soundGen.mSound + "'"));
     }
 }
+
+bool CSMTools::SoundGenCheckStage::isParallel() const
+{
+    return true;
+}
+
+std::string CSMTools::SoundGenCheckStage::getName() const
+{
+    return "Sound generators";
+}
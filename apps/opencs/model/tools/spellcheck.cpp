@@ -44,3 +44,13 @@ void CSMTools::SpellCheckStage::perform (int stage, CSMDoc::Messages& messages)
 
     /// \todo check data members that can't be edited in the table view
 }
+
+bool CSMTools::SpellCheckStage::isParallel() const
+{
+    return true;
+}
+
+std::string CSMTools::SpellCheckStage::getName() const
+{
+    return "Spells";
+}
@@ -35,3 +35,13 @@ int CSMTools::StartScriptCheckStage::setup()
 
     return mStartScripts.getSize();
 }
+
+bool CSMTools::StartScriptCheckStage::isParallel() const
+{
+    return true;
+}
+
+std::string CSMTools::StartScriptCheckStage::getName() const
+{
+    return "Start scripts";
+}
@@ -22,6 +22,9 @@ namespace CSMTools
                 const CSMWorld::IdCollection<ESM::Script>& scripts);
 
             virtual void perform(int stage, CSMDoc::Messages& messages);
+
+            virtual bool isParallel() const;
+            virtual std::string getName() const;
             virtual int setup();
     };
 }
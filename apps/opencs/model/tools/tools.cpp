@@ -9,6 +9,8 @@
 #include "../world/data.hpp"
 #include "../world/universalid.hpp"
 
+#include "../prefs/state.hpp"
+
 #include "reportmodel.hpp"
 #include "mandatoryid.hpp"
 #include "skillcheck.hpp"
@@ -184,7 +186,12 @@ CSMWorld::UniversalId CSMTools::Tools::runVerifier (const CSMWorld::UniversalId&
 
     mActiveReports[CSMDoc::State_Verifying] = reportNumber;
 
-    getVerifier()->start();
+    CSMDoc::OperationHolder *verifier = getVerifier();
+
+    mVerifierOperation->setThreads (CSMPrefs::get()["Reports"]["verifier-threads"].toInt());
+    mVerifierOperation->setReportTiming (CSMPrefs::get()["Reports"]["verifier-timing"].isTrue());
+
+    verifier->start();
 
     return CSMWorld::UniversalId (CSMWorld::UniversalId::Type_VerificationResults, reportNumber);
 }
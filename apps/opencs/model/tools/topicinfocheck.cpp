@@ -446,3 +446,13 @@ void CSMTools::TopicInfoCheckStage::writeInvalidTypeError(const std::string& spe
 
     messages.add(id, stream.str(), "", CSMDoc::Message::Severity_Error);
 }
+
+bool CSMTools::TopicInfoCheckStage::isParallel() const
+{
+    return true;
+}
+
+std::string CSMTools::TopicInfoCheckStage::getName() const
+{
+    return "Topic infos";
+}
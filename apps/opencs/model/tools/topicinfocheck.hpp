@@ -46,6 +46,9 @@ namespace CSMTools
         virtual void perform(int step, CSMDoc::Messages& messages);
         ///< Messages resulting from this stage will be appended to \a messages
 
+        virtual bool isParallel() const;
+        virtual std::string getName() const;
+
     private:
 
         const CSMWorld::InfoCollection& mTopicInfos;
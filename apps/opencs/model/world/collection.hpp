@@ -3,6 +3,8 @@
 
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <utility>
 #include <algorithm>
 #include <cctype>
 #include <stdexcept>
@@ -84,19 +86,39 @@ namespace CSMWorld
         private:
 
             std::vector<Record<ESXRecordT> > mRecords;
-            std::map<std::string, int> mIndex;
+
+            // Records are indexed through handles that don't change when rows are moved, so moving rows
+            // only updates the handle->row table for the rows that moved rather than the ID index. The
+            // table is kept up to date by the calls that move rows, so lookups never write to it and
+            // can run from several threads at once.
+            std::unordered_map<std::string, int> mIndex; // lower case ID -> handle
+            std::map<std::string, int> mSortedIds; // lower case ID -> handle, in ID order
+            std::vector<int> mHandles; // row -> handle
+            std::vector<int> mRows; // handle -> row (-1 for unused handles)
+            std::vector<std::string> mIds; // handle -> lower case ID, since erased records can't be read
+            std::vector<int> mFreeHandles;
+
             std::vector<Column<ESXRecordT> *> mColumns;
 
             // not implemented
             Collection (const Collection&);
             Collection& operator= (const Collection&);
 
-        protected:
+            int createHandle();
 
-            const std::map<std::string, int>& getIdMap() const;
+            void updateRows (int begin, int end);
+            ///< Update the handle->row table for rows [begin, end).
+
+        protected:
 
             const std::vector<Record<ESXRecordT> >& getRecords() const;
 
+            int getRow (int handle) const;
+            ///< Return the current row of the record with the given handle.
+
+            const std::map<std::string, int>& getSortedIds() const;
+            ///< Return a map from lower case ID to handle, sorted by ID.
+
             bool reorderRowsImp (int baseIndex, const std::vector<int>& newOrder);
             ///< Reorder the rows [baseIndex, baseIndex+newOrder.size()) according to the indices
             /// given in \a newOrder (baseIndex+newOrder[0] specifies the new index of row baseIndex).
@@ -204,9 +226,37 @@ namespace CSMWorld
     };
 
     template<typename ESXRecordT, typename IdAccessorT>
-    const std::map<std::string, int>& Collection<ESXRecordT, IdAccessorT>::getIdMap() const
+    int Collection<ESXRecordT, IdAccessorT>::createHandle()
     {
-        return mIndex;
+        if (!mFreeHandles.empty())
+        {
+            int handle = mFreeHandles.back();
+            mFreeHandles.pop_back();
+            return handle;
+        }
+
+        mRows.push_back (-1);
+        mIds.push_back (std::string());
+        return static_cast<int> (mRows.size())-1;
+    }
+
+    template<typename ESXRecordT, typename IdAccessorT>
+    void Collection<ESXRecordT, IdAccessorT>::updateRows (int begin, int end)
+    {
+        for (int row = begin; row<end; ++row)
+            mRows[mHandles[row]] = row;
+    }
+
+    template<typename ESXRecordT, typename IdAccessorT>
+    int Collection<ESXRecordT, IdAccessorT>::getRow (int handle) const
+    {
+        return mRows.at (handle);
+    }
+
+    template<typename ESXRecordT, typename IdAccessorT>
+    const std::map<std::string, int>& Collection<ESXRecordT, IdAccessorT>::getSortedIds() const
+    {
+        return mSortedIds;
     }
 
     template<typename ESXRecordT, typename IdAccessorT>
@@ -231,20 +281,20 @@ namespace CSMWorld
 
             // reorder records
             std::vector<Record<ESXRecordT> > buffer (size);
+            std::vector<int> handles (size);
 
             for (int i=0; i<size; ++i)
             {
                 buffer[newOrder[i]] = mRecords [baseIndex+i];
                 buffer[newOrder[i]].setModified (buffer[newOrder[i]].get());
+                handles[newOrder[i]] = mHandles[baseIndex+i];
             }
 
             std::copy (buffer.begin(), buffer.end(), mRecords.begin()+baseIndex);
+            std::copy (handles.begin(), handles.end(), mHandles.begin()+baseIndex);
 
             // adjust index
-            for (std::map<std::string, int>::iterator iter (mIndex.begin()); iter!=mIndex.end();
-                 ++iter)
-                if (iter->second>=baseIndex && iter->second<baseIndex+size)
-                    iter->second = newOrder.at (iter->second-baseIndex)+baseIndex;
+            updateRows (baseIndex, baseIndex+size);
         }
 
         return true;
@@ -334,7 +384,7 @@ namespace CSMWorld
     {
         std::string id = Misc::StringUtils::lowerCase (IdAccessorT().getId (record));
 
-        std::map<std::string, int>::iterator iter = mIndex.find (id);
+        std::unordered_map<std::string, int>::const_iterator iter = mIndex.find (id);
 
         if (iter==mIndex.end())
         {
@@ -346,7 +396,7 @@ namespace CSMWorld
         }
         else
         {
-            mRecords[iter->second].setModified (record);
+            mRecords[getRow (iter->second)].setModified (record);
         }
     }
 
@@ -424,41 +474,45 @@ namespace CSMWorld
     template<typename ESXRecordT, typename IdAccessorT>
     void  Collection<ESXRecordT, IdAccessorT>::purge()
     {
-        int i = 0;
+        // remove runs of erased records from the back, so each run only moves the rows behind it once
+        int i = static_cast<int> (mRecords.size());
 
-        while (i<static_cast<int> (mRecords.size()))
+        while (i>0)
         {
-            if (mRecords[i].isErased())
-                removeRows (i, 1);
-            else
-                ++i;
+            if (!mRecords[i-1].isErased())
+            {
+                --i;
+                continue;
+            }
+
+            int end = i;
+
+            while (i>0 && mRecords[i-1].isErased())
+                --i;
+
+            removeRows (i, end-i);
         }
     }
 
     template<typename ESXRecordT, typename IdAccessorT>
     void Collection<ESXRecordT, IdAccessorT>::removeRows (int index, int count)
     {
-        mRecords.erase (mRecords.begin()+index, mRecords.begin()+index+count);
-
-        typename std::map<std::string, int>::iterator iter = mIndex.begin();
-
-        while (iter!=mIndex.end())
+        for (int row = index; row<index+count; ++row)
         {
-            if (iter->second>=index)
-            {
-                if (iter->second>=index+count)
-                {
-                    iter->second -= count;
-                    ++iter;
-                }
-                else
-                {
-                    mIndex.erase (iter++);
-                }
-            }
-            else
-                ++iter;
+            int handle = mHandles.at (row);
+            mRows[handle] = -1;
+            mFreeHandles.push_back (handle);
+
+            mIndex.erase (mIds[handle]);
+            mSortedIds.erase (mIds[handle]);
+            mIds[handle].clear();
         }
+
+        mRecords.erase (mRecords.begin()+index, mRecords.begin()+index+count);
+        mHandles.erase (mHandles.begin()+index, mHandles.begin()+index+count);
+
+        // the rows behind the removed ones have moved
+        updateRows (index, static_cast<int> (mHandles.size()));
     }
 
     template<typename ESXRecordT, typename IdAccessorT>
@@ -481,12 +535,12 @@ namespace CSMWorld
     {
         std::string id2 = Misc::StringUtils::lowerCase(id);
 
-        std::map<std::string, int>::const_iterator iter = mIndex.find (id2);
+        std::unordered_map<std::string, int>::const_iterator iter = mIndex.find (id2);
 
         if (iter==mIndex.end())
             return -1;
 
-        return iter->second;
+        return getRow (iter->second);
     }
 
     template<typename ESXRecordT, typename IdAccessorT>
@@ -515,12 +569,15 @@ namespace CSMWorld
     std::vector<std::string> Collection<ESXRecordT, IdAccessorT>::getIds (bool listDeleted) const
     {
         std::vector<std::string> ids;
+        ids.reserve (mSortedIds.size());
 
-        for (typename std::map<std::string, int>::const_iterator iter = mIndex.begin();
-            iter!=mIndex.end(); ++iter)
+        for (std::map<std::string, int>::const_iterator iter = mSortedIds.begin();
+            iter!=mSortedIds.end(); ++iter)
         {
-            if (listDeleted || !mRecords[iter->second].isDeleted())
-                ids.push_back (IdAccessorT().getId (mRecords[iter->second].get()));
+            const Record<ESXRecordT>& record = mRecords[getRow (iter->second)];
+
+            if (listDeleted || !record.isDeleted())
+                ids.push_back (IdAccessorT().getId (record.get()));
         }
 
         return ids;
@@ -548,18 +605,19 @@ namespace CSMWorld
 
         const Record<ESXRecordT>& record2 = dynamic_cast<const Record<ESXRecordT>&> (record);
 
+        std::string id = Misc::StringUtils::lowerCase (IdAccessorT().getId (record2.get()));
+
+        int handle = createHandle();
+
         mRecords.insert (mRecords.begin()+index, record2);
+        mHandles.insert (mHandles.begin()+index, handle);
 
-        if (index<static_cast<int> (mRecords.size())-1)
-        {
-            for (std::map<std::string, int>::iterator iter (mIndex.begin()); iter!=mIndex.end();
-                ++iter)
-                 if (iter->second>=index)
-                     ++(iter->second);
-        }
+        // the new row and the rows behind it have moved
+        updateRows (index, static_cast<int> (mHandles.size()));
+        mIds[handle] = id;
 
-        mIndex.insert (std::make_pair (Misc::StringUtils::lowerCase (IdAccessorT().getId (
-            record2.get())), index));
+        mIndex.insert (std::make_pair (id, handle));
+        mSortedIds.insert (std::make_pair (id, handle));
     }
 
     template<typename ESXRecordT, typename IdAccessorT>
@@ -1,5 +1,6 @@
 #include "infocollection.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 #include <iterator>
 
@@ -144,14 +145,14 @@ CSMWorld::InfoCollection::Range CSMWorld::InfoCollection::getTopicRange (const s
 {
     std::string topic2 = Misc::StringUtils::lowerCase (topic);
 
-    std::map<std::string, int>::const_iterator iter = getIdMap().lower_bound (topic2);
+    std::map<std::string, int>::const_iterator iter = getSortedIds().lower_bound (topic2);
 
     // Skip invalid records: The beginning of a topic string could be identical to another topic
     // string.
-    for (; iter!=getIdMap().end(); ++iter)
+    for (; iter!=getSortedIds().end(); ++iter)
     {
         std::string testTopicId =
-            Misc::StringUtils::lowerCase (getRecord (iter->second).get().mTopicId);
+            Misc::StringUtils::lowerCase (getRecord (getRow (iter->second)).get().mTopicId);
 
         if (testTopicId==topic2)
             break;
@@ -162,10 +163,10 @@ CSMWorld::InfoCollection::Range CSMWorld::InfoCollection::getTopicRange (const s
             return Range (getRecords().end(), getRecords().end());
     }
 
-    if (iter==getIdMap().end())
+    if (iter==getSortedIds().end())
         return Range (getRecords().end(), getRecords().end());
 
-    RecordConstIterator begin = getRecords().begin()+iter->second;
+    RecordConstIterator begin = getRecords().begin()+getRow (iter->second);
 
     while (begin != getRecords().begin())
     {
@@ -193,22 +194,23 @@ void CSMWorld::InfoCollection::removeDialogueInfos(const std::string& dialogueId
     std::string id = Misc::StringUtils::lowerCase(dialogueId);
     std::vector<int> erasedRecords;
 
-    std::map<std::string, int>::const_iterator current = getIdMap().lower_bound(id);
-    std::map<std::string, int>::const_iterator end = getIdMap().end();
+    std::map<std::string, int>::const_iterator current = getSortedIds().lower_bound(id);
+    std::map<std::string, int>::const_iterator end = getSortedIds().end();
     for (; current != end; ++current)
     {
-        Record<Info> record = getRecord(current->second);
+        int row = getRow(current->second);
+        Record<Info> record = getRecord(row);
 
         if (Misc::StringUtils::ciEqual(dialogueId, record.get().mTopicId))
         {
             if (record.mState == RecordBase::State_ModifiedOnly)
             {
-                erasedRecords.push_back(current->second);
+                erasedRecords.push_back(row);
             }
             else
             {
                 record.mState = RecordBase::State_Deleted;
-                setRecord(current->second, record);
+                setRecord(row, record);
             }
         }
         else
@@ -217,6 +219,9 @@ void CSMWorld::InfoCollection::removeDialogueInfos(const std::string& dialogueId
         }
     }
 
+    // remove from the back, so the rows of the remaining records don't change
+    std::sort(erasedRecords.begin(), erasedRecords.end());
+
     while (!erasedRecords.empty())
     {
         removeRows(erasedRecords.back(), 1);
@@ -6,6 +6,7 @@
 
 #include <components/openmw-mp/NetworkMessages.hpp>
 
+#include <chrono>
 #include <iostream>
 #include "Player.hpp"
 #include "Script/Script.hpp"
@@ -15,6 +16,7 @@ using namespace std;
 Cell::Cell(ESM::Cell cell) : cell(cell)
 {
     cellActorList.count = 0;
+    resetActorStats();
 }
 
 Cell::Iterator Cell::begin() const
@@ -203,6 +205,8 @@ void Cell::sendToLoaded(mwmp::ActorPacket *actorPacket, mwmp::BaseActorList *bas
     plList.sort();
     plList.unique();
 
+    const chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
     for (auto pl : plList)
     {
         if (pl->guid == baseActorList->guid) continue;
@@ -211,7 +215,13 @@ void Cell::sendToLoaded(mwmp::ActorPacket *actorPacket, mwmp::BaseActorList *bas
 
         // Send the packet to this eligible guid
         actorPacket->Send(pl->guid);
+        actorStats.sends++;
     }
+
+    const chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    actorStats.sendTime += elapsed.count();
+    actorStats.packets++;
+    actorStats.actors += (unsigned int) baseActorList->baseActors.size();
 }
 
 void Cell::sendToLoaded(mwmp::ObjectPacket *objectPacket, mwmp::BaseObjectList *baseObjectList) const
@@ -245,3 +255,16 @@ std::string Cell::getDescription() const
 {
     return cell.getDescription();
 }
+
+const Cell::ActorStats &Cell::getActorStats() const
+{
+    return actorStats;
+}
+
+void Cell::resetActorStats()
+{
+    actorStats.packets = 0;
+    actorStats.actors = 0;
+    actorStats.sends = 0;
+    actorStats.sendTime = 0;
+}
@@ -45,6 +45,18 @@ public:
 
     std::string getDescription() const;
 
+    // What relaying the actor packets of this cell has cost since the stats were last reset
+    struct ActorStats
+    {
+        unsigned int packets;
+        unsigned int actors;
+        unsigned int sends;
+        double sendTime;
+    };
+
+    const ActorStats &getActorStats() const;
+    void resetActorStats();
+
 
 private:
     TPlayers players;
@@ -52,6 +64,8 @@ private:
 
     RakNet::RakNetGUID authorityGuid;
     mwmp::BaseActorList cellActorList;
+
+    mutable ActorStats actorStats;
 };
 
 
@@ -1,5 +1,6 @@
 #include "CellController.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include "Cell.hpp"
 #include "Player.hpp"
@@ -191,3 +192,36 @@ void CellController::update(Player *player)
         removeCell(cell);
     }
 }
+
+void CellController::logActorStats(double elapsedSeconds)
+{
+    const size_t maxCellsLogged = 10;
+
+    std::vector<Cell*> busyCells;
+    for (auto &&cell : cells)
+    {
+        if (cell->getActorStats().packets > 0)
+            busyCells.push_back(cell);
+    }
+
+    std::sort(busyCells.begin(), busyCells.end(), [](const Cell *left, const Cell *right)
+    {
+        return left->getActorStats().sendTime > right->getActorStats().sendTime;
+    });
+
+    if (!busyCells.empty())
+    {
+        LOG_MESSAGE_SIMPLE(MWMPLog::LOG_INFO, "Actor packets relayed per cell over the last %.0f seconds:", elapsedSeconds);
+
+        for (size_t i = 0; i < busyCells.size() && i < maxCellsLogged; ++i)
+        {
+            const Cell::ActorStats &stats = busyCells[i]->getActorStats();
+            LOG_APPEND(MWMPLog::LOG_INFO, "- %s: %i players, %.1f packets/s, %.1f actors/s, %.1f sends/s, %.3f ms CPU/s",
+                busyCells[i]->getDescription().c_str(), (int) busyCells[i]->players.size(), stats.packets / elapsedSeconds,
+                stats.actors / elapsedSeconds, stats.sends / elapsedSeconds, stats.sendTime * 1000 / elapsedSeconds);
+        }
+    }
+
+    for (auto &&cell : cells)
+        cell->resetActorStats();
+}
@@ -38,6 +38,9 @@ public:
 
     void update(Player *player);
 
+    // Logs the cells whose actor packets took the most time to relay, then starts counting again
+    void logActorStats(double elapsedSeconds);
+
 private:
     static CellController *sThis;
     TContainer cells;
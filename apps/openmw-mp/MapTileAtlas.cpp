@@ -0,0 +1,221 @@
+#include "MapTileAtlas.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+
+#include <boost/filesystem/operations.hpp>
+
+using namespace std;
+
+namespace
+{
+    const char atlasMagic[8] = {'T', 'E', 'S', '3', 'M', 'P', 'M', 'A'};
+    const uint32_t atlasFormat = 1;
+    const uint32_t initialCapacity = 256;
+}
+
+MapTileAtlas::MapTileAtlas(const string &path) : path(path), usedSlots(0), lastVersion(0)
+{
+    if (!boost::filesystem::exists(path))
+    {
+        boost::iostreams::mapped_file_params params(path);
+        params.flags = boost::iostreams::mapped_file::readwrite;
+        params.new_file_size = sizeof(Header) + initialCapacity * sizeof(Slot);
+        file.open(params);
+
+        Header *header = getHeader();
+        memcpy(header->magic, atlasMagic, sizeof(atlasMagic));
+        header->format = atlasFormat;
+        header->capacity = initialCapacity;
+        return;
+    }
+
+    open();
+
+    if (file.size() < sizeof(Header))
+        throw runtime_error("Map tile atlas " + path + " is not valid");
+
+    const Header *header = getHeader();
+    if (memcmp(header->magic, atlasMagic, sizeof(atlasMagic)) != 0 || header->format != atlasFormat ||
+        file.size() < sizeof(Header) + (uint64_t) header->capacity * sizeof(Slot))
+        throw runtime_error("Map tile atlas " + path + " is not valid");
+
+    for (uint32_t index = 0; index < header->capacity; ++index)
+    {
+        const Slot *slot = getSlot(index);
+        if (slot->version == 0)
+            continue;
+
+        if (slot->size > mwmp::maxImageDataSize)
+            throw runtime_error("Map tile atlas " + path + " has a tile with too much image data");
+
+        usedSlots = index + 1;
+        lastVersion = max(lastVersion, slot->version);
+
+        // The server stopped after storing a changed tile but before freeing its old slot
+        auto inserted = slotsByCoordinates.insert({Coordinates(slot->x, slot->y), index});
+        if (!inserted.second)
+        {
+            if (getSlot(inserted.first->second)->version > slot->version)
+            {
+                getSlot(index)->version = 0;
+                continue;
+            }
+            freeSlot(inserted.first->second);
+            inserted.first->second = index;
+        }
+        slotsByVersion[slot->version] = index;
+    }
+
+    freeSlots.clear();
+    for (uint32_t index = 0; index < usedSlots; ++index)
+    {
+        if (getSlot(index)->version == 0)
+            freeSlots.push_back(index);
+    }
+}
+
+uint32_t MapTileAtlas::store(const mwmp::MapTile &mapTile)
+{
+    if (mapTile.imageData.size() > mwmp::maxImageDataSize)
+        throw runtime_error("Map tile has more image data than fits into the map tile atlas");
+
+    const Coordinates coordinates(mapTile.x, mapTile.y);
+    auto found = slotsByCoordinates.find(coordinates);
+
+    if (found != slotsByCoordinates.end())
+    {
+        const Slot *slot = getSlot(found->second);
+
+        // Players that explored the same cell send the same tile, which others don't need again
+        if (slot->size == mapTile.imageData.size() &&
+            memcmp(slot->imageData, mapTile.imageData.data(), slot->size) == 0)
+            return slot->version;
+    }
+
+    const uint32_t index = allocateSlot();
+
+    Slot *slot = getSlot(index);
+    slot->x = mapTile.x;
+    slot->y = mapTile.y;
+    slot->size = (uint32_t) mapTile.imageData.size();
+    if (!mapTile.imageData.empty())
+        memcpy(slot->imageData, mapTile.imageData.data(), mapTile.imageData.size());
+
+    // The version marks the slot as used, so it's set only after the rest of the tile is written
+    atomic_signal_fence(memory_order_release);
+    slot->version = ++lastVersion;
+    slotsByVersion[slot->version] = index;
+
+    if (found != slotsByCoordinates.end())
+    {
+        freeSlot(found->second);
+        found->second = index;
+    }
+    else
+        slotsByCoordinates[coordinates] = index;
+
+    return slot->version;
+}
+
+bool MapTileAtlas::getUnknownTiles(KnownTiles &known, vector<mwmp::MapTile> &mapTiles, size_t maxBytes) const
+{
+    size_t bytes = 0;
+
+    for (auto it = slotsByVersion.upper_bound(known.cursor); it != slotsByVersion.end(); ++it)
+    {
+        if (bytes >= maxBytes)
+            return true;
+
+        known.cursor = it->first;
+
+        const Slot *slot = getSlot(it->second);
+        uint32_t &knownVersion = known.versions[Coordinates(slot->x, slot->y)];
+        if (knownVersion >= slot->version)
+            continue;
+
+        knownVersion = slot->version;
+
+        mwmp::MapTile mapTile;
+        mapTile.x = slot->x;
+        mapTile.y = slot->y;
+        mapTile.imageData.assign(slot->imageData, slot->imageData + slot->size);
+        mapTiles.push_back(std::move(mapTile));
+
+        bytes += slot->size;
+    }
+
+    return false;
+}
+
+bool MapTileAtlas::hasUnknownTiles(const KnownTiles &known) const
+{
+    return known.cursor < lastVersion;
+}
+
+size_t MapTileAtlas::getTileCount() const
+{
+    return slotsByCoordinates.size();
+}
+
+void MapTileAtlas::open()
+{
+    boost::iostreams::mapped_file_params params(path);
+    params.flags = boost::iostreams::mapped_file::readwrite;
+    file.open(params);
+}
+
+void MapTileAtlas::grow()
+{
+    const uint32_t capacity = getHeader()->capacity * 2;
+
+    file.close();
+    boost::filesystem::resize_file(path, sizeof(Header) + capacity * sizeof(Slot));
+    open();
+
+    getHeader()->capacity = capacity;
+}
+
+uint32_t MapTileAtlas::allocateSlot()
+{
+    if (!freeSlots.empty())
+    {
+        const uint32_t index = freeSlots.back();
+        freeSlots.pop_back();
+        return index;
+    }
+
+    if (usedSlots == getHeader()->capacity)
+        grow();
+
+    return usedSlots++;
+}
+
+void MapTileAtlas::freeSlot(uint32_t index)
+{
+    Slot *slot = getSlot(index);
+    slotsByVersion.erase(slot->version);
+    slot->version = 0;
+    freeSlots.push_back(index);
+}
+
+MapTileAtlas::Header *MapTileAtlas::getHeader()
+{
+    return reinterpret_cast<Header *>(file.data());
+}
+
+const MapTileAtlas::Header *MapTileAtlas::getHeader() const
+{
+    return reinterpret_cast<const Header *>(file.const_data());
+}
+
+MapTileAtlas::Slot *MapTileAtlas::getSlot(uint32_t index)
+{
+    return reinterpret_cast<Slot *>(file.data() + sizeof(Header)) + index;
+}
+
+const MapTileAtlas::Slot *MapTileAtlas::getSlot(uint32_t index) const
+{
+    return reinterpret_cast<const Slot *>(file.const_data() + sizeof(Header)) + index;
+}
@@ -0,0 +1,87 @@
+#ifndef OPENMW_MAPTILEATLAS_HPP
+#define OPENMW_MAPTILEATLAS_HPP
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <components/openmw-mp/Base/BaseWorldstate.hpp>
+
+/*
+ * Keeps the explored map tiles of every player in one memory-mapped file, instead of one image file per tile.
+ *
+ * The file is a header followed by fixed-size slots, one per tile. A changed tile is written to a free slot, and
+ * its old slot is only freed once the new one is complete, so a tile that was partly written when the server
+ * stopped is left out and the previous one is kept. Every stored tile gets a new version, which lets the server
+ * send each player only the tiles that are newer than the ones it has.
+ */
+class MapTileAtlas
+{
+public:
+    typedef std::pair<int, int> Coordinates;
+
+    // The tiles a player has, with their versions, and the newest version that has been looked at for it
+    struct KnownTiles
+    {
+        KnownTiles() : cursor(0) {}
+
+        std::map<Coordinates, uint32_t> versions;
+        uint32_t cursor;
+    };
+
+    // Opens the atlas at path, or creates it if it doesn't exist. Throws std::runtime_error if it can't.
+    MapTileAtlas(const std::string &path);
+
+    // Stores a tile if its image data changed, and returns the tile's version
+    uint32_t store(const mwmp::MapTile &mapTile);
+
+    // Adds the tiles that are newer than the ones in known to mapTiles, until maxBytes of image data are added,
+    // and counts them as known. Returns whether any tiles are left to send afterwards.
+    bool getUnknownTiles(KnownTiles &known, std::vector<mwmp::MapTile> &mapTiles, size_t maxBytes) const;
+
+    bool hasUnknownTiles(const KnownTiles &known) const;
+
+    size_t getTileCount() const;
+
+private:
+    struct Header
+    {
+        char magic[8];
+        uint32_t format;
+        uint32_t capacity;
+    };
+
+    // A slot with a version of 0 is free
+    struct Slot
+    {
+        int32_t x;
+        int32_t y;
+        uint32_t version;
+        uint32_t size;
+        char imageData[mwmp::maxImageDataSize];
+    };
+
+    void open();
+    void grow();
+    uint32_t allocateSlot();
+    void freeSlot(uint32_t index);
+    Header *getHeader();
+    const Header *getHeader() const;
+    Slot *getSlot(uint32_t index);
+    const Slot *getSlot(uint32_t index) const;
+
+    std::string path;
+    boost::iostreams::mapped_file file;
+
+    std::map<Coordinates, uint32_t> slotsByCoordinates;
+    std::map<uint32_t, uint32_t> slotsByVersion;
+    std::vector<uint32_t> freeSlots; // Free slots before usedSlots
+    uint32_t usedSlots;
+    uint32_t lastVersion;
+};
+
+#endif //OPENMW_MAPTILEATLAS_HPP
@@ -8,8 +8,11 @@
 #include <components/openmw-mp/MWMPLog.hpp>
 #include <components/openmw-mp/Version.hpp>
 #include <components/openmw-mp/Packets/PacketPreInit.hpp>
+#include <components/openmw-mp/Packets/PacketStringTable.hpp>
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
 #include <Script/Script.hpp>
 #include <Script/API/TimerAPI.hpp>
 #include <chrono>
@@ -33,7 +36,7 @@ static int currentMpNum = 0;
 static bool dataFileEnforcementState = true;
 static bool scriptErrorIgnoringState = false;
 
-Networking::Networking(RakNet::RakPeerInterface *peer) : mclient(nullptr)
+Networking::Networking(RakNet::RakPeerInterface *peer) : mclient(nullptr), worldSnapshotPacket(peer)
 {
     sThis = this;
     this->peer = peer;
@@ -51,6 +54,18 @@ Networking::Networking(RakNet::RakPeerInterface *peer) : mclient(nullptr)
     actorPacketController->SetStream(0, &bsOut);
     objectPacketController->SetStream(0, &bsOut);
     worldstatePacketController->SetStream(0, &bsOut);
+    worldSnapshotPacket.SetSendStream(&bsOut);
+
+    worldSnapshotRate = 128 * 1024;
+    worldSnapshotBudget = 0;
+    lastWorldSnapshotTime = chrono::steady_clock::now();
+
+    mapTileRate = 32 * 1024;
+    mapTileBudget = 0;
+    lastMapTileTime = chrono::steady_clock::now();
+
+    cellStatsInterval = 0;
+    lastCellStatsTime = chrono::steady_clock::now();
 
     running = true;
     exitCode = 0;
@@ -80,6 +95,69 @@ void Networking::setServerPassword(std::string password) noexcept
     serverPassword = password.empty() ? TES3MP_DEFAULT_PASSW : password;
 }
 
+void Networking::setWorldSnapshotRate(unsigned int bytesPerSecond)
+{
+    worldSnapshotRate = bytesPerSecond;
+}
+
+void Networking::setCellStatsInterval(unsigned int seconds)
+{
+    cellStatsInterval = seconds;
+    lastCellStatsTime = chrono::steady_clock::now();
+}
+
+void Networking::setMapTileAtlas(const std::string &path, unsigned int bytesPerSecond)
+{
+    mapTileAtlas.reset();
+    knownMapTiles.clear();
+    mapTileRate = bytesPerSecond;
+
+    if (path.empty())
+        return;
+
+    try
+    {
+        mapTileAtlas.reset(new MapTileAtlas(path));
+        LOG_MESSAGE_SIMPLE(MWMPLog::LOG_INFO, "Loaded %u map tiles from %s",
+            (unsigned int) mapTileAtlas->getTileCount(), path.c_str());
+    }
+    catch (const std::exception &e)
+    {
+        LOG_MESSAGE_SIMPLE(MWMPLog::LOG_ERROR, "Could not open map tile atlas %s: %s", path.c_str(), e.what());
+        LOG_APPEND(MWMPLog::LOG_ERROR, "- Map tiles will not be stored by the server");
+    }
+}
+
+bool Networking::hasMapTileAtlas() const
+{
+    return mapTileAtlas != nullptr;
+}
+
+void Networking::storeMapTiles(RakNet::RakNetGUID guid, const std::vector<MapTile> &mapTiles)
+{
+    if (!mapTileAtlas)
+        return;
+
+    for (const MapTile &mapTile : mapTiles)
+    {
+        try
+        {
+            const uint32_t version = mapTileAtlas->store(mapTile);
+
+            // The player that sent a tile doesn't need to get it back
+            if (guid != RakNet::UNASSIGNED_CRABNET_GUID)
+            {
+                uint32_t &knownVersion = knownMapTiles[guid].versions[MapTileAtlas::Coordinates(mapTile.x, mapTile.y)];
+                knownVersion = std::max(knownVersion, version);
+            }
+        }
+        catch (const std::exception &e)
+        {
+            LOG_MESSAGE_SIMPLE(MWMPLog::LOG_ERROR, "Could not store map tile %i, %i: %s", mapTile.x, mapTile.y, e.what());
+        }
+    }
+}
+
 bool Networking::isPassworded() const
 {
     return serverPassword != TES3MP_DEFAULT_PASSW;
@@ -172,6 +250,10 @@ void Networking::processPlayerPacket(RakNet::Packet *packet)
     else if (player->getLoadState() == Player::LOADED)
     {
         player->setLoadState(Player::POSTLOADED);
+
+        // From now on, every packet sent to this client is read by it
+        PacketStringTables::enable(packet->guid);
+
         newPlayer(packet->guid);
         return;
     }
@@ -325,11 +407,15 @@ void Networking::newPlayer(RakNet::RakNetGUID guid)
     playerPacketController->GetPacket(ID_PLAYER_CELL_CHANGE)->RequestData(guid);
     playerPacketController->GetPacket(ID_PLAYER_EQUIPMENT)->RequestData(guid);
 
-    LOG_MESSAGE_SIMPLE(MWMPLog::LOG_WARN, "Sending info about other players to %lu", guid.g);
+    // The other players are sent in chunks by sendWorldSnapshots(), so that a join doesn't hold up the main loop
+    WorldSnapshotStream stream;
+    stream.guid = guid;
+    stream.nextPlayer = 0;
+    stream.nextChunk = 0;
 
-    for (TPlayers::iterator pl = players->begin(); pl != players->end(); pl++) //sending other players to new player
+    for (TPlayers::iterator pl = players->begin(); pl != players->end(); pl++)
     {
-        // If we are iterating over the new player, don't send the packets below
+        // If we are iterating over the new player, don't send it to itself
         if (pl->first == guid) continue;
 
         // If an invalid key makes it into the Players map, ignore it
@@ -340,27 +426,154 @@ void Networking::newPlayer(RakNet::RakNetGUID guid)
 
         // If we are iterating over a player who has inputted their name, proceed
         else if (pl->second->getLoadState() == Player::POSTLOADED)
+            stream.players.push_back(pl->first);
+    }
+
+    if (stream.players.empty())
+        return;
+
+    LOG_MESSAGE_SIMPLE(MWMPLog::LOG_INFO, "Queueing world snapshot with %u other players for %lu",
+        (unsigned int) stream.players.size(), guid.g);
+
+    worldSnapshotStreams.push_back(std::move(stream));
+}
+
+void Networking::sendWorldSnapshots()
+{
+    const chrono::steady_clock::time_point now = chrono::steady_clock::now();
+    const chrono::duration<double> elapsed = now - lastWorldSnapshotTime;
+    lastWorldSnapshotTime = now;
+
+    if (worldSnapshotStreams.empty())
+    {
+        worldSnapshotBudget = 0;
+        return;
+    }
+
+    // A rate of 0 sends every snapshot in full right away
+    if (worldSnapshotRate == 0)
+    {
+        while (!worldSnapshotStreams.empty())
+            sendWorldSnapshotChunk();
+        return;
+    }
+
+    // Don't let the budget build up beyond about one chunk, so that the chunks are spread out over time
+    worldSnapshotBudget = std::min(worldSnapshotBudget + elapsed.count() * worldSnapshotRate, (double) worldSnapshotChunkSize);
+
+    while (worldSnapshotBudget > 0 && !worldSnapshotStreams.empty())
+        worldSnapshotBudget -= sendWorldSnapshotChunk();
+}
+
+uint32_t Networking::sendWorldSnapshotChunk()
+{
+    static const RakNet::MessageID playerPacketIDs[] = {
+        ID_PLAYER_BASEINFO, ID_PLAYER_STATS_DYNAMIC, ID_PLAYER_ATTRIBUTE, ID_PLAYER_SKILL,
+        ID_PLAYER_POSITION, ID_PLAYER_CELL_CHANGE, ID_PLAYER_EQUIPMENT
+    };
+
+    // Take turns between joining players
+    WorldSnapshotStream stream = std::move(worldSnapshotStreams.front());
+    worldSnapshotStreams.pop_front();
+
+    worldSnapshotPacket.clear();
+
+    while (stream.nextPlayer < stream.players.size() && worldSnapshotPacket.getDataSize() < worldSnapshotChunkSize)
+    {
+        // Players are sent as they are now, skipping the ones that have disconnected in the meantime
+        Player *player = Players::getPlayer(stream.players[stream.nextPlayer++]);
+        if (player == nullptr || player->getLoadState() != Player::POSTLOADED)
+            continue;
+
+        for (RakNet::MessageID packetID : playerPacketIDs)
         {
-            playerPacketController->GetPacket(ID_PLAYER_BASEINFO)->setPlayer(pl->second);
-            playerPacketController->GetPacket(ID_PLAYER_STATS_DYNAMIC)->setPlayer(pl->second);
-            playerPacketController->GetPacket(ID_PLAYER_ATTRIBUTE)->setPlayer(pl->second);
-            playerPacketController->GetPacket(ID_PLAYER_SKILL)->setPlayer(pl->second);
-            playerPacketController->GetPacket(ID_PLAYER_POSITION)->setPlayer(pl->second);
-            playerPacketController->GetPacket(ID_PLAYER_CELL_CHANGE)->setPlayer(pl->second);
-            playerPacketController->GetPacket(ID_PLAYER_EQUIPMENT)->setPlayer(pl->second);
-
-            playerPacketController->GetPacket(ID_PLAYER_BASEINFO)->Send(guid);
-            playerPacketController->GetPacket(ID_PLAYER_STATS_DYNAMIC)->Send(guid);
-            playerPacketController->GetPacket(ID_PLAYER_ATTRIBUTE)->Send(guid);
-            playerPacketController->GetPacket(ID_PLAYER_SKILL)->Send(guid);
-            playerPacketController->GetPacket(ID_PLAYER_POSITION)->Send(guid);
-            playerPacketController->GetPacket(ID_PLAYER_CELL_CHANGE)->Send(guid);
-            playerPacketController->GetPacket(ID_PLAYER_EQUIPMENT)->Send(guid);
+            PlayerPacket *packet = playerPacketController->GetPacket(packetID);
+            packet->setPlayer(player);
+
+            RakNet::BitStream packetStream;
+            packet->Packet(&packetStream, true);
+            worldSnapshotPacket.addPacket(packetStream);
         }
     }
 
-    LOG_APPEND(MWMPLog::LOG_WARN, "- Done");
+    worldSnapshotPacket.chunkIndex = stream.nextChunk++;
+    worldSnapshotPacket.isLastChunk = stream.nextPlayer >= stream.players.size();
+    worldSnapshotPacket.setGUID(stream.guid);
+    worldSnapshotPacket.Send(stream.guid);
+
+    const uint32_t sentBytes = bsOut.GetNumberOfBytesUsed();
+
+    if (worldSnapshotPacket.isLastChunk)
+        LOG_MESSAGE_SIMPLE(MWMPLog::LOG_INFO, "Sent world snapshot to %lu in %u chunks", stream.guid.g, (unsigned int) stream.nextChunk);
+    else
+        worldSnapshotStreams.push_back(std::move(stream));
+
+    return sentBytes;
+}
+
+void Networking::sendMapTiles()
+{
+    const chrono::steady_clock::time_point now = chrono::steady_clock::now();
+    const chrono::duration<double> elapsed = now - lastMapTileTime;
+    lastMapTileTime = now;
+
+    if (!mapTileAtlas || players->empty())
+    {
+        mapTileBudget = 0;
+        return;
+    }
+
+    // A rate of 0 gives every player a packet of tiles on every update, otherwise the budget doesn't build up
+    // beyond about one packet, so that the packets are spread out over time
+    if (mapTileRate == 0)
+        mapTileBudget = std::numeric_limits<double>::max();
+    else
+        mapTileBudget = std::min(mapTileBudget + elapsed.count() * mapTileRate, (double) mapTilePacketSize);
+
+    WorldstatePacket *packet = worldstatePacketController->GetPacket(ID_WORLD_MAP);
+
+    // Take turns between the players that are missing tiles
+    TPlayers::iterator pl = players->upper_bound(lastMapTilePlayer);
+    for (size_t i = 0; i < players->size() && mapTileBudget > 0; ++i, ++pl)
+    {
+        if (pl == players->end())
+            pl = players->begin();
+
+        if (pl->second == nullptr || pl->second->getLoadState() != Player::POSTLOADED)
+            continue;
+
+        MapTileAtlas::KnownTiles &known = knownMapTiles[pl->first];
+        if (!mapTileAtlas->hasUnknownTiles(known))
+            continue;
+
+        lastMapTilePlayer = pl->first;
+
+        mapTileWorldstate.mapTiles.clear();
+        mapTileAtlas->getUnknownTiles(known, mapTileWorldstate.mapTiles, mapTilePacketSize);
+        if (mapTileWorldstate.mapTiles.empty())
+            continue;
+
+        mapTileWorldstate.guid = pl->first;
+        packet->setWorldstate(&mapTileWorldstate);
+        packet->Send(false);
+
+        mapTileBudget -= bsOut.GetNumberOfBytesUsed();
+    }
+}
+
+void Networking::logCellStats()
+{
+    if (cellStatsInterval == 0)
+        return;
+
+    const chrono::steady_clock::time_point now = chrono::steady_clock::now();
+    const chrono::duration<double> elapsed = now - lastCellStatsTime;
+
+    if (elapsed.count() < cellStatsInterval)
+        return;
 
+    CellController::get()->logActorStats(elapsed.count());
+    lastCellStatsTime = now;
 }
 
 void Networking::disconnectPlayer(RakNet::RakNetGUID guid)
@@ -373,6 +586,11 @@ void Networking::disconnectPlayer(RakNet::RakNetGUID guid)
     playerPacketController->GetPacket(ID_USER_DISCONNECTED)->setPlayer(player);
     playerPacketController->GetPacket(ID_USER_DISCONNECTED)->Send(true);
     Players::deletePlayer(guid);
+    PacketStringTables::remove(guid);
+
+    worldSnapshotStreams.erase(std::remove_if(worldSnapshotStreams.begin(), worldSnapshotStreams.end(),
+        [&guid](const WorldSnapshotStream &stream) { return stream.guid == guid; }), worldSnapshotStreams.end());
+    knownMapTiles.erase(guid);
 }
 
 PlayerPacketController *Networking::getPlayerPacketController() const
@@ -522,6 +740,8 @@ int Networking::mainLoop()
                     bsIn.IgnoreBytes((unsigned int) RakNet::RakNetGUID::size()); // Ignore GUID from received packet
 
 
+                    PacketStringTables::setSender(packet->guid);
+
                     if (Players::doesPlayerExist(packet->guid))
                         update(packet, bsIn);
                     else
@@ -530,6 +750,9 @@ int Networking::mainLoop()
                 }
             }
         }
+        sendWorldSnapshots();
+        sendMapTiles();
+        logCellStats();
         TimerAPI::Tick();
         this_thread::sleep_for(chrono::milliseconds(1));
     }
@@ -6,6 +6,13 @@
 #include <components/openmw-mp/Controllers/ObjectPacketController.hpp>
 #include <components/openmw-mp/Controllers/WorldstatePacketController.hpp>
 #include <components/openmw-mp/Packets/PacketPreInit.hpp>
+#include <components/openmw-mp/Packets/PacketWorldSnapshot.hpp>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <memory>
+#include <vector>
+#include "MapTileAtlas.hpp"
 #include "Player.hpp"
 
 class MasterClient;
@@ -64,6 +71,18 @@ namespace  mwmp
         void setServerPassword(std::string passw) noexcept;
         bool isPassworded() const;
 
+        // Maximum number of bytes per second used to send world snapshots to joining players
+        void setWorldSnapshotRate(unsigned int bytesPerSecond);
+
+        // How often to log what relaying actor packets costs per cell, 0 to never log it
+        void setCellStatsInterval(unsigned int seconds);
+
+        // Keep the map tiles sent by players in the atlas at path, an empty path turns the atlas off,
+        // and send players the tiles they don't have with at most bytesPerSecond
+        void setMapTileAtlas(const std::string &path, unsigned int bytesPerSecond);
+        bool hasMapTileAtlas() const;
+        void storeMapTiles(RakNet::RakNetGUID guid, const std::vector<MapTile> &mapTiles);
+
         static const Networking &get();
         static Networking *getPtr();
 
@@ -72,6 +91,10 @@ namespace  mwmp
         PacketPreInit::PluginContainer &getSamples();
     private:
         bool preInit(RakNet::Packet *packet, RakNet::BitStream &bsIn);
+        void sendWorldSnapshots();
+        uint32_t sendWorldSnapshotChunk();
+        void sendMapTiles();
+        void logCellStats();
         std::string serverPassword;
         static Networking *sThis;
 
@@ -92,6 +115,38 @@ namespace  mwmp
         bool running;
         int exitCode;
         PacketPreInit::PluginContainer samples;
+
+        // The players that still have to be sent to a joining player, as of when it joined
+        struct WorldSnapshotStream
+        {
+            RakNet::RakNetGUID guid;
+            std::vector<RakNet::RakNetGUID> players;
+            size_t nextPlayer;
+            uint16_t nextChunk;
+        };
+
+        std::deque<WorldSnapshotStream> worldSnapshotStreams;
+        PacketWorldSnapshot worldSnapshotPacket;
+        unsigned int worldSnapshotRate;
+        double worldSnapshotBudget;
+        std::chrono::steady_clock::time_point lastWorldSnapshotTime;
+
+        // Amount of packet data before compression that goes into one chunk of a world snapshot
+        const static uint32_t worldSnapshotChunkSize = 16 * 1024;
+
+        std::unique_ptr<MapTileAtlas> mapTileAtlas;
+        std::map<RakNet::RakNetGUID, MapTileAtlas::KnownTiles> knownMapTiles;
+        BaseWorldstate mapTileWorldstate;
+        RakNet::RakNetGUID lastMapTilePlayer;
+        unsigned int mapTileRate;
+        double mapTileBudget;
+        std::chrono::steady_clock::time_point lastMapTileTime;
+
+        // Amount of image data that goes into one packet of map tiles
+        const static uint32_t mapTilePacketSize = 16 * 1024;
+
+        unsigned int cellStatsInterval;
+        std::chrono::steady_clock::time_point lastCellStatsTime;
     };
 }
 
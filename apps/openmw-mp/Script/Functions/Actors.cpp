@@ -8,6 +8,8 @@
 
 #include <components/esm/creaturestats.hpp>
 
+#include <GetTime.h>
+
 #include "Actors.hpp"
 
 using namespace mwmp;
@@ -409,6 +411,11 @@ void ActorFunctions::SendActorAuthority() noexcept
 
 void ActorFunctions::SendActorPosition(bool sendToOtherVisitors, bool skipAttachedPlayer) noexcept
 {
+    // Stamp the positions like relayed ones, so clients play them back in order with those
+    const uint32_t positionTime = RakNet::GetTimeMS();
+    for (auto &actor : writeActorList.baseActors)
+        actor.positionTime = positionTime;
+
     mwmp::ActorPacket *actorPacket = mwmp::Networking::get().getActorPacketController()->GetPacket(ID_ACTOR_POSITION);
     actorPacket->setActorList(&writeActorList);
 
@@ -9,6 +9,8 @@
 
 using namespace mwmp;
 
+static_assert(equipmentSlots == MWWorld::InventoryStore::Slots, "Packets have to carry every equipment slot");
+
 void ItemFunctions::ClearInventoryChanges(unsigned short pid) noexcept
 {
     Player *player;
@@ -196,6 +196,16 @@ void WorldstateFunctions::LoadMapTileImageFile(int cellX, int cellY, const char*
     }
 }
 
+bool WorldstateFunctions::IsMapTileAtlasEnabled() noexcept
+{
+    return mwmp::Networking::getPtr()->hasMapTileAtlas();
+}
+
+void WorldstateFunctions::StoreMapChangesInAtlas() noexcept
+{
+    mwmp::Networking::getPtr()->storeMapTiles(RakNet::UNASSIGNED_CRABNET_GUID, writeWorldstate.mapTiles);
+}
+
 void WorldstateFunctions::SendWorldMap(unsigned short pid, bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
 {
     Player *player;
@@ -49,6 +49,9 @@
     {"SaveMapTileImageFile",              WorldstateFunctions::SaveMapTileImageFile},\
     {"LoadMapTileImageFile",              WorldstateFunctions::LoadMapTileImageFile},\
     \
+    {"IsMapTileAtlasEnabled",             WorldstateFunctions::IsMapTileAtlasEnabled},\
+    {"StoreMapChangesInAtlas",            WorldstateFunctions::StoreMapChangesInAtlas},\
+    \
     {"SendWorldMap",                      WorldstateFunctions::SendWorldMap},\
     {"SendWorldTime",                     WorldstateFunctions::SendWorldTime},\
     {"SendWorldWeather",                  WorldstateFunctions::SendWorldWeather},\
@@ -331,6 +334,27 @@ public:
     */
     static void LoadMapTileImageFile(int cellX, int cellY, const char* filePath) noexcept;
 
+    /**
+    * \brief Check whether the server keeps map tiles in its own atlas, as set by mapTileAtlas in the
+    *        server's config.
+    *
+    * If it does, map tiles sent by players are stored automatically and every player is sent the
+    * ones they lack, so scripts no longer need to save or send them.
+    *
+    * \return Whether the map tile atlas is enabled.
+    */
+    static bool IsMapTileAtlasEnabled() noexcept;
+
+    /**
+    * \brief Store the map changes in the write-only worldstate in the server's map tile atlas, e.g. to
+    *        import the map tiles previously saved as image files.
+    *
+    * The tiles are then sent to every player that lacks them.
+    *
+    * \return void
+    */
+    static void StoreMapChangesInAtlas() noexcept;
+
     /**
     * \brief Send a WorldRegionAuthority packet establishing a certain player as the only one who
     *        should process certain region-specific events (such as weather changes).
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>
 
 #include <boost/filesystem/fstream.hpp>
@@ -265,6 +266,10 @@ int main(int argc, char *argv[])
 
         Networking networking(peer);
         networking.setServerPassword(password);
+        networking.setWorldSnapshotRate((unsigned) std::max(mgr.getInt("worldSnapshotRate", "General"), 0));
+        networking.setCellStatsInterval((unsigned) std::max(mgr.getInt("cellStatsInterval", "General"), 0));
+        networking.setMapTileAtlas(mgr.getString("mapTileAtlas", "General"),
+            (unsigned) std::max(mgr.getInt("mapTileRate", "General"), 0));
 
         if (mgr.getBool("enabled", "MasterServer"))
         {
@@ -3,6 +3,8 @@
 
 #include "../ActorProcessor.hpp"
 
+#include <GetTime.h>
+
 namespace mwmp
 {
     class ProcessorActorPosition : public ActorProcessor
@@ -20,6 +22,10 @@ namespace mwmp
 
             if (serverCell != nullptr && *serverCell->getAuthority() == actorList.guid)
             {
+                const uint32_t positionTime = RakNet::GetTimeMS();
+                for (auto &actor : actorList.baseActors)
+                    actor.positionTime = positionTime;
+
                 serverCell->readActorList(packetID, &actorList);
                 serverCell->sendToLoaded(&packet, &actorList);
             }
@@ -3,6 +3,8 @@
 
 #include "../PlayerProcessor.hpp"
 
+#include <GetTime.h>
+
 namespace mwmp
 {
     class ProcessorPlayerPosition : public PlayerProcessor
@@ -15,6 +17,8 @@ namespace mwmp
 
         void Do(PlayerPacket &packet, Player &player) override
         {
+            // Clients play positions back by the time they were relayed, so they don't depend on the sending rate
+            player.positionTime = RakNet::GetTimeMS();
             player.sendToLoaded(&packet);
         }
     };
@@ -1,6 +1,7 @@
 #ifndef OPENMW_PROCESSORWORLDMAP_HPP
 #define OPENMW_PROCESSORWORLDMAP_HPP
 
+#include <apps/openmw-mp/Networking.hpp>
 #include "../WorldstateProcessor.hpp"
 
 namespace mwmp
@@ -17,6 +18,8 @@ namespace mwmp
         {
             DEBUG_PRINTF(strPacketID.c_str());
 
+            Networking::getPtr()->storeMapTiles(player.guid, worldstate.mapTiles);
+
             Script::Call<Script::CallbackIdentity("OnWorldMap")>(player.getId());
         }
     };
@@ -34,6 +34,11 @@ namespace Loading
     class Listener;
 }
 
+namespace MWMechanics
+{
+    class AsyncPathFinder;
+}
+
 namespace MWBase
 {
     /// \brief Interface for game mechanics manager (implemented in MWMechanics)
@@ -281,6 +286,9 @@ namespace MWBase
             virtual bool isAttackPrepairing(const MWWorld::Ptr& ptr) = 0;
             virtual bool isRunning(const MWWorld::Ptr& ptr) = 0;
             virtual bool isSneaking(const MWWorld::Ptr& ptr) = 0;
+
+            /// Finds paths for AI packages in the background
+            virtual MWMechanics::AsyncPathFinder& getAsyncPathFinder() = 0;
     };
 }
 
@@ -143,6 +143,9 @@ namespace MWBase
             virtual void stopSound(Sound *sound) = 0;
             ///< Stop the given sound from playing
 
+            virtual void preloadSound(const std::string& soundId) = 0;
+            ///< Start decoding the given sound in the background, so it's ready once it's played.
+
             virtual void stopSound3D(const MWWorld::ConstPtr &reference, const std::string& soundId) = 0;
             ///< Stop the given object from playing the given sound,
 
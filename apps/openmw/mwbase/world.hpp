@@ -19,6 +19,7 @@ namespace osg
     class Matrixf;
     class Quat;
     class Image;
+    class Stats;
 }
 
 namespace Loading
@@ -518,6 +519,8 @@ namespace MWBase
 
             virtual void updateWindowManager () = 0;
 
+            virtual void reportStats (unsigned int frameNumber, osg::Stats& stats) const = 0;
+
             virtual MWWorld::Ptr placeObject (const MWWorld::ConstPtr& object, float cursorX, float cursorY, int amount) = 0;
             ///< copy and place an object into the gameworld at the specified cursor position
             /// @param object
@@ -189,7 +189,9 @@ namespace
                 int index = class_->mData.mSkills[i2][i];
                 if (index >= 0 && index < ESM::Skill::Length)
                 {
-                    npcStats.getSkill(index).setBase (npcStats.getSkill(index).getBase() + bonus);
+                    MWMechanics::SkillValue skill = npcStats.getSkill(index);
+                    skill.setBase (skill.getBase() + bonus);
+                    npcStats.setSkill(index, skill);
                 }
             }
         }
@@ -229,14 +231,16 @@ namespace
                 specBonus = 5;
             }
 
-            npcStats.getSkill(skillIndex).setBase(
+            MWMechanics::SkillValue skillValue = npcStats.getSkill(skillIndex);
+            skillValue.setBase(
                   std::min(
                     round_ieee_754(
-                            npcStats.getSkill(skillIndex).getBase()
+                            skillValue.getBase()
                     + 5
                     + raceBonus
                     + specBonus
                     +(int(level)-1) * (majorMultiplier + specMultiplier)), 100)); // Must gracefully handle level 0
+            npcStats.setSkill(skillIndex, skillValue);
         }
 
         int skills[ESM::Skill::Length];
@@ -330,7 +334,11 @@ namespace MWClass
                 gold = ref->mBase->mNpdt.mGold;
 
                 for (unsigned int i=0; i< ESM::Skill::Length; ++i)
-                    data->mNpcStats.getSkill (i).setBase (ref->mBase->mNpdt.mSkills[i]);
+                {
+                    MWMechanics::SkillValue skill = data->mNpcStats.getSkill (i);
+                    skill.setBase (ref->mBase->mNpdt.mSkills[i]);
+                    data->mNpcStats.setSkill (i, skill);
+                }
 
                 data->mNpcStats.setAttribute(ESM::Attribute::Strength, ref->mBase->mNpdt.mStrength);
                 data->mNpcStats.setAttribute(ESM::Attribute::Intelligence, ref->mBase->mNpdt.mIntelligence);
@@ -74,6 +74,12 @@ namespace MWDialogue
         mIsInChoice = false;
         mGoodbye = false;
         mCompilerContext.setExtensions (&extensions);
+
+        const MWWorld::Store<ESM::Dialogue>& dialogues =
+            MWBase::Environment::get().getWorld()->getStore().get<ESM::Dialogue>();
+
+        for (MWWorld::Store<ESM::Dialogue>::iterator it = dialogues.begin(); it != dialogues.end(); ++it)
+            mFilterIndex.addDialogue (*it);
     }
 
     void DialogueManager::clear()
@@ -169,7 +175,7 @@ namespace MWDialogue
         const MWWorld::Store<ESM::Dialogue> &dialogs =
             MWBase::Environment::get().getWorld()->getStore().get<ESM::Dialogue>();
 
-        Filter filter (actor, mChoice, mTalkedTo);
+        Filter filter (actor, mChoice, mTalkedTo, &mFilterIndex);
 
         for (MWWorld::Store<ESM::Dialogue>::iterator it = dialogs.begin(); it != dialogs.end(); ++it)
         {
@@ -289,7 +295,7 @@ namespace MWDialogue
 
     void DialogueManager::executeTopic (const std::string& topic, ResponseCallback* callback)
     {
-        Filter filter (mActor, mChoice, mTalkedTo);
+        Filter filter (mActor, mChoice, mTalkedTo, &mFilterIndex);
 
         const MWWorld::Store<ESM::Dialogue> &dialogues =
             MWBase::Environment::get().getWorld()->getStore().get<ESM::Dialogue>();
@@ -362,7 +368,7 @@ namespace MWDialogue
         const MWWorld::Store<ESM::Dialogue> &dialogs =
             MWBase::Environment::get().getWorld()->getStore().get<ESM::Dialogue>();
 
-        Filter filter (mActor, -1, mTalkedTo);
+        Filter filter (mActor, -1, mTalkedTo, &mFilterIndex);
 
         for (MWWorld::Store<ESM::Dialogue>::iterator iter = dialogs.begin(); iter != dialogs.end(); ++iter)
         {
@@ -436,7 +442,7 @@ namespace MWDialogue
         const ESM::Dialogue* dialogue = searchDialogue(mLastTopic);
         if (dialogue)
         {
-            Filter filter (mActor, mChoice, mTalkedTo);
+            Filter filter (mActor, mChoice, mTalkedTo, &mFilterIndex);
 
             if (dialogue->mType == ESM::Dialogue::Topic || dialogue->mType == ESM::Dialogue::Greeting)
             {
@@ -569,7 +575,7 @@ namespace MWDialogue
 
     bool DialogueManager::checkServiceRefused(ResponseCallback* callback)
     {
-        Filter filter (mActor, mChoice, mTalkedTo);
+        Filter filter (mActor, mChoice, mTalkedTo, &mFilterIndex);
 
         const MWWorld::Store<ESM::Dialogue> &dialogues =
             MWBase::Environment::get().getWorld()->getStore().get<ESM::Dialogue>();
@@ -621,7 +627,7 @@ namespace MWDialogue
         const ESM::Dialogue *dial = store.get<ESM::Dialogue>().find(topic);
 
         const MWMechanics::CreatureStats& creatureStats = actor.getClass().getCreatureStats(actor);
-        Filter filter(actor, 0, creatureStats.hasTalkedToPlayer());
+        Filter filter(actor, 0, creatureStats.hasTalkedToPlayer(), &mFilterIndex);
         const ESM::DialInfo *info = filter.search(*dial, false);
         if(info != NULL)
         {
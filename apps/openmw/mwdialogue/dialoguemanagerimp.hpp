@@ -14,6 +14,8 @@
 
 #include "../mwscript/compilercontext.hpp"
 
+#include "filterindex.hpp"
+
 namespace ESM
 {
     struct Dialogue;
@@ -49,6 +51,8 @@ namespace MWDialogue
             float mTemporaryDispositionChange;
             float mPermanentDispositionChange;
 
+            FilterIndex mFilterIndex;
+
             void parseText (const std::string& text);
 
             void updateActorKnownTopics();
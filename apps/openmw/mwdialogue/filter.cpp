@@ -612,9 +612,32 @@ bool MWDialogue::Filter::hasFactionRankReputationRequirements (const MWWorld::Pt
     return stats.getFactionReputation (factionId)>=faction.mData.mRankData[rank].mFactReaction;
 }
 
-MWDialogue::Filter::Filter (const MWWorld::Ptr& actor, int choice, bool talkedToPlayer)
-: mActor (actor), mChoice (choice), mTalkedToPlayer (talkedToPlayer)
-{}
+MWDialogue::Filter::Filter (const MWWorld::Ptr& actor, int choice, bool talkedToPlayer, const FilterIndex* index)
+: mActor (actor), mChoice (choice), mTalkedToPlayer (talkedToPlayer), mIndex (index)
+{
+    if (mIndex)
+    {
+        if (mActor.getTypeName() == typeid (ESM::NPC).name())
+            mIndexActor = mIndex->getNpc (mActor.getCellRef().getRefId(), *mActor.get<ESM::NPC>()->mBase);
+        else
+            mIndexActor = mIndex->getCreature (mActor.getCellRef().getRefId());
+    }
+}
+
+std::vector<const ESM::DialInfo *> MWDialogue::Filter::listActorInfos (const ESM::Dialogue& dialogue) const
+{
+    std::vector<const ESM::DialInfo *> infos;
+
+    if (mIndex && mIndex->getInfos (dialogue, mIndexActor, infos))
+        return infos;
+
+    for (ESM::Dialogue::InfoContainer::const_iterator iter = dialogue.mInfo.begin(); iter!=dialogue.mInfo.end(); ++iter)
+    {
+        if (testActor (*iter))
+            infos.push_back(&*iter);
+    }
+    return infos;
+}
 
 const ESM::DialInfo* MWDialogue::Filter::search (const ESM::Dialogue& dialogue, const bool fallbackToInfoRefusal) const
 {
@@ -628,13 +651,7 @@ const ESM::DialInfo* MWDialogue::Filter::search (const ESM::Dialogue& dialogue,
 
 std::vector<const ESM::DialInfo *> MWDialogue::Filter::listAll (const ESM::Dialogue& dialogue) const
 {
-    std::vector<const ESM::DialInfo *> infos;
-    for (ESM::Dialogue::InfoContainer::const_iterator iter = dialogue.mInfo.begin(); iter!=dialogue.mInfo.end(); ++iter)
-    {
-        if (testActor (*iter))
-            infos.push_back(&*iter);
-    }
-    return infos;
+    return listActorInfos (dialogue);
 }
 
 std::vector<const ESM::DialInfo *> MWDialogue::Filter::list (const ESM::Dialogue& dialogue,
@@ -645,13 +662,14 @@ std::vector<const ESM::DialInfo *> MWDialogue::Filter::list (const ESM::Dialogue
     bool infoRefusal = false;
 
     // Iterate over topic responses to find a matching one
-    for (ESM::Dialogue::InfoContainer::const_iterator iter = dialogue.mInfo.begin();
-        iter!=dialogue.mInfo.end(); ++iter)
+    const std::vector<const ESM::DialInfo *> actorInfos = listActorInfos (dialogue);
+    for (std::vector<const ESM::DialInfo *>::const_iterator iter = actorInfos.begin();
+        iter!=actorInfos.end(); ++iter)
     {
-        if (testActor (*iter) && testPlayer (*iter) && testSelectStructs (*iter))
+        if (testPlayer (**iter) && testSelectStructs (**iter))
         {
-            if (testDisposition (*iter, invertDisposition)) {
-                infos.push_back(&*iter);
+            if (testDisposition (**iter, invertDisposition)) {
+                infos.push_back(*iter);
                 if (!searchAll)
                     break;
             }
@@ -670,10 +688,11 @@ std::vector<const ESM::DialInfo *> MWDialogue::Filter::list (const ESM::Dialogue
 
         const ESM::Dialogue& infoRefusalDialogue = *dialogues.find ("Info Refusal");
 
-        for (ESM::Dialogue::InfoContainer::const_iterator iter = infoRefusalDialogue.mInfo.begin();
-            iter!=infoRefusalDialogue.mInfo.end(); ++iter)
-            if (testActor (*iter) && testPlayer (*iter) && testSelectStructs (*iter) && testDisposition(*iter, invertDisposition)) {
-                infos.push_back(&*iter);
+        const std::vector<const ESM::DialInfo *> refusalInfos = listActorInfos (infoRefusalDialogue);
+        for (std::vector<const ESM::DialInfo *>::const_iterator iter = refusalInfos.begin();
+            iter!=refusalInfos.end(); ++iter)
+            if (testPlayer (**iter) && testSelectStructs (**iter) && testDisposition(**iter, invertDisposition)) {
+                infos.push_back(*iter);
                 if (!searchAll)
                     break;
             }
@@ -684,10 +703,11 @@ std::vector<const ESM::DialInfo *> MWDialogue::Filter::list (const ESM::Dialogue
 
 bool MWDialogue::Filter::responseAvailable (const ESM::Dialogue& dialogue) const
 {
-    for (ESM::Dialogue::InfoContainer::const_iterator iter = dialogue.mInfo.begin();
-        iter!=dialogue.mInfo.end(); ++iter)
+    const std::vector<const ESM::DialInfo *> actorInfos = listActorInfos (dialogue);
+    for (std::vector<const ESM::DialInfo *>::const_iterator iter = actorInfos.begin();
+        iter!=actorInfos.end(); ++iter)
     {
-        if (testActor (*iter) && testPlayer (*iter) && testSelectStructs (*iter))
+        if (testPlayer (**iter) && testSelectStructs (**iter))
             return true;
     }
 
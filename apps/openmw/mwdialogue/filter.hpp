@@ -5,6 +5,8 @@
 
 #include "../mwworld/ptr.hpp"
 
+#include "filterindex.hpp"
+
 namespace ESM
 {
     struct DialInfo;
@@ -20,6 +22,11 @@ namespace MWDialogue
             MWWorld::Ptr mActor;
             int mChoice;
             bool mTalkedToPlayer;
+            const FilterIndex* mIndex;
+            FilterIndex::Actor mIndexActor;
+
+            std::vector<const ESM::DialInfo *> listActorInfos (const ESM::Dialogue& dialogue) const;
+            ///< List the infos that are for the right actor, in the order of the dialogue.
 
             bool testActor (const ESM::DialInfo& info) const;
             ///< Is this the right actor for this \a info?
@@ -53,7 +60,8 @@ namespace MWDialogue
 
         public:
 
-            Filter (const MWWorld::Ptr& actor, int choice, bool talkedToPlayer);
+            Filter (const MWWorld::Ptr& actor, int choice, bool talkedToPlayer, const FilterIndex* index = nullptr);
+            ///< \param index Used to find the infos for the actor without testing all of them, if given.
 
             std::vector<const ESM::DialInfo *> list (const ESM::Dialogue& dialogue,
                 bool fallbackToInfoRefusal, bool searchAll, bool invertDisposition=false) const;
@@ -0,0 +1,182 @@
+#include "filterindex.hpp"
+
+#include <components/esm/loaddial.hpp>
+#include <components/esm/loadnpc.hpp>
+#include <components/misc/stringops.hpp>
+
+namespace
+{
+    const MWDialogue::FilterIndex::StringId Id_None = -1; // The condition is not set
+    const MWDialogue::FilterIndex::StringId Id_Unknown = -2; // Not used by any info, so it matches no condition
+}
+
+void MWDialogue::FilterIndex::addDialogue (const ESM::Dialogue& dialogue)
+{
+    CompiledDialogue& compiled = mDialogues[&dialogue];
+    compiled = CompiledDialogue();
+    compiled.mInfos.reserve (dialogue.mInfo.size());
+
+    for (ESM::Dialogue::InfoContainer::const_iterator iter = dialogue.mInfo.begin(); iter != dialogue.mInfo.end(); ++iter)
+    {
+        Info info;
+        info.mInfo = &*iter;
+        info.mActor = intern (iter->mActor);
+        info.mRace = intern (iter->mRace);
+        info.mClass = intern (iter->mClass);
+        info.mFaction = intern (iter->mFaction);
+        info.mRank = iter->mData.mRank;
+        info.mGender = iter->mData.mGender;
+        info.mFactionLess = iter->mFactionLess;
+
+        const unsigned int index = static_cast<unsigned int> (compiled.mInfos.size());
+        compiled.mInfos.push_back (info);
+
+        // Each info goes into the bucket of its most specific condition, an actor only matches it if that condition does
+        if (info.mActor != Id_None)
+            compiled.mByActor[info.mActor].push_back (index);
+        else if (info.mFactionLess)
+            compiled.mByFaction[Id_None].push_back (index);
+        else if (info.mFaction != Id_None)
+            compiled.mByFaction[info.mFaction].push_back (index);
+        else if (info.mRace != Id_None)
+            compiled.mByRace[info.mRace].push_back (index);
+        else if (info.mClass != Id_None)
+            compiled.mByClass[info.mClass].push_back (index);
+        else
+            compiled.mOthers.push_back (index);
+    }
+}
+
+MWDialogue::FilterIndex::Actor MWDialogue::FilterIndex::getNpc (const std::string& refId, const ESM::NPC& npc) const
+{
+    Actor actor;
+    actor.mId = find (refId);
+    actor.mRace = find (npc.mRace);
+    actor.mClass = find (npc.mClass);
+    actor.mFaction = find (npc.mFaction);
+    actor.mRank = npc.getFactionRank();
+    actor.mIsCreature = false;
+    actor.mIsFemale = (npc.mFlags & ESM::NPC::Female) != 0;
+    return actor;
+}
+
+MWDialogue::FilterIndex::Actor MWDialogue::FilterIndex::getCreature (const std::string& refId) const
+{
+    Actor actor;
+    actor.mId = find (refId);
+    actor.mRace = Id_Unknown;
+    actor.mClass = Id_Unknown;
+    actor.mFaction = Id_Unknown;
+    actor.mRank = -1;
+    actor.mIsCreature = true;
+    actor.mIsFemale = false;
+    return actor;
+}
+
+bool MWDialogue::FilterIndex::getInfos (const ESM::Dialogue& dialogue, const Actor& actor,
+    std::vector<const ESM::DialInfo *>& infos) const
+{
+    std::unordered_map<const ESM::Dialogue*, CompiledDialogue>::const_iterator found = mDialogues.find (&dialogue);
+    if (found == mDialogues.end())
+        return false;
+
+    const CompiledDialogue& compiled = found->second;
+
+    // Creatures must not have topics aside of those specific to their id
+    const Bucket* buckets[5] = { findBucket (compiled.mByActor, actor.mId) };
+    std::size_t numBuckets = 1;
+    if (!actor.mIsCreature)
+    {
+        buckets[numBuckets++] = findBucket (compiled.mByFaction, actor.mFaction);
+        buckets[numBuckets++] = findBucket (compiled.mByRace, actor.mRace);
+        buckets[numBuckets++] = findBucket (compiled.mByClass, actor.mClass);
+        buckets[numBuckets++] = &compiled.mOthers;
+    }
+
+    // Every info is in one bucket only, so merging the buckets restores the order of the dialogue
+    std::size_t positions[5] = {};
+    while (true)
+    {
+        std::size_t next = numBuckets;
+        for (std::size_t i = 0; i < numBuckets; ++i)
+        {
+            if (buckets[i] && positions[i] < buckets[i]->size()
+                && (next == numBuckets || (*buckets[i])[positions[i]] < (*buckets[next])[positions[next]]))
+                next = i;
+        }
+
+        if (next == numBuckets)
+            break;
+
+        const Info& info = compiled.mInfos[(*buckets[next])[positions[next]++]];
+        if (test (info, actor))
+            infos.push_back (info.mInfo);
+    }
+
+    return true;
+}
+
+MWDialogue::FilterIndex::StringId MWDialogue::FilterIndex::intern (const std::string& id)
+{
+    if (id.empty())
+        return Id_None;
+
+    std::pair<std::map<std::string, StringId>::iterator, bool> inserted =
+        mStrings.insert (std::make_pair (Misc::StringUtils::lowerCase (id), static_cast<StringId> (mStrings.size())));
+
+    return inserted.first->second;
+}
+
+MWDialogue::FilterIndex::StringId MWDialogue::FilterIndex::find (const std::string& id) const
+{
+    if (id.empty())
+        return Id_None;
+
+    std::map<std::string, StringId>::const_iterator found = mStrings.find (Misc::StringUtils::lowerCase (id));
+    if (found == mStrings.end())
+        return Id_Unknown;
+
+    return found->second;
+}
+
+bool MWDialogue::FilterIndex::test (const Info& info, const Actor& actor)
+{
+    if (info.mActor != Id_None && info.mActor != actor.mId)
+        return false;
+
+    if (actor.mIsCreature)
+        return info.mActor != Id_None;
+
+    if (info.mRace != Id_None && info.mRace != actor.mRace)
+        return false;
+
+    if (info.mClass != Id_None && info.mClass != actor.mClass)
+        return false;
+
+    if (info.mFactionLess)
+    {
+        if (actor.mFaction != Id_None)
+            return false;
+    }
+    else if (info.mFaction != Id_None)
+    {
+        if (info.mFaction != actor.mFaction || actor.mRank < info.mRank)
+            return false;
+    }
+    else if (info.mRank != -1)
+    {
+        if (actor.mRank < info.mRank)
+            return false;
+    }
+
+    return info.mGender != (actor.mIsFemale ? 0 : 1);
+}
+
+const MWDialogue::FilterIndex::Bucket* MWDialogue::FilterIndex::findBucket (const Buckets& buckets, StringId id)
+{
+    Buckets::const_iterator found = buckets.find (id);
+    if (found == buckets.end())
+        return nullptr;
+
+    return &found->second;
+}
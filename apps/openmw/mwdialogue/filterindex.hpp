@@ -0,0 +1,94 @@
+#ifndef GAME_MWDIALOGUE_FILTERINDEX_H
+#define GAME_MWDIALOGUE_FILTERINDEX_H
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ESM
+{
+    struct DialInfo;
+    struct Dialogue;
+    struct NPC;
+}
+
+namespace MWDialogue
+{
+    /// \brief Conditions of dialogue infos that only depend on the actor's records, compiled for fast filtering
+    ///
+    /// Actor ID, race, class and faction of each info are interned to integers, and the infos of each dialogue
+    /// are put into buckets by the most specific of them. An actor then only has to look at the buckets for its
+    /// own ID, faction, race and class, and at the infos that have none of these conditions.
+    class FilterIndex
+    {
+        public:
+
+            typedef int StringId;
+
+            /// The static properties of an actor, as interned by the index
+            struct Actor
+            {
+                StringId mId;
+                StringId mRace;
+                StringId mClass;
+                StringId mFaction;
+                int mRank;
+                bool mIsCreature;
+                bool mIsFemale;
+            };
+
+            /// Compiles the infos of \a dialogue. Infos must not be added or removed afterwards.
+            void addDialogue (const ESM::Dialogue& dialogue);
+
+            Actor getNpc (const std::string& refId, const ESM::NPC& npc) const;
+
+            Actor getCreature (const std::string& refId) const;
+
+            bool getInfos (const ESM::Dialogue& dialogue, const Actor& actor,
+                std::vector<const ESM::DialInfo *>& infos) const;
+            ///< Append the infos of \a dialogue whose actor conditions match \a actor, in the order of the dialogue.
+            /// \return Was the dialogue added to the index?
+
+        private:
+
+            struct Info
+            {
+                const ESM::DialInfo* mInfo;
+                StringId mActor;
+                StringId mRace;
+                StringId mClass;
+                StringId mFaction;
+                int mRank;
+                signed char mGender;
+                bool mFactionLess;
+            };
+
+            typedef std::vector<unsigned int> Bucket;
+            typedef std::unordered_map<StringId, Bucket> Buckets;
+
+            struct CompiledDialogue
+            {
+                std::vector<Info> mInfos;
+                Buckets mByActor;
+                Buckets mByFaction; ///< Factionless infos are in the bucket for no faction
+                Buckets mByRace;
+                Buckets mByClass;
+                Bucket mOthers;
+            };
+
+            std::map<std::string, StringId> mStrings;
+            std::unordered_map<const ESM::Dialogue*, CompiledDialogue> mDialogues;
+
+            StringId intern (const std::string& id);
+
+            StringId find (const std::string& id) const;
+
+            static bool test (const Info& info, const Actor& actor);
+            ///< Does the info match the actor? Mirrors Filter::testActor.
+
+            static const Bucket* findBucket (const Buckets& buckets, StringId id);
+    };
+}
+
+#endif
@@ -50,15 +50,17 @@ namespace MWDialogue
             const MWWorld::Store<ESM::Dialogue> & dialogs =
                 MWBase::Environment::get().getWorld()->getStore().get<ESM::Dialogue>();
 
-            std::list<std::string> keywordList;
-            for (MWWorld::Store<ESM::Dialogue>::iterator it = dialogs.begin(); it != dialogs.end(); ++it)
-                keywordList.push_back(Misc::StringUtils::lowerCase(it->mId));
-            keywordList.sort(Misc::StringUtils::ciLess);
+            // Dialogue records don't change after loading, so the keywords only have to be compiled once
+            static KeywordSearch<std::string, int /*unused*/> keywordSearch;
+            static size_t numKeywords = 0;
 
-            KeywordSearch<std::string, int /*unused*/> keywordSearch;
-
-            for (std::list<std::string>::const_iterator it = keywordList.begin(); it != keywordList.end(); ++it)
-                keywordSearch.seed(*it, 0 /*unused*/);
+            if (numKeywords != dialogs.getSize())
+            {
+                keywordSearch.clear();
+                for (MWWorld::Store<ESM::Dialogue>::iterator it = dialogs.begin(); it != dialogs.end(); ++it)
+                    keywordSearch.seed(Misc::StringUtils::lowerCase(it->mId), 0 /*unused*/);
+                numKeywords = dialogs.getSize();
+            }
 
             std::vector<KeywordSearch<std::string, int /*unused*/>::Match> matches;
             keywordSearch.highlightKeywords(text.begin(), text.end(), matches);
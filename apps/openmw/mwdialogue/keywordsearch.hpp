@@ -1,17 +1,24 @@
 #ifndef GAME_MWDIALOGUE_KEYWORDSEARCH_H
 #define GAME_MWDIALOGUE_KEYWORDSEARCH_H
 
-#include <map>
 #include <cctype>
+#include <deque>
 #include <stdexcept>
+#include <unordered_map>
+#include <utility>
 #include <vector>
-#include <algorithm>    // std::reverse
+#include <algorithm>    // std::sort
 
 #include <components/misc/stringops.hpp>
 
 namespace MWDialogue
 {
 
+/// \brief Finds keywords in a text, ignoring case
+///
+/// The keywords are compiled into an Aho-Corasick automaton, so a text is scanned once no matter how many keywords
+/// there are. Seeding only extends the trie, the transitions are rebuilt on the next search. The matches of the
+/// last searched texts are cached until the keywords change.
 template <typename string_t, typename value_t>
 class KeywordSearch
 {
@@ -26,46 +33,61 @@ public:
         value_t mValue;
     };
 
+    KeywordSearch ()
+    {
+        clear ();
+    }
+
     void seed (string_t keyword, value_t value)
     {
         if (keyword.empty())
             return;
-        seed_impl  (/*std::move*/ (keyword), /*std::move*/ (value), 0, mRoot);
+
+        int node = 0;
+        for (Point i = keyword.begin (); i != keyword.end (); ++i)
+        {
+            const unsigned char ch = static_cast<unsigned char> (Misc::StringUtils::toLower (*i));
+            int next = findChild (node, ch);
+            if (next == -1)
+            {
+                next = static_cast<int> (mNodes.size ());
+                mNodes.push_back (Node ());
+                mNodes[next].mDepth = mNodes[node].mDepth + 1;
+                insertChild (node, ch, next);
+            }
+            node = next;
+        }
+
+        if (mNodes[node].mKeyword != -1)
+            throw std::runtime_error ("duplicate keyword inserted");
+
+        mNodes[node].mKeyword = static_cast<int> (mKeywords.size ());
+        mKeywords.push_back (std::make_pair (/*std::move*/ (keyword), /*std::move*/ (value)));
+
+        mCompiled = false;
+        mCache.clear ();
     }
 
     void clear ()
     {
-        mRoot.mChildren.clear ();
-        mRoot.mKeyword.clear ();
+        mNodes.assign (1, Node ());
+        mKeywords.clear ();
+        mCompiled = false;
+        mTransitions.clear ();
+        mCache.clear ();
     }
 
     bool containsKeyword (string_t keyword, value_t& value)
     {
-        typename Entry::childen_t::iterator current;
-        typename Entry::childen_t::iterator next;
+        int node = 0;
+        for (Point i = keyword.begin (); i != keyword.end () && node != -1; ++i)
+            node = findChild (node, static_cast<unsigned char> (Misc::StringUtils::toLower (*i)));
 
-        current = mRoot.mChildren.find (Misc::StringUtils::toLower (*keyword.begin()));
-        if (current == mRoot.mChildren.end())
+        if (node == -1 || mNodes[node].mKeyword == -1)
             return false;
-        else if (current->second.mKeyword.size() && Misc::StringUtils::ciEqual(current->second.mKeyword, keyword))
-        {
-            value = current->second.mValue;
-            return true;
-        }
 
-        for (Point i = ++keyword.begin(); i != keyword.end(); ++i)
-        {
-            next = current->second.mChildren.find(Misc::StringUtils::toLower (*i));
-            if (next == current->second.mChildren.end())
-                return false;
-            if (Misc::StringUtils::ciEqual(next->second.mKeyword, keyword))
-            {
-                value = next->second.mValue;
-                return true;
-            }
-            current = next;
-        }
-        return false;
+        value = mKeywords[mNodes[node].mKeyword].second;
+        return true;
     }
 
     static bool sortMatches(const Match& left, const Match& right)
@@ -75,103 +97,174 @@ public:
 
     void highlightKeywords (Point beg, Point end, std::vector<Match>& out)
     {
-        std::vector<Match> matches;
-        for (Point i = beg; i != end; ++i)
+        const string_t text (beg, end);
+
+        typename Cache::const_iterator cached = mCache.find (text);
+        if (cached == mCache.end ())
         {
-            // check if previous character marked start of new word
-            if (i != beg)
-            {
-                Point prev = i;
-                --prev;
-                if(isalpha(*prev))
-                    continue;
-            }
+            if (mCache.size () >= sMaxCachedTexts)
+                mCache.clear ();
+            cached = mCache.insert (std::make_pair (text, findKeywords (beg, end))).first;
+        }
+
+        for (typename std::vector<CachedMatch>::const_iterator it = cached->second.begin (); it != cached->second.end (); ++it)
+        {
+            Match match;
+            match.mBeg = beg + it->mBeg;
+            match.mEnd = beg + it->mEnd;
+            match.mValue = mKeywords[it->mKeyword].second;
+            out.push_back (match);
+        }
+    }
 
+private:
 
-            // check first character
-            typename Entry::childen_t::iterator candidate = mRoot.mChildren.find (Misc::StringUtils::toLower (*i));
+    struct Node
+    {
+        Node () : mDepth (0), mKeyword (-1), mFailure (0), mOutput (-1) {}
+
+        std::vector<std::pair<unsigned char, int> > mChildren; ///< sorted by character
+        int mDepth;
+        int mKeyword; ///< keyword ending here, or -1
+        int mFailure; ///< node of the longest proper suffix that is in the trie
+        int mOutput; ///< nearest node on the failure chain that ends a keyword, or -1
+    };
 
-            // no match, on to next character
-            if (candidate == mRoot.mChildren.end ())
-                continue;
+    struct CachedMatch
+    {
+        std::ptrdiff_t mBeg;
+        std::ptrdiff_t mEnd;
+        int mKeyword;
+    };
 
-            // see how far the match goes
-            Point j = i;
+    typedef std::unordered_map<string_t, std::vector<CachedMatch> > Cache;
 
-            // some keywords might be longer variations of other keywords, so we definitely need a list of candidates
-            // the first element in the pair is length of the match, i.e. depth from the first character on
-            std::vector< typename std::pair<int, typename Entry::childen_t::iterator> > candidates;
+    static const std::size_t sMaxCachedTexts = 4096;
 
-            while ((j + 1) != end)
-            {
-                typename Entry::childen_t::iterator next = candidate->second.mChildren.find (Misc::StringUtils::toLower (*++j));
+    std::vector<Node> mNodes;
+    std::vector<std::pair<string_t, value_t> > mKeywords;
+    bool mCompiled;
+    int mClasses[256];
+    int mNumClasses;
+    std::vector<int> mTransitions; ///< mNumClasses transitions per node
+    Cache mCache;
 
-                if (next == candidate->second.mChildren.end ())
-                {
-                    if (candidate->second.mKeyword.size() > 0)
-                        candidates.push_back(std::make_pair((j-i), candidate));
-                    break;
-                }
+    static bool compareChild (const std::pair<unsigned char, int>& child, unsigned char ch)
+    {
+        return child.first < ch;
+    }
 
-                candidate = next;
+    int findChild (int node, unsigned char ch) const
+    {
+        const std::vector<std::pair<unsigned char, int> >& children = mNodes[node].mChildren;
+        typename std::vector<std::pair<unsigned char, int> >::const_iterator found =
+            std::lower_bound (children.begin (), children.end (), ch, compareChild);
+        if (found == children.end () || found->first != ch)
+            return -1;
+        return found->second;
+    }
 
-                if (candidate->second.mKeyword.size() > 0)
-                    candidates.push_back(std::make_pair((j-i), candidate));
+    void insertChild (int node, unsigned char ch, int child)
+    {
+        std::vector<std::pair<unsigned char, int> >& children = mNodes[node].mChildren;
+        children.insert (std::lower_bound (children.begin (), children.end (), ch, compareChild), std::make_pair (ch, child));
+    }
+
+    /// Builds the transitions of every node for every character that is in a keyword, so a search follows
+    /// one transition per character. Characters that are in no keyword all share class 0, which leads back to the root.
+    void compile ()
+    {
+        std::fill (mClasses, mClasses + 256, 0);
+        mNumClasses = 1;
+        for (typename std::vector<Node>::const_iterator node = mNodes.begin (); node != mNodes.end (); ++node)
+        {
+            for (std::size_t i = 0; i < node->mChildren.size (); ++i)
+            {
+                const unsigned char ch = node->mChildren[i].first;
+                if (mClasses[ch] == 0)
+                    mClasses[ch] = mNumClasses++;
             }
+        }
+        for (int ch = 'A'; ch <= 'Z'; ++ch)
+            mClasses[ch] = mClasses[ch - 'A' + 'a'];
 
-            if (candidates.empty())
-                continue; // didn't match enough to disambiguate, on to next character
+        mTransitions.assign (mNodes.size () * mNumClasses, 0);
 
-            // shorter candidates will be added to the vector first. however, we want to check against longer candidates first
-            std::reverse(candidates.begin(), candidates.end());
+        // Breadth first, so the transitions of the failure node are known when a node is reached
+        std::deque<int> queue (1, 0);
+        mNodes[0].mFailure = 0;
+        mNodes[0].mOutput = -1;
+        while (!queue.empty ())
+        {
+            const int node = queue.front ();
+            queue.pop_front ();
 
-            for (typename std::vector< std::pair<int, typename Entry::childen_t::iterator> >::iterator it = candidates.begin();
-                 it != candidates.end(); ++it)
+            const int failure = mNodes[node].mFailure;
+            if (node != 0)
+                std::copy (mTransitions.begin () + failure * mNumClasses, mTransitions.begin () + (failure + 1) * mNumClasses,
+                    mTransitions.begin () + node * mNumClasses);
+
+            for (std::size_t i = 0; i < mNodes[node].mChildren.size (); ++i)
             {
-                candidate = it->second;
-                // try to match the rest of the keyword
-                Point k = i + it->first;
-                typename string_t::const_iterator t = candidate->second.mKeyword.begin () + (k - i);
+                const int cls = mClasses[mNodes[node].mChildren[i].first];
+                const int child = mNodes[node].mChildren[i].second;
+                const int childFailure = node == 0 ? 0 : mTransitions[failure * mNumClasses + cls];
+                mNodes[child].mFailure = childFailure;
+                mNodes[child].mOutput = mNodes[childFailure].mKeyword != -1 ? childFailure : mNodes[childFailure].mOutput;
+                mTransitions[node * mNumClasses + cls] = child;
+                queue.push_back (child);
+            }
+        }
 
+        mCompiled = true;
+    }
 
-                while (k != end && t != candidate->second.mKeyword.end ())
-                {
-                    if (Misc::StringUtils::toLower (*k) != Misc::StringUtils::toLower (*t))
-                        break;
+    std::vector<CachedMatch> findKeywords (Point beg, Point end)
+    {
+        if (!mCompiled)
+            compile ();
 
-                    ++k, ++t;
-                }
+        // Keywords have to start at the beginning of a word, of those starting at the same place the longest one wins
+        std::vector<CachedMatch> matches;
+        int node = 0;
+        for (Point i = beg; i != end; ++i)
+        {
+            node = mTransitions[node * mNumClasses + mClasses[static_cast<unsigned char> (*i)]];
 
-                // didn't match full keyword, try the next candidate
-                if (t != candidate->second.mKeyword.end ())
+            for (int found = mNodes[node].mKeyword != -1 ? node : mNodes[node].mOutput; found != -1; found = mNodes[found].mOutput)
+            {
+                const std::ptrdiff_t matchEnd = (i - beg) + 1;
+                const std::ptrdiff_t matchBeg = matchEnd - mNodes[found].mDepth;
+                if (matchBeg > 0 && isalpha (static_cast<unsigned char> (*(beg + (matchBeg - 1)))))
                     continue;
 
-                // found a keyword, but there might still be longer keywords that start somewhere _within_ this keyword
-                // we will resolve these overlapping keywords later, choosing the longest one in case of conflict
-                Match match;
-                match.mValue = candidate->second.mValue;
-                match.mBeg = i;
-                match.mEnd = k;
-                matches.push_back(match);
-                break;
+                CachedMatch match;
+                match.mBeg = matchBeg;
+                match.mEnd = matchEnd;
+                match.mKeyword = mNodes[found].mKeyword;
+                matches.push_back (match);
             }
         }
 
+        std::sort (matches.begin (), matches.end (), sortLongestFirst);
+        matches.erase (std::unique (matches.begin (), matches.end (), sameBeginning), matches.end ());
+
         // resolve overlapping keywords
+        std::vector<CachedMatch> out;
         while (!matches.empty())
         {
-            int longestKeywordSize = 0;
-            typename std::vector<Match>::iterator longestKeyword = matches.begin();
-            for (typename std::vector<Match>::iterator it = matches.begin(); it != matches.end(); ++it)
+            std::ptrdiff_t longestKeywordSize = 0;
+            typename std::vector<CachedMatch>::iterator longestKeyword = matches.begin();
+            for (typename std::vector<CachedMatch>::iterator it = matches.begin(); it != matches.end(); ++it)
             {
-                int size = it->mEnd - it->mBeg;
+                std::ptrdiff_t size = it->mEnd - it->mBeg;
                 if (size > longestKeywordSize)
                 {
                     longestKeywordSize = size;
                     longestKeyword = it;
                 }
 
-                typename std::vector<Match>::iterator next = it;
+                typename std::vector<CachedMatch>::iterator next = it;
                 ++next;
 
                 if (next == matches.end())
@@ -183,11 +276,11 @@ public:
                 }
             }
 
-            Match keyword = *longestKeyword;
+            CachedMatch keyword = *longestKeyword;
             matches.erase(longestKeyword);
             out.push_back(keyword);
             // erase anything that overlaps with the keyword we just added to the output
-            for (typename std::vector<Match>::iterator it = matches.begin(); it != matches.end();)
+            for (typename std::vector<CachedMatch>::iterator it = matches.begin(); it != matches.end();)
             {
                 if (it->mBeg < keyword.mEnd && it->mEnd > keyword.mBeg)
                     it = matches.erase(it);
@@ -196,59 +289,21 @@ public:
             }
         }
 
-        std::sort(out.begin(), out.end(), sortMatches);
+        std::sort (out.begin (), out.end (), sortLongestFirst);
+        return out;
     }
 
-private:
-
-    struct Entry
+    static bool sortLongestFirst (const CachedMatch& left, const CachedMatch& right)
     {
-        typedef std::map <wchar_t, Entry> childen_t;
-
-        string_t mKeyword;
-        value_t mValue;
-        childen_t mChildren;
-    };
+        if (left.mBeg != right.mBeg)
+            return left.mBeg < right.mBeg;
+        return left.mEnd > right.mEnd;
+    }
 
-    void seed_impl (string_t keyword, value_t value, size_t depth, Entry  & entry)
+    static bool sameBeginning (const CachedMatch& left, const CachedMatch& right)
     {
-        int ch = Misc::StringUtils::toLower (keyword.at (depth));
-
-        typename Entry::childen_t::iterator j = entry.mChildren.find (ch);
-
-        if (j == entry.mChildren.end ())
-        {
-            entry.mChildren [ch].mValue = /*std::move*/ (value);
-            entry.mChildren [ch].mKeyword = /*std::move*/ (keyword);
-        }
-        else
-        {
-            if (j->second.mKeyword.size () > 0)
-            {
-                if (keyword == j->second.mKeyword)
-                    throw std::runtime_error ("duplicate keyword inserted");
-
-                value_t pushValue = /*std::move*/ (j->second.mValue);
-                string_t pushKeyword = /*std::move*/ (j->second.mKeyword);
-
-                if (depth >= pushKeyword.size ())
-                    throw std::runtime_error ("unexpected");
-
-                if (depth+1 < pushKeyword.size())
-                {
-                    seed_impl (/*std::move*/ (pushKeyword), /*std::move*/ (pushValue), depth+1, j->second);
-                    j->second.mKeyword.clear ();
-                }
-            }
-            if (depth+1 == keyword.size())
-                j->second.mKeyword = value;
-            else // depth+1 < keyword.size()
-                seed_impl (/*std::move*/ (keyword), /*std::move*/ (value), depth+1, j->second);
-        }
-
+        return left.mBeg == right.mBeg;
     }
-
-    Entry mRoot;
 };
 
 }
@@ -141,7 +141,8 @@ namespace MWGui
             int skill = Misc::Rng::rollDice(ESM::Skill::Length);
             skills.insert(skill);
 
-            MWMechanics::SkillValue& value = player.getClass().getNpcStats(player).getSkill(skill);
+            MWMechanics::NpcStats& npcStats = player.getClass().getNpcStats(player);
+            MWMechanics::SkillValue value = npcStats.getSkill(skill);
 
             /*
                 Start of tes3mp change (minor)
@@ -157,6 +158,8 @@ namespace MWGui
                 value.setBase(std::min(100, value.getBase()+1));
             else
                 value.setBase(std::max(0, value.getBase()-1));
+
+            npcStats.setSkill(skill, value);
         }
 
         const MWWorld::Store<ESM::GameSetting>& gmst = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>();
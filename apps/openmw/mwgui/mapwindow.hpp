@@ -246,7 +246,8 @@ namespace MWGui
             End of tes3mp addition
         */
     public:
-        MapWindow(CustomMarkerCollection& customMarkers, DragAndDrop* drag, MWRender::LocalMap* localMapRender, SceneUtil::WorkQueue* workQueue);
+        MapWindow(CustomMarkerCollection& customMarkers, DragAndDrop* drag, MWRender::LocalMap* localMapRender, SceneUtil::WorkQueue* workQueue,
+                  const std::string& globalMapCachePath);
         virtual ~MapWindow();
 
         void setCellName(const std::string& cellName);
@@ -195,6 +195,7 @@ namespace MWGui
         , mEncoding(encoding)
         , mFontHeight(16)
         , mVersionDescription(versionDescription)
+        , mUserDataPath(userDataPath)
     {
         float uiScale = Settings::Manager::getFloat("scaling factor", "GUI");
         mGuiPlatform = new osgMyGUI::Platform(viewer, guiRoot, resourceSystem->getImageManager(), uiScale);
@@ -420,7 +421,10 @@ namespace MWGui
         mWindows.push_back(menu);
 
         mLocalMapRender = new MWRender::LocalMap(mViewer->getSceneData()->asGroup());
-        mMap = new MapWindow(mCustomMarkers, mDragAndDrop, mLocalMapRender, mWorkQueue);
+        std::string globalMapCachePath;
+        if (Settings::Manager::getBool("global map cache", "Map"))
+            globalMapCachePath = mUserDataPath + "/globalmapcache";
+        mMap = new MapWindow(mCustomMarkers, mDragAndDrop, mLocalMapRender, mWorkQueue, globalMapCachePath);
         mWindows.push_back(mMap);
         mMap->renderGlobalMap();
         trackWindow(mMap, "map");
@@ -615,6 +615,8 @@ namespace MWGui
 
         std::string mVersionDescription;
 
+        std::string mUserDataPath;
+
         MWGui::TextColours mTextColours;
 
         std::unique_ptr<KeyboardNavigation> mKeyboardNavigation;
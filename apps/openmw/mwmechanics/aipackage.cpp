@@ -8,6 +8,7 @@
 
 #include "../mwbase/world.hpp"
 #include "../mwbase/environment.hpp"
+#include "../mwbase/mechanicsmanager.hpp"
 
 #include "../mwworld/action.hpp"
 #include "../mwworld/class.hpp"
@@ -32,7 +33,10 @@ MWMechanics::AiPackage::AiPackage() :
     mRotateOnTheRunChecks(0),
     mIsShortcutting(false),
     mShortcutProhibited(false),
-    mShortcutFailPos()
+    mShortcutFailPos(),
+    mPathRequest(0),
+    mPathRequestDest(),
+    mPathRequestDestInLOS(false)
 {
 }
 
@@ -91,6 +95,7 @@ void MWMechanics::AiPackage::reset()
     mIsShortcutting = false;
     mShortcutProhibited = false;
     mShortcutFailPos = ESM::Pathgrid::Point();
+    mPathRequest = 0;
 
     mPathFinder.clearPath();
     mObstacleCheck.clear();
@@ -118,6 +123,9 @@ bool MWMechanics::AiPackage::pathTo(const MWWorld::Ptr& actor, const ESM::Pathgr
     float distToTarget = distance(start, dest);
     bool isDestReached = (distToTarget <= destTolerance);
 
+    if (mPathRequest != 0)
+        takeRequestedPath(actor, start);
+
     if (!isDestReached && mTimer > AI_REACTION_TIME)
     {
         if (actor.getClass().isBipedal(actor))
@@ -137,27 +145,30 @@ bool MWMechanics::AiPackage::pathTo(const MWWorld::Ptr& actor, const ESM::Pathgr
         if (actorCanMoveByZ || getTypeId() != TypeIdWander)
             mIsShortcutting = shortcutPath(start, dest, actor, &destInLOS, actorCanMoveByZ); // try to shortcut first
 
-        if (!mIsShortcutting)
+        if (mIsShortcutting)
+            mPathRequest = 0;
+        else
         {
-            if (wasShortcutting || doesPathNeedRecalc(dest, actor.getCell())) // if need to rebuild path
+            // if need to rebuild path, and it is not being built already
+            if (mPathRequest == 0 && (wasShortcutting || doesPathNeedRecalc(dest, actor.getCell())))
             {
-                mPathFinder.buildSyncedPath(start, dest, actor.getCell(), getPathGridGraph(actor.getCell()));
-                mRotateOnTheRunChecks = 3;
+                AsyncPathFinder& asyncPathFinder = MWBase::Environment::get().getMechanicsManager()->getAsyncPathFinder();
 
-                // give priority to go directly on target if there is minimal opportunity
-                if (destInLOS && mPathFinder.getPath().size() > 1)
+                // AiWander expects to have a path as soon as it asks for one
+                if (asyncPathFinder.isEnabled() && getTypeId() != TypeIdWander)
                 {
-                    // get point just before dest
-                    std::list<ESM::Pathgrid::Point>::const_iterator pPointBeforeDest = mPathFinder.getPath().end();
-                    --pPointBeforeDest;
-                    --pPointBeforeDest;
-
-                    // if start point is closer to the target then last point of path (excluding target itself) then go straight on the target
-                    if (distance(start, dest) <= distance(dest, *pPointBeforeDest))
-                    {
-                        mPathFinder.clearPath();
+                    mPathRequest = asyncPathFinder.request(actor, start, dest, getPathGridGraph(actor.getCell()));
+                    mPathRequestDest = dest;
+                    mPathRequestDestInLOS = destInLOS;
+
+                    // Keep following the old path until the new one is found, or head for the destination
+                    if (mPathFinder.getPath().empty())
                         mPathFinder.addPointToPath(dest);
-                    }
+                }
+                else
+                {
+                    mPathFinder.buildSyncedPath(start, dest, actor.getCell(), getPathGridGraph(actor.getCell()));
+                    onPathBuilt(start, dest, destInLOS);
                 }
             }
 
@@ -200,6 +211,46 @@ bool MWMechanics::AiPackage::pathTo(const MWWorld::Ptr& actor, const ESM::Pathgr
     return false;
 }
 
+void MWMechanics::AiPackage::takeRequestedPath(const MWWorld::Ptr& actor, const ESM::Pathgrid::Point& start)
+{
+    FoundPath path;
+    switch (MWBase::Environment::get().getMechanicsManager()->getAsyncPathFinder().takeResult(mPathRequest, path))
+    {
+        case AsyncPathFinder::Status_Pending:
+            return;
+        case AsyncPathFinder::Status_Found:
+            mPathFinder.setSyncedPath(path, start, actor.getCell());
+            break;
+        case AsyncPathFinder::Status_Lost:
+            mPathFinder.buildSyncedPath(start, mPathRequestDest, actor.getCell(), getPathGridGraph(actor.getCell()));
+            break;
+    }
+
+    mPathRequest = 0;
+    onPathBuilt(start, mPathRequestDest, mPathRequestDestInLOS);
+}
+
+void MWMechanics::AiPackage::onPathBuilt(const ESM::Pathgrid::Point& start, const ESM::Pathgrid::Point& dest, bool destInLOS)
+{
+    mRotateOnTheRunChecks = 3;
+
+    // give priority to go directly on target if there is minimal opportunity
+    if (destInLOS && mPathFinder.getPath().size() > 1)
+    {
+        // get point just before dest
+        std::list<ESM::Pathgrid::Point>::const_iterator pPointBeforeDest = mPathFinder.getPath().end();
+        --pPointBeforeDest;
+        --pPointBeforeDest;
+
+        // if start point is closer to the target then last point of path (excluding target itself) then go straight on the target
+        if (distance(start, dest) <= distance(dest, *pPointBeforeDest))
+        {
+            mPathFinder.clearPath();
+            mPathFinder.addPointToPath(dest);
+        }
+    }
+}
+
 void MWMechanics::AiPackage::evadeObstacles(const MWWorld::Ptr& actor, float duration, const ESM::Position& pos)
 {
     zTurn(actor, mPathFinder.getZAngleToNext(pos.pos[0], pos.pos[1]));
@@ -4,6 +4,7 @@
 #include <components/esm/defs.hpp>
 
 #include "pathfinding.hpp"
+#include "asyncpathfinder.hpp"
 #include "obstacle.hpp"
 #include "aistate.hpp"
 
@@ -124,6 +125,12 @@ namespace MWMechanics
             virtual bool doesPathNeedRecalc(const ESM::Pathgrid::Point& newDest, const MWWorld::CellStore* currentCell);
 
             void evadeObstacles(const MWWorld::Ptr& actor, float duration, const ESM::Position& pos);
+
+            /// Applies the path that was requested from the AsyncPathFinder once it is found
+            void takeRequestedPath(const MWWorld::Ptr& actor, const ESM::Pathgrid::Point& start);
+
+            /// Adjusts a newly built path to the destination
+            void onPathBuilt(const ESM::Pathgrid::Point& start, const ESM::Pathgrid::Point& dest, bool destInLOS);
             void openDoors(const MWWorld::Ptr& actor);
 
             const PathgridGraph& getPathGridGraph(const MWWorld::CellStore* cell);
@@ -145,6 +152,10 @@ namespace MWMechanics
             bool mShortcutProhibited; // shortcutting may be prohibited after unsuccessful attempt
             ESM::Pathgrid::Point mShortcutFailPos; // position of last shortcut fail
 
+            AsyncPathFinder::RequestId mPathRequest; // path that is being searched in the background, 0 if none
+            ESM::Pathgrid::Point mPathRequestDest;
+            bool mPathRequestDestInLOS;
+
         private:
             bool isNearInactiveCell(const ESM::Position& actorPos);
     };
@@ -0,0 +1,198 @@
+#include "asyncpathfinder.hpp"
+
+#include <iterator>
+
+#include <components/detournavigator/findsmoothpath.hpp>
+#include <components/detournavigator/navigator.hpp>
+#include <components/sceneutil/workqueue.hpp>
+
+#include "../mwbase/world.hpp"
+#include "../mwbase/environment.hpp"
+
+#include "../mwworld/cellstore.hpp"
+#include "../mwworld/class.hpp"
+
+#include "pathgrid.hpp"
+
+namespace MWMechanics
+{
+    class PathSearchBatch : public SceneUtil::WorkItem
+    {
+        public:
+            struct Request
+            {
+                AsyncPathFinder::RequestId mId;
+                ESM::Pathgrid::Point mStartPoint;
+                ESM::Pathgrid::Point mEndPoint;
+                const ESM::Cell* mCell;
+                const PathgridGraph* mPathgridGraph;
+                DetourNavigator::SharedNavMeshCacheItem mNavMesh;
+                osg::Vec3f mHalfExtents;
+                DetourNavigator::Flags mFlags;
+            };
+
+            std::vector<Request> mRequests;
+            std::vector<FoundPath> mPaths;
+
+            /// Only set when a request has a navmesh, the navigator may be gone before the batch is done
+            DetourNavigator::Settings mNavigatorSettings;
+
+            void doWork() override
+            {
+                mPaths.resize(mRequests.size());
+                for (std::size_t i = 0; i < mRequests.size(); ++i)
+                    mPaths[i] = findPath(mRequests[i]);
+            }
+
+        private:
+            FoundPath findPath(const Request& request) const
+            {
+                if (request.mNavMesh)
+                {
+                    std::vector<osg::Vec3f> points;
+                    try
+                    {
+                        using DetourNavigator::toNavMeshCoordinates;
+                        const DetourNavigator::Settings& settings = mNavigatorSettings;
+                        // Take steps as long as the actor is wide
+                        const float stepSize = 2 * request.mHalfExtents.y();
+                        DetourNavigator::findSmoothPath(request.mNavMesh->lockConst()->getImpl(),
+                            toNavMeshCoordinates(settings, request.mHalfExtents), toNavMeshCoordinates(settings, stepSize),
+                            toNavMeshCoordinates(settings, PathFinder::MakeOsgVec3(request.mStartPoint)),
+                            toNavMeshCoordinates(settings, PathFinder::MakeOsgVec3(request.mEndPoint)),
+                            request.mFlags, settings, std::back_inserter(points));
+                    }
+                    catch (const DetourNavigator::NavigatorException&)
+                    {
+                        // The start or the end is not on the navmesh, the pathgrid may still know a way
+                        points.clear();
+                    }
+
+                    if (!points.empty())
+                    {
+                        FoundPath path;
+                        path.mMaySkipFirstPoint = false;
+                        path.mPoints.reserve(points.size());
+                        for (const osg::Vec3f& point : points)
+                            path.mPoints.push_back(PathFinder::MakePathgridPoint(point));
+                        return path;
+                    }
+                }
+
+                return findPathgridPath(request.mStartPoint, request.mEndPoint, request.mCell, *request.mPathgridGraph);
+            }
+    };
+
+    AsyncPathFinder::AsyncPathFinder(int numThreads)
+        : mLastRequestId(0)
+        , mFrameNumber(0)
+    {
+        if (numThreads > 0)
+            mWorkQueue = new SceneUtil::WorkQueue(numThreads);
+    }
+
+    AsyncPathFinder::~AsyncPathFinder()
+    {
+        // Joins the threads, so no batch is left referencing the records after they're gone
+        mWorkQueue = nullptr;
+    }
+
+    bool AsyncPathFinder::isEnabled() const
+    {
+        return mWorkQueue.valid();
+    }
+
+    AsyncPathFinder::RequestId AsyncPathFinder::request(const MWWorld::ConstPtr& actor,
+        const ESM::Pathgrid::Point& startPoint, const ESM::Pathgrid::Point& endPoint, const PathgridGraph& pathgridGraph)
+    {
+        const MWBase::World* world = MWBase::Environment::get().getWorld();
+
+        if (!mNextBatch)
+            mNextBatch = new PathSearchBatch;
+
+        PathSearchBatch::Request request;
+        request.mId = ++mLastRequestId;
+        request.mStartPoint = startPoint;
+        request.mEndPoint = endPoint;
+        request.mCell = actor.getCell()->getCell();
+        request.mPathgridGraph = &pathgridGraph;
+        request.mHalfExtents = world->getPathfindingHalfExtents(actor);
+        request.mNavMesh = world->getNavigator()->getNavMesh(request.mHalfExtents);
+        request.mFlags = DetourNavigator::Flag_walk;
+        if (actor.getClass().canSwim(actor))
+            request.mFlags |= DetourNavigator::Flag_swim;
+        if (actor.getClass().isBipedal(actor))
+            request.mFlags |= DetourNavigator::Flag_openDoor;
+
+        mNextBatch->mRequests.push_back(request);
+        mPending.insert(request.mId);
+
+        return request.mId;
+    }
+
+    AsyncPathFinder::Status AsyncPathFinder::takeResult(RequestId id, FoundPath& path)
+    {
+        std::map<RequestId, Result>::iterator found = mResults.find(id);
+        if (found != mResults.end())
+        {
+            path = std::move(found->second.mPath);
+            mResults.erase(found);
+            return Status_Found;
+        }
+
+        return mPending.count(id) ? Status_Pending : Status_Lost;
+    }
+
+    void AsyncPathFinder::collectResults()
+    {
+        ++mFrameNumber;
+
+        // A result that is not taken within a couple of frames belongs to a package that is gone
+        for (std::map<RequestId, Result>::iterator it = mResults.begin(); it != mResults.end();)
+        {
+            if (mFrameNumber - it->second.mCollectedAt > 2)
+                it = mResults.erase(it);
+            else
+                ++it;
+        }
+
+        for (std::vector<osg::ref_ptr<PathSearchBatch> >::iterator it = mRunningBatches.begin(); it != mRunningBatches.end();)
+        {
+            PathSearchBatch& batch = **it;
+            if (!batch.isDone())
+            {
+                ++it;
+                continue;
+            }
+
+            for (std::size_t i = 0; i < batch.mRequests.size(); ++i)
+            {
+                Result& result = mResults[batch.mRequests[i].mId];
+                result.mPath = std::move(batch.mPaths[i]);
+                result.mCollectedAt = mFrameNumber;
+                mPending.erase(batch.mRequests[i].mId);
+            }
+
+            it = mRunningBatches.erase(it);
+        }
+    }
+
+    void AsyncPathFinder::submitRequests()
+    {
+        if (!mNextBatch)
+            return;
+
+        for (const PathSearchBatch::Request& request : mNextBatch->mRequests)
+        {
+            if (request.mNavMesh)
+            {
+                mNextBatch->mNavigatorSettings = MWBase::Environment::get().getWorld()->getNavigator()->getSettings();
+                break;
+            }
+        }
+
+        mWorkQueue->addWorkItem(mNextBatch);
+        mRunningBatches.push_back(mNextBatch);
+        mNextBatch = nullptr;
+    }
+}
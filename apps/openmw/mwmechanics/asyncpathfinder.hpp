@@ -0,0 +1,82 @@
+#ifndef GAME_MWMECHANICS_ASYNCPATHFINDER_H
+#define GAME_MWMECHANICS_ASYNCPATHFINDER_H
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <vector>
+
+#include <osg/ref_ptr>
+
+#include "pathfinding.hpp"
+
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
+namespace MWWorld
+{
+    class ConstPtr;
+}
+
+namespace MWMechanics
+{
+    class PathgridGraph;
+    class PathSearchBatch;
+
+    /// \brief Finds paths for AI packages on background threads
+    ///
+    /// Paths are searched on the actor's navmesh when there is one, and on the pathgrid otherwise.
+    /// The requests made during a frame are searched together as one batch, and their results
+    /// can be taken in a later frame.
+    class AsyncPathFinder
+    {
+        public:
+            typedef std::size_t RequestId;
+
+            enum Status
+            {
+                Status_Pending,
+                Status_Found,
+                Status_Lost ///< The request is unknown, or its result was not taken in time
+            };
+
+            /// @param numThreads Number of background threads, or 0 to disable
+            explicit AsyncPathFinder(int numThreads);
+            ~AsyncPathFinder();
+
+            bool isEnabled() const;
+
+            /// @note The path grid graph must stay valid until the request is done.
+            /// @return The id to take the result with, never 0
+            RequestId request(const MWWorld::ConstPtr& actor, const ESM::Pathgrid::Point& startPoint,
+                              const ESM::Pathgrid::Point& endPoint, const PathgridGraph& pathgridGraph);
+
+            /// @param path Receives the path if it was found
+            Status takeResult(RequestId id, FoundPath& path);
+
+            /// Collects the results of the finished batches. Call at the beginning of a frame.
+            void collectResults();
+
+            /// Starts a batch with the requests made since the last call. Call at the end of a frame.
+            void submitRequests();
+
+        private:
+            struct Result
+            {
+                FoundPath mPath;
+                unsigned int mCollectedAt;
+            };
+
+            osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+            osg::ref_ptr<PathSearchBatch> mNextBatch;
+            std::vector<osg::ref_ptr<PathSearchBatch> > mRunningBatches;
+            std::set<RequestId> mPending;
+            std::map<RequestId, Result> mResults;
+            RequestId mLastRequestId;
+            unsigned int mFrameNumber;
+    };
+}
+
+#endif
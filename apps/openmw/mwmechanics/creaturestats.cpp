@@ -34,7 +34,8 @@ namespace MWMechanics
           mKnockdown(false), mKnockdownOneFrame(false), mKnockdownOverOneFrame(false),
           mHitRecovery(false), mBlock(false), mMovementFlags(0),
           mFallHeight(0), mRecalcMagicka(false), mLastRestock(0,0), mGoldPool(0), mActorId(-1), mHitAttemptActorId(-1),
-          mDeathAnimation(-1), mTimeOfDeath(), mLevel (0)
+          mDeathAnimation(-1), mTimeOfDeath(), mAttributesGeneration(0), mDynamicGeneration(0), mLevel (0),
+          mLevelGeneration(0)
     {
         for (int i=0; i<4; ++i)
             mAiSettings[i] = 0;
@@ -155,6 +156,7 @@ namespace MWMechanics
         if (value != currentValue)
         {
             mAttributes[index] = value;
+            ++mAttributesGeneration;
 
             if (index == ESM::Attribute::Intelligence)
                 mRecalcMagicka = true;
@@ -197,6 +199,9 @@ namespace MWMechanics
         if (index < 0 || index > 2)
             throw std::runtime_error("dynamic stat index is out of range");
 
+        if (value != mDynamic[index])
+            ++mDynamicGeneration;
+
         mDynamic[index] = value;
 
         if (index==0 && mDynamic[index].getCurrent()<1)
@@ -208,6 +213,7 @@ namespace MWMechanics
 
             mDynamic[index].setModifier(0);
             mDynamic[index].setCurrent(0);
+            ++mDynamicGeneration;
 
             if (MWBase::Environment::get().getWorld()->getGodModeState())
                 MWBase::Environment::get().getMechanicsManager()->keepPlayerAlive();
@@ -216,9 +222,27 @@ namespace MWMechanics
 
     void CreatureStats::setLevel(int level)
     {
+        if (level != mLevel)
+            ++mLevelGeneration;
+
         mLevel = level;
     }
 
+    unsigned int CreatureStats::getAttributesGeneration() const
+    {
+        return mAttributesGeneration;
+    }
+
+    unsigned int CreatureStats::getDynamicGeneration() const
+    {
+        return mDynamicGeneration;
+    }
+
+    unsigned int CreatureStats::getLevelGeneration() const
+    {
+        return mLevelGeneration;
+    }
+
     void CreatureStats::modifyMagicEffects(const MagicEffects &effects)
     {
         if (effects.get(ESM::MagicEffect::FortifyMaximumMagicka).getModifier()
@@ -298,6 +322,7 @@ namespace MWMechanics
                 mDynamic[0].setModified(1, 0);
 
             mDynamic[0].setCurrent(mDynamic[0].getModified());
+            ++mDynamicGeneration;
             mDead = false;
             mDeathAnimationFinished = false;
         }
@@ -587,6 +612,10 @@ namespace MWMechanics
         for (int i=0; i<3; ++i)
             mDynamic[i].readState (state.mDynamic[i]);
 
+        ++mAttributesGeneration;
+        ++mDynamicGeneration;
+        ++mLevelGeneration;
+
         mLastRestock = MWWorld::TimeStamp(state.mTradeTime);
         mGoldPool = state.mGoldPool;
 
@@ -71,6 +71,10 @@ namespace MWMechanics
 
         MWWorld::TimeStamp mTimeOfDeath;
 
+        // Counted up whenever the matching stats change
+        unsigned int mAttributesGeneration;
+        unsigned int mDynamicGeneration;
+
     public:
         typedef std::pair<int, std::string> SummonKey; // <ESM::MagicEffect index, spell ID>
     private:
@@ -82,6 +86,7 @@ namespace MWMechanics
 
     protected:
         int mLevel;
+        unsigned int mLevelGeneration;
 
     public:
         CreatureStats();
@@ -143,6 +148,15 @@ namespace MWMechanics
 
         void setLevel(int level);
 
+        unsigned int getAttributesGeneration() const;
+        ///< Changes whenever an attribute changes, so observers can tell if they are up to date without comparing them.
+
+        unsigned int getDynamicGeneration() const;
+        ///< Changes whenever health, magicka or fatigue change.
+
+        unsigned int getLevelGeneration() const;
+        ///< Changes whenever the level changes.
+
         enum AiSetting
         {
             AI_Hello = 0,
@@ -3,6 +3,7 @@
 #include <limits.h>
 
 #include <components/misc/rng.hpp>
+#include <components/settings/settings.hpp>
 
 #include <components/esm/esmwriter.hpp>
 #include <components/esm/stolenitems.hpp>
@@ -98,7 +99,11 @@ namespace MWMechanics
         creatureStats.modifyMagicEffects(MagicEffects());
 
         for (int i=0; i<27; ++i)
-            npcStats.getSkill (i).setBase (player->mNpdt.mSkills[i]);
+        {
+            SkillValue skill = npcStats.getSkill (i);
+            skill.setBase (player->mNpdt.mSkills[i]);
+            npcStats.setSkill (i, skill);
+        }
 
         creatureStats.setAttribute(ESM::Attribute::Strength, player->mNpdt.mStrength);
         creatureStats.setAttribute(ESM::Attribute::Intelligence, player->mNpdt.mIntelligence);
@@ -137,7 +142,9 @@ namespace MWMechanics
                         break;
                     }
 
-                npcStats.getSkill (i).setBase (5 + bonus);
+                SkillValue skill = npcStats.getSkill (i);
+                skill.setBase (5 + bonus);
+                npcStats.setSkill (i, skill);
             }
 
             for (std::vector<std::string>::const_iterator iter (race->mPowers.mList.begin());
@@ -189,8 +196,9 @@ namespace MWMechanics
 
                     if (index>=0 && index<27)
                     {
-                        npcStats.getSkill (index).setBase (
-                            npcStats.getSkill (index).getBase() + bonus);
+                        SkillValue skill = npcStats.getSkill (index);
+                        skill.setBase (skill.getBase() + bonus);
+                        npcStats.setSkill (index, skill);
                     }
                 }
             }
@@ -207,8 +215,9 @@ namespace MWMechanics
 
                     if (index>=0 && index<27)
                     {
-                        npcStats.getSkill (index).setBase (
-                            npcStats.getSkill (index).getBase() + 5);
+                        SkillValue skill = npcStats.getSkill (index);
+                        skill.setBase (skill.getBase() + 5);
+                        npcStats.setSkill (index, skill);
                     }
                 }
             }
@@ -253,7 +262,8 @@ namespace MWMechanics
     // if stats.getTimeToStartDrowning() == 0 already on game start
     MechanicsManager::MechanicsManager()
     : mWatchedTimeToStartDrowning(-1), mWatchedStatsEmpty (true), mUpdatePlayer (true), mClassSelected (false),
-      mRaceSelected (false), mAI(true)
+      mRaceSelected (false), mAI(true),
+      mAsyncPathFinder(Settings::Manager::getInt("async pathfinding threads", "Game"))
     {
         //buildPlayer no longer here, needs to be done explicitly after all subsystems are up and running
     }
@@ -439,8 +449,12 @@ namespace MWMechanics
             mActors.addActor(ptr, true);
         }
 
+        mAsyncPathFinder.collectResults();
+
         mActors.update(duration, paused);
         mObjects.update(duration, paused);
+
+        mAsyncPathFinder.submitRequests();
     }
 
     bool MechanicsManager::isActorDetected(const MWWorld::Ptr& actor, const MWWorld::Ptr& observer)
@@ -463,6 +477,11 @@ namespace MWMechanics
         return mActors.isSneaking(ptr);
     }
 
+    AsyncPathFinder& MechanicsManager::getAsyncPathFinder()
+    {
+        return mAsyncPathFinder;
+    }
+
     void MechanicsManager::rest(bool sleep)
     {
         mActors.rest(sleep);
@@ -1972,7 +1991,9 @@ namespace MWMechanics
         const MWWorld::Store<ESM::GameSetting>& gmst = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>();
         MWMechanics::NpcStats &stats = actor.getClass().getNpcStats(actor);
 
-        stats.getSkill(ESM::Skill::Acrobatics).setBase(gmst.find("fWerewolfAcrobatics")->getInt());
+        SkillValue acrobatics = stats.getSkill(ESM::Skill::Acrobatics);
+        acrobatics.setBase(gmst.find("fWerewolfAcrobatics")->getInt());
+        stats.setSkill(ESM::Skill::Acrobatics, acrobatics);
     }
 
     void MechanicsManager::cleanupSummonedCreature(const MWWorld::Ptr &caster, int creatureActorId)
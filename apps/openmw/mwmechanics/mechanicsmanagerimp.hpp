@@ -9,6 +9,7 @@
 #include "npcstats.hpp"
 #include "objects.hpp"
 #include "actors.hpp"
+#include "asyncpathfinder.hpp"
 
 namespace MWWorld
 {
@@ -38,6 +39,7 @@ namespace MWMechanics
 
             Objects mObjects;
             Actors mActors;
+            AsyncPathFinder mAsyncPathFinder;
 
             typedef std::pair<std::string, bool> Owner; // < Owner id, bool isFaction >
             typedef std::map<Owner, int> OwnerMap; // < Owner, number of stolen items with this id from this owner >
@@ -247,6 +249,8 @@ namespace MWMechanics
             virtual bool isRunning(const MWWorld::Ptr& ptr);
             virtual bool isSneaking(const MWWorld::Ptr& ptr);
 
+            virtual AsyncPathFinder& getAsyncPathFinder();
+
         private:
             bool canReportCrime(const MWWorld::Ptr &actor, const MWWorld::Ptr &victim, std::set<MWWorld::Ptr> &playerFollowers);
 
@@ -25,6 +25,8 @@ MWMechanics::NpcStats::NpcStats()
 , mLevelProgress(0)
 , mTimeToStartDrowning(-1.0) // set breath to special value, it will be replaced during actor update
     , mIsWerewolf(false)
+    , mSkillsGeneration(0)
+    , mProgressGeneration(0)
 {
     mSkillIncreases.resize (ESM::Attribute::Length, 0);
     mSpecIncreases.resize(3, 0);
@@ -48,20 +50,26 @@ const MWMechanics::SkillValue& MWMechanics::NpcStats::getSkill (int index) const
     return mSkill[index];
 }
 
-MWMechanics::SkillValue& MWMechanics::NpcStats::getSkill (int index)
+void MWMechanics::NpcStats::setSkill(int index, const MWMechanics::SkillValue &value)
 {
     if (index<0 || index>=ESM::Skill::Length)
         throw std::runtime_error ("skill index out of range");
 
-    return mSkill[index];
+    if (value != mSkill[index])
+    {
+        mSkill[index] = value;
+        ++mSkillsGeneration;
+    }
 }
 
-void MWMechanics::NpcStats::setSkill(int index, const MWMechanics::SkillValue &value)
+unsigned int MWMechanics::NpcStats::getSkillsGeneration() const
 {
-    if (index<0 || index>=ESM::Skill::Length)
-        throw std::runtime_error ("skill index out of range");
+    return mSkillsGeneration;
+}
 
-    mSkill[index] = value;
+unsigned int MWMechanics::NpcStats::getProgressGeneration() const
+{
+    return mProgressGeneration;
 }
 
 const std::map<std::string, int>& MWMechanics::NpcStats::getFactionRanks() const
@@ -203,9 +211,10 @@ void MWMechanics::NpcStats::useSkill (int skillIndex, const ESM::Class& class_,
     }
     skillGain *= extraFactor;
 
-    MWMechanics::SkillValue& value = getSkill (skillIndex);
+    MWMechanics::SkillValue value = getSkill (skillIndex);
 
     value.setProgress(value.getProgress() + skillGain);
+    setSkill (skillIndex, value);
 
     if (int(value.getProgress())>=int(getSkillProgressRequirement(skillIndex, class_)))
     {
@@ -250,6 +259,7 @@ void MWMechanics::NpcStats::increaseSkill(int skillIndex, const ESM::Class &clas
     mSkillIncreases[skill->mData.mAttribute] += increase;
 
     mSpecIncreases[skill->mData.mSpecialization] += gmst.find("iLevelupSpecialization")->getInt();
+    ++mProgressGeneration;
 
     // Play sound & skill progress notification
     /// \todo check if character is the player, if levelling is ever implemented for NPCs
@@ -272,9 +282,11 @@ void MWMechanics::NpcStats::increaseSkill(int skillIndex, const ESM::Class &clas
         MWBase::Environment::get().getWindowManager ()->messageBox ("#{sLevelUpMsg}", MWGui::ShowInDialogueMode_Never);
     }
 
-    getSkill(skillIndex).setBase (base);
+    MWMechanics::SkillValue value = getSkill (skillIndex);
+    value.setBase (base);
     if (!preserveProgress)
-        getSkill(skillIndex).setProgress(0);
+        value.setProgress(0);
+    setSkill (skillIndex, value);
 }
 
 int MWMechanics::NpcStats::getLevelProgress () const
@@ -290,6 +302,9 @@ int MWMechanics::NpcStats::getLevelProgress () const
 */
 void MWMechanics::NpcStats::setLevelProgress(int value)
 {
+    if (value != mLevelProgress)
+        ++mProgressGeneration;
+
     mLevelProgress = value;
 }
 /*
@@ -318,6 +333,9 @@ int MWMechanics::NpcStats::getSkillIncrease(int attribute) const
 */
 void MWMechanics::NpcStats::setSkillIncrease(int attribute, int value)
 {
+    if (value != mSkillIncreases[attribute])
+        ++mProgressGeneration;
+
     mSkillIncreases[attribute] = value;
 }
 /*
@@ -354,6 +372,8 @@ void MWMechanics::NpcStats::levelUp()
     for (int i=0; i<ESM::Attribute::Length; ++i)
         mSkillIncreases[i] = 0;
 
+    ++mProgressGeneration;
+
     const int endurance = getAttribute(ESM::Attribute::Endurance).getBase();
 
     // "When you gain a level, in addition to increasing three primary attributes, your Health
@@ -578,6 +598,9 @@ void MWMechanics::NpcStats::readState (const ESM::NpcStats& state)
     for (int i=0; i<ESM::Skill::Length; ++i)
         mSkill[i].readState (state.mSkills[i]);
 
+    ++mSkillsGeneration;
+    ++mProgressGeneration;
+
     mIsWerewolf = state.mIsWerewolf;
 
     mCrimeId = state.mCrimeId;
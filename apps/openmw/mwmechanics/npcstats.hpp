@@ -64,6 +64,10 @@ namespace MWMechanics
 
             bool mIsWerewolf;
 
+            // Counted up whenever the matching stats change
+            unsigned int mSkillsGeneration;
+            unsigned int mProgressGeneration;
+
         public:
 
             NpcStats();
@@ -78,9 +82,14 @@ namespace MWMechanics
             void setCrimeId(int id);
 
             const SkillValue& getSkill (int index) const;
-            SkillValue& getSkill (int index);
             void setSkill(int index, const SkillValue& value);
 
+            unsigned int getSkillsGeneration() const;
+            ///< Changes whenever a skill, including its progress, changes.
+
+            unsigned int getProgressGeneration() const;
+            ///< Changes whenever the level progress or the skill increases for the next level change.
+
             const std::map<std::string, int>& getFactionRanks() const;
             /// Increase the rank in this faction by 1, if such a rank exists.
             void raiseRank(const std::string& faction);
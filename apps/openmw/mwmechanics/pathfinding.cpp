@@ -120,8 +120,7 @@ namespace MWMechanics
     }
 
     PathFinder::PathFinder()
-        : mPathgrid(NULL)
-        , mCell(NULL)
+        : mCell(NULL)
     {
     }
 
@@ -131,66 +130,25 @@ namespace MWMechanics
             mPath.clear();
     }
 
-    /*
-     * NOTE: This method may fail to find a path.  The caller must check the
-     * result before using it.  If there is no path the AI routies need to
-     * implement some other heuristics to reach the target.
-     *
-     * NOTE: It may be desirable to simply go directly to the endPoint if for
-     *       example there are no pathgrids in this cell.
-     *
-     * NOTE: startPoint & endPoint are in world coordinates
-     *
-     * Updates mPath using aStarSearch() or ray test (if shortcut allowed).
-     * mPath consists of pathgrid points, except the last element which is
-     * endPoint.  This may be useful where the endPoint is not on a pathgrid
-     * point (e.g. combat).  However, if the caller has already chosen a
-     * pathgrid point (e.g. wander) then it may be worth while to call
-     * pop_back() to remove the redundant entry.
-     *
-     * NOTE: coordinates must be converted prior to calling GetClosestPoint()
-     *
-     *    |
-     *    |       cell
-     *    |     +-----------+
-     *    |     |           |
-     *    |     |           |
-     *    |     |      @    |
-     *    |  i  |   j       |
-     *    |<--->|<---->|    |
-     *    |     +-----------+
-     *    |   k
-     *    |<---------->|         world
-     *    +-----------------------------
-     *
-     *    i = x value of cell itself (multiply by ESM::Land::REAL_SIZE to convert)
-     *    j = @.x in local coordinates (i.e. within the cell)
-     *    k = @.x in world coordinates
-     */
-    void PathFinder::buildPath(const ESM::Pathgrid::Point &startPoint,
-                               const ESM::Pathgrid::Point &endPoint,
-                               const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph)
+    FoundPath findPathgridPath(const ESM::Pathgrid::Point &startPoint, const ESM::Pathgrid::Point &endPoint,
+                               const ESM::Cell* cell, const PathgridGraph& pathgridGraph)
     {
-        mPath.clear();
+        FoundPath result;
+        result.mMaySkipFirstPoint = false;
 
-        // TODO: consider removing mCell / mPathgrid in favor of mPathgridGraph
-        if(mCell != cell || !mPathgrid)
-        {
-            mCell = cell;
-            mPathgrid = pathgridGraph.getPathgrid();
-        }
+        const ESM::Pathgrid* pathgrid = pathgridGraph.getPathgrid();
 
         // Refer to AiWander reseach topic on openmw forums for some background.
         // Maybe there is no pathgrid for this cell.  Just go to destination and let
         // physics take care of any blockages.
-        if(!mPathgrid || mPathgrid->mPoints.empty())
+        if(!pathgrid || pathgrid->mPoints.empty())
         {
-            mPath.push_back(endPoint);
-            return;
+            result.mPoints.push_back(endPoint);
+            return result;
         }
 
         // NOTE: GetClosestPoint expects local coordinates
-        CoordinateConverter converter(mCell->getCell());
+        CoordinateConverter converter(cell);
 
         // NOTE: It is possible that GetClosestPoint returns a pathgrind point index
         //       that is unreachable in some situations. e.g. actor is standing
@@ -198,22 +156,22 @@ namespace MWMechanics
         //       point right behind the wall that is closer than any pathgrid
         //       point outside the wall
         osg::Vec3f startPointInLocalCoords(converter.toLocalVec3(startPoint));
-        int startNode = GetClosestPoint(mPathgrid, startPointInLocalCoords);
+        int startNode = PathFinder::GetClosestPoint(pathgrid, startPointInLocalCoords);
 
         osg::Vec3f endPointInLocalCoords(converter.toLocalVec3(endPoint));
-        std::pair<int, bool> endNode = getClosestReachablePoint(mPathgrid, &pathgridGraph,
+        std::pair<int, bool> endNode = getClosestReachablePoint(pathgrid, &pathgridGraph,
             endPointInLocalCoords,
                 startNode);
 
         // if it's shorter for actor to travel from start to end, than to travel from either
         // start or end to nearest pathgrid point, just travel from start to end.
         float startToEndLength2 = (endPointInLocalCoords - startPointInLocalCoords).length2();
-        float endTolastNodeLength2 = DistanceSquared(mPathgrid->mPoints[endNode.first], endPointInLocalCoords);
-        float startTo1stNodeLength2 = DistanceSquared(mPathgrid->mPoints[startNode], startPointInLocalCoords);
+        float endTolastNodeLength2 = PathFinder::DistanceSquared(pathgrid->mPoints[endNode.first], endPointInLocalCoords);
+        float startTo1stNodeLength2 = PathFinder::DistanceSquared(pathgrid->mPoints[startNode], startPointInLocalCoords);
         if ((startToEndLength2 < startTo1stNodeLength2) || (startToEndLength2 < endTolastNodeLength2))
         {
-            mPath.push_back(endPoint);
-            return;
+            result.mPoints.push_back(endPoint);
+            return result;
         }
 
         // AiWander has logic that depends on whether a path was created,
@@ -223,40 +181,30 @@ namespace MWMechanics
         //       nodes are the same
         if(startNode == endNode.first)
         {
-            ESM::Pathgrid::Point temp(mPathgrid->mPoints[startNode]);
+            ESM::Pathgrid::Point temp(pathgrid->mPoints[startNode]);
             converter.toWorld(temp);
-            mPath.push_back(temp);
+            result.mPoints.push_back(temp);
         }
         else
         {
-            mPath = pathgridGraph.aStarSearch(startNode, endNode.first);
+            const std::list<ESM::Pathgrid::Point> path = pathgridGraph.aStarSearch(startNode, endNode.first);
+            result.mPoints.assign(path.begin(), path.end());
 
-            // If nearest path node is in opposite direction from second, remove it from path.
+            // If nearest path node is in opposite direction from second, it may be removed from path.
             // Especially useful for wandering actors, if the nearest node is blocked for some reason.
-            if (mPath.size() > 1)
+            if (result.mPoints.size() > 1)
             {
-                ESM::Pathgrid::Point secondNode = *(++mPath.begin());
-                osg::Vec3f firstNodeVec3f = MakeOsgVec3(mPathgrid->mPoints[startNode]);
-                osg::Vec3f secondNodeVec3f = MakeOsgVec3(secondNode);
+                osg::Vec3f firstNodeVec3f = PathFinder::MakeOsgVec3(pathgrid->mPoints[startNode]);
+                osg::Vec3f secondNodeVec3f = PathFinder::MakeOsgVec3(result.mPoints[1]);
                 osg::Vec3f toSecondNodeVec3f = secondNodeVec3f - firstNodeVec3f;
                 osg::Vec3f toStartPointVec3f = startPointInLocalCoords - firstNodeVec3f;
-                if (toSecondNodeVec3f * toStartPointVec3f > 0)
-                {
-                    ESM::Pathgrid::Point temp(secondNode);
-                    converter.toWorld(temp);
-                    // Add Z offset since path node can overlap with other objects.
-                    // Also ignore doors in raytesting.
-                    bool isPathClear = !MWBase::Environment::get().getWorld()->castRay(
-                        startPoint.mX, startPoint.mY, startPoint.mZ+16, temp.mX, temp.mY, temp.mZ+16, true);
-                    if (isPathClear)
-                        mPath.pop_front();
-                }
+                result.mMaySkipFirstPoint = toSecondNodeVec3f * toStartPointVec3f > 0;
             }
 
             // convert supplied path to world coordinates
-            for (std::list<ESM::Pathgrid::Point>::iterator iter(mPath.begin()); iter != mPath.end(); ++iter)
+            for (ESM::Pathgrid::Point& point : result.mPoints)
             {
-                converter.toWorld(*iter);
+                converter.toWorld(point);
             }
         }
 
@@ -273,7 +221,70 @@ namespace MWMechanics
         //
         // The AI routines will have to deal with such situations.
         if(endNode.second)
-            mPath.push_back(endPoint);
+            result.mPoints.push_back(endPoint);
+
+        return result;
+    }
+
+    /*
+     * NOTE: This method may fail to find a path.  The caller must check the
+     * result before using it.  If there is no path the AI routies need to
+     * implement some other heuristics to reach the target.
+     *
+     * NOTE: It may be desirable to simply go directly to the endPoint if for
+     *       example there are no pathgrids in this cell.
+     *
+     * NOTE: startPoint & endPoint are in world coordinates
+     *
+     * Updates mPath using aStarSearch() or ray test (if shortcut allowed).
+     * mPath consists of pathgrid points, except the last element which is
+     * endPoint.  This may be useful where the endPoint is not on a pathgrid
+     * point (e.g. combat).  However, if the caller has already chosen a
+     * pathgrid point (e.g. wander) then it may be worth while to call
+     * pop_back() to remove the redundant entry.
+     *
+     * NOTE: coordinates must be converted prior to calling GetClosestPoint()
+     *
+     *    |
+     *    |       cell
+     *    |     +-----------+
+     *    |     |           |
+     *    |     |           |
+     *    |     |      @    |
+     *    |  i  |   j       |
+     *    |<--->|<---->|    |
+     *    |     +-----------+
+     *    |   k
+     *    |<---------->|         world
+     *    +-----------------------------
+     *
+     *    i = x value of cell itself (multiply by ESM::Land::REAL_SIZE to convert)
+     *    j = @.x in local coordinates (i.e. within the cell)
+     *    k = @.x in world coordinates
+     */
+    void PathFinder::buildPath(const ESM::Pathgrid::Point &startPoint,
+                               const ESM::Pathgrid::Point &endPoint,
+                               const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph)
+    {
+        setPath(findPathgridPath(startPoint, endPoint, cell->getCell(), pathgridGraph), startPoint, cell);
+    }
+
+    void PathFinder::setPath(const FoundPath& path, const ESM::Pathgrid::Point& startPoint,
+                             const MWWorld::CellStore* cell)
+    {
+        mCell = cell;
+        mPath.assign(path.mPoints.begin(), path.mPoints.end());
+
+        if (path.mMaySkipFirstPoint && mPath.size() > 1)
+        {
+            const ESM::Pathgrid::Point& secondNode = *(++mPath.begin());
+            // Add Z offset since path node can overlap with other objects.
+            // Also ignore doors in raytesting.
+            bool isPathClear = !MWBase::Environment::get().getWorld()->castRay(
+                startPoint.mX, startPoint.mY, startPoint.mZ+16, secondNode.mX, secondNode.mY, secondNode.mZ+16, true);
+            if (isPathClear)
+                mPath.pop_front();
+        }
     }
 
     float PathFinder::getZAngleToNext(float x, float y) const
@@ -325,17 +336,23 @@ namespace MWMechanics
     void PathFinder::buildSyncedPath(const ESM::Pathgrid::Point &startPoint,
         const ESM::Pathgrid::Point &endPoint,
         const MWWorld::CellStore* cell, const MWMechanics::PathgridGraph& pathgridGraph)
+    {
+        setSyncedPath(findPathgridPath(startPoint, endPoint, cell->getCell(), pathgridGraph), startPoint, cell);
+    }
+
+    void PathFinder::setSyncedPath(const FoundPath& path, const ESM::Pathgrid::Point& startPoint,
+                                   const MWWorld::CellStore* cell)
     {
         if (mPath.size() < 2)
         {
             // if path has one point, then it's the destination.
             // don't need to worry about bad path for this case
-            buildPath(startPoint, endPoint, cell, pathgridGraph);
+            setPath(path, startPoint, cell);
         }
         else
         {
             const ESM::Pathgrid::Point oldStart(*getPath().begin());
-            buildPath(startPoint, endPoint, cell, pathgridGraph);
+            setPath(path, startPoint, cell);
             if (mPath.size() >= 2)
             {
                 // if 2nd waypoint of new path == 1st waypoint of old,
@@ -2,11 +2,17 @@
 #define GAME_MWMECHANICS_PATHFINDING_H
 
 #include <list>
+#include <vector>
 #include <cassert>
 
 #include <components/esm/defs.hpp>
 #include <components/esm/loadpgrd.hpp>
 
+namespace ESM
+{
+    struct Cell;
+}
+
 namespace MWWorld
 {
     class CellStore;
@@ -32,6 +38,20 @@ namespace MWMechanics
     // magnitude of pits/obstacles is defined by PATHFIND_Z_REACH
     bool checkWayIsClear(const osg::Vec3f& from, const osg::Vec3f& to, float offsetXY);
 
+    /// Path points in world coordinates, that still have to be given to a PathFinder
+    struct FoundPath
+    {
+        std::vector<ESM::Pathgrid::Point> mPoints;
+
+        /// The first point is behind the actor, and may be skipped if the way to the second one is clear
+        bool mMaySkipFirstPoint;
+    };
+
+    /// Searches the pathgrid the same way as PathFinder::buildPath does, except for the ray casts.
+    /// Only reads the records, so it may be called from any thread.
+    FoundPath findPathgridPath(const ESM::Pathgrid::Point &startPoint, const ESM::Pathgrid::Point &endPoint,
+                               const ESM::Cell* cell, const PathgridGraph& pathgridGraph);
+
     class PathFinder
     {
         public:
@@ -93,6 +113,13 @@ namespace MWMechanics
             void buildSyncedPath(const ESM::Pathgrid::Point &startPoint, const ESM::Pathgrid::Point &endPoint,
                 const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph);
 
+            /// Replaces the path with one that was found in advance, e.g. by AsyncPathFinder
+            void setPath(const FoundPath& path, const ESM::Pathgrid::Point& startPoint, const MWWorld::CellStore* cell);
+
+            /// Like setPath, but synchronizes the new path with the old one like buildSyncedPath does
+            void setSyncedPath(const FoundPath& path, const ESM::Pathgrid::Point& startPoint,
+                const MWWorld::CellStore* cell);
+
             void addPointToPath(const ESM::Pathgrid::Point &point)
             {
                 mPath.push_back(point);
@@ -155,7 +182,6 @@ namespace MWMechanics
         private:
             std::list<ESM::Pathgrid::Point> mPath;
 
-            const ESM::Pathgrid *mPathgrid;
             const MWWorld::CellStore* mCell;
     };
 }
@@ -1379,11 +1379,12 @@ namespace MWMechanics
             if (!actor.getClass().isNpc())
                 break;
             NpcStats &npcStats = actor.getClass().getNpcStats(actor);
-            SkillValue& skill = npcStats.getSkill(effectKey.mArg);
+            SkillValue skill = npcStats.getSkill(effectKey.mArg);
             if (effectKey.mId == ESM::MagicEffect::RestoreSkill)
                 skill.restore(magnitude);
             else
                 skill.damage(magnitude);
+            npcStats.setSkill(effectKey.mArg, skill);
             break;
         }
 
@@ -25,6 +25,7 @@ mwmp::Cell::Cell(MWWorld::CellStore* cellStore)
     std::map<std::string, DedicatedActor *> dedicatedActors;
 
     updateTimer = 0;
+    positionTimer = 0;
 }
 
 Cell::~Cell()
@@ -39,11 +40,21 @@ void Cell::updateLocal(bool forceUpdate)
 
     const float timeoutSec = 0.025;
 
-    if (!forceUpdate && (updateTimer += MWBase::Environment::get().getFrameDuration()) < timeoutSec)
+    // Other clients interpolate between the positions they receive, so these don't need to be sent as often
+    const float positionTimeoutSec = 0.05;
+
+    const float frameDuration = MWBase::Environment::get().getFrameDuration();
+    positionTimer += frameDuration;
+
+    if (!forceUpdate && (updateTimer += frameDuration) < timeoutSec)
         return;
     else
         updateTimer = 0;
 
+    const bool shouldUpdatePositions = forceUpdate || positionTimer >= positionTimeoutSec;
+    if (shouldUpdatePositions)
+        positionTimer = 0;
+
     CellController *cellController = Main::get().getCellController();
     ActorList *actorList = mwmp::Main::get().getNetworking()->getActorList();
     actorList->reset();
@@ -85,7 +96,7 @@ void Cell::updateLocal(bool forceUpdate)
             // Forcibly update this local actor if its data has never been sent before;
             // otherwise, use the current forceUpdate value
             if (actor->getPtr().getRefData().isEnabled())
-                actor->update(actor->hasSentData ? forceUpdate : true);
+                actor->update(actor->hasSentData ? forceUpdate : true, shouldUpdatePositions);
 
             ++it;
         }
@@ -130,6 +141,8 @@ void Cell::readPositions(ActorList& actorList)
             DedicatedActor *actor = dedicatedActors[mapIndex];
             actor->position = baseActor.position;
             actor->direction = baseActor.direction;
+            actor->positionTime = baseActor.positionTime;
+            actor->addPositionSnapshot();
 
             if (!actor->hasPositionData)
             {
@@ -232,7 +245,7 @@ void Cell::readEquipment(ActorList& actorList)
         {
             DedicatedActor *actor = dedicatedActors[mapIndex];
 
-            for (int slot = 0; slot < 19; ++slot)
+            for (int slot = 0; slot < mwmp::equipmentSlots; ++slot)
                 actor->equipmentItems[slot] = baseActor.equipmentItems[slot];
 
             actor->setEquipment();
@@ -57,6 +57,7 @@ namespace mwmp
         std::map<std::string, DedicatedActor *> dedicatedActors;
 
         float updateTimer;
+        float positionTimer;
     };
 }
 
@@ -42,7 +42,6 @@ DedicatedActor::DedicatedActor()
 
     hasPositionData = false;
     hasStatsDynamicData = false;
-    hasChangedCell = true;
 
     attack.pressed = false;
 }
@@ -68,41 +67,32 @@ void DedicatedActor::setCell(MWWorld::CellStore *cellStore)
 {
     MWBase::World *world = MWBase::Environment::get().getWorld();
 
+    // Positions from before a change to or from an interior are meaningless in the new cell
+    if (!cellStore->isExterior() || !ptr.getCell()->isExterior())
+        positionSnapshots.clear();
+
     ptr = world->moveObject(ptr, cellStore, position.pos[0], position.pos[1], position.pos[2]);
     setMovementSettings();
-
-    hasChangedCell = true;
 }
 
 void DedicatedActor::move(float dt)
 {
-    ESM::Position refPos = ptr.getRefData().getPosition();
     MWBase::World *world = MWBase::Environment::get().getWorld();
-    const int maxInterpolationDistance = 40;
 
-    // Apply interpolation only if the position hasn't changed too much from last time
-    bool shouldInterpolate = abs(position.pos[0] - refPos.pos[0]) < maxInterpolationDistance && abs(position.pos[1] - refPos.pos[1]) < maxInterpolationDistance && abs(position.pos[2] - refPos.pos[2]) < maxInterpolationDistance;
+    // Use the latest position as it is until positions with server times have been received
+    ESM::Position playedPosition = position;
+    positionSnapshots.getPosition(SnapshotBuffer::getTime(), playedPosition);
 
-    // Don't apply linear interpolation if the DedicatedActor has just gone through a cell change, because
-    // the interpolated position will be invalid, causing a slight hopping glitch
-    if (shouldInterpolate && !hasChangedCell)
-    {
-        static const int timeMultiplier = 15;
-        osg::Vec3f lerp = MechanicsHelper::getLinearInterpolation(refPos.asVec3(), position.asVec3(), dt * timeMultiplier);
-        refPos.pos[0] = lerp.x();
-        refPos.pos[1] = lerp.y();
-        refPos.pos[2] = lerp.z();
-
-        world->moveObject(ptr, refPos.pos[0], refPos.pos[1], refPos.pos[2]);
-    }
-    else
-    {
-        setPosition();
-        hasChangedCell = false;
-    }
+    world->moveObject(ptr, playedPosition.pos[0], playedPosition.pos[1], playedPosition.pos[2]);
 
     setMovementSettings();
-    world->rotateObject(ptr, position.rot[0], position.rot[1], position.rot[2]);
+    world->rotateObject(ptr, playedPosition.rot[0], playedPosition.rot[1], playedPosition.rot[2]);
+}
+
+void DedicatedActor::addPositionSnapshot()
+{
+    const bool isMoving = direction.pos[0] != 0 || direction.pos[1] != 0 || direction.pos[2] != 0;
+    positionSnapshots.add(positionTime, SnapshotBuffer::getTime(), position, isMoving);
 }
 
 void DedicatedActor::setMovementSettings()
@@ -5,6 +5,8 @@
 #include "../mwmechanics/aisequence.hpp"
 #include "../mwworld/manualref.hpp"
 
+#include "SnapshotBuffer.hpp"
+
 namespace mwmp
 {
     class DedicatedActor : public BaseActor
@@ -16,6 +18,7 @@ namespace mwmp
 
         void update(float dt);
         void move(float dt);
+        void addPositionSnapshot();
         void setCell(MWWorld::CellStore *cellStore);
         void setMovementSettings();
         void setPosition();
@@ -35,7 +38,7 @@ namespace mwmp
     private:
         MWWorld::Ptr ptr;
 
-        bool hasChangedCell;
+        SnapshotBuffer positionSnapshots;
     };
 }
 
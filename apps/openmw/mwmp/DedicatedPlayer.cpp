@@ -114,27 +114,14 @@ void DedicatedPlayer::move(float dt)
 {
     if (!reference) return;
 
-    ESM::Position refPos = ptr.getRefData().getPosition();
     MWBase::World *world = MWBase::Environment::get().getWorld();
-    const int maxInterpolationDistance = 40;
 
-    // Apply interpolation only if the position hasn't changed too much from last time
-    bool shouldInterpolate =
-            abs(position.pos[0] - refPos.pos[0]) < maxInterpolationDistance &&
-            abs(position.pos[1] - refPos.pos[1]) < maxInterpolationDistance &&
-            abs(position.pos[2] - refPos.pos[2]) < maxInterpolationDistance;
+    // Use the latest position as it is until positions with server times have been received
+    ESM::Position playedPosition = position;
+    positionSnapshots.getPosition(SnapshotBuffer::getTime(), playedPosition);
 
-    if (shouldInterpolate)
-    {
-        static const int timeMultiplier = 15;
-        osg::Vec3f lerp = MechanicsHelper::getLinearInterpolation(refPos.asVec3(), position.asVec3(), dt * timeMultiplier);
-
-        world->moveObject(ptr, lerp.x(), lerp.y(), lerp.z());
-    }
-    else
-        world->moveObject(ptr, position.pos[0], position.pos[1], position.pos[2]);
-
-    world->rotateObject(ptr, position.rot[0], 0, position.rot[2]);
+    world->moveObject(ptr, playedPosition.pos[0], playedPosition.pos[1], playedPosition.pos[2]);
+    world->rotateObject(ptr, playedPosition.rot[0], 0, playedPosition.rot[2]);
 
     MWMechanics::Movement *move = &ptr.getClass().getMovementSettings(ptr);
     move->mPosition[0] = direction.pos[0];
@@ -150,6 +137,12 @@ void DedicatedPlayer::move(float dt)
     }
 }
 
+void DedicatedPlayer::addPositionSnapshot()
+{
+    const bool isMoving = direction.pos[0] != 0 || direction.pos[1] != 0 || direction.pos[2] != 0;
+    positionSnapshots.add(positionTime, SnapshotBuffer::getTime(), position, isMoving);
+}
+
 void DedicatedPlayer::setBaseInfo()
 {
     // Use the previous race if the new one doesn't exist
@@ -380,6 +373,10 @@ void DedicatedPlayer::setCell()
     else
         world->enable(getPtr());
 
+    // Positions from before a change to or from an interior are meaningless in the new cell
+    if (!cellStore->isExterior() || !ptr.getCell()->isExterior())
+        positionSnapshots.clear();
+
     // Allow this player's reference to move across a cell now that a manual cell
     // update has been called
     setPtr(world->moveObject(ptr, cellStore, position.pos[0], position.pos[1], position.pos[2]));
@@ -16,6 +16,8 @@
 
 #include "../mwworld/manualref.hpp"
 
+#include "SnapshotBuffer.hpp"
+
 #include <map>
 #include <RakNetTypes.h>
 
@@ -37,6 +39,7 @@ namespace mwmp
         void update(float dt);
 
         void move(float dt);
+        void addPositionSnapshot();
         void setBaseInfo();
         void setShapeshift();
         void setAnimFlags();
@@ -70,6 +73,8 @@ namespace mwmp
 
         MWWorld::Ptr ptr;
 
+        SnapshotBuffer positionSnapshots;
+
         ESM::CustomMarker marker;
         bool markerEnabled;
 
@@ -49,14 +49,15 @@ LocalActor::~LocalActor()
 
 }
 
-void LocalActor::update(bool forceUpdate)
+void LocalActor::update(bool forceUpdate, bool shouldUpdatePosition)
 {
     updateStatsDynamic(forceUpdate);
     updateEquipment(forceUpdate);
 
     if (forceUpdate || !creatureStats.mDead)
     {
-        updatePosition(forceUpdate);
+        if (forceUpdate || shouldUpdatePosition)
+            updatePosition(forceUpdate);
         updateAnimFlags(forceUpdate);
         updateAnimPlay();
         updateSpeech();
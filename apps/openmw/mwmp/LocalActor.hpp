@@ -14,7 +14,7 @@ namespace mwmp
         LocalActor();
         virtual ~LocalActor();
 
-        void update(bool forceUpdate);
+        void update(bool forceUpdate, bool shouldUpdatePosition = true);
 
         void updateCell();
         void updatePosition(bool forceUpdate);
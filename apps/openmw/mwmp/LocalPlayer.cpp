@@ -20,6 +20,7 @@
 #include "../mwmechanics/aitravel.hpp"
 #include "../mwmechanics/creaturestats.hpp"
 #include "../mwmechanics/mechanicsmanagerimp.hpp"
+#include "../mwmechanics/npcstats.hpp"
 #include "../mwmechanics/spellcasting.hpp"
 
 #include "../mwscript/scriptmanagerimp.hpp"
@@ -81,6 +82,8 @@ LocalPlayer::LocalPlayer()
     isReceivingQuickKeys = false;
     isPlayingAnimation = false;
     diedSinceArrestAttempt = false;
+
+    comparedGenerations = ComparedGenerations();
 }
 
 LocalPlayer::~LocalPlayer()
@@ -101,13 +104,27 @@ MWWorld::Ptr LocalPlayer::getPlayerPtr()
 void LocalPlayer::update()
 {
     static float updateTimer = 0;
+    static float positionTimer = 0;
     const float timeoutSec = 0.015;
 
-    if ((updateTimer += MWBase::Environment::get().getFrameDuration()) >= timeoutSec)
+    // Other clients interpolate between the positions they receive, so these don't need to be sent as often
+    const float positionTimeoutSec = 0.05;
+
+    const float frameDuration = MWBase::Environment::get().getFrameDuration();
+    positionTimer += frameDuration;
+
+    if ((updateTimer += frameDuration) >= timeoutSec)
     {
         updateTimer = 0;
+        checkComparedGenerations();
         updateCell();
-        updatePosition();
+
+        if (positionTimer >= positionTimeoutSec)
+        {
+            positionTimer = 0;
+            updatePosition();
+        }
+
         updateAnimFlags();
         updateAttack();
         updateEquipment();
@@ -202,6 +219,29 @@ bool LocalPlayer::isLoggedIn()
     return false;
 }
 
+void LocalPlayer::checkComparedGenerations()
+{
+    MWWorld::Ptr ptrPlayer = getPlayerPtr();
+    const MWMechanics::NpcStats &ptrNpcStats = ptrPlayer.getClass().getNpcStats(ptrPlayer);
+
+    if (comparedGenerations.stats == &ptrNpcStats)
+        return;
+
+    // The player's stats and inventory have been replaced, so compare everything again; generations
+    // only ever count up, so the ones before the current ones don't come up again
+    const MWWorld::InventoryStore &invStore = ptrPlayer.getClass().getInventoryStore(ptrPlayer);
+
+    comparedGenerations.stats = &ptrNpcStats;
+    comparedGenerations.statsDynamic = ptrNpcStats.getDynamicGeneration() - 1;
+    comparedGenerations.attributes = ptrNpcStats.getAttributesGeneration() - 1;
+    comparedGenerations.attributeProgress = ptrNpcStats.getProgressGeneration() - 1;
+    comparedGenerations.skills = ptrNpcStats.getSkillsGeneration() - 1;
+    comparedGenerations.level = ptrNpcStats.getLevelGeneration() - 1;
+    comparedGenerations.levelProgress = ptrNpcStats.getProgressGeneration() - 1;
+    comparedGenerations.equipment = invStore.getGeneration() - 1;
+    comparedGenerations.inventory = invStore.getGeneration() - 1;
+}
+
 void LocalPlayer::updateStatsDynamic(bool forceUpdate)
 {
     if (statsDynamicIndexChanges.size() > 0)
@@ -210,6 +250,12 @@ void LocalPlayer::updateStatsDynamic(bool forceUpdate)
     MWWorld::Ptr ptrPlayer = getPlayerPtr();
 
     MWMechanics::CreatureStats *ptrCreatureStats = &ptrPlayer.getClass().getCreatureStats(ptrPlayer);
+
+    if (!forceUpdate && ptrCreatureStats->getDynamicGeneration() == comparedGenerations.statsDynamic)
+        return;
+
+    comparedGenerations.statsDynamic = ptrCreatureStats->getDynamicGeneration();
+
     MWMechanics::DynamicStat<float> health(ptrCreatureStats->getHealth());
     MWMechanics::DynamicStat<float> magicka(ptrCreatureStats->getMagicka());
     MWMechanics::DynamicStat<float> fatigue(ptrCreatureStats->getFatigue());
@@ -280,6 +326,13 @@ void LocalPlayer::updateAttributes(bool forceUpdate)
     MWWorld::Ptr ptrPlayer = getPlayerPtr();
     const MWMechanics::NpcStats &ptrNpcStats = ptrPlayer.getClass().getNpcStats(ptrPlayer);
 
+    if (!forceUpdate && ptrNpcStats.getAttributesGeneration() == comparedGenerations.attributes &&
+        ptrNpcStats.getProgressGeneration() == comparedGenerations.attributeProgress)
+        return;
+
+    comparedGenerations.attributes = ptrNpcStats.getAttributesGeneration();
+    comparedGenerations.attributeProgress = ptrNpcStats.getProgressGeneration();
+
     for (int i = 0; i < 8; ++i)
     {
         if (ptrNpcStats.getAttribute(i).getBase() != creatureStats.mAttributes[i].mBase ||
@@ -314,6 +367,11 @@ void LocalPlayer::updateSkills(bool forceUpdate)
     MWWorld::Ptr ptrPlayer = getPlayerPtr();
     const MWMechanics::NpcStats &ptrNpcStats = ptrPlayer.getClass().getNpcStats(ptrPlayer);
 
+    if (!forceUpdate && ptrNpcStats.getSkillsGeneration() == comparedGenerations.skills)
+        return;
+
+    comparedGenerations.skills = ptrNpcStats.getSkillsGeneration();
+
     for (int i = 0; i < 27; ++i)
     {
         // Update a skill if its base value has changed at all or its progress has changed enough
@@ -341,6 +399,13 @@ void LocalPlayer::updateLevel(bool forceUpdate)
     MWWorld::Ptr ptrPlayer = getPlayerPtr();
     const MWMechanics::NpcStats &ptrNpcStats = ptrPlayer.getClass().getNpcStats(ptrPlayer);
 
+    if (!forceUpdate && ptrNpcStats.getLevelGeneration() == comparedGenerations.level &&
+        ptrNpcStats.getProgressGeneration() == comparedGenerations.levelProgress)
+        return;
+
+    comparedGenerations.level = ptrNpcStats.getLevelGeneration();
+    comparedGenerations.levelProgress = ptrNpcStats.getProgressGeneration();
+
     if (ptrNpcStats.getLevel() != creatureStats.mLevel ||
         ptrNpcStats.getLevelProgress() != npcStats.mLevelProgress ||
         forceUpdate)
@@ -474,6 +539,12 @@ void LocalPlayer::updateEquipment(bool forceUpdate)
     MWWorld::Ptr ptrPlayer = getPlayerPtr();
 
     MWWorld::InventoryStore &invStore = ptrPlayer.getClass().getInventoryStore(ptrPlayer);
+
+    // Unless items were moved around since the last comparison, the same items are equipped, but their
+    // counts and charges can still have changed through their references
+    const bool compareIds = forceUpdate || invStore.getGeneration() != comparedGenerations.equipment;
+    comparedGenerations.equipment = invStore.getGeneration();
+
     for (int slot = 0; slot < MWWorld::InventoryStore::Slots; slot++)
     {
         auto &item = equipmentItems[slot];
@@ -483,7 +554,7 @@ void LocalPlayer::updateEquipment(bool forceUpdate)
         {
             MWWorld::CellRef &cellRef = it->getCellRef();
 
-            if (Misc::StringUtils::ciEqual(cellRef.getRefId(), item.refId) == false ||
+            if ((compareIds && Misc::StringUtils::ciEqual(cellRef.getRefId(), item.refId) == false) ||
                 cellRef.getCharge() != item.charge ||
                 Utils::compareFloats(cellRef.getEnchantmentCharge(), item.enchantmentCharge, 1.0f) == false ||
                 it->getRefData().getCount() != item.count ||
@@ -517,69 +588,32 @@ void LocalPlayer::updateEquipment(bool forceUpdate)
 
 void LocalPlayer::updateInventory(bool forceUpdate)
 {
-    static bool invChanged = false;
-
-    if (forceUpdate)
-        invChanged = true;
-
     MWWorld::Ptr ptrPlayer = getPlayerPtr();
     MWWorld::InventoryStore &ptrInventory = ptrPlayer.getClass().getInventoryStore(ptrPlayer);
-    mwmp::Item item;
+    const unsigned int generation = ptrInventory.getGeneration();
 
-    auto setItem = [](Item &item, const MWWorld::Ptr &iter) {
-        item.refId = iter.getCellRef().getRefId();
-        if (item.refId.find("$dynamic") != string::npos)
-            return true;
-        item.count = iter.getRefData().getCount();
-        item.charge = iter.getCellRef().getCharge();
-        item.enchantmentCharge = iter.getCellRef().getEnchantmentCharge();
-        item.soul = iter.getCellRef().getSoul();
-
-        return false;
-    };
-
-    if (!invChanged)
+    // Only send the inventory if items have been added, removed or restacked since it was last sent, or if
+    // their charges have changed, which happens through their references rather than the store
+    if (!forceUpdate && generation == comparedGenerations.inventory)
     {
-        for (const auto &itemOld : inventoryChanges.items)
+        size_t index = 0;
+        bool chargesChanged = false;
+        for (auto iter = ptrInventory.begin(); iter != ptrInventory.end() && !chargesChanged; ++iter, ++index)
         {
-            auto result = ptrInventory.begin();
-            for (; result != ptrInventory.end(); ++result)
-            {
-                if(setItem(item, *result))
-                    continue;
-
-                if (item == itemOld)
-                    break;
-            }
-            if (result == ptrInventory.end())
-            {
-                invChanged = true;
-                break;
-            }
+            chargesChanged = index >= comparedCharges.size() ||
+                comparedCharges[index].first != iter->getCellRef().getCharge() ||
+                comparedCharges[index].second != iter->getCellRef().getEnchantmentCharge();
         }
-    }
 
-    if (!invChanged)
-    {
-        for (const auto &iter : ptrInventory)
-        {
-            if(setItem(item, iter))
-                continue;
-
-            auto items = inventoryChanges.items;
-
-            if (find(items.begin(), items.end(), item) == items.end())
-            {
-                invChanged = true;
-                break;
-            }
-        }
+        if (!chargesChanged)
+            return;
     }
 
-    if (!invChanged)
-        return;
+    comparedGenerations.inventory = generation;
 
-    invChanged = false;
+    comparedCharges.clear();
+    for (auto iter = ptrInventory.begin(); iter != ptrInventory.end(); ++iter)
+        comparedCharges.push_back(std::make_pair(iter->getCellRef().getCharge(), iter->getCellRef().getEnchantmentCharge()));
 
     sendInventory();
 }
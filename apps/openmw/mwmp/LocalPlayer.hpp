@@ -5,6 +5,11 @@
 #include "../mwworld/ptr.hpp"
 #include <RakNetTypes.h>
 
+namespace MWMechanics
+{
+    class NpcStats;
+}
+
 namespace mwmp
 {
     class Networking;
@@ -112,6 +117,29 @@ namespace mwmp
     private:
         Networking *getNetworking();
 
+        void checkComparedGenerations();
+
+        // The generations of the engine's stats and inventory when they were last compared with what was sent,
+        // so the comparisons can be skipped while nothing changes
+        struct ComparedGenerations
+        {
+            const MWMechanics::NpcStats *stats;
+            unsigned int statsDynamic;
+            unsigned int attributes;
+            unsigned int attributeProgress;
+            unsigned int skills;
+            unsigned int level;
+            unsigned int levelProgress;
+            unsigned int equipment;
+            unsigned int inventory;
+        };
+
+        ComparedGenerations comparedGenerations;
+
+        // The charge and enchantment charge of each inventory item when the inventory was last sent, in the order
+        // of the store, which keeps its order while its generation stays the same
+        std::vector<std::pair<int, float> > comparedCharges;
+
     };
 }
 
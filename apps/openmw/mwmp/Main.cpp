@@ -171,6 +171,7 @@ bool Main::init(std::vector<std::string> &content, Files::Collections &collectio
     }
     get().mLocalPlayer->serverPassword = serverPassword;
 
+    pMain->mNetworking->setPacketBudget(manager.getFloat("packetBudget", "Network"));
     pMain->mNetworking->connect(pMain->server, pMain->port, content, collections);
     restoreManager(manager);
     return pMain->mNetworking->isConnected();
@@ -1,11 +1,15 @@
 #include <stdexcept>
+#include <chrono>
 #include <iostream>
 #include <string>
 
 #include <components/openmw-mp/MWMPLog.hpp>
+#include <components/openmw-mp/ChecksumCache.hpp>
 #include <components/openmw-mp/Utils.hpp>
 #include <components/openmw-mp/Version.hpp>
 #include <components/openmw-mp/Packets/PacketPreInit.hpp>
+#include <components/openmw-mp/Packets/PacketWorldSnapshot.hpp>
+#include <components/openmw-mp/Packets/PacketStringTable.hpp>
 
 #include <components/esm/cellid.hpp>
 #include <components/files/configurationmanager.hpp>
@@ -194,7 +198,8 @@ string listComparison(PacketPreInit::PluginContainer checksums, PacketPreInit::P
 }
 
 Networking::Networking(): peer(RakNet::RakPeerInterface::GetInstance()), playerPacketController(peer),
-    actorPacketController(peer), objectPacketController(peer), worldstatePacketController(peer)
+    actorPacketController(peer), objectPacketController(peer), worldstatePacketController(peer), lastSequence(0),
+    packetBudget(0)
 {
 
     RakNet::SocketDescriptor sd;
@@ -213,6 +218,8 @@ Networking::Networking(): peer(RakNet::RakPeerInterface::GetInstance()), playerP
 
 Networking::~Networking()
 {
+    clearQueuedMessages();
+
     peer->Shutdown(100);
     peer->CloseConnection(peer->GetSystemAddressFromIndex(0), true, 0);
     RakNet::RakPeerInterface::DestroyInstance(peer);
@@ -223,7 +230,7 @@ void Networking::update()
     RakNet::Packet *packet;
     std::string errmsg = "";
 
-    for (packet=peer->Receive(); packet; peer->DeallocatePacket(packet), packet=peer->Receive())
+    for (packet=peer->Receive(); packet; packet=peer->Receive())
     {
         switch (packet->data[0])
         {
@@ -252,10 +259,25 @@ void Networking::update()
                 errmsg = "Connection lost.";
                 break;
             default:
-                receiveMessage(packet);
-                //LOG_MESSAGE_SIMPLE(MWMPLog::LOG_INFO, "Message with identifier %i has arrived.", packet->data[0]);
-                break;
+                // Deallocated once it has been applied
+                queueMessage(packet);
+                continue;
         }
+
+        peer->DeallocatePacket(packet);
+    }
+
+    const auto start = chrono::steady_clock::now();
+    const chrono::duration<float, milli> budget(packetBudget);
+
+    while (!packetQueues[PACKET_CLASS_MOVEMENT].empty())
+        processQueuedMessage();
+
+    // Applies at least one more packet each frame, so the queues always make progress
+    while (processQueuedMessage())
+    {
+        if (packetBudget > 0 && chrono::steady_clock::now() - start >= budget)
+            break;
     }
 
     if (!errmsg.empty())
@@ -266,6 +288,125 @@ void Networking::update()
     }
 }
 
+void Networking::setPacketBudget(float milliseconds)
+{
+    packetBudget = milliseconds;
+}
+
+void Networking::queueMessage(RakNet::Packet *packet)
+{
+    QueuedPacket queued;
+    queued.packet = packet;
+    queued.packetID = packet->data[0];
+    queued.sequence = ++lastSequence;
+    queued.guid = 0;
+    queued.canOvertake = false;
+    queued.isCoalescable = false;
+
+    const RakNet::MessageID packetID = queued.packetID;
+    PacketClass packetClass = PACKET_CLASS_NORMAL;
+
+    if (packetID == ID_ACTOR_POSITION)
+        packetClass = PACKET_CLASS_MOVEMENT;
+    else if (objectPacketController.ContainsPacket(packetID) || actorPacketController.ContainsPacket(packetID))
+        packetClass = PACKET_CLASS_BULK;
+    else if (playerPacketController.ContainsPacket(packetID) && packet->length > 1 + RakNet::RakNetGUID::size())
+    {
+        RakNet::BitStream bsIn(&packet->data[1], packet->length - 1, false);
+        RakNet::RakNetGUID guid;
+        bsIn.Read(guid);
+        queued.guid = guid.g;
+
+        // Packets about other players don't depend on the objects and actors of the local player's cells, but
+        // the local player's own ones, such as cell changes and teleports, have to wait for the earlier edits
+        if (guid != getLocalPlayer()->guid)
+        {
+            queued.canOvertake = true;
+
+            if (packetID == ID_PLAYER_POSITION)
+                packetClass = PACKET_CLASS_MOVEMENT;
+            else if (packetID == ID_PLAYER_ANIM_FLAGS)
+                queued.isCoalescable = true;
+            else if (packetID == ID_PLAYER_STATS_DYNAMIC)
+            {
+                // Only the ones that exchange all dynamic stats replace the earlier ones
+                bool exchangeFullInfo = false;
+                queued.isCoalescable = bsIn.Read(exchangeFullInfo) && exchangeFullInfo;
+            }
+        }
+    }
+
+    // Positions are never coalesced, because each one is a sample for the snapshot buffer. Neither are packets
+    // with indexed strings, because skipping them would leave their strings out of the string tables.
+    std::deque<QueuedPacket> &queue = packetQueues[packetClass];
+    queue.push_back(queued);
+
+    if (queued.isCoalescable)
+    {
+        QueuedPacket *&latest = coalescablePackets[make_pair(packetID, queued.guid)];
+        if (latest != nullptr)
+        {
+            peer->DeallocatePacket(latest->packet);
+            latest->packet = nullptr;
+        }
+        latest = &queue.back();
+    }
+}
+
+bool Networking::processQueuedMessage()
+{
+    std::deque<QueuedPacket> *queue = nullptr;
+
+    if (!packetQueues[PACKET_CLASS_MOVEMENT].empty())
+        queue = &packetQueues[PACKET_CLASS_MOVEMENT];
+    else
+    {
+        std::deque<QueuedPacket> &normal = packetQueues[PACKET_CLASS_NORMAL];
+        std::deque<QueuedPacket> &bulk = packetQueues[PACKET_CLASS_BULK];
+
+        if (!normal.empty() && (bulk.empty() || normal.front().canOvertake ||
+            normal.front().sequence < bulk.front().sequence))
+            queue = &normal;
+        else if (!bulk.empty())
+            queue = &bulk;
+        else
+            return false;
+    }
+
+    QueuedPacket queued = queue->front();
+
+    if (queued.isCoalescable)
+    {
+        auto latest = coalescablePackets.find(make_pair(queued.packetID, queued.guid));
+        if (latest != coalescablePackets.end() && latest->second == &queue->front())
+            coalescablePackets.erase(latest);
+    }
+
+    queue->pop_front();
+
+    if (queued.packet != nullptr)
+    {
+        receiveMessage(queued.packet);
+        peer->DeallocatePacket(queued.packet);
+    }
+
+    return true;
+}
+
+void Networking::clearQueuedMessages()
+{
+    for (auto &queue : packetQueues)
+    {
+        for (auto &queued : queue)
+        {
+            if (queued.packet != nullptr)
+                peer->DeallocatePacket(queued.packet);
+        }
+        queue.clear();
+    }
+    coalescablePackets.clear();
+}
+
 void Networking::connect(const std::string &ip, unsigned short port, std::vector<string> &content, Files::Collections &collections)
 {
     RakNet::SystemAddress master;
@@ -273,6 +414,9 @@ void Networking::connect(const std::string &ip, unsigned short port, std::vector
     master.SetPortHostOrder(port);
     std::string errmsg = "";
 
+    // String tables learned from a previous server are no longer valid
+    PacketStringTables::clear();
+
     stringstream sstr;
     sstr << TES3MP_VERSION;
     sstr << TES3MP_PROTO_VERSION;
@@ -349,25 +493,32 @@ void Networking::connect(const std::string &ip, unsigned short port, std::vector
 
 void Networking::preInit(std::vector<std::string> &content, Files::Collections &collections)
 {
-    PacketPreInit::PluginContainer checksums;
-    vector<string>::const_iterator it(content.begin());
-    for (int idx = 0; it != content.end(); ++it, ++idx)
+    std::vector<boost::filesystem::path> paths;
+    for (const std::string &file : content)
     {
-        boost::filesystem::path filename(*it);
+        boost::filesystem::path filename(file);
         const Files::MultiDirCollection& col = collections.getCollection(filename.extension().string());
-        if (col.doesExist(*it))
-        {
-            PacketPreInit::HashList hashList;
-            unsigned crc32 = Utils::crc32Checksum(col.getPath(*it).string());
-            hashList.push_back(crc32);
-            checksums.push_back(make_pair(*it, hashList));
-
-            LOG_APPEND(MWMPLog::LOG_WARN, "idx: %d\tchecksum: %X\tfile: %s\n", idx, crc32, col.getPath(*it).string().c_str());
-        }
+        if (col.doesExist(file))
+            paths.push_back(col.getPath(file));
         else
             throw std::runtime_error("Plugin doesn't exist.");
     }
 
+    // Only files that have changed since the last launch need to be hashed
+    Files::ConfigurationManager cfgMgr;
+    ChecksumCache checksumCache(cfgMgr.getCachePath() / "tes3mp-checksums.txt");
+    std::vector<unsigned int> crc32s = checksumCache.getChecksums(paths);
+
+    PacketPreInit::PluginContainer checksums;
+    for (size_t idx = 0; idx < content.size(); ++idx)
+    {
+        PacketPreInit::HashList hashList;
+        hashList.push_back(crc32s[idx]);
+        checksums.push_back(make_pair(content[idx], hashList));
+
+        LOG_APPEND(MWMPLog::LOG_WARN, "idx: %d\tchecksum: %X\tfile: %s\n", (int) idx, crc32s[idx], paths[idx].string().c_str());
+    }
+
     PacketPreInit packetPreInit(peer);
     RakNet::BitStream bs;
     RakNet::RakNetGUID guid;
@@ -423,7 +574,11 @@ void Networking::receiveMessage(RakNet::Packet *packet)
     if (packet->length < 2)
         return;
 
-    if (playerPacketController.ContainsPacket(packet->data[0]))
+    PacketStringTables::setSender(packet->guid);
+
+    if (packet->data[0] == ID_WORLD_SNAPSHOT)
+        processWorldSnapshot(packet);
+    else if (playerPacketController.ContainsPacket(packet->data[0]))
     {
         if (!PlayerProcessor::Process(*packet))
             LOG_MESSAGE_SIMPLE(MWMPLog::LOG_WARN, "Unhandled PlayerPacket with identifier %i has arrived", packet->data[0]);
@@ -445,6 +600,34 @@ void Networking::receiveMessage(RakNet::Packet *packet)
     }
 }
 
+void Networking::processWorldSnapshot(RakNet::Packet *packet)
+{
+    RakNet::BitStream bsIn(&packet->data[1], packet->length, false);
+    bsIn.IgnoreBytes((unsigned int) RakNet::RakNetGUID::size());
+
+    PacketWorldSnapshot snapshotPacket(peer);
+    snapshotPacket.SetReadStream(&bsIn);
+    snapshotPacket.Read();
+
+    if (!snapshotPacket.isPacketValid())
+        return;
+
+    LOG_MESSAGE_SIMPLE(MWMPLog::LOG_INFO, "Received chunk %u of the world snapshot with %u packets%s",
+        snapshotPacket.chunkIndex, snapshotPacket.getNumberOfPackets(), snapshotPacket.isLastChunk ? ", which was the last one" : "");
+
+    // Handle every packet in the chunk as if it had been received on its own
+    for (uint32_t i = 0; i < snapshotPacket.getNumberOfPackets(); ++i)
+    {
+        RakNet::Packet embeddedPacket = *packet;
+        embeddedPacket.data = const_cast<unsigned char *>(snapshotPacket.getPacketData(i));
+        embeddedPacket.length = snapshotPacket.getPacketLength(i);
+        embeddedPacket.bitSize = BYTES_TO_BITS(embeddedPacket.length);
+
+        if (embeddedPacket.data[0] != ID_WORLD_SNAPSHOT)
+            receiveMessage(&embeddedPacket);
+    }
+}
+
 PlayerPacket *Networking::getPlayerPacket(RakNet::MessageID id)
 {
     return playerPacketController.GetPacket(id);
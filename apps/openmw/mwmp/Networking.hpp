@@ -3,6 +3,8 @@
 
 #include <RakPeerInterface.h>
 #include <BitStream.h>
+#include <deque>
+#include <map>
 #include <string>
 
 #include <components/openmw-mp/NetworkMessages.hpp>
@@ -30,6 +32,9 @@ namespace mwmp
         void connect(const std::string& ip, unsigned short port, std::vector<std::string> &content, Files::Collections &collections);
         void update();
 
+        // How many milliseconds per frame may be spent on applying received packets, or 0 for no limit
+        void setPacketBudget(float milliseconds);
+
         PlayerPacket *getPlayerPacket(RakNet::MessageID id);
         ActorPacket *getActorPacket(RakNet::MessageID id);
         ObjectPacket *getObjectPacket(RakNet::MessageID id);
@@ -62,7 +67,36 @@ namespace mwmp
         ObjectList objectList;
         Worldstate worldstate;
 
+        // Received packets are applied in these classes, one after the other. Within each class, they keep their order.
+        enum PacketClass
+        {
+            PACKET_CLASS_MOVEMENT, // Positions of other players and actors, which are always applied in the same frame
+            PACKET_CLASS_NORMAL,
+            PACKET_CLASS_BULK, // Object and actor edits, which are deferred to later frames when the budget runs out
+            PACKET_CLASS_COUNT
+        };
+
+        struct QueuedPacket
+        {
+            RakNet::Packet *packet; // Null once a newer packet superseded it
+            RakNet::MessageID packetID;
+            uint64_t sequence;
+            uint64_t guid;
+            // Whether the packet may be applied before bulk packets that arrived earlier
+            bool canOvertake;
+            bool isCoalescable;
+        };
+
+        std::deque<QueuedPacket> packetQueues[PACKET_CLASS_COUNT];
+        std::map<std::pair<RakNet::MessageID, uint64_t>, QueuedPacket *> coalescablePackets;
+        uint64_t lastSequence;
+        float packetBudget;
+
+        void queueMessage(RakNet::Packet *packet);
+        bool processQueuedMessage();
+        void clearQueuedMessages();
         void receiveMessage(RakNet::Packet *packet);
+        void processWorldSnapshot(RakNet::Packet *packet);
 
         void preInit(std::vector<std::string> &content, Files::Collections &collections);
     };
@@ -0,0 +1,226 @@
+#include "SnapshotBuffer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include <osg/Math>
+
+using namespace mwmp;
+using namespace std;
+
+namespace
+{
+    // Used until the interval between positions is known
+    const double defaultInterval = 0.05;
+
+    // Gaps longer than this mean the entity stood still in between, rather than that positions got delayed
+    const double maxInterval = 0.5;
+
+    const double minPlayoutDelay = 0.02;
+    const double maxPlayoutDelay = 0.5;
+    const double playoutMargin = 0.01;
+
+    // How much faster or slower than real time the playback may run while the playout delay adapts
+    const double maxTimeScale = 0.1;
+
+    const double maxExtrapolation = 0.25;
+
+    // Anything moving faster than this, in units per second, is treated as a teleport
+    const float maxSpeed = 5000.f;
+    const float minTeleportDistance = 256.f;
+
+    float interpolateAngle(float start, float end, float factor)
+    {
+        return start + static_cast<float>(remainder(end - start, 2 * osg::PI)) * factor;
+    }
+
+    ESM::Position interpolate(const ESM::Position &start, const ESM::Position &end, float factor)
+    {
+        ESM::Position result;
+        for (int i = 0; i < 3; ++i)
+        {
+            result.pos[i] = start.pos[i] + (end.pos[i] - start.pos[i]) * factor;
+            result.rot[i] = interpolateAngle(start.rot[i], end.rot[i], factor);
+        }
+        return result;
+    }
+}
+
+SnapshotBuffer::SnapshotBuffer() : first(0), count(0), hasClock(false), lastServerTime(0), lastServerSeconds(0),
+    clockOffset(0), jitter(0), interval(defaultInterval), hasPlayedOut(false), playoutOffset(0), lastPlayoutTime(0)
+{
+
+}
+
+void SnapshotBuffer::add(uint32_t serverTime, double localTime, const ESM::Position &position, bool isMoving)
+{
+    Snapshot snapshot;
+    snapshot.position = position;
+    snapshot.isMoving = isMoving;
+
+    // Positions the server sets itself, e.g. from scripts, have no time and are shown right away
+    if (serverTime == 0)
+    {
+        snapshot.time = lastServerSeconds;
+        snapshot.isMoving = false;
+        clear();
+        push(snapshot);
+        return;
+    }
+
+    if (!hasClock)
+    {
+        hasClock = true;
+        snapshot.time = serverTime * 0.001;
+        clockOffset = localTime - snapshot.time;
+    }
+    else
+    {
+        // The server's millisecond counter wraps around, so only the difference to the last one is used
+        const int32_t elapsed = static_cast<int32_t>(serverTime - lastServerTime);
+
+        // Positions that arrive out of order are older than the ones that are already played back
+        if (elapsed <= 0)
+            return;
+
+        snapshot.time = lastServerSeconds + elapsed * 0.001;
+
+        // The position that arrived fastest tells how the clocks relate. The estimate creeps up slowly
+        // otherwise, in case the route got longer.
+        const double offset = localTime - snapshot.time;
+        if (offset < clockOffset)
+            clockOffset = offset;
+        else
+            clockOffset += (offset - clockOffset) * 0.01;
+
+        // Keeps the latest arrival in mind for a while, so a single late position doesn't stall the playback each time
+        const double lateness = localTime - snapshot.time - clockOffset;
+        if (lateness > jitter)
+            jitter = lateness;
+        else
+            jitter += (lateness - jitter) * 0.01;
+    }
+
+    lastServerTime = serverTime;
+    lastServerSeconds = snapshot.time;
+
+    if (count > 0)
+    {
+        const Snapshot &newest = at(count - 1);
+        const double gap = snapshot.time - newest.time;
+
+        const float distance = (position.asVec3() - newest.position.asVec3()).length();
+        if (distance > minTeleportDistance + maxSpeed * gap)
+            clear();
+        else if (gap > maxInterval)
+        {
+            // Senders don't send anything while the entity stands still, so it only started moving just now
+            Snapshot standing = newest;
+            standing.time = snapshot.time - interval;
+            standing.isMoving = false;
+            push(standing);
+        }
+        else
+            interval += (gap - interval) * 0.1;
+    }
+
+    push(snapshot);
+}
+
+bool SnapshotBuffer::getPosition(double localTime, ESM::Position &position)
+{
+    if (count == 0)
+        return false;
+
+    // With a delay of one interval the next position arrives just as the playback reaches the last one,
+    // if it isn't late
+    const double targetDelay = min(max(interval + jitter + playoutMargin, minPlayoutDelay), maxPlayoutDelay);
+
+    // Changes to the clock offset are eased in as well, or each better estimate of it would make the entity jump
+    if (!hasPlayedOut)
+    {
+        hasPlayedOut = true;
+        playoutOffset = clockOffset + targetDelay;
+    }
+    else
+    {
+        const double maxChange = max(localTime - lastPlayoutTime, 0.0) * maxTimeScale;
+        playoutOffset += min(max(clockOffset + targetDelay - playoutOffset, -maxChange), maxChange);
+    }
+    lastPlayoutTime = localTime;
+
+    const double playoutTime = localTime - playoutOffset;
+
+    const Snapshot &oldest = at(0);
+    if (playoutTime <= oldest.time)
+    {
+        position = oldest.position;
+        return true;
+    }
+
+    const Snapshot &newest = at(count - 1);
+    if (playoutTime >= newest.time)
+    {
+        position = newest.position;
+        if (count < 2 || !newest.isMoving)
+            return true;
+
+        const Snapshot &previous = at(count - 2);
+        const double gap = newest.time - previous.time;
+        if (gap <= 0 || gap > maxInterval)
+            return true;
+
+        const double extrapolation = min(playoutTime - newest.time, maxExtrapolation);
+        position = interpolate(previous.position, newest.position, static_cast<float>(1 + extrapolation / gap));
+        return true;
+    }
+
+    size_t index = count - 1;
+    while (at(index - 1).time > playoutTime)
+        --index;
+
+    const Snapshot &start = at(index - 1);
+    const Snapshot &end = at(index);
+    position = interpolate(start.position, end.position,
+        static_cast<float>((playoutTime - start.time) / (end.time - start.time)));
+    return true;
+}
+
+void SnapshotBuffer::clear()
+{
+    first = 0;
+    count = 0;
+}
+
+bool SnapshotBuffer::isEmpty() const
+{
+    return count == 0;
+}
+
+double SnapshotBuffer::getPlayoutDelay() const
+{
+    return hasPlayedOut ? playoutOffset - clockOffset : interval + jitter + playoutMargin;
+}
+
+double SnapshotBuffer::getTime()
+{
+    return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void SnapshotBuffer::push(const Snapshot &snapshot)
+{
+    if (count == capacity)
+    {
+        first = (first + 1) % capacity;
+        --count;
+    }
+
+    snapshots[(first + count) % capacity] = snapshot;
+    ++count;
+}
+
+const SnapshotBuffer::Snapshot &SnapshotBuffer::at(size_t index) const
+{
+    return snapshots[(first + index) % capacity];
+}
@@ -0,0 +1,70 @@
+#ifndef OPENMW_SNAPSHOTBUFFER_HPP
+#define OPENMW_SNAPSHOTBUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <components/esm/defs.hpp>
+
+namespace mwmp
+{
+    /*
+     * The positions received for a DedicatedPlayer or DedicatedActor, stamped with the time the server relayed them.
+     *
+     * They are played back with a delay that adapts to how often and how evenly they arrive, so there is usually
+     * a received position on both sides of the played back time to interpolate between. When there isn't one
+     * after it, a moving entity keeps moving for a short while, and then stops at the last received position.
+     */
+    class SnapshotBuffer
+    {
+    public:
+        SnapshotBuffer();
+
+        // Adds a position the server relayed at serverTime (in milliseconds), received at localTime (in seconds).
+        // isMoving tells whether the sender was still moving the entity, so it can be extrapolated.
+        // A serverTime of 0 replaces the added positions, for positions the server set itself.
+        void add(uint32_t serverTime, double localTime, const ESM::Position &position, bool isMoving);
+
+        // Sets position to where the entity should be shown at localTime. Returns false if no position was added.
+        bool getPosition(double localTime, ESM::Position &position);
+
+        // Forgets the added positions, so the next one is shown right away, e.g. after a cell change
+        void clear();
+
+        bool isEmpty() const;
+
+        double getPlayoutDelay() const;
+
+        // The current time in seconds, for use as localTime
+        static double getTime();
+
+    private:
+        struct Snapshot
+        {
+            double time; // In server seconds
+            ESM::Position position;
+            bool isMoving;
+        };
+
+        static const size_t capacity = 32;
+
+        void push(const Snapshot &snapshot);
+        const Snapshot &at(size_t index) const; // From the oldest at 0
+
+        Snapshot snapshots[capacity];
+        size_t first;
+        size_t count;
+
+        bool hasClock;
+        uint32_t lastServerTime;
+        double lastServerSeconds;
+        double clockOffset; // Local time minus server time for a position that arrived without delay
+        double jitter;
+        double interval;
+        bool hasPlayedOut;
+        double playoutOffset; // Local time minus the server time that is played back
+        double lastPlayoutTime;
+    };
+}
+
+#endif //OPENMW_SNAPSHOTBUFFER_HPP
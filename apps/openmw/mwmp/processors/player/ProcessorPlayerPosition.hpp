@@ -32,7 +32,10 @@ namespace mwmp
                     static_cast<LocalPlayer*>(player)->updatePosition(true);
             }
             else if (player != 0) // dedicated player
+            {
+                static_cast<DedicatedPlayer*>(player)->addPositionSnapshot();
                 static_cast<DedicatedPlayer*>(player)->updateMarker();
+            }
         }
     };
 }
@@ -1,6 +1,8 @@
 #include "globalmap.hpp"
 
 #include <climits>
+#include <cstdint>
+#include <cstring>
 
 #include <osg/Image>
 #include <osg/Texture2D>
@@ -11,6 +13,9 @@
 
 #include <osgDB/WriteFile>
 
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
 #include <components/loadinglistener/loadinglistener.hpp>
 #include <components/settings/settings.hpp>
 #include <components/files/memorystream.hpp>
@@ -105,6 +110,64 @@ namespace
         MWRender::GlobalMap* mParent;
     };
 
+    /// Width and height of the map tiles that are generated separately, in cells
+    const int mapTileCells = 8;
+
+    const char tileCacheMagic[8] = {'O', 'M', 'W', 'G', 'M', 'A', 'P', '\0'};
+    const std::uint32_t tileCacheVersion = 1;
+    const char* const tileCacheExtension = ".maptile";
+
+    struct TileCacheHeader
+    {
+        char mMagic[8];
+        std::uint32_t mVersion;
+        std::uint64_t mKey;
+    };
+
+    /// The first cell of the tile that the cell is in. Tiles are aligned to the cell grid rather than to the
+    /// edge of the map, so that cached tiles stay valid when content files move the edge.
+    int getTileStart(int cell)
+    {
+        return (cell >= 0 ? cell / mapTileCells : (cell + 1) / mapTileCells - 1) * mapTileCells;
+    }
+
+    void getMapColor(float y2, unsigned char* rgb)
+    {
+        unsigned char r,g,b;
+
+        if (y2 < 0)
+        {
+            r = static_cast<unsigned char>(14 * y2 + 38);
+            g = static_cast<unsigned char>(20 * y2 + 56);
+            b = static_cast<unsigned char>(18 * y2 + 51);
+        }
+        else if (y2 < 0.3f)
+        {
+            if (y2 < 0.1f)
+                y2 *= 8.f;
+            else
+            {
+                y2 -= 0.1f;
+                y2 += 0.8f;
+            }
+            r = static_cast<unsigned char>(66 - 32 * y2);
+            g = static_cast<unsigned char>(48 - 23 * y2);
+            b = static_cast<unsigned char>(33 - 16 * y2);
+        }
+        else
+        {
+            y2 -= 0.3f;
+            y2 *= 1.428f;
+            r = static_cast<unsigned char>(34 - 29 * y2);
+            g = static_cast<unsigned char>(25 - 20 * y2);
+            b = static_cast<unsigned char>(17 - 12 * y2);
+        }
+
+        rgb[0] = r;
+        rgb[1] = g;
+        rgb[2] = b;
+    }
+
 }
 
 namespace MWRender
@@ -121,23 +184,57 @@ namespace MWRender
         End of tes3mp addition
     */
 
+    /// Generates the part of the world map covered by one tile, or reads it from the disk cache
+    /// if the land records it is generated from haven't changed
     class CreateMapWorkItem : public SceneUtil::WorkItem
     {
     public:
-        CreateMapWorkItem(int width, int height, int minX, int minY, int maxX, int maxY, int cellSize, const MWWorld::Store<ESM::Land>& landStore)
-            : mWidth(width), mHeight(height), mMinX(minX), mMinY(minY), mMaxX(maxX), mMaxY(maxY), mCellSize(cellSize), mLandStore(landStore)
+        CreateMapWorkItem(int minX, int minY, int maxX, int maxY, int cellSize, const MWWorld::Store<ESM::Land>& landStore,
+                          const std::string& cachePath)
+            : mMinX(minX), mMinY(minY), mMaxX(maxX), mMaxY(maxY), mCellSize(cellSize), mLandStore(landStore)
+            , mCachePath(cachePath)
         {
         }
 
         virtual void doWork()
         {
-            osg::ref_ptr<osg::Image> image = new osg::Image;
-            image->allocateImage(mWidth, mHeight, 1, GL_RGB, GL_UNSIGNED_BYTE);
-            unsigned char* data = image->data();
+            const int width = (mMaxX - mMinX + 1) * mCellSize;
+            const int height = (mMaxY - mMinY + 1) * mCellSize;
+
+            mImage = new osg::Image;
+            mImage->allocateImage(width, height, 1, GL_RGB, GL_UNSIGNED_BYTE);
+
+            mAlphaImage = new osg::Image;
+            mAlphaImage->allocateImage(width, height, 1, GL_ALPHA, GL_UNSIGNED_BYTE);
+
+            const std::uint64_t key = makeKey();
+            if (mCachePath.empty() || !readCache(key))
+            {
+                generate();
+                if (!mCachePath.empty())
+                    writeCache(key);
+            }
+        }
+
+        bool contains(int cellX, int cellY) const
+        {
+            return cellX >= mMinX && cellX <= mMaxX && cellY >= mMinY && cellY <= mMaxY;
+        }
+
+        int mMinX, mMinY, mMaxX, mMaxY;
+        int mCellSize;
+        const MWWorld::Store<ESM::Land>& mLandStore;
+        std::string mCachePath;
 
-            osg::ref_ptr<osg::Image> alphaImage = new osg::Image;
-            alphaImage->allocateImage(mWidth, mHeight, 1, GL_ALPHA, GL_UNSIGNED_BYTE);
-            unsigned char* alphaData = alphaImage->data();
+        osg::ref_ptr<osg::Image> mImage;
+        osg::ref_ptr<osg::Image> mAlphaImage;
+
+    private:
+        void generate()
+        {
+            const int width = mImage->s();
+            unsigned char* data = mImage->data();
+            unsigned char* alphaData = mAlphaImage->data();
 
             for (int x = mMinX; x <= mMaxX; ++x)
             {
@@ -155,98 +252,108 @@ namespace MWRender
                             int texelX = (x-mMinX) * mCellSize + cellX;
                             int texelY = (y-mMinY) * mCellSize + cellY;
 
-                            unsigned char r,g,b;
-
                             float y2 = 0;
                             if (land && (land->mDataTypes & ESM::Land::DATA_WNAM))
                                 y2 = land->mWnam[vertexY * 9 + vertexX] / 128.f;
                             else
                                 y2 = SCHAR_MIN / 128.f;
-                            if (y2 < 0)
-                            {
-                                r = static_cast<unsigned char>(14 * y2 + 38);
-                                g = static_cast<unsigned char>(20 * y2 + 56);
-                                b = static_cast<unsigned char>(18 * y2 + 51);
-                            }
-                            else if (y2 < 0.3f)
-                            {
-                                if (y2 < 0.1f)
-                                    y2 *= 8.f;
-                                else
-                                {
-                                    y2 -= 0.1f;
-                                    y2 += 0.8f;
-                                }
-                                r = static_cast<unsigned char>(66 - 32 * y2);
-                                g = static_cast<unsigned char>(48 - 23 * y2);
-                                b = static_cast<unsigned char>(33 - 16 * y2);
-                            }
-                            else
-                            {
-                                y2 -= 0.3f;
-                                y2 *= 1.428f;
-                                r = static_cast<unsigned char>(34 - 29 * y2);
-                                g = static_cast<unsigned char>(25 - 20 * y2);
-                                b = static_cast<unsigned char>(17 - 12 * y2);
-                            }
-
-                            data[texelY * mWidth * 3 + texelX * 3] = r;
-                            data[texelY * mWidth * 3 + texelX * 3+1] = g;
-                            data[texelY * mWidth * 3 + texelX * 3+2] = b;
-
-                            alphaData[texelY * mWidth+ texelX] = (y2 < 0) ? static_cast<unsigned char>(0) : static_cast<unsigned char>(255);
+
+                            getMapColor(y2, &data[texelY * width * 3 + texelX * 3]);
+
+                            alphaData[texelY * width + texelX] = (y2 < 0) ? static_cast<unsigned char>(0) : static_cast<unsigned char>(255);
                         }
                     }
                 }
             }
+        }
 
-            mBaseTexture = new osg::Texture2D;
-            mBaseTexture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
-            mBaseTexture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
-            mBaseTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
-            mBaseTexture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
-            mBaseTexture->setImage(image);
-            mBaseTexture->setResizeNonPowerOfTwoHint(false);
-
-            mAlphaTexture = new osg::Texture2D;
-            mAlphaTexture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
-            mAlphaTexture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
-            mAlphaTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
-            mAlphaTexture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
-            mAlphaTexture->setImage(alphaImage);
-            mAlphaTexture->setResizeNonPowerOfTwoHint(false);
-
-            mOverlayImage = new osg::Image;
-            mOverlayImage->allocateImage(mWidth, mHeight, 1, GL_RGBA, GL_UNSIGNED_BYTE);
-            assert(mOverlayImage->isDataContiguous());
-
-            memset(mOverlayImage->data(), 0, mOverlayImage->getTotalSizeInBytes());
-
-            mOverlayTexture = new osg::Texture2D;
-            mOverlayTexture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
-            mOverlayTexture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
-            mOverlayTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
-            mOverlayTexture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
-            mOverlayTexture->setResizeNonPowerOfTwoHint(false);
-            mOverlayTexture->setInternalFormat(GL_RGBA);
-            mOverlayTexture->setTextureSize(mWidth, mHeight);
-        }
-
-        int mWidth, mHeight;
-        int mMinX, mMinY, mMaxX, mMaxY;
-        int mCellSize;
-        const MWWorld::Store<ESM::Land>& mLandStore;
+        /// Hash of everything the tile is generated from
+        std::uint64_t makeKey() const
+        {
+            std::uint64_t hash = 14695981039346656037ull;
+            const auto add = [&] (const void* value, std::size_t size)
+            {
+                const unsigned char* bytes = static_cast<const unsigned char*>(value);
+                for (std::size_t i = 0; i < size; ++i)
+                    hash = (hash ^ bytes[i]) * 1099511628211ull;
+            };
 
-        osg::ref_ptr<osg::Texture2D> mBaseTexture;
-        osg::ref_ptr<osg::Texture2D> mAlphaTexture;
+            const std::int32_t header[] = {mMinX, mMinY, mMaxX, mMaxY, mCellSize};
+            add(header, sizeof(header));
 
-        osg::ref_ptr<osg::Image> mOverlayImage;
-        osg::ref_ptr<osg::Texture2D> mOverlayTexture;
+            for (int x = mMinX; x <= mMaxX; ++x)
+            {
+                for (int y = mMinY; y <= mMaxY; ++y)
+                {
+                    const ESM::Land* land = mLandStore.search (x,y);
+                    const bool hasData = land && (land->mDataTypes & ESM::Land::DATA_WNAM);
+                    add(&hasData, sizeof(hasData));
+                    if (hasData)
+                        add(land->mWnam, sizeof(land->mWnam));
+                }
+            }
+
+            return hash;
+        }
+
+        boost::filesystem::path getCacheFilePath() const
+        {
+            return boost::filesystem::path(mCachePath)
+                / ("tile_" + std::to_string(mMinX) + "_" + std::to_string(mMinY) + tileCacheExtension);
+        }
+
+        bool readCache(std::uint64_t key)
+        {
+            boost::filesystem::ifstream stream(getCacheFilePath(), std::ios_base::binary);
+            if (!stream)
+                return false;
+
+            TileCacheHeader header;
+            return stream.read(reinterpret_cast<char*>(&header), sizeof(header))
+                && std::memcmp(header.mMagic, tileCacheMagic, sizeof(tileCacheMagic)) == 0
+                && header.mVersion == tileCacheVersion
+                && header.mKey == key
+                && stream.read(reinterpret_cast<char*>(mImage->data()), mImage->getTotalSizeInBytes())
+                && stream.read(reinterpret_cast<char*>(mAlphaImage->data()), mAlphaImage->getTotalSizeInBytes());
+        }
+
+        void writeCache(std::uint64_t key) const
+        {
+            TileCacheHeader header;
+            std::memcpy(header.mMagic, tileCacheMagic, sizeof(tileCacheMagic));
+            header.mVersion = tileCacheVersion;
+            header.mKey = key;
+
+            // Written under another name first, so that a tile isn't read while it's only half written
+            const boost::filesystem::path path = getCacheFilePath();
+            boost::filesystem::path tempPath = path;
+            tempPath += ".tmp";
+
+            bool written;
+            {
+                boost::filesystem::ofstream stream(tempPath, std::ios_base::binary | std::ios_base::trunc);
+                stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                stream.write(reinterpret_cast<const char*>(mImage->data()), mImage->getTotalSizeInBytes());
+                stream.write(reinterpret_cast<const char*>(mAlphaImage->data()), mAlphaImage->getTotalSizeInBytes());
+                stream.close();
+                written = static_cast<bool>(stream);
+            }
+
+            boost::system::error_code error;
+            if (written)
+                boost::filesystem::rename(tempPath, path, error);
+            if (!written || error)
+            {
+                std::cerr << "Warning: Can't write global map tile cache file " << path << std::endl;
+                boost::filesystem::remove(tempPath, error);
+            }
+        }
     };
 
-    GlobalMap::GlobalMap(osg::Group* root, SceneUtil::WorkQueue* workQueue)
+    GlobalMap::GlobalMap(osg::Group* root, SceneUtil::WorkQueue* workQueue, const std::string& cachePath)
         : mRoot(root)
         , mWorkQueue(workQueue)
+        , mCachePath(cachePath)
         , mWidth(0)
         , mHeight(0)
         , mMinX(0), mMaxX(0)
@@ -275,8 +382,11 @@ namespace MWRender
         for (CameraVector::iterator it = mActiveCameras.begin(); it != mActiveCameras.end(); ++it)
             removeCamera(*it);
 
-        if (mWorkItem)
-            mWorkItem->waitTillDone();
+        for (WorkItemVector::iterator it = mWorkItems.begin(); it != mWorkItems.end(); ++it)
+        {
+            if (!mWorkQueue->cancelWorkItem(*it))
+                (*it)->waitTillDone();
+        }
     }
 
     void GlobalMap::render ()
@@ -301,8 +411,76 @@ namespace MWRender
         mWidth = mCellSize*(mMaxX-mMinX+1);
         mHeight = mCellSize*(mMaxY-mMinY+1);
 
-        mWorkItem = new CreateMapWorkItem(mWidth, mHeight, mMinX, mMinY, mMaxX, mMaxY, mCellSize, esmStore.get<ESM::Land>());
-        mWorkQueue->addWorkItem(mWorkItem);
+        // The textures are created right away and filled in as the tiles are done,
+        // so the map can be shown before all of it is generated
+        osg::ref_ptr<osg::Image> image = new osg::Image;
+        image->allocateImage(mWidth, mHeight, 1, GL_RGB, GL_UNSIGNED_BYTE);
+        unsigned char water[3];
+        getMapColor(SCHAR_MIN / 128.f, water);
+        for (unsigned int i = 0; i < image->getTotalSizeInBytes(); i += 3)
+            memcpy(image->data() + i, water, 3);
+
+        osg::ref_ptr<osg::Image> alphaImage = new osg::Image;
+        alphaImage->allocateImage(mWidth, mHeight, 1, GL_ALPHA, GL_UNSIGNED_BYTE);
+        memset(alphaImage->data(), 0, alphaImage->getTotalSizeInBytes());
+
+        mBaseTexture = new osg::Texture2D;
+        mBaseTexture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+        mBaseTexture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+        mBaseTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
+        mBaseTexture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
+        mBaseTexture->setImage(image);
+        mBaseTexture->setResizeNonPowerOfTwoHint(false);
+        mBaseTexture->setUnRefImageDataAfterApply(false);
+
+        mAlphaTexture = new osg::Texture2D;
+        mAlphaTexture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+        mAlphaTexture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+        mAlphaTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
+        mAlphaTexture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
+        mAlphaTexture->setImage(alphaImage);
+        mAlphaTexture->setResizeNonPowerOfTwoHint(false);
+        mAlphaTexture->setUnRefImageDataAfterApply(false);
+
+        mOverlayImage = new osg::Image;
+        mOverlayImage->allocateImage(mWidth, mHeight, 1, GL_RGBA, GL_UNSIGNED_BYTE);
+        assert(mOverlayImage->isDataContiguous());
+
+        memset(mOverlayImage->data(), 0, mOverlayImage->getTotalSizeInBytes());
+
+        mOverlayTexture = new osg::Texture2D;
+        mOverlayTexture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
+        mOverlayTexture->setWrap(osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE);
+        mOverlayTexture->setFilter(osg::Texture::MIN_FILTER, osg::Texture::LINEAR);
+        mOverlayTexture->setFilter(osg::Texture::MAG_FILTER, osg::Texture::LINEAR);
+        mOverlayTexture->setResizeNonPowerOfTwoHint(false);
+        mOverlayTexture->setInternalFormat(GL_RGBA);
+        mOverlayTexture->setTextureSize(mWidth, mHeight);
+
+        requestOverlayTextureUpdate(0, 0, mWidth, mHeight, osg::ref_ptr<osg::Texture2D>(), true, false);
+
+        if (!mCachePath.empty())
+        {
+            boost::system::error_code error;
+            boost::filesystem::create_directories(mCachePath, error);
+            if (error)
+            {
+                std::cerr << "Warning: Can't create global map cache directory " << mCachePath << ": " << error.message() << std::endl;
+                mCachePath.clear();
+            }
+        }
+
+        for (int y = getTileStart(mMinY); y <= mMaxY; y += mapTileCells)
+        {
+            for (int x = getTileStart(mMinX); x <= mMaxX; x += mapTileCells)
+            {
+                osg::ref_ptr<CreateMapWorkItem> workItem = new CreateMapWorkItem(std::max(x, mMinX), std::max(y, mMinY),
+                    std::min(x + mapTileCells - 1, mMaxX), std::min(y + mapTileCells - 1, mMaxY), mCellSize,
+                    esmStore.get<ESM::Land>(), mCachePath);
+                mWorkItems.push_back(workItem);
+                mWorkQueue->addWorkItem(workItem);
+            }
+        }
     }
 
     void GlobalMap::worldPosToImageSpace(float x, float z, float& imageX, float& imageY)
@@ -407,8 +585,6 @@ namespace MWRender
 
     void GlobalMap::exploreCell(int cellX, int cellY, osg::ref_ptr<osg::Texture2D> localMapTexture)
     {
-        ensureLoaded();
-
         if (!localMapTexture)
             return;
 
@@ -418,6 +594,9 @@ namespace MWRender
         if (cellX > mMaxX || cellX < mMinX || cellY > mMaxY || cellY < mMinY)
             return;
 
+        // The overlay is masked with the water of the base map, so the cell's tile has to be there
+        ensureTileLoaded(cellX, cellY);
+
         /*
             Start of tes3mp addition
 
@@ -434,8 +613,6 @@ namespace MWRender
 
     void GlobalMap::clear()
     {
-        ensureLoaded();
-
         memset(mOverlayImage->data(), 0, mOverlayImage->getTotalSizeInBytes());
 
         mPendingImageDest.clear();
@@ -447,8 +624,6 @@ namespace MWRender
 
     void GlobalMap::write(ESM::GlobalMap& map)
     {
-        ensureLoaded();
-
         map.mBounds.mMinX = mMinX;
         map.mBounds.mMaxX = mMaxX;
         map.mBounds.mMinY = mMinY;
@@ -587,33 +762,85 @@ namespace MWRender
 
     osg::ref_ptr<osg::Texture2D> GlobalMap::getBaseTexture()
     {
-        ensureLoaded();
         return mBaseTexture;
     }
 
     osg::ref_ptr<osg::Texture2D> GlobalMap::getOverlayTexture()
     {
-        ensureLoaded();
         return mOverlayTexture;
     }
 
     void GlobalMap::ensureLoaded()
     {
-        if (mWorkItem)
+        if (mWorkItems.empty())
+            return;
+
+        for (WorkItemVector::iterator it = mWorkItems.begin(); it != mWorkItems.end(); ++it)
+        {
+            (*it)->waitTillDone();
+            copyTile(**it);
+        }
+
+        mWorkItems.clear();
+
+        mBaseTexture->getImage()->dirty();
+        mAlphaTexture->getImage()->dirty();
+    }
+
+    void GlobalMap::ensureTileLoaded(int cellX, int cellY)
+    {
+        for (WorkItemVector::iterator it = mWorkItems.begin(); it != mWorkItems.end(); ++it)
         {
-            mWorkItem->waitTillDone();
+            if (!(*it)->contains(cellX, cellY))
+                continue;
+
+            // Don't wait for the tile behind whatever else is queued
+            if (mWorkQueue->cancelWorkItem(*it))
+                (*it)->doWork();
+            else
+                (*it)->waitTillDone();
+
+            copyTile(**it);
+            mWorkItems.erase(it);
+
+            mBaseTexture->getImage()->dirty();
+            mAlphaTexture->getImage()->dirty();
+            return;
+        }
+    }
 
-            mOverlayImage = mWorkItem->mOverlayImage;
-            mBaseTexture = mWorkItem->mBaseTexture;
-            mAlphaTexture = mWorkItem->mAlphaTexture;
-            mOverlayTexture = mWorkItem->mOverlayTexture;
+    void GlobalMap::updateTiles()
+    {
+        bool changed = false;
+        for (WorkItemVector::iterator it = mWorkItems.begin(); it != mWorkItems.end();)
+        {
+            if (!(*it)->isDone())
+            {
+                ++it;
+                continue;
+            }
 
-            requestOverlayTextureUpdate(0, 0, mWidth, mHeight, osg::ref_ptr<osg::Texture2D>(), true, false);
+            copyTile(**it);
+            it = mWorkItems.erase(it);
+            changed = true;
+        }
 
-            mWorkItem = NULL;
+        // Uploads the whole texture again, so it's done at most once per frame however many tiles are done
+        if (changed)
+        {
+            mBaseTexture->getImage()->dirty();
+            mAlphaTexture->getImage()->dirty();
         }
     }
 
+    void GlobalMap::copyTile(const CreateMapWorkItem& workItem)
+    {
+        const int x = (workItem.mMinX - mMinX) * mCellSize;
+        const int y = (workItem.mMinY - mMinY) * mCellSize;
+        mBaseTexture->getImage()->copySubImage(x, y, 0, workItem.mImage);
+        mAlphaTexture->getImage()->copySubImage(x, y, 0, workItem.mAlphaImage);
+    }
+
     void GlobalMap::markForRemoval(osg::Camera *camera)
     {
         CameraVector::iterator found = std::find(mActiveCameras.begin(), mActiveCameras.end(), camera);
@@ -628,6 +855,8 @@ namespace MWRender
 
     void GlobalMap::cleanupCameras()
     {
+        updateTiles();
+
         for (CameraVector::iterator it = mCamerasPendingRemoval.begin(); it != mCamerasPendingRemoval.end(); ++it)
             removeCamera(*it);
 
@@ -642,7 +871,6 @@ namespace MWRender
                 continue;
             }
 
-            ensureLoaded();
             mOverlayImage->copySubImage(imageDest.mX, imageDest.mY, 0, imageDest.mImage);
 
             /*
@@ -737,7 +965,9 @@ namespace MWRender
 
         if (cellX > mMaxX || cellX < mMinX || cellY > mMaxY || cellY < mMinY)
             return;
-        
+
+        ensureTileLoaded(cellX, cellY);
+
         osg::ref_ptr<osg::Texture2D> texture(new osg::Texture2D);
         texture->setImage(image);
         texture->setWrap(osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE);
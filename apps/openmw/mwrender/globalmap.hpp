@@ -32,9 +32,12 @@ namespace MWRender
     class GlobalMap
     {
     public:
-        GlobalMap(osg::Group* root, SceneUtil::WorkQueue* workQueue);
+        /// @param cachePath Directory to keep generated map tiles in, or empty to always generate them
+        GlobalMap(osg::Group* root, SceneUtil::WorkQueue* workQueue, const std::string& cachePath);
         ~GlobalMap();
 
+        /// Starts generating the map. Its tiles are generated in parallel on the work queue and
+        /// added to the base texture as they are done.
         void render();
 
         int getWidth() const { return mWidth; }
@@ -82,9 +85,18 @@ namespace MWRender
         osg::ref_ptr<osg::Texture2D> getBaseTexture();
         osg::ref_ptr<osg::Texture2D> getOverlayTexture();
 
+        /// Waits until all tiles of the map are generated
         void ensureLoaded();
 
     private:
+        /// Waits until the tile that contains the cell is generated, generating it right away if it is still queued
+        void ensureTileLoaded(int cellX, int cellY);
+
+        /// Adds the tiles that are done to the base texture
+        void updateTiles();
+
+        void copyTile(const CreateMapWorkItem& workItem);
+
         /**
          * Request rendering a 2d quad onto mOverlayTexture.
          * x, y, width and height are the destination coordinates (top-left coordinate origin)
@@ -132,7 +144,12 @@ namespace MWRender
         osg::ref_ptr<osg::Image> mOverlayImage;
 
         osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
-        osg::ref_ptr<CreateMapWorkItem> mWorkItem;
+
+        // Tiles that are not added to the base texture yet
+        typedef std::vector<osg::ref_ptr<CreateMapWorkItem> > WorkItemVector;
+        WorkItemVector mWorkItems;
+
+        std::string mCachePath;
 
         int mWidth;
         int mHeight;
@@ -373,7 +373,9 @@ namespace MWScript
 
                     MWMechanics::NpcStats& stats = ptr.getClass().getNpcStats (ptr);
 
-                    stats.getSkill (mIndex).setBase (value);
+                    MWMechanics::SkillValue skill = stats.getSkill (mIndex);
+                    skill.setBase (value);
+                    stats.setSkill (mIndex, skill);
                 }
         };
 
@@ -393,9 +395,8 @@ namespace MWScript
                     Interpreter::Type_Integer value = runtime[0].mInteger;
                     runtime.pop();
 
-                    MWMechanics::SkillValue &skill = ptr.getClass()
-                        .getNpcStats(ptr)
-                        .getSkill(mIndex);
+                    MWMechanics::NpcStats& stats = ptr.getClass().getNpcStats(ptr);
+                    MWMechanics::SkillValue skill = stats.getSkill(mIndex);
 
                     if (value == 0)
                         return;
@@ -408,6 +409,8 @@ namespace MWScript
                         skill.setBase(std::max(0, skill.getBase() + value));
                     else
                         skill.setBase(std::min(100, skill.getBase() + value));
+
+                    stats.setSkill(mIndex, skill);
                 }
         };
 
@@ -18,6 +18,7 @@
 
 #include "openal_output.hpp"
 #include "sound_decoder.hpp"
+#include "sound_buffer.hpp"
 #include "sound.hpp"
 #include "soundmanagerimp.hpp"
 #include "loudness.hpp"
@@ -942,52 +943,31 @@ namespace MWSound
     }
 
 
-    std::pair<Sound_Handle, size_t> OpenAL_Output::loadSound(const std::string &fname)
+    std::pair<Sound_Handle, size_t> OpenAL_Output::loadSound(const Sound_Data &sfxdata)
     {
         getALError();
 
-        std::vector<char> data;
         ALenum format = AL_NONE;
-        int srate = 0;
+        if (!sfxdata.mData.empty())
+            format = getALFormat(sfxdata.mChannels, sfxdata.mType);
 
-        try
-        {
-            DecoderPtr decoder = mManager.getDecoder();
-            // Workaround: Bethesda at some point converted some of the files to mp3, but the references were kept as .wav.
-            if (decoder->mResourceMgr->exists(fname))
-                decoder->open(fname);
-            else
-            {
-                std::string file = fname;
-                std::string::size_type pos = file.rfind('.');
-                if (pos != std::string::npos)
-                    file = file.substr(0, pos) + ".mp3";
-                decoder->open(file);
-            }
-
-            ChannelConfig chans;
-            SampleType type;
-            decoder->getInfo(&srate, &chans, &type);
-            format = getALFormat(chans, type);
-            if (format) decoder->readAll(data);
-        }
-        catch (std::exception &e)
-        {
-            Log(Debug::Error) << "Failed to load audio from " << fname << ": " << e.what();
-        }
+        const std::vector<char> *data = &sfxdata.mData;
+        int srate = sfxdata.mSampleRate;
 
-        if (data.empty())
+        std::vector<char> silence;
+        if (!format)
         {
             // If we failed to get any usable audio, substitute with silence.
             format = AL_FORMAT_MONO8;
             srate = 8000;
-            data.assign(8000, -128);
+            silence.assign(8000, -128);
+            data = &silence;
         }
 
         ALint size;
         ALuint buf = 0;
         alGenBuffers(1, &buf);
-        alBufferData(buf, format, data.data(), data.size(), srate);
+        alBufferData(buf, format, data->data(), data->size(), srate);
         alGetBufferi(buf, AL_SIZE, &size);
         if (getALError() != AL_NO_ERROR)
         {
@@ -1,12 +1,28 @@
 #ifndef GAME_SOUND_SOUND_BUFFER_H
 #define GAME_SOUND_SOUND_BUFFER_H
 
+#include <list>
 #include <string>
+#include <vector>
 
 #include "sound_output.hpp"
+#include "sound_decoder.hpp"
 
 namespace MWSound
 {
+    // Raw audio decoded from a sound file, ready to be handed over to the output
+    struct Sound_Data
+    {
+        std::vector<char> mData;
+        int mSampleRate;
+        ChannelConfig mChannels;
+        SampleType mType;
+
+        Sound_Data()
+          : mSampleRate(0), mChannels(ChannelConfig_Mono), mType(SampleType_UInt8)
+        { }
+    };
+
     class Sound_Buffer
     {
     public:
@@ -19,8 +35,13 @@ namespace MWSound
 
         size_t mUses;
 
+        // Position in the manager's unused buffer list, only valid while mIsUnused is set
+        std::list<Sound_Buffer*>::iterator mUnusedIter;
+        bool mIsUnused;
+
         Sound_Buffer(std::string resname, float volume, float mindist, float maxdist)
           : mResourceName(resname), mVolume(volume), mMinDist(mindist), mMaxDist(maxdist), mHandle(0), mUses(0)
+          , mIsUnused(false)
         { }
     };
 }
@@ -13,6 +13,7 @@ namespace MWSound
     struct Sound_Decoder;
     class Sound;
     class Stream;
+    struct Sound_Data;
 
     // An opaque handle for the implementation's sound buffers.
     typedef void *Sound_Handle;
@@ -36,7 +37,7 @@ namespace MWSound
         virtual std::vector<std::string> enumerateHrtf() = 0;
         virtual void setHrtf(const std::string &hrtfname, HrtfMode hrtfmode) = 0;
 
-        virtual std::pair<Sound_Handle, size_t> loadSound(const std::string &fname) = 0;
+        virtual std::pair<Sound_Handle, size_t> loadSound(const Sound_Data &data) = 0;
         virtual size_t unloadSound(Sound_Handle data) = 0;
 
         virtual bool playSound(Sound *sound, Sound_Handle data, float offset) = 0;
@@ -9,6 +9,7 @@
 #include <components/misc/rng.hpp>
 #include <components/debug/debuglog.hpp>
 #include <components/vfs/manager.hpp>
+#include <components/sceneutil/workqueue.hpp>
 
 #include "../mwbase/environment.hpp"
 #include "../mwbase/world.hpp"
@@ -33,6 +34,51 @@ namespace MWSound
     // For combining PlayMode and Type flags
     inline int operator|(PlayMode a, Type b) { return static_cast<int>(a) | static_cast<int>(b); }
 
+    /// Worker thread item: decode a sound file into memory. The result is uploaded
+    /// to the output by the main thread once the item is done.
+    class DecodeSoundWorkItem : public SceneUtil::WorkItem
+    {
+    public:
+        DecodeSoundWorkItem(DecoderPtr decoder, const std::string &fname)
+            : mDecoder(decoder)
+            , mFileName(fname)
+        {
+        }
+
+        virtual void doWork()
+        {
+            try
+            {
+                // Workaround: Bethesda at some point converted some of the files to mp3, but the references were kept as .wav.
+                if (mDecoder->mResourceMgr->exists(mFileName))
+                    mDecoder->open(mFileName);
+                else
+                {
+                    std::string file = mFileName;
+                    std::string::size_type pos = file.rfind('.');
+                    if (pos != std::string::npos)
+                        file = file.substr(0, pos) + ".mp3";
+                    mDecoder->open(file);
+                }
+
+                mDecoder->getInfo(&mData.mSampleRate, &mData.mChannels, &mData.mType);
+                mDecoder->readAll(mData.mData);
+            }
+            catch (std::exception &e)
+            {
+                Log(Debug::Error) << "Failed to load audio from " << mFileName << ": " << e.what();
+                mData.mData.clear();
+            }
+            mDecoder.reset();
+        }
+
+        Sound_Data mData;
+
+    private:
+        DecoderPtr mDecoder;
+        std::string mFileName;
+    };
+
     SoundManager::SoundManager(const VFS::Manager* vfs, bool useSound)
         : mVFS(vfs)
         , mOutput(new DEFAULT_OUTPUT(*this))
@@ -77,6 +123,8 @@ namespace MWSound
         mBufferCacheMax *= 1024 * 1024;
         mBufferCacheMin = std::min(mBufferCacheMin * 1024 * 1024, mBufferCacheMax);
 
+        int decodeThreads = std::max(Settings::Manager::getInt("buffer decode threads", "Sound"), 1);
+
         if (!useSound)
         {
             Log(Debug::Info) << "Sound disabled.";
@@ -105,6 +153,8 @@ namespace MWSound
         Log(Debug::Info) << stream.str();
         stream.str("");
 
+        mDecodeQueue = new SceneUtil::WorkQueue(decodeThreads);
+
         names = mOutput->enumerateHrtf();
         if (!names.empty())
         {
@@ -119,6 +169,9 @@ namespace MWSound
     SoundManager::~SoundManager()
     {
         clear();
+        // Joins the decoding threads, so no job is left referencing a buffer
+        mDecodeQueue = nullptr;
+        mLoadingBuffers.clear();
         for (Sound_Buffer &sfx : *mSoundBuffers)
         {
             if (sfx.mHandle)
@@ -168,15 +221,12 @@ namespace MWSound
     }
 
     // Lookup a soundId for its sound data (resource name, local volume,
-    // minRange, and maxRange)
+    // minRange, and maxRange). The buffer may still be loading.
     Sound_Buffer *SoundManager::lookupSound(const std::string &soundId) const
     {
         NameBufferMap::const_iterator snd = mBufferNameMap.find(soundId);
         if (snd != mBufferNameMap.end())
-        {
-            Sound_Buffer *sfx = snd->second;
-            if (sfx->mHandle) return sfx;
-        }
+            return snd->second;
         return nullptr;
     }
 
@@ -212,34 +262,131 @@ namespace MWSound
 #undef LIKELY
 #undef UNLIKELY
 
-        if (!sfx->mHandle)
+        if (!sfx->mHandle && mLoadingBuffers.find(sfx) == mLoadingBuffers.end())
         {
+            osg::ref_ptr<DecodeSoundWorkItem> item = new DecodeSoundWorkItem(getDecoder(), sfx->mResourceName);
+            mDecodeQueue->addWorkItem(item);
+            mLoadingBuffers.insert(std::make_pair(sfx, item));
+        }
+
+        return sfx;
+    }
+
+    // Upload buffers that have finished decoding, start the sounds that were waiting
+    // for them, and purge old buffers if the cache got too big.
+    void SoundManager::updateLoadingBuffers()
+    {
+        bool finished = false;
+        LoadingBufferMap::iterator it = mLoadingBuffers.begin();
+        while (it != mLoadingBuffers.end())
+        {
+            if (!it->second->isDone())
+            {
+                ++it;
+                continue;
+            }
+
+            Sound_Buffer *sfx = it->first;
             size_t size;
-            std::tie(sfx->mHandle, size) = mOutput->loadSound(sfx->mResourceName);
-            if (!sfx->mHandle) return nullptr;
+            std::tie(sfx->mHandle, size) = mOutput->loadSound(it->second->mData);
+            it = mLoadingBuffers.erase(it);
+            finished = true;
+            if (!sfx->mHandle)
+                continue;
 
             mBufferCacheSize += size;
-            if (mBufferCacheSize > mBufferCacheMax)
+            if (sfx->mUses == 0)
             {
-                do {
-                    if (mUnusedBuffers.empty())
-                    {
-                        Log(Debug::Warning) << "No unused sound buffers to free, using " << mBufferCacheSize << " bytes!";
-                        break;
-                    }
-                    Sound_Buffer *unused = mUnusedBuffers.back();
+                sfx->mUnusedIter = mUnusedBuffers.insert(mUnusedBuffers.begin(), sfx);
+                sfx->mIsUnused = true;
+            }
+        }
 
-                    size = mOutput->unloadSound(unused->mHandle);
-                    mBufferCacheSize -= size;
-                    unused->mHandle = 0;
+        if (!finished)
+            return;
 
-                    mUnusedBuffers.pop_back();
-                } while (mBufferCacheSize > mBufferCacheMin);
+        PendingSoundMap::iterator pending = mPendingSounds.begin();
+        while (pending != mPendingSounds.end())
+        {
+            Sound *sound = pending->first;
+            Sound_Buffer *sfx = pending->second.first;
+            if (sfx->mHandle)
+            {
+                float offset = pending->second.second;
+                pending = mPendingSounds.erase(pending);
+                // If this fails, the sound is no longer playing and gets cleaned up with the finished ones
+                if (sound->getIs3D())
+                    mOutput->playSound3D(sound, sfx->mHandle, offset);
+                else
+                    mOutput->playSound(sound, sfx->mHandle, offset);
             }
-            mUnusedBuffers.push_front(sfx);
+            else if (mLoadingBuffers.find(sfx) == mLoadingBuffers.end())
+                pending = mPendingSounds.erase(pending);
+            else
+                ++pending;
         }
 
-        return sfx;
+        if (mBufferCacheSize > mBufferCacheMax)
+        {
+            do {
+                if (mUnusedBuffers.empty())
+                {
+                    Log(Debug::Warning) << "No unused sound buffers to free, using " << mBufferCacheSize << " bytes!";
+                    break;
+                }
+                Sound_Buffer *unused = mUnusedBuffers.back();
+
+                mBufferCacheSize -= mOutput->unloadSound(unused->mHandle);
+                unused->mHandle = 0;
+                unused->mIsUnused = false;
+
+                mUnusedBuffers.pop_back();
+            } while (mBufferCacheSize > mBufferCacheMin);
+        }
+    }
+
+    void SoundManager::useBuffer(Sound_Buffer *sfx)
+    {
+        if (sfx->mUses++ == 0 && sfx->mIsUnused)
+        {
+            mUnusedBuffers.erase(sfx->mUnusedIter);
+            sfx->mIsUnused = false;
+        }
+    }
+
+    void SoundManager::releaseBuffer(Sound_Buffer *sfx)
+    {
+        if (sfx->mUses-- == 1 && sfx->mHandle)
+        {
+            sfx->mUnusedIter = mUnusedBuffers.insert(mUnusedBuffers.begin(), sfx);
+            sfx->mIsUnused = true;
+        }
+    }
+
+    bool SoundManager::startSound(Sound *sound, Sound_Buffer *sfx, float offset)
+    {
+        if (!sfx->mHandle)
+        {
+            mPendingSounds[sound] = std::make_pair(sfx, offset);
+            return true;
+        }
+
+        if (sound->getIs3D())
+            return mOutput->playSound3D(sound, sfx->mHandle, offset);
+        return mOutput->playSound(sound, sfx->mHandle, offset);
+    }
+
+    void SoundManager::finishSound(Sound *sound)
+    {
+        mPendingSounds.erase(sound);
+        mOutput->finishSound(sound);
+    }
+
+    bool SoundManager::isSoundPlaying(Sound *sound) const
+    {
+        if (mPendingSounds.find(sound) != mPendingSounds.end())
+            return true;
+        return mOutput->isSoundPlaying(sound);
     }
 
     DecoderPtr SoundManager::loadVoice(const std::string &voicefile)
@@ -654,18 +801,13 @@ namespace MWSound
 
         Sound *sound = getSoundRef();
         sound->init(volume * sfx->mVolume, volumeFromType(type), pitch, mode | type | Play_2D);
-        if (!mOutput->playSound(sound, sfx->mHandle, offset))
+        if (!startSound(sound, sfx, offset))
         {
             mUnusedSounds.push_back(sound);
             return nullptr;
         }
 
-        if (sfx->mUses++ == 0)
-        {
-            SoundList::iterator iter = std::find(mUnusedBuffers.begin(), mUnusedBuffers.end(), sfx);
-            if (iter != mUnusedBuffers.end())
-                mUnusedBuffers.erase(iter);
-        }
+        useBuffer(sfx);
         mActiveSounds[MWWorld::ConstPtr()].push_back(std::make_pair(sound, sfx));
         return sound;
     }
@@ -693,13 +835,13 @@ namespace MWSound
         if (!(mode&PlayMode::NoPlayerLocal) && ptr == MWMechanics::getPlayer())
         {
             sound->init(volume * sfx->mVolume, volumeFromType(type), pitch, mode | type | Play_2D);
-            played = mOutput->playSound(sound, sfx->mHandle, offset);
+            played = startSound(sound, sfx, offset);
         }
         else
         {
             sound->init(objpos, volume * sfx->mVolume, volumeFromType(type), pitch,
                 sfx->mMinDist, sfx->mMaxDist, mode | type | Play_3D);
-            played = mOutput->playSound3D(sound, sfx->mHandle, offset);
+            played = startSound(sound, sfx, offset);
         }
         if (!played)
         {
@@ -707,12 +849,7 @@ namespace MWSound
             return nullptr;
         }
 
-        if (sfx->mUses++ == 0)
-        {
-            SoundList::iterator iter = std::find(mUnusedBuffers.begin(), mUnusedBuffers.end(), sfx);
-            if (iter != mUnusedBuffers.end())
-                mUnusedBuffers.erase(iter);
-        }
+        useBuffer(sfx);
         mActiveSounds[ptr].push_back(std::make_pair(sound, sfx));
         return sound;
     }
@@ -731,18 +868,13 @@ namespace MWSound
         Sound *sound = getSoundRef();
         sound->init(initialPos, volume * sfx->mVolume, volumeFromType(type), pitch,
             sfx->mMinDist, sfx->mMaxDist, mode | type | Play_3D);
-        if (!mOutput->playSound3D(sound, sfx->mHandle, offset))
+        if (!startSound(sound, sfx, offset))
         {
             mUnusedSounds.push_back(sound);
             return nullptr;
         }
 
-        if (sfx->mUses++ == 0)
-        {
-            SoundList::iterator iter = std::find(mUnusedBuffers.begin(), mUnusedBuffers.end(), sfx);
-            if (iter != mUnusedBuffers.end())
-                mUnusedBuffers.erase(iter);
-        }
+        useBuffer(sfx);
         mActiveSounds[MWWorld::ConstPtr()].push_back(std::make_pair(sound, sfx));
         return sound;
     }
@@ -750,7 +882,15 @@ namespace MWSound
     void SoundManager::stopSound(Sound *sound)
     {
         if (sound)
-            mOutput->finishSound(sound);
+            finishSound(sound);
+    }
+
+    void SoundManager::preloadSound(const std::string& soundId)
+    {
+        if (!mOutput->isInitialized())
+            return;
+
+        loadSound(Misc::StringUtils::lowerCase(soundId));
     }
 
     void SoundManager::stopSound(Sound_Buffer *sfx, const MWWorld::ConstPtr &ptr)
@@ -761,7 +901,7 @@ namespace MWSound
             for (SoundBufferRefPair &snd : snditer->second)
             {
                 if (snd.second == sfx)
-                    mOutput->finishSound(snd.first);
+                    finishSound(snd.first);
             }
         }
     }
@@ -771,7 +911,7 @@ namespace MWSound
         if (!mOutput->isInitialized())
             return;
 
-        Sound_Buffer *sfx = loadSound(Misc::StringUtils::lowerCase(soundId));
+        Sound_Buffer *sfx = lookupSound(Misc::StringUtils::lowerCase(soundId));
         if (!sfx) return;
 
         stopSound(sfx, MWWorld::ConstPtr());
@@ -782,7 +922,7 @@ namespace MWSound
         if (!mOutput->isInitialized())
             return;
 
-        Sound_Buffer *sfx = loadSound(Misc::StringUtils::lowerCase(soundId));
+        Sound_Buffer *sfx = lookupSound(Misc::StringUtils::lowerCase(soundId));
         if (!sfx) return;
 
         stopSound(sfx, ptr);
@@ -794,7 +934,7 @@ namespace MWSound
         if (snditer != mActiveSounds.end())
         {
             for (SoundBufferRefPair &snd : snditer->second)
-                mOutput->finishSound(snd.first);
+                finishSound(snd.first);
         }
         SaySoundMap::iterator sayiter = mSaySoundsQueue.find(ptr);
         if (sayiter != mSaySoundsQueue.end())
@@ -811,7 +951,7 @@ namespace MWSound
             if (!snd.first.isEmpty() && snd.first != MWMechanics::getPlayer() && snd.first.getCell() == cell)
             {
                 for (SoundBufferRefPair &sndbuf : snd.second)
-                    mOutput->finishSound(sndbuf.first);
+                    finishSound(sndbuf.first);
             }
         }
 
@@ -834,7 +974,7 @@ namespace MWSound
         SoundMap::iterator snditer = mActiveSounds.find(ptr);
         if (snditer != mActiveSounds.end())
         {
-            Sound_Buffer *sfx = loadSound(Misc::StringUtils::lowerCase(soundId));
+            Sound_Buffer *sfx = lookupSound(Misc::StringUtils::lowerCase(soundId));
             for (SoundBufferRefPair &sndbuf : snditer->second)
             {
                 if (sndbuf.second == sfx)
@@ -851,7 +991,7 @@ namespace MWSound
             Sound_Buffer *sfx = lookupSound(Misc::StringUtils::lowerCase(soundId));
             return std::find_if(snditer->second.cbegin(), snditer->second.cend(),
                 [this, sfx](const SoundBufferRefPair &snd) -> bool
-            { return snd.second == sfx && mOutput->isSoundPlaying(snd.first); }
+            { return snd.second == sfx && isSoundPlaying(snd.first); }
             ) != snditer->second.cend();
         }
         return false;
@@ -988,7 +1128,7 @@ namespace MWSound
         {
             if (volume == 0.0f)
             {
-                mOutput->finishSound(mNearWaterSound);
+                finishSound(mNearWaterSound);
                 mNearWaterSound = nullptr;
             }
             else
@@ -1014,7 +1154,7 @@ namespace MWSound
 
                 if (soundIdChanged)
                 {
-                    mOutput->finishSound(mNearWaterSound);
+                    finishSound(mNearWaterSound);
                     mNearWaterSound = playSound(soundId, volume, 1.0f, Type::Sfx, PlayMode::Loop);
                 }
                 else if (sfx)
@@ -1056,7 +1196,7 @@ namespace MWSound
             env = Env_Underwater;
         else if (mUnderwaterSound)
         {
-            mOutput->finishSound(mUnderwaterSound);
+            finishSound(mUnderwaterSound);
             mUnderwaterSound = nullptr;
         }
 
@@ -1070,6 +1210,8 @@ namespace MWSound
 
         updateMusic(duration);
 
+        updateLoadingBuffers();
+
         // Check if any sounds are finished playing, and trash them
         SoundMap::iterator snditer = mActiveSounds.begin();
         while (snditer != mActiveSounds.end())
@@ -1091,20 +1233,19 @@ namespace MWSound
                     if (sound->getDistanceCull())
                     {
                         if ((mListenerPos - objpos).length2() > 2000 * 2000)
-                            mOutput->finishSound(sound);
+                            finishSound(sound);
                     }
                 }
 
-                if (!mOutput->isSoundPlaying(sound))
+                if (!isSoundPlaying(sound))
                 {
-                    mOutput->finishSound(sound);
+                    finishSound(sound);
                     mUnusedSounds.push_back(sound);
                     if (sound == mUnderwaterSound)
                         mUnderwaterSound = nullptr;
                     if (sound == mNearWaterSound)
                         mNearWaterSound = nullptr;
-                    if (sfx->mUses-- == 1)
-                        mUnusedBuffers.push_front(sfx);
+                    releaseBuffer(sfx);
                     sndidx = snditer->second.erase(sndidx);
                 }
                 else
@@ -1368,11 +1509,10 @@ namespace MWSound
         {
             for (SoundBufferRefPair &sndbuf : snd.second)
             {
-                mOutput->finishSound(sndbuf.first);
+                finishSound(sndbuf.first);
                 mUnusedSounds.push_back(sndbuf.first);
                 Sound_Buffer *sfx = sndbuf.second;
-                if (sfx->mUses-- == 1)
-                    mUnusedBuffers.push_front(sfx);
+                releaseBuffer(sfx);
             }
         }
         mActiveSounds.clear();
@@ -5,9 +5,12 @@
 #include <string>
 #include <utility>
 #include <deque>
+#include <list>
 #include <map>
 #include <unordered_map>
 
+#include <osg/ref_ptr>
+
 #include <components/settings/settings.hpp>
 
 #include <components/fallback/fallback.hpp>
@@ -24,6 +27,11 @@ namespace ESM
     struct Sound;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace MWSound
 {
     class Sound_Output;
@@ -31,6 +39,7 @@ namespace MWSound
     class Sound;
     class Stream;
     class Sound_Buffer;
+    class DecodeSoundWorkItem;
 
     enum Environment {
         Env_Normal,
@@ -77,10 +86,22 @@ namespace MWSound
         typedef std::unordered_map<std::string, Sound_Buffer*> NameBufferMap;
         NameBufferMap mBufferNameMap;
 
-        // NOTE: unused buffers are stored in front-newest order.
-        typedef std::deque<Sound_Buffer*> SoundList;
+        // NOTE: unused buffers are stored in front-newest order. Each buffer keeps
+        // its own position in the list, so it can be taken out in constant time.
+        typedef std::list<Sound_Buffer*> SoundList;
         SoundList mUnusedBuffers;
 
+        // Background threads decoding sound files for buffers that aren't loaded yet
+        osg::ref_ptr<SceneUtil::WorkQueue> mDecodeQueue;
+
+        typedef std::unordered_map<Sound_Buffer*, osg::ref_ptr<DecodeSoundWorkItem> > LoadingBufferMap;
+        LoadingBufferMap mLoadingBuffers;
+
+        // Sounds waiting for their buffer to finish decoding, with the offset to start playback at
+        typedef std::pair<Sound_Buffer*, float> PendingSound;
+        typedef std::unordered_map<Sound*, PendingSound> PendingSoundMap;
+        PendingSoundMap mPendingSounds;
+
         std::unique_ptr<std::deque<Sound>> mSounds;
         std::vector<Sound*> mUnusedSounds;
 
@@ -116,6 +137,17 @@ namespace MWSound
 
         Sound_Buffer *lookupSound(const std::string &soundId) const;
         Sound_Buffer *loadSound(const std::string &soundId);
+        ///< Lookup the buffer for \a soundId, and start decoding it in the background
+        /// if it isn't loaded yet. Check mHandle to see if it's ready for playback.
+
+        void useBuffer(Sound_Buffer *sfx);
+        void releaseBuffer(Sound_Buffer *sfx);
+
+        bool startSound(Sound *sound, Sound_Buffer *sfx, float offset);
+        ///< Start playing \a sound, or defer it until \a sfx has finished loading.
+
+        void finishSound(Sound *sound);
+        bool isSoundPlaying(Sound *sound) const;
 
         // returns a decoder to start streaming, or nullptr if the sound was not found
         DecoderPtr loadVoice(const std::string &voicefile);
@@ -129,6 +161,7 @@ namespace MWSound
         void advanceMusic(const std::string& filename);
         void startRandomTitle();
 
+        void updateLoadingBuffers();
         void updateSounds(float duration);
         void updateRegionSound(float duration);
         void updateWaterSound(float duration);
@@ -223,6 +256,9 @@ namespace MWSound
         ///< Stop the given sound from playing
         /// @note no-op if \a sound is null
 
+        virtual void preloadSound(const std::string& soundId);
+        ///< Start decoding the given sound in the background, so it's ready once it's played.
+
         virtual void stopSound3D(const MWWorld::ConstPtr &reference, const std::string& soundId);
         ///< Stop the given object from playing the given sound,
 
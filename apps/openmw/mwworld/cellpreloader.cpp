@@ -1,6 +1,10 @@
 #include "cellpreloader.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <map>
+#include <set>
 
 #include <components/resource/scenemanager.hpp>
 #include <components/resource/resourcesystem.hpp>
@@ -14,18 +18,35 @@
 #include <components/sceneutil/unrefqueue.hpp>
 #include <components/esm/loadcell.hpp>
 
+#include <osg/Stats>
+
 #include "../mwbase/environment.hpp"
 #include "../mwbase/world.hpp"
+#include "../mwbase/soundmanager.hpp"
 
 #include "../mwrender/landmanager.hpp"
 
 #include "cellstore.hpp"
 #include "manualref.hpp"
+#include "esmstore.hpp"
 #include "class.hpp"
 
 namespace MWWorld
 {
 
+    namespace
+    {
+        float getPreloadPriority(PreloadLane lane, float distance)
+        {
+            // Lanes are spaced further apart than any preload distance, so a lower lane always wins.
+            // Every lane stays above 0, the default priority of other work items (e.g. global map tiles),
+            // so preloading is never starved by them.
+            static const float laneSpacing = 1e6f;
+            static const int numLanes = static_cast<int>(PreloadLane::FastTravel) + 1;
+            return (numLanes - static_cast<int>(lane)) * laneSpacing - std::min(std::max(distance, 0.f), laneSpacing - 1.f);
+        }
+    }
+
     struct ListModelsVisitor
     {
         ListModelsVisitor(std::vector<std::string>& out)
@@ -43,29 +64,145 @@ namespace MWWorld
         std::vector<std::string>& mOut;
     };
 
+    struct ListSoundsVisitor
+    {
+        ListSoundsVisitor(std::set<std::string>& out, std::set<std::string>& creatures)
+            : mOut(out)
+            , mCreatures(creatures)
+        {
+        }
+
+        virtual bool operator()(const MWWorld::Ptr& ptr)
+        {
+            const std::string& type = ptr.getTypeName();
+            if (type == typeid(ESM::Light).name())
+            {
+                const std::string& sound = ptr.get<ESM::Light>()->mBase->mSound;
+                if (!sound.empty())
+                    mOut.insert(Misc::StringUtils::lowerCase(sound));
+            }
+            else if (type == typeid(ESM::Door).name())
+            {
+                const ESM::Door* door = ptr.get<ESM::Door>()->mBase;
+                if (!door->mOpenSound.empty())
+                    mOut.insert(Misc::StringUtils::lowerCase(door->mOpenSound));
+                if (!door->mCloseSound.empty())
+                    mOut.insert(Misc::StringUtils::lowerCase(door->mCloseSound));
+            }
+            else if (type == typeid(ESM::Creature).name())
+            {
+                const ESM::Creature* creature = ptr.get<ESM::Creature>()->mBase;
+                mCreatures.insert(Misc::StringUtils::lowerCase(creature->mOriginal.empty() ? creature->mId : creature->mOriginal));
+            }
+
+            return true;
+        }
+
+        std::set<std::string>& mOut;
+        std::set<std::string>& mCreatures;
+    };
+
+    /// Worker thread item: preload one of the models in a cell.
+    class PreloadModelItem : public SceneUtil::WorkItem
+    {
+    public:
+        /// @param numInstances How many instances to preload, if instances are preloaded at all
+        /// @param abort The abort flag of the cell's PreloadItem, which outlives this item's work
+        PreloadModelItem(const std::string& mesh, unsigned int numInstances, Resource::SceneManager* sceneManager, Resource::BulletShapeManager* bulletShapeManager, Resource::KeyframeManager* keyframeManager, bool preloadInstances, const std::atomic<bool>& abort)
+            : mMesh(mesh)
+            , mNumInstances(numInstances)
+            , mSceneManager(sceneManager)
+            , mBulletShapeManager(bulletShapeManager)
+            , mKeyframeManager(keyframeManager)
+            , mPreloadInstances(preloadInstances)
+            , mAbort(abort)
+        {
+        }
+
+        virtual void doWork()
+        {
+            if (mAbort)
+                return;
+
+            try
+            {
+                std::string mesh  = mMesh;
+                mesh = Misc::ResourceHelpers::correctActorModelPath(mesh, mSceneManager->getVFS());
+
+                if (mPreloadInstances)
+                {
+                    for (unsigned int i = 0; i < mNumInstances && !mAbort; ++i)
+                    {
+                        mPreloadedObjects.push_back(mSceneManager->cacheInstance(mesh));
+                        mPreloadedObjects.push_back(mBulletShapeManager->cacheInstance(mesh));
+                    }
+                }
+                else
+                {
+                    mPreloadedObjects.push_back(mSceneManager->getTemplate(mesh));
+                    mPreloadedObjects.push_back(mBulletShapeManager->getShape(mesh));
+                }
+
+                size_t slashpos = mesh.find_last_of("/\\");
+                if (slashpos != std::string::npos && slashpos != mesh.size()-1)
+                {
+                    Misc::StringUtils::lowerCaseInPlace(mesh);
+                    if (mesh[slashpos+1] == 'x')
+                    {
+                        std::string kfname = mesh;
+                        if(kfname.size() > 4 && kfname.compare(kfname.size()-4, 4, ".nif") == 0)
+                        {
+                            kfname.replace(kfname.size()-4, 4, ".kf");
+                            mPreloadedObjects.push_back(mKeyframeManager->get(kfname));
+                        }
+
+                    }
+                }
+            }
+            catch (std::exception& e)
+            {
+                // ignore error for now, would spam the log too much
+                // error will be shown when visiting the cell
+            }
+        }
+
+    private:
+        std::string mMesh;
+        unsigned int mNumInstances;
+        Resource::SceneManager* mSceneManager;
+        Resource::BulletShapeManager* mBulletShapeManager;
+        Resource::KeyframeManager* mKeyframeManager;
+        bool mPreloadInstances;
+        const std::atomic<bool>& mAbort;
+
+        // keep a ref to the loaded objects to make sure it stays loaded as long as the cell is in the preloaded state
+        std::vector<osg::ref_ptr<const osg::Object> > mPreloadedObjects;
+    };
+
     /// Worker thread item: preload models in a cell.
     class PreloadItem : public SceneUtil::WorkItem
     {
     public:
         /// Constructor to be called from the main thread.
-        PreloadItem(MWWorld::CellStore* cell, Resource::SceneManager* sceneManager, Resource::BulletShapeManager* bulletShapeManager, Resource::KeyframeManager* keyframeManager, Terrain::World* terrain, MWRender::LandManager* landManager, bool preloadInstances)
+        PreloadItem(MWWorld::CellStore* cell, Resource::SceneManager* sceneManager, Resource::BulletShapeManager* bulletShapeManager, Resource::KeyframeManager* keyframeManager, Terrain::World* terrain, MWRender::LandManager* landManager, bool preloadInstances, SceneUtil::WorkQueue* workQueue)
             : mIsExterior(cell->getCell()->isExterior())
             , mX(cell->getCell()->getGridX())
             , mY(cell->getCell()->getGridY())
-            , mSceneManager(sceneManager)
-            , mBulletShapeManager(bulletShapeManager)
-            , mKeyframeManager(keyframeManager)
             , mTerrain(terrain)
             , mLandManager(landManager)
-            , mPreloadInstances(preloadInstances)
+            , mWorkQueue(workQueue)
             , mAbort(false)
         {
             mTerrainView = mTerrain->createView();
 
-            ListModelsVisitor visitor (mMeshes);
+            std::vector<std::string> meshes;
+            std::set<std::string> creatures;
+            ListModelsVisitor visitor (meshes);
+            ListSoundsVisitor soundVisitor (mSounds, creatures);
             if (cell->getState() == MWWorld::CellStore::State_Loaded)
             {
                 cell->forEach(visitor);
+                cell->forEach(soundVisitor);
             }
             else
             {
@@ -77,9 +214,33 @@ namespace MWWorld
                     MWWorld::ManualRef ref(MWBase::Environment::get().getWorld()->getStore(), *it);
                     std::string model = ref.getPtr().getClass().getModel(ref.getPtr());
                     if (!model.empty())
-                        mMeshes.push_back(model);
+                        meshes.push_back(model);
+                    soundVisitor(ref.getPtr());
                 }
             }
+
+            if (!creatures.empty())
+            {
+                const MWWorld::Store<ESM::SoundGenerator>& soundGens = MWBase::Environment::get().getWorld()->getStore().get<ESM::SoundGenerator>();
+                for (const ESM::SoundGenerator& soundGen : soundGens)
+                {
+                    if (!soundGen.mCreature.empty() && creatures.count(Misc::StringUtils::lowerCase(soundGen.mCreature)))
+                        mSounds.insert(Misc::StringUtils::lowerCase(soundGen.mSound));
+                }
+            }
+
+            // One item per model, so that several threads can work on the models of a cell
+            std::map<std::string, unsigned int> numInstances;
+            for (const std::string& mesh : meshes)
+                ++numInstances[mesh];
+            for (const auto& mesh : numInstances)
+                mModelItems.push_back(new PreloadModelItem(mesh.first, mesh.second, sceneManager, bulletShapeManager, keyframeManager, preloadInstances, mAbort));
+        }
+
+        /// Sound IDs used by objects in the cell. To be decoded by the sound manager, not in this work item.
+        const std::set<std::string>& getSounds() const
+        {
+            return mSounds;
         }
 
         virtual void abort()
@@ -102,65 +263,41 @@ namespace MWWorld
                 }
             }
 
-            for (MeshList::const_iterator it = mMeshes.begin(); it != mMeshes.end(); ++it)
-            {
-                if (mAbort)
-                    break;
-
-                try
-                {
-                    std::string mesh  = *it;
-                    mesh = Misc::ResourceHelpers::correctActorModelPath(mesh, mSceneManager->getVFS());
-
-                    if (mPreloadInstances)
-                    {
-                        mPreloadedObjects.push_back(mSceneManager->cacheInstance(mesh));
-                        mPreloadedObjects.push_back(mBulletShapeManager->cacheInstance(mesh));
-                    }
-                    else
-                    {
-                        mPreloadedObjects.push_back(mSceneManager->getTemplate(mesh));
-                        mPreloadedObjects.push_back(mBulletShapeManager->getShape(mesh));
-                    }
+            if (mAbort)
+                return;
 
-                    size_t slashpos = mesh.find_last_of("/\\");
-                    if (slashpos != std::string::npos && slashpos != mesh.size()-1)
-                    {
-                        Misc::StringUtils::lowerCaseInPlace(mesh);
-                        if (mesh[slashpos+1] == 'x')
-                        {
-                            std::string kfname = mesh;
-                            if(kfname.size() > 4 && kfname.compare(kfname.size()-4, 4, ".nif") == 0)
-                            {
-                                kfname.replace(kfname.size()-4, 4, ".kf");
-                                mPreloadedObjects.push_back(mKeyframeManager->get(kfname));
-                            }
+            // Idle threads pick up the models, so they get the cell's priority
+            for (const osg::ref_ptr<PreloadModelItem>& item : mModelItems)
+            {
+                item->setPriority(getPriority());
+                mWorkQueue->addWorkItem(item);
+            }
 
-                        }
-                    }
-                }
-                catch (std::exception& e)
-                {
-                    // ignore error for now, would spam the log too much
-                    // error will be shown when visiting the cell
-                }
+            // This thread works on the models that nobody has taken yet, rather than only waiting for the others.
+            // Other cells that need the same models wait for them in the resource managers instead of loading them again.
+            for (const osg::ref_ptr<PreloadModelItem>& item : mModelItems)
+            {
+                if (mWorkQueue->cancelWorkItem(item))
+                    item->doWork();
             }
+
+            // The model items refer to mAbort, so they must not run past this item's work
+            for (const osg::ref_ptr<PreloadModelItem>& item : mModelItems)
+                item->waitTillDone();
         }
 
     private:
-        typedef std::vector<std::string> MeshList;
         bool mIsExterior;
         int mX;
         int mY;
-        MeshList mMeshes;
-        Resource::SceneManager* mSceneManager;
-        Resource::BulletShapeManager* mBulletShapeManager;
-        Resource::KeyframeManager* mKeyframeManager;
+        std::set<std::string> mSounds;
         Terrain::World* mTerrain;
         MWRender::LandManager* mLandManager;
-        bool mPreloadInstances;
+        SceneUtil::WorkQueue* mWorkQueue;
+
+        std::atomic<bool> mAbort;
 
-        volatile bool mAbort;
+        std::vector<osg::ref_ptr<PreloadModelItem> > mModelItems;
 
         osg::ref_ptr<Terrain::View> mTerrainView;
 
@@ -198,6 +335,7 @@ namespace MWWorld
         , mMaxCacheSize(0)
         , mPreloadInstances(true)
         , mLastResourceCacheUpdate(0.0)
+        , mNumDropped(0)
     {
     }
 
@@ -225,7 +363,7 @@ namespace MWWorld
         mPreloadCells.clear();
     }
 
-    void CellPreloader::preload(CellStore *cell, double timestamp)
+    void CellPreloader::preload(CellStore *cell, double timestamp, PreloadLane lane, float distance)
     {
         if (!mWorkQueue)
         {
@@ -241,8 +379,14 @@ namespace MWWorld
         PreloadMap::iterator found = mPreloadCells.find(cell);
         if (found != mPreloadCells.end())
         {
-            // already preloaded, nothing to do other than updating the timestamp
+            // already preloaded, nothing to do other than updating the timestamp and priority
             found->second.mTimeStamp = timestamp;
+            if (found->second.mLane != PreloadLane::Immediate)
+            {
+                found->second.mLane = lane;
+                if (found->second.mWorkItem && !found->second.mWorkItem->isDone())
+                    found->second.mWorkItem->setPriority(getPreloadPriority(lane, distance));
+            }
             return;
         }
 
@@ -270,10 +414,34 @@ namespace MWWorld
                 return;
         }
 
-        osg::ref_ptr<PreloadItem> item(new PreloadItem(cell, mResourceSystem->getSceneManager(), mBulletShapeManager, mResourceSystem->getKeyframeManager(), mTerrain, mLandManager, mPreloadInstances));
+        osg::ref_ptr<PreloadItem> item(new PreloadItem(cell, mResourceSystem->getSceneManager(), mBulletShapeManager, mResourceSystem->getKeyframeManager(), mTerrain, mLandManager, mPreloadInstances, mWorkQueue.get()));
+        item->setPriority(getPreloadPriority(lane, distance));
         mWorkQueue->addWorkItem(item);
 
-        mPreloadCells[cell] = PreloadEntry(timestamp, item);
+        MWBase::SoundManager* soundManager = MWBase::Environment::get().getSoundManager();
+        for (const std::string& sound : item->getSounds())
+            soundManager->preloadSound(sound);
+
+        mPreloadCells[cell] = PreloadEntry(timestamp, item, lane);
+    }
+
+    void CellPreloader::dropStaleRequests(double timestamp)
+    {
+        for (PreloadMap::iterator it = mPreloadCells.begin(); it != mPreloadCells.end();)
+        {
+            const PreloadEntry& entry = it->second;
+            if (entry.mLane != PreloadLane::Immediate && entry.mTimeStamp < timestamp
+                    && entry.mWorkItem && !entry.mWorkItem->isDone())
+            {
+                if (!mWorkQueue->cancelWorkItem(entry.mWorkItem))
+                    entry.mWorkItem->abort();
+                mUnrefQueue->push(entry.mWorkItem);
+                mPreloadCells.erase(it++);
+                ++mNumDropped;
+            }
+            else
+                ++it;
+        }
     }
 
     void CellPreloader::notifyLoaded(CellStore *cell)
@@ -429,8 +597,23 @@ namespace MWWorld
             // right now, we just use it to make sure the resources are preloaded
             mTerrainPreloadPositions = positions;
             mTerrainPreloadItem = new TerrainPreloadItem(mTerrainViews, mTerrain, positions);
+            mTerrainPreloadItem->setPriority(getPreloadPriority(PreloadLane::Nearby, 0.f));
             mWorkQueue->addWorkItem(mTerrainPreloadItem);
         }
     }
 
+    void CellPreloader::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        unsigned int pending = 0;
+        for (PreloadMap::const_iterator it = mPreloadCells.begin(); it != mPreloadCells.end(); ++it)
+        {
+            if (it->second.mWorkItem && !it->second.mWorkItem->isDone())
+                ++pending;
+        }
+
+        stats.setAttribute(frameNumber, "Preload Cells", mPreloadCells.size());
+        stats.setAttribute(frameNumber, "Preload Pending", pending);
+        stats.setAttribute(frameNumber, "Preload Dropped", mNumDropped);
+    }
+
 }
@@ -23,6 +23,11 @@ namespace SceneUtil
     class UnrefQueue;
 }
 
+namespace osg
+{
+    class Stats;
+}
+
 namespace MWRender
 {
     class LandManager;
@@ -32,6 +37,15 @@ namespace MWWorld
 {
     class CellStore;
 
+    /// Preload requests of a lower lane are always processed before requests of a higher lane.
+    /// Within a lane, cells closer to the (predicted) player position go first.
+    enum class PreloadLane
+    {
+        Immediate, ///< Explicit requests, e.g. the player's cell after loading a game. Never dropped.
+        Nearby, ///< Exterior grid and teleport door destinations.
+        FastTravel ///< Travel service destinations.
+    };
+
     class CellPreloader
     {
     public:
@@ -40,7 +54,14 @@ namespace MWWorld
 
         /// Ask a background thread to preload rendering meshes and collision shapes for objects in this cell.
         /// @note The cell itself must be in State_Loaded or State_Preloaded.
-        void preload(MWWorld::CellStore* cell, double timestamp);
+        /// @param distance Distance to the predicted player position, used to order requests within a lane.
+        /// @note Repeating a request updates its priority.
+        void preload(MWWorld::CellStore* cell, double timestamp, PreloadLane lane = PreloadLane::Immediate, float distance = 0.f);
+
+        /// Drop preload jobs that have not finished yet and were not requested again at \a timestamp.
+        /// Jobs that are still queued are cancelled, jobs that are running are aborted. Requests in the
+        /// PreloadLane::Immediate lane are kept.
+        void dropStaleRequests(double timestamp);
 
         void notifyLoaded(MWWorld::CellStore* cell);
 
@@ -69,6 +90,8 @@ namespace MWWorld
 
         void setTerrainPreloadPositions(const std::vector<osg::Vec3f>& positions);
 
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
     private:
         Resource::ResourceSystem* mResourceSystem;
         Resource::BulletShapeManager* mBulletShapeManager;
@@ -82,21 +105,25 @@ namespace MWWorld
         bool mPreloadInstances;
 
         double mLastResourceCacheUpdate;
+        unsigned int mNumDropped;
 
         struct PreloadEntry
         {
-            PreloadEntry(double timestamp, osg::ref_ptr<SceneUtil::WorkItem> workItem)
+            PreloadEntry(double timestamp, osg::ref_ptr<SceneUtil::WorkItem> workItem, PreloadLane lane)
                 : mTimeStamp(timestamp)
                 , mWorkItem(workItem)
+                , mLane(lane)
             {
             }
             PreloadEntry()
                 : mTimeStamp(0.0)
+                , mLane(PreloadLane::Immediate)
             {
             }
 
             double mTimeStamp;
             osg::ref_ptr<SceneUtil::WorkItem> mWorkItem;
+            PreloadLane mLane;
         };
         typedef std::map<const MWWorld::CellStore*, PreloadEntry> PreloadMap;
 
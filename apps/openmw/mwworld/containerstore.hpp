@@ -71,6 +71,8 @@ namespace MWWorld
         protected:
             ContainerStoreListener* mListener;
 
+            unsigned int mGeneration;
+
         private:
 
             MWWorld::CellRefList<ESM::Potion>            potions;
@@ -175,6 +177,10 @@ namespace MWWorld
             ContainerStoreListener* getContListener() const;
             void setContListener(ContainerStoreListener* listener);
 
+            unsigned int getGeneration() const;
+            ///< Changes whenever items are added, removed or restacked, or for an inventory, equipped or unequipped.
+            /// Item counts and charges changed through the references themselves are not tracked.
+
         protected:
             ContainerStoreIterator addNewStack (const ConstPtr& ptr, int count);
             ///< Add the item to this container (do not try to stack it onto existing items)
@@ -936,6 +936,7 @@ MWWorld::ContainerStoreIterator MWWorld::InventoryStore::unequipItemQuantity(con
         {
             iter->getRefData().setCount(iter->getRefData().getCount() + count);
             item.getRefData().setCount(item.getRefData().getCount() - count);
+            flagAsModified();
             return iter;
         }
     }
@@ -956,6 +957,8 @@ void MWWorld::InventoryStore::setInvListener(InventoryStoreListener *listener, c
 
 void MWWorld::InventoryStore::fireEquipmentChangedEvent(const Ptr& actor)
 {
+    ++mGeneration;
+
     if (!mUpdatesEnabled)
         return;
     if (mInventoryListener)
@@ -801,6 +801,9 @@ namespace MWWorld
                 preloadFastTravelDestinations(playerPos, predictedPos, exteriorPositions);
         }
 
+        // cancel jobs for cells that were requested before but are no longer relevant
+        mPreloader->dropStaleRequests(mRendering.getReferenceTime());
+
         mPreloader->setTerrainPreloadPositions(exteriorPositions);
     }
 
@@ -826,20 +829,23 @@ namespace MWWorld
         {
             const MWWorld::ConstPtr& door = *it;
             float sqrDistToPlayer = (playerPos - door.getRefData().getPosition().asVec3()).length2();
-            sqrDistToPlayer = std::min(sqrDistToPlayer, (predictedPos - door.getRefData().getPosition().asVec3()).length2());
+            float sqrDistToPredicted = (predictedPos - door.getRefData().getPosition().asVec3()).length2();
+            sqrDistToPlayer = std::min(sqrDistToPlayer, sqrDistToPredicted);
 
             if (sqrDistToPlayer < mPreloadDistance*mPreloadDistance)
             {
+                // order by the predicted position, the player is more likely to use the doors they're heading to
+                float distance = std::sqrt(sqrDistToPredicted);
                 try
                 {
                     if (!door.getCellRef().getDestCell().empty())
-                        preloadCell(MWBase::Environment::get().getWorld()->getInterior(door.getCellRef().getDestCell()));
+                        requestPreload(MWBase::Environment::get().getWorld()->getInterior(door.getCellRef().getDestCell()), false, PreloadLane::Nearby, distance);
                     else
                     {
                         osg::Vec3f pos = door.getCellRef().getDoorDest().asVec3();
                         int x,y;
                         MWBase::Environment::get().getWorld()->positionToIndex (pos.x(), pos.y(), x, y);
-                        preloadCell(MWBase::Environment::get().getWorld()->getExterior(x,y), true);
+                        requestPreload(MWBase::Environment::get().getWorld()->getExterior(x,y), true, PreloadLane::Nearby, distance);
                         exteriorPositions.push_back(pos);
                     }
                 }
@@ -880,12 +886,20 @@ namespace MWWorld
                 float loadDist = 8192/2 + 8192 - mCellLoadingThreshold + mPreloadDistance;
 
                 if (dist < loadDist)
-                    preloadCell(MWBase::Environment::get().getWorld()->getExterior(cellX+dx, cellY+dy));
+                {
+                    float distToPredicted = std::max(std::abs(thisCellCenterX - predictedPos.x()), std::abs(thisCellCenterY - predictedPos.y()));
+                    requestPreload(MWBase::Environment::get().getWorld()->getExterior(cellX+dx, cellY+dy), false, PreloadLane::Nearby, distToPredicted);
+                }
             }
         }
     }
 
     void Scene::preloadCell(CellStore *cell, bool preloadSurrounding)
+    {
+        requestPreload(cell, preloadSurrounding, PreloadLane::Immediate, 0.f);
+    }
+
+    void Scene::requestPreload(CellStore *cell, bool preloadSurrounding, PreloadLane lane, float distance)
     {
         if (preloadSurrounding && cell->isExterior())
         {
@@ -896,14 +910,14 @@ namespace MWWorld
             {
                 for (int dy = -mHalfGridSize; dy <= mHalfGridSize; ++dy)
                 {
-                    mPreloader->preload(MWBase::Environment::get().getWorld()->getExterior(x+dx, y+dy), mRendering.getReferenceTime());
+                    mPreloader->preload(MWBase::Environment::get().getWorld()->getExterior(x+dx, y+dy), mRendering.getReferenceTime(), lane, distance);
                     if (++numpreloaded >= mPreloader->getMaxCacheSize())
                         break;
                 }
             }
         }
         else
-            mPreloader->preload(cell, mRendering.getReferenceTime());
+            mPreloader->preload(cell, mRendering.getReferenceTime(), lane, distance);
     }
 
     void Scene::preloadTerrain(const osg::Vec3f &pos)
@@ -913,6 +927,11 @@ namespace MWWorld
         mPreloader->setTerrainPreloadPositions(vec);
     }
 
+    void Scene::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        mPreloader->reportStats(frameNumber, stats);
+    }
+
     struct ListFastTravelDestinationsVisitor
     {
         ListFastTravelDestinationsVisitor(float preloadDist, const osg::Vec3f& playerPos)
@@ -958,13 +977,13 @@ namespace MWWorld
         for (std::vector<ESM::Transport::Dest>::const_iterator it = listVisitor.mList.begin(); it != listVisitor.mList.end(); ++it)
         {
             if (!it->mCellName.empty())
-                preloadCell(MWBase::Environment::get().getWorld()->getInterior(it->mCellName));
+                requestPreload(MWBase::Environment::get().getWorld()->getInterior(it->mCellName), false, PreloadLane::FastTravel, 0.f);
             else
             {
                 osg::Vec3f pos = it->mPos.asVec3();
                 int x,y;
                 MWBase::Environment::get().getWorld()->positionToIndex( pos.x(), pos.y(), x, y);
-                preloadCell(MWBase::Environment::get().getWorld()->getExterior(x,y), true);
+                requestPreload(MWBase::Environment::get().getWorld()->getExterior(x,y), true, PreloadLane::FastTravel, 0.f);
                 exteriorPositions.push_back(pos);
             }
         }
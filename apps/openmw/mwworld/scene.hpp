@@ -11,6 +11,7 @@
 namespace osg
 {
     class Vec3f;
+    class Stats;
 }
 
 namespace ESM
@@ -50,6 +51,7 @@ namespace MWWorld
     class Player;
     class CellStore;
     class CellPreloader;
+    enum class PreloadLane;
 
     class Scene
     {
@@ -90,6 +92,7 @@ namespace MWWorld
         void preloadTeleportDoorDestinations(const osg::Vec3f& playerPos, const osg::Vec3f& predictedPos, std::vector<osg::Vec3f>& exteriorPositions);
         void preloadExteriorGrid(const osg::Vec3f& playerPos, const osg::Vec3f& predictedPos);
         void preloadFastTravelDestinations(const osg::Vec3f& playerPos, const osg::Vec3f& predictedPos, std::vector<osg::Vec3f>& exteriorPositions);
+        void requestPreload(MWWorld::CellStore* cell, bool preloadSurrounding, PreloadLane lane, float distance);
 
     public:
 
@@ -101,6 +104,8 @@ namespace MWWorld
         void preloadCell(MWWorld::CellStore* cell, bool preloadSurrounding = false);
         void preloadTerrain(const osg::Vec3f& pos);
 
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
         void unloadCell(CellStoreCollection::iterator iter);
 
         void loadCell(CellStore *cell, Loading::Listener* loadingListener, bool respawn);
@@ -225,6 +225,8 @@ namespace MWWorld
             navigatorSettings->mMaxClimb = MWPhysics::sStepSizeUp;
             navigatorSettings->mMaxSlope = MWPhysics::sMaxSlope;
             navigatorSettings->mSwimHeightScale = mSwimHeightScale;
+            if (navigatorSettings->mNavMeshDiskCachePath.empty())
+                navigatorSettings->mNavMeshDiskCachePath = mUserDataPath + "/navmeshcache";
             DetourNavigator::RecastGlobalAllocator::init();
             mNavigator.reset(new DetourNavigator::NavigatorImpl(*navigatorSettings));
         }
@@ -2073,6 +2075,11 @@ namespace MWWorld
         MWBase::Environment::get().getSoundManager()->setListenerPosDir(listenerPos, forward, up, underwater);
     }
 
+    void World::reportStats (unsigned int frameNumber, osg::Stats& stats) const
+    {
+        mWorldScene->reportStats(frameNumber, stats);
+    }
+
     void World::updateWindowManager ()
     {
         try
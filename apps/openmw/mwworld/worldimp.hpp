@@ -20,6 +20,7 @@
 namespace osg
 {
     class Group;
+    class Stats;
 }
 
 namespace osgViewer
@@ -611,6 +612,8 @@ namespace MWWorld
 
             void updateWindowManager () override;
 
+            void reportStats (unsigned int frameNumber, osg::Stats& stats) const override;
+
             MWWorld::Ptr placeObject (const MWWorld::ConstPtr& object, float cursorX, float cursorY, int amount) override;
             ///< copy and place an object into the gameworld at the specified cursor position
             /// @param object
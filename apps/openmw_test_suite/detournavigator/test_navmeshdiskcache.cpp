@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include "components/detournavigator/navmeshdiskcache.hpp"
+#include "components/detournavigator/settings.hpp"
+
+#include <boost/filesystem/operations.hpp>
+
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    using namespace DetourNavigator;
+
+    struct DetourNavigatorNavMeshDiskCacheTest : public ::testing::Test
+    {
+        boost::filesystem::path mDirectory;
+        Settings mSettings;
+        const osg::Vec3f mAgentHalfExtents {1, 2, 3};
+        const RecastMesh mRecastMesh {{0, 1, 2}, {0, 0, 0, 1, 0, 0, 0, 1, 0}, {AreaType_ground}, {}, 1};
+        const std::vector<OffMeshConnection> mOffMeshConnections;
+        std::vector<unsigned char> mData;
+
+        DetourNavigatorNavMeshDiskCacheTest()
+        {
+            mSettings.mTileSize = 64;
+            mSettings.mCellSize = 0.2f;
+            for (int i = 0; i < 1000; ++i)
+                mData.push_back(static_cast<unsigned char>(i));
+        }
+
+        void SetUp()
+        {
+            mDirectory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+        }
+
+        void TearDown()
+        {
+            boost::filesystem::remove_all(mDirectory);
+        }
+
+        NavMeshDataRef getData()
+        {
+            return NavMeshDataRef {mData.data(), static_cast<int>(mData.size())};
+        }
+
+        std::size_t countFiles() const
+        {
+            std::size_t result = 0;
+            for (boost::filesystem::directory_iterator it(mDirectory), end; it != end; ++it)
+                ++result;
+            return result;
+        }
+    };
+
+    TEST_F(DetourNavigatorNavMeshDiskCacheTest, get_should_return_written_tile_after_restart)
+    {
+        {
+            NavMeshDiskCache cache(mSettings, mDirectory, 1024 * 1024);
+            EXPECT_FALSE(cache.get(mAgentHalfExtents, TilePosition(0, 0), mRecastMesh, mOffMeshConnections).mValue);
+            cache.set(mAgentHalfExtents, TilePosition(0, 0), mRecastMesh, mOffMeshConnections, getData());
+        }
+
+        NavMeshDiskCache cache(mSettings, mDirectory, 1024 * 1024);
+        const auto result = cache.get(mAgentHalfExtents, TilePosition(0, 0), mRecastMesh, mOffMeshConnections);
+        ASSERT_TRUE(result.mValue);
+        ASSERT_EQ(result.mSize, static_cast<int>(mData.size()));
+        EXPECT_EQ(std::memcmp(result.mValue.get(), mData.data(), mData.size()), 0);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDiskCacheTest, get_should_not_return_tile_for_other_tile_agent_or_settings)
+    {
+        {
+            NavMeshDiskCache cache(mSettings, mDirectory, 1024 * 1024);
+            cache.set(mAgentHalfExtents, TilePosition(0, 0), mRecastMesh, mOffMeshConnections, getData());
+            cache.wait();
+            EXPECT_FALSE(cache.get(mAgentHalfExtents, TilePosition(0, 1), mRecastMesh, mOffMeshConnections).mValue);
+            EXPECT_FALSE(cache.get(osg::Vec3f(1, 2, 4), TilePosition(0, 0), mRecastMesh, mOffMeshConnections).mValue);
+        }
+
+        Settings otherSettings = mSettings;
+        otherSettings.mCellSize = 0.25f;
+        NavMeshDiskCache cache(otherSettings, mDirectory, 1024 * 1024);
+        EXPECT_FALSE(cache.get(mAgentHalfExtents, TilePosition(0, 0), mRecastMesh, mOffMeshConnections).mValue);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDiskCacheTest, set_should_remove_files_over_max_size)
+    {
+        NavMeshDiskCache cache(mSettings, mDirectory, 2500);
+        for (int i = 0; i < 5; ++i)
+            cache.set(mAgentHalfExtents, TilePosition(0, i), mRecastMesh, mOffMeshConnections, getData());
+        cache.wait();
+
+        EXPECT_EQ(countFiles(), 2u);
+        EXPECT_TRUE(cache.get(mAgentHalfExtents, TilePosition(0, 4), mRecastMesh, mOffMeshConnections).mValue);
+    }
+}
@@ -0,0 +1,285 @@
+#include <gtest/gtest.h>
+#include "components/esm/parallelreader.hpp"
+#include "components/esm/esmwriter.hpp"
+#include "components/esm/loadland.hpp"
+#include "components/esm/loadstat.hpp"
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <chrono>
+#include <iostream>
+
+namespace
+{
+    using ESM::ParallelReader;
+
+    struct ParallelReaderTest : public ::testing::Test
+    {
+        boost::filesystem::path mDirectory;
+        std::string mPath;
+
+        void SetUp()
+        {
+            mDirectory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+            boost::filesystem::create_directories(mDirectory);
+            mPath = (mDirectory / "test.esp").string();
+        }
+
+        void TearDown()
+        {
+            boost::filesystem::remove_all(mDirectory);
+        }
+
+        // Writes count statics, followed by land if there is one
+        void writeStatics(int count, const ESM::Land* land = nullptr)
+        {
+            boost::filesystem::ofstream stream(mPath, std::ios::binary);
+
+            ESM::ESMWriter writer;
+            writer.setVersion(ESM::VER_13);
+            writer.setAuthor("author");
+            writer.setRecordCount(land ? count + 1 : count);
+            writer.save(stream);
+
+            for (int i = 0; i < count; ++i)
+            {
+                ESM::Static record;
+                record.mId = "static_" + std::to_string(i);
+                record.mModel = "meshes/static_" + std::to_string(i) + ".nif";
+
+                writer.startRecord(ESM::Static::sRecordId);
+                record.save(writer);
+                writer.endRecord(ESM::Static::sRecordId);
+            }
+
+            if (land)
+            {
+                writer.startRecord(ESM::Land::sRecordId);
+                land->save(writer);
+                writer.endRecord(ESM::Land::sRecordId);
+            }
+
+            writer.close();
+        }
+
+        // Reads the ids of all statics, in the order they were handed back
+        std::vector<std::string> readIds(ParallelReader& reader)
+        {
+            std::vector<std::string> ids;
+
+            reader.read<std::vector<std::string> >(
+                [] (ESM::ESMReader& esm, size_t /*offset*/)
+                {
+                    std::vector<std::string> batchIds;
+                    while (esm.hasMoreRecs())
+                    {
+                        esm.getRecName();
+                        esm.getRecHeader();
+
+                        ESM::Static record;
+                        bool isDeleted = false;
+                        record.load(esm, isDeleted);
+                        batchIds.push_back(record.mId);
+                    }
+                    return batchIds;
+                },
+                [&ids] (std::vector<std::string>& batchIds)
+                {
+                    ids.insert(ids.end(), batchIds.begin(), batchIds.end());
+                    return true;
+                });
+
+            return ids;
+        }
+    };
+}
+
+TEST_F(ParallelReaderTest, should_hand_back_records_in_file_order)
+{
+    writeStatics(1000);
+
+    ParallelReader reader(mPath, 4);
+    reader.setBatchSize(256);
+    const std::vector<std::string> ids = readIds(reader);
+
+    ASSERT_EQ(ids.size(), 1000u);
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_EQ(ids[i], "static_" + std::to_string(i));
+}
+
+TEST_F(ParallelReaderTest, should_give_offsets_in_the_file)
+{
+    writeStatics(100);
+
+    std::vector<size_t> offsets;
+    ESM::ESMReader sequential;
+    sequential.open(mPath);
+    while (sequential.hasMoreRecs())
+    {
+        offsets.push_back(sequential.getFileOffset());
+        sequential.getRecName();
+        sequential.getRecHeader();
+        sequential.skipRecord();
+    }
+
+    ParallelReader reader(mPath, 2);
+    reader.setBatchSize(100);
+
+    std::vector<size_t> parallelOffsets;
+    reader.read<std::vector<size_t> >(
+        [] (ESM::ESMReader& esm, size_t offset)
+        {
+            std::vector<size_t> batchOffsets;
+            while (esm.hasMoreRecs())
+            {
+                batchOffsets.push_back(esm.getFileOffset() + offset);
+                esm.getRecName();
+                esm.getRecHeader();
+                esm.skipRecord();
+            }
+            return batchOffsets;
+        },
+        [&parallelOffsets] (std::vector<size_t>& batchOffsets)
+        {
+            parallelOffsets.insert(parallelOffsets.end(), batchOffsets.begin(), batchOffsets.end());
+            return true;
+        });
+
+    EXPECT_EQ(parallelOffsets, offsets);
+}
+
+TEST_F(ParallelReaderTest, should_stop_when_asked_to)
+{
+    writeStatics(1000);
+
+    ParallelReader reader(mPath, 4);
+    reader.setBatchSize(1);
+
+    int batches = 0;
+    reader.read<int>(
+        [] (ESM::ESMReader& esm, size_t /*offset*/)
+        {
+            esm.getRecName();
+            esm.getRecHeader();
+            esm.skipRecord();
+            return 1;
+        },
+        [&batches] (int& records)
+        {
+            batches += records;
+            return batches < 10;
+        });
+
+    EXPECT_EQ(batches, 10);
+}
+
+TEST_F(ParallelReaderTest, should_throw_errors_of_the_parser)
+{
+    writeStatics(100);
+    boost::filesystem::resize_file(mPath, boost::filesystem::file_size(mPath) - 10);
+
+    ParallelReader reader(mPath, 4);
+    reader.setBatchSize(100);
+    EXPECT_THROW(readIds(reader), std::runtime_error);
+
+    boost::filesystem::ofstream(mPath) << "not a content file";
+    EXPECT_THROW(ParallelReader(mPath, 1), std::runtime_error);
+}
+
+TEST_F(ParallelReaderTest, should_hand_back_every_record_on_the_default_threads)
+{
+    const int count = 10000;
+    writeStatics(count);
+
+    ParallelReader reader(mPath);
+    reader.setBatchSize(4096);
+    const std::vector<std::string> ids = readIds(reader);
+
+    ASSERT_EQ(ids.size(), static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i)
+        EXPECT_EQ(ids[i], "static_" + std::to_string(i));
+}
+
+TEST_F(ParallelReaderTest, should_give_offsets_that_let_land_load_its_data_from_the_file)
+{
+    ESM::Land land;
+    land.blank();
+    land.mX = 3;
+    land.mY = -4;
+    land.mFlags = 0;
+    land.getLandData()->mUnk1 = 7;
+    for (int i = 0; i < ESM::Land::LAND_NUM_VERTS; ++i)
+        land.getLandData()->mHeights[i] = (i % 16) * ESM::Land::HEIGHT_SCALE;
+    writeStatics(1000, &land);
+
+    ParallelReader reader(mPath, 2);
+    reader.setBatchSize(4096);
+
+    std::vector<ESM::Land> lands;
+    reader.read<std::vector<ESM::Land> >(
+        [] (ESM::ESMReader& esm, size_t offset)
+        {
+            std::vector<ESM::Land> batchLands;
+            while (esm.hasMoreRecs())
+            {
+                const ESM::NAME name = esm.getRecName();
+                esm.getRecHeader();
+                if (name.intval != ESM::Land::sRecordId)
+                {
+                    esm.skipRecord();
+                    continue;
+                }
+
+                batchLands.push_back(ESM::Land());
+                bool isDeleted = false;
+                batchLands.back().load(esm, isDeleted);
+                // Land loads its data later from the file itself, rather than from the batch
+                batchLands.back().mContext.filePos += offset;
+            }
+            return batchLands;
+        },
+        [&lands] (std::vector<ESM::Land>& batchLands)
+        {
+            lands.insert(lands.end(), batchLands.begin(), batchLands.end());
+            return true;
+        });
+
+    ASSERT_EQ(lands.size(), 1u);
+    EXPECT_GT(lands[0].mContext.filePos, 4096u);
+
+    const ESM::Land::LandData* data = lands[0].getLandData(ESM::Land::DATA_VHGT);
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(data->mUnk1, 7);
+    for (int i = 0; i < ESM::Land::LAND_NUM_VERTS; ++i)
+        EXPECT_EQ(data->mHeights[i], land.getLandData()->mHeights[i]) << i;
+}
+
+TEST_F(ParallelReaderTest, DISABLED_benchmark)
+{
+    const int count = 100000;
+    writeStatics(count);
+
+    const auto sequentialStart = std::chrono::steady_clock::now();
+    ESM::ESMReader sequential;
+    sequential.open(mPath);
+    while (sequential.hasMoreRecs())
+    {
+        sequential.getRecName();
+        sequential.getRecHeader();
+
+        ESM::Static record;
+        bool isDeleted = false;
+        record.load(sequential, isDeleted);
+    }
+    const std::chrono::duration<double> sequentialElapsed = std::chrono::steady_clock::now() - sequentialStart;
+
+    const auto parallelStart = std::chrono::steady_clock::now();
+    ParallelReader reader(mPath);
+    readIds(reader);
+    const std::chrono::duration<double> parallelElapsed = std::chrono::steady_clock::now() - parallelStart;
+
+    std::cout << "Read " << count << " records in " << sequentialElapsed.count() * 1e3 << " ms on one thread, "
+              << parallelElapsed.count() * 1e3 << " ms on " << std::max(std::thread::hardware_concurrency(), 1u)
+              << " threads" << std::endl;
+}
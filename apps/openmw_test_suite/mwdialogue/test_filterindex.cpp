@@ -0,0 +1,231 @@
+#include <gtest/gtest.h>
+#include "apps/openmw/mwdialogue/filterindex.hpp"
+
+#include <components/esm/loaddial.hpp>
+#include <components/esm/loadnpc.hpp>
+#include <components/misc/stringops.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <list>
+#include <sstream>
+
+namespace
+{
+    std::string makeId(const std::string& prefix, int index)
+    {
+        std::ostringstream stream;
+        stream << prefix << index;
+        return stream.str();
+    }
+
+    ESM::DialInfo makeInfo(const std::string& actor, const std::string& race, const std::string& cls,
+                           const std::string& faction, int rank, int gender, bool factionLess)
+    {
+        ESM::DialInfo info;
+        info.blank();
+        info.mActor = actor;
+        info.mRace = race;
+        info.mClass = cls;
+        info.mFaction = faction;
+        info.mData.mRank = static_cast<signed char>(rank);
+        info.mData.mGender = static_cast<signed char>(gender);
+        info.mFactionLess = factionLess;
+        return info;
+    }
+
+    ESM::NPC makeNpc(const std::string& race, const std::string& cls, const std::string& faction, int rank, bool female)
+    {
+        ESM::NPC npc;
+        npc.blank();
+        npc.mRace = race;
+        npc.mClass = cls;
+        npc.mFaction = faction;
+        npc.mNpdtType = ESM::NPC::NPC_DEFAULT;
+        npc.mNpdt.mRank = static_cast<signed char>(rank);
+        npc.mFlags = female ? ESM::NPC::Female : 0;
+        return npc;
+    }
+
+    // The string comparisons MWDialogue::Filter::testActor does for NPCs
+    bool testNpc(const ESM::DialInfo& info, const std::string& refId, const ESM::NPC& npc)
+    {
+        if (!info.mActor.empty() && !Misc::StringUtils::ciEqual(info.mActor, refId))
+            return false;
+        if (!info.mRace.empty() && !Misc::StringUtils::ciEqual(info.mRace, npc.mRace))
+            return false;
+        if (!info.mClass.empty() && !Misc::StringUtils::ciEqual(info.mClass, npc.mClass))
+            return false;
+        if (info.mFactionLess)
+        {
+            if (!npc.mFaction.empty())
+                return false;
+        }
+        else if (!info.mFaction.empty())
+        {
+            if (!Misc::StringUtils::ciEqual(npc.mFaction, info.mFaction) || npc.getFactionRank() < info.mData.mRank)
+                return false;
+        }
+        else if (info.mData.mRank != -1 && npc.getFactionRank() < info.mData.mRank)
+            return false;
+        return info.mData.mGender != ((npc.mFlags & ESM::NPC::Female) ? 0 : 1);
+    }
+
+    std::vector<const ESM::DialInfo*> listNpc(const ESM::Dialogue& dialogue, const std::string& refId, const ESM::NPC& npc)
+    {
+        std::vector<const ESM::DialInfo*> result;
+        for (const ESM::DialInfo& info : dialogue.mInfo)
+            if (testNpc(info, refId, npc))
+                result.push_back(&info);
+        return result;
+    }
+
+    // Like a large quest mod: most infos are for one actor, the rest are for a faction, race or class, or anyone
+    struct QuestMod
+    {
+        std::vector<std::string> mRefIds;
+        std::vector<ESM::NPC> mNpcs;
+        std::list<ESM::Dialogue> mDialogues;
+
+        QuestMod(int numNpcs, int numTopics)
+        {
+            const int numRaces = 10;
+            const int numClasses = 40;
+            const int numFactions = 20;
+
+            for (int i = 0; i < numNpcs; ++i)
+            {
+                mRefIds.push_back(makeId("npc_", i));
+                mNpcs.push_back(makeNpc(makeId("race_", i % numRaces), makeId("class_", i % numClasses),
+                                        i % 3 ? makeId("faction_", i % numFactions) : std::string(), i % 10, i % 2 != 0));
+            }
+
+            for (int topic = 0; topic < numTopics; ++topic)
+            {
+                mDialogues.push_back(ESM::Dialogue());
+                ESM::Dialogue& dialogue = mDialogues.back();
+                for (int i = 0; i < 30; ++i)
+                {
+                    const int seed = topic * 31 + i * 7;
+                    switch (i % 6)
+                    {
+                        case 0:
+                        case 1:
+                        case 2:
+                            dialogue.mInfo.push_back(makeInfo(makeId("NPC_", seed % numNpcs), "", "", "", -1, -1, false));
+                            break;
+                        case 3:
+                            dialogue.mInfo.push_back(makeInfo("", "", "", makeId("Faction_", seed % numFactions),
+                                                              seed % 10, -1, false));
+                            break;
+                        case 4:
+                            dialogue.mInfo.push_back(makeInfo("", makeId("Race_", seed % numRaces),
+                                                              makeId("Class_", seed % numClasses), "", -1, seed % 3 - 1, false));
+                            break;
+                        default:
+                            dialogue.mInfo.push_back(makeInfo("", "", "", "", -1, -1, seed % 2 == 0));
+                            break;
+                    }
+                }
+            }
+        }
+    };
+}
+
+TEST(MWDialogueFilterIndexTest, should_match_infos_like_filter)
+{
+    ESM::Dialogue dialogue;
+    dialogue.mInfo.push_back(makeInfo("Fargoth", "", "", "", -1, -1, false));
+    dialogue.mInfo.push_back(makeInfo("", "Wood Elf", "", "", -1, ESM::DialInfo::Male, false));
+    dialogue.mInfo.push_back(makeInfo("", "", "", "Fighters Guild", 2, -1, false));
+    dialogue.mInfo.push_back(makeInfo("", "", "", "", -1, -1, true));
+    dialogue.mInfo.push_back(makeInfo("", "", "Commoner", "", -1, ESM::DialInfo::Female, false));
+    dialogue.mInfo.push_back(makeInfo("", "", "", "", -1, -1, false));
+    dialogue.mInfo.push_back(makeInfo("mudcrab", "", "", "", -1, -1, false));
+
+    MWDialogue::FilterIndex index;
+    index.addDialogue(dialogue);
+
+    const ESM::NPC fargoth = makeNpc("wood elf", "commoner", "", 0, false);
+    const ESM::NPC fighter = makeNpc("Nord", "Warrior", "fighters guild", 3, true);
+
+    std::vector<const ESM::DialInfo*> infos;
+    ASSERT_TRUE(index.getInfos(dialogue, index.getNpc("fargoth", fargoth), infos));
+    EXPECT_EQ(infos, listNpc(dialogue, "fargoth", fargoth));
+    ASSERT_EQ(infos.size(), 4u);
+    EXPECT_EQ(infos.front()->mActor, "Fargoth");
+
+    infos.clear();
+    index.getInfos(dialogue, index.getNpc("unknown npc", fighter), infos);
+    EXPECT_EQ(infos, listNpc(dialogue, "unknown npc", fighter));
+    EXPECT_EQ(infos.size(), 2u);
+
+    infos.clear();
+    index.getInfos(dialogue, index.getCreature("Mudcrab"), infos);
+    ASSERT_EQ(infos.size(), 1u);
+    EXPECT_EQ(infos.front()->mActor, "mudcrab");
+
+    ESM::Dialogue other;
+    EXPECT_FALSE(index.getInfos(other, index.getCreature("mudcrab"), infos));
+}
+
+TEST(MWDialogueFilterIndexTest, should_match_testing_every_info_for_every_npc)
+{
+    const QuestMod mod(100, 50);
+
+    MWDialogue::FilterIndex index;
+    for (const ESM::Dialogue& dialogue : mod.mDialogues)
+        index.addDialogue(dialogue);
+
+    std::vector<const ESM::DialInfo*> infos;
+    for (std::size_t i = 0; i < mod.mNpcs.size(); ++i)
+    {
+        const MWDialogue::FilterIndex::Actor actor = index.getNpc(mod.mRefIds[i], mod.mNpcs[i]);
+        for (const ESM::Dialogue& dialogue : mod.mDialogues)
+        {
+            infos.clear();
+            index.getInfos(dialogue, actor, infos);
+            EXPECT_EQ(infos, listNpc(dialogue, mod.mRefIds[i], mod.mNpcs[i]));
+        }
+    }
+}
+
+TEST(MWDialogueFilterIndexTest, DISABLED_open_dialogue_with_every_npc_benchmark)
+{
+    const int numNpcs = 1000;
+    const int numTopics = 1500;
+    const QuestMod mod(numNpcs, numTopics);
+
+    const auto buildStart = std::chrono::steady_clock::now();
+    MWDialogue::FilterIndex index;
+    for (const ESM::Dialogue& dialogue : mod.mDialogues)
+        index.addDialogue(dialogue);
+    const std::chrono::duration<double> buildElapsed = std::chrono::steady_clock::now() - buildStart;
+
+    // Opening dialogue lists the infos of every topic for the actor
+    std::vector<const ESM::DialInfo*> infos;
+    const auto indexStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < numNpcs; ++i)
+    {
+        const MWDialogue::FilterIndex::Actor actor = index.getNpc(mod.mRefIds[i], mod.mNpcs[i]);
+        for (const ESM::Dialogue& dialogue : mod.mDialogues)
+        {
+            infos.clear();
+            index.getInfos(dialogue, actor, infos);
+        }
+    }
+    const std::chrono::duration<double> indexElapsed = std::chrono::steady_clock::now() - indexStart;
+
+    const auto linearStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < numNpcs; ++i)
+    {
+        for (const ESM::Dialogue& dialogue : mod.mDialogues)
+            listNpc(dialogue, mod.mRefIds[i], mod.mNpcs[i]);
+    }
+    const std::chrono::duration<double> linearElapsed = std::chrono::steady_clock::now() - linearStart;
+
+    std::cout << "Dialogue filter: " << numNpcs << " NPCs x " << numTopics << " topics: index built in "
+              << buildElapsed.count() * 1e3 << " ms, "
+              << indexElapsed.count() * 1e3 / numNpcs << " ms per NPC, "
+              << linearElapsed.count() * 1e3 / numNpcs << " ms per NPC testing every info" << std::endl;
+}
@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 #include "apps/openmw/mwdialogue/keywordsearch.hpp"
 
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
 struct KeywordSearchTest : public ::testing::Test
 {
   protected:
@@ -65,3 +69,136 @@ TEST_F(KeywordSearchTest, keyword_test_conflict_resolution3)
     ASSERT_TRUE (matches.size() == 1);
     ASSERT_TRUE (std::string(matches.front().mBeg, matches.front().mEnd) == "bar lock");
 }
+
+TEST_F(KeywordSearchTest, keyword_test_word_start_and_case)
+{
+    MWDialogue::KeywordSearch<std::string, int> search;
+    search.seed("vivec", 1);
+    search.seed("ashlanders", 2);
+
+    std::string text = "Vivec city has no ashlanders, but it has ASHLANDERS' gossip about Lord Vivec.";
+
+    std::vector<MWDialogue::KeywordSearch<std::string, int>::Match> matches;
+    search.highlightKeywords(text.begin(), text.end(), matches);
+
+    ASSERT_EQ (matches.size(), 4u);
+    EXPECT_EQ (std::string(matches[0].mBeg, matches[0].mEnd), "Vivec");
+    EXPECT_EQ (matches[0].mValue, 1);
+    EXPECT_EQ (std::string(matches[2].mBeg, matches[2].mEnd), "ASHLANDERS");
+    EXPECT_EQ (matches[2].mValue, 2);
+
+    // must not match in the middle of a word
+    text = "xvivec";
+    matches.clear();
+    search.highlightKeywords(text.begin(), text.end(), matches);
+    EXPECT_TRUE (matches.empty());
+}
+
+TEST_F(KeywordSearchTest, keyword_test_seed_after_search)
+{
+    MWDialogue::KeywordSearch<std::string, int> search;
+    search.seed("morrowind", 0);
+
+    std::string text = "the latest rumors about morrowind";
+
+    std::vector<MWDialogue::KeywordSearch<std::string, int>::Match> matches;
+    search.highlightKeywords(text.begin(), text.end(), matches);
+    ASSERT_EQ (matches.size(), 1u);
+
+    // the cached matches must not be used once the keywords change
+    search.seed("latest rumors", 1);
+    matches.clear();
+    search.highlightKeywords(text.begin(), text.end(), matches);
+    ASSERT_EQ (matches.size(), 2u);
+    EXPECT_EQ (std::string(matches[0].mBeg, matches[0].mEnd), "latest rumors");
+    EXPECT_EQ (std::string(matches[1].mBeg, matches[1].mEnd), "morrowind");
+
+    int value = -1;
+    EXPECT_TRUE (search.containsKeyword("Latest Rumors", value));
+    EXPECT_EQ (value, 1);
+    EXPECT_FALSE (search.containsKeyword("latest", value));
+}
+
+TEST_F(KeywordSearchTest, keyword_test_same_text_again)
+{
+    MWDialogue::KeywordSearch<std::string, int> search;
+    search.seed("topic1", 1);
+    search.seed("topic2 of house", 2);
+
+    std::string text = "topic2 of house and topic1, then topic1 again";
+
+    std::vector<MWDialogue::KeywordSearch<std::string, int>::Match> first;
+    search.highlightKeywords(text.begin(), text.end(), first);
+    ASSERT_EQ (first.size(), 3u);
+
+    // searching the same page again, like turning back in the journal, gives the same matches
+    std::vector<MWDialogue::KeywordSearch<std::string, int>::Match> second;
+    search.highlightKeywords(text.begin(), text.end(), second);
+    ASSERT_EQ (second.size(), first.size());
+
+    for (std::size_t i = 0; i < first.size(); ++i)
+    {
+        EXPECT_EQ (second[i].mBeg, first[i].mBeg);
+        EXPECT_EQ (second[i].mEnd, first[i].mEnd);
+        EXPECT_EQ (second[i].mValue, first[i].mValue);
+    }
+
+    EXPECT_EQ (first[0].mValue, 2);
+    EXPECT_EQ (first[1].mValue, 1);
+    EXPECT_EQ (first[2].mValue, 1);
+}
+
+TEST_F(KeywordSearchTest, DISABLED_keyword_test_journal_benchmark)
+{
+    // A journal the size of a finished main quest and guild quest lines
+    const int numTopics = 1500;
+    const int numEntries = 3000;
+
+    std::vector<std::string> topics;
+    for (int i = 0; i < numTopics; ++i)
+    {
+        std::ostringstream topic;
+        topic << "topic" << i;
+        if (i % 3 == 0)
+            topic << " of house" << i % 7;
+        topics.push_back(topic.str());
+    }
+
+    MWDialogue::KeywordSearch<std::string, int> search;
+    for (int i = 0; i < numTopics; ++i)
+        search.seed(topics[i], i);
+
+    std::vector<std::string> entries;
+    std::size_t numCharacters = 0;
+    for (int i = 0; i < numEntries; ++i)
+    {
+        std::ostringstream entry;
+        for (int word = 0; word < 40; ++word)
+        {
+            if (word % 10 == 3)
+                entry << topics[(i * 13 + word) % numTopics] << ' ';
+            else
+                entry << "somewhere" << word << ' ';
+        }
+        entries.push_back(entry.str());
+        numCharacters += entries.back().size();
+    }
+
+    std::vector<MWDialogue::KeywordSearch<std::string, int>::Match> matches;
+    std::chrono::duration<double> elapsed[2];
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        // the second pass renders the same pages again, like turning back in the journal
+        const auto start = std::chrono::steady_clock::now();
+        for (std::vector<std::string>::const_iterator it = entries.begin(); it != entries.end(); ++it)
+        {
+            matches.clear();
+            search.highlightKeywords(it->begin(), it->end(), matches);
+        }
+        elapsed[pass] = std::chrono::steady_clock::now() - start;
+    }
+
+    std::cout << "Keyword search: " << numTopics << " topics, " << numEntries << " journal entries: "
+              << numCharacters / elapsed[0].count() / (1 << 20) << " MiB/s, "
+              << numCharacters / elapsed[1].count() / (1 << 20) << " MiB/s with cached matches" << std::endl;
+}
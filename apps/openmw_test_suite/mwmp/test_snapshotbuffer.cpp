@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+#include "apps/openmw/mwmp/SnapshotBuffer.hpp"
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace
+{
+    using namespace testing;
+    using mwmp::SnapshotBuffer;
+
+    const float speed = 300.f;
+
+    ESM::Position makePosition(float x, float yaw = 0.f)
+    {
+        ESM::Position position;
+        position.pos[0] = x;
+        position.pos[1] = 0.f;
+        position.pos[2] = 0.f;
+        position.rot[0] = 0.f;
+        position.rot[1] = 0.f;
+        position.rot[2] = yaw;
+        return position;
+    }
+
+    struct Playback
+    {
+        double minStep = std::numeric_limits<double>::max();
+        double maxStep = 0;
+    };
+
+    // Sends positions of an entity walking at a steady speed every interval, delays each by latency plus up to
+    // jitter, and plays them back at 60 frames per second
+    Playback play(double interval, double latency, double jitter, uint32_t serverStart = 1000)
+    {
+        std::minstd_rand random(42);
+        std::uniform_real_distribution<double> delay(0, jitter);
+
+        SnapshotBuffer buffer;
+        Playback playback;
+
+        const double duration = 20;
+        const double frame = 1.0 / 60;
+        double nextSend = 0;
+        double nextArrival = latency;
+        double lastX = std::numeric_limits<double>::quiet_NaN();
+        std::vector<std::pair<double, double>> inFlight;
+
+        for (double time = 0; time < duration; time += frame)
+        {
+            while (nextSend <= time)
+            {
+                // Packets on one connection keep their order
+                nextArrival = std::max(nextArrival, nextSend + latency + delay(random));
+                inFlight.emplace_back(nextArrival, nextSend);
+                nextSend += interval;
+            }
+
+            for (auto it = inFlight.begin(); it != inFlight.end();)
+            {
+                if (it->first > time)
+                {
+                    ++it;
+                    continue;
+                }
+                const uint32_t serverTime = serverStart + static_cast<uint32_t>(it->second * 1000);
+                buffer.add(serverTime, time, makePosition(static_cast<float>(it->second * speed)), true);
+                it = inFlight.erase(it);
+            }
+
+            ESM::Position position;
+            if (!buffer.getPosition(time, position))
+                continue;
+
+            // Skip the first seconds, while the playout delay adapts
+            if (time > 3 && !std::isnan(lastX))
+            {
+                playback.minStep = std::min(playback.minStep, position.pos[0] - lastX);
+                playback.maxStep = std::max(playback.maxStep, position.pos[0] - lastX);
+            }
+            lastX = position.pos[0];
+        }
+
+        return playback;
+    }
+}
+
+TEST(SnapshotBufferTest, should_interpolate_between_positions)
+{
+    SnapshotBuffer buffer;
+    buffer.add(1000, 10.0, makePosition(0, 3.0f), true);
+    buffer.add(1100, 10.1, makePosition(100, -3.0f), true);
+
+    ESM::Position position;
+    buffer.getPosition(10.1, position);
+    ASSERT_TRUE(buffer.getPosition(10.05 + buffer.getPlayoutDelay(), position));
+    EXPECT_NEAR(position.pos[0], 50.f, 1.f);
+
+    // The shorter way around the circle
+    EXPECT_GT(std::abs(position.rot[2]), 3.0f);
+}
+
+TEST(SnapshotBufferTest, should_extrapolate_moving_entities_only_for_a_while)
+{
+    SnapshotBuffer buffer;
+    buffer.add(1000, 10.0, makePosition(0), true);
+    buffer.add(1100, 10.1, makePosition(100), true);
+
+    ESM::Position position;
+    buffer.getPosition(10.1, position);
+    ASSERT_TRUE(buffer.getPosition(10.2 + buffer.getPlayoutDelay(), position));
+    EXPECT_NEAR(position.pos[0], 200.f, 10.f);
+
+    ASSERT_TRUE(buffer.getPosition(20.0, position));
+    EXPECT_NEAR(position.pos[0], 350.f, 1.f);
+
+    SnapshotBuffer stopped;
+    stopped.add(1000, 10.0, makePosition(0), true);
+    stopped.add(1100, 10.1, makePosition(100), false);
+    ASSERT_TRUE(stopped.getPosition(20.0, position));
+    EXPECT_EQ(position.pos[0], 100.f);
+}
+
+TEST(SnapshotBufferTest, should_show_teleports_right_away)
+{
+    SnapshotBuffer buffer;
+    buffer.add(1000, 10.0, makePosition(0), true);
+    buffer.add(1100, 10.1, makePosition(100), true);
+    buffer.add(1200, 10.2, makePosition(50000), true);
+
+    ESM::Position position;
+    ASSERT_TRUE(buffer.getPosition(10.2, position));
+    EXPECT_EQ(position.pos[0], 50000.f);
+}
+
+TEST(SnapshotBufferTest, should_not_slide_across_a_pause)
+{
+    SnapshotBuffer buffer;
+    buffer.add(1000, 10.0, makePosition(0), false);
+    buffer.add(11000, 20.0, makePosition(10), true);
+    buffer.add(11100, 20.1, makePosition(40), true);
+
+    ESM::Position position;
+    ASSERT_TRUE(buffer.getPosition(19.0, position));
+    EXPECT_EQ(position.pos[0], 0.f);
+}
+
+TEST(SnapshotBufferTest, should_drop_positions_that_arrive_out_of_order)
+{
+    SnapshotBuffer buffer;
+    buffer.add(1000, 10.0, makePosition(0), true);
+    buffer.add(1100, 10.1, makePosition(100), false);
+    buffer.add(1050, 10.15, makePosition(-100), true);
+
+    ESM::Position position;
+    ASSERT_TRUE(buffer.getPosition(11.0, position));
+    EXPECT_EQ(position.pos[0], 100.f);
+}
+
+TEST(SnapshotBufferTest, should_show_positions_without_server_time_right_away)
+{
+    SnapshotBuffer buffer;
+    buffer.add(1000, 10.0, makePosition(0), true);
+    buffer.add(1100, 10.1, makePosition(100), true);
+    buffer.add(0, 10.15, makePosition(-500), false);
+
+    ESM::Position position;
+    ASSERT_TRUE(buffer.getPosition(10.15, position));
+    EXPECT_EQ(position.pos[0], -500.f);
+    ASSERT_TRUE(buffer.getPosition(11.0, position));
+    EXPECT_EQ(position.pos[0], -500.f);
+
+    // Positions relayed afterwards are played back from there
+    buffer.add(1200, 10.2, makePosition(-490), false);
+    ASSERT_TRUE(buffer.getPosition(20.0, position));
+    EXPECT_EQ(position.pos[0], -490.f);
+}
+
+TEST(SnapshotBufferTest, should_play_back_smoothly_at_low_send_rates)
+{
+    const double rates[] = {66.7, 20, 10};
+    for (double rate : rates)
+    {
+        const Playback steady = play(1 / rate, 0.05, 0);
+        const Playback jittery = play(1 / rate, 0.05, 0.04);
+        const Playback wrapping = play(1 / rate, 0.05, 0.04, std::numeric_limits<uint32_t>::max() - 5000);
+
+        // At 60 frames per second, a steady walk moves 5 units per frame
+        for (const Playback& playback : {steady, jittery, wrapping})
+        {
+            EXPECT_GT(playback.minStep, speed / 60 * 0.5) << rate << " Hz";
+            EXPECT_LT(playback.maxStep, speed / 60 * 1.5) << rate << " Hz";
+        }
+    }
+}
@@ -0,0 +1,230 @@
+#include <gtest/gtest.h>
+#include "components/nif/niffile.hpp"
+#include "components/nif/data.hpp"
+#include "components/nif/property.hpp"
+#include "components/files/mappedfile.hpp"
+#include "components/files/memorystream.hpp"
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+    /// Writes the parts of a Morrowind NIF file
+    struct NifWriter
+    {
+        std::string mData;
+
+        template <class T>
+        void write(T value)
+        {
+            mData.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        void writeString(const std::string& value)
+        {
+            write<uint32_t>(value.size());
+            mData += value;
+        }
+
+        void writeHeader(int numRecords)
+        {
+            mData += "NetImmerse File Format, Version 4.0.0.2\n";
+            write<uint32_t>(0x04000002);
+            write<int32_t>(numRecords);
+        }
+
+        void writeAlphaProperty(const std::string& name, unsigned short flags, char threshold)
+        {
+            writeString("NiAlphaProperty");
+            writeString(name);
+            write<int32_t>(-1); // Extra data
+            write<int32_t>(-1); // Controller
+            write<uint16_t>(flags);
+            write<char>(threshold);
+        }
+
+        void writeTriShapeData(unsigned short numVertices)
+        {
+            writeString("NiTriShapeData");
+            write<uint16_t>(numVertices);
+            write<int32_t>(1);
+            for (unsigned short i = 0; i < numVertices; ++i)
+            {
+                write<float>(i);
+                write<float>(i * 2.f);
+                write<float>(i * 3.f);
+            }
+            write<int32_t>(1);
+            for (unsigned short i = 0; i < numVertices; ++i)
+            {
+                write<float>(0.f);
+                write<float>(0.f);
+                write<float>(1.f);
+            }
+            write<float>(0.f); // Center
+            write<float>(0.f);
+            write<float>(0.f);
+            write<float>(1.f); // Radius
+            write<int32_t>(0); // No colors
+            write<uint16_t>(0); // No texture coordinates
+            write<int32_t>(0);
+            write<uint16_t>(numVertices / 3);
+            write<int32_t>(numVertices / 3 * 3);
+            for (unsigned short i = 0; i < numVertices / 3 * 3; ++i)
+                write<uint16_t>(i);
+            write<uint16_t>(0); // No matching vertices
+        }
+
+        void writeRoots(const std::vector<int>& roots)
+        {
+            write<uint32_t>(roots.size());
+            for (int root : roots)
+                write<int32_t>(root);
+        }
+    };
+
+    std::string makeAlphaPropertyNif()
+    {
+        NifWriter writer;
+        writer.writeHeader(1);
+        writer.writeAlphaProperty("alpha", 0x12ed, 128);
+        writer.writeRoots({0});
+        return writer.mData;
+    }
+
+    void expectAlphaProperty(const Nif::NIFFile& file)
+    {
+        ASSERT_EQ(file.numRecords(), 1u);
+        ASSERT_EQ(file.numRoots(), 1u);
+
+        const Nif::NiAlphaProperty* property = dynamic_cast<const Nif::NiAlphaProperty*>(file.getRoot());
+        ASSERT_NE(property, nullptr);
+        EXPECT_EQ(property->recName, "NiAlphaProperty");
+        EXPECT_EQ(property->name, "alpha");
+        EXPECT_EQ(property->flags, 0x12ed);
+        EXPECT_EQ(property->data.threshold, 128);
+    }
+}
+
+TEST(NifFileTest, should_parse_from_memory)
+{
+    const std::string data = makeAlphaPropertyNif();
+    const Nif::NIFFile file(data.data(), data.size(), "test.nif");
+    expectAlphaProperty(file);
+}
+
+TEST(NifFileTest, should_parse_a_stream_like_memory)
+{
+    const std::string data = makeAlphaPropertyNif();
+    const Nif::NIFFile file(std::make_shared<Files::IMemStream>(data.data(), data.size()), "test.nif");
+    expectAlphaProperty(file);
+}
+
+TEST(NifFileTest, should_stop_strings_at_null_terminators)
+{
+    NifWriter writer;
+    writer.writeHeader(1);
+    writer.writeAlphaProperty(std::string("alpha\0padding", 13), 0, 0);
+    writer.writeRoots({0});
+
+    const Nif::NIFFile file(writer.mData.data(), writer.mData.size(), "test.nif");
+    EXPECT_EQ(static_cast<const Nif::Named*>(file.getRoot())->name, "alpha");
+}
+
+TEST(NifFileTest, should_fail_instead_of_reading_past_the_end)
+{
+    const std::string data = makeAlphaPropertyNif();
+    for (size_t size = 0; size < data.size(); ++size)
+        EXPECT_THROW(Nif::NIFFile(data.data(), size, "test.nif"), std::runtime_error) << size;
+}
+
+TEST(NifFileTest, should_fail_on_counts_larger_than_the_file)
+{
+    NifWriter writer;
+    writer.writeHeader(0x10000000);
+    EXPECT_THROW(Nif::NIFFile(writer.mData.data(), writer.mData.size(), "test.nif"), std::runtime_error);
+
+    NifWriter shape;
+    shape.writeHeader(1);
+    shape.writeTriShapeData(300);
+    shape.mData.resize(shape.mData.size() / 2);
+    EXPECT_THROW(Nif::NIFFile(shape.mData.data(), shape.mData.size(), "test.nif"), std::runtime_error);
+}
+
+TEST(NifFileTest, should_read_arrays)
+{
+    NifWriter writer;
+    writer.writeHeader(1);
+    writer.writeTriShapeData(300);
+    writer.writeRoots({0});
+
+    const Nif::NIFFile file(writer.mData.data(), writer.mData.size(), "test.nif");
+    const Nif::NiTriShapeData* data = dynamic_cast<const Nif::NiTriShapeData*>(file.getRoot());
+    ASSERT_NE(data, nullptr);
+    ASSERT_EQ(data->vertices.size(), 300u);
+    EXPECT_EQ(data->vertices[299], osg::Vec3f(299.f, 598.f, 897.f));
+    ASSERT_EQ(data->normals.size(), 300u);
+    EXPECT_EQ(data->normals[0], osg::Vec3f(0.f, 0.f, 1.f));
+    ASSERT_EQ(data->triangles.size(), 300u);
+    EXPECT_EQ(data->triangles[299], 299);
+}
+
+TEST(NifFileTest, should_parse_a_mapped_file_like_a_file_stream)
+{
+    const boost::filesystem::path path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    boost::filesystem::ofstream(path, std::ios::binary) << makeAlphaPropertyNif();
+
+    {
+        const Nif::NIFFile file(Files::openConstrainedFileStream(path.string().c_str()), path.string());
+        expectAlphaProperty(file);
+    }
+
+    {
+        const Files::MappedFile mapped(path.string());
+        const Nif::NIFFile file(mapped.data(), mapped.size(), path.string());
+        expectAlphaProperty(file);
+    }
+
+    boost::filesystem::remove(path);
+}
+
+TEST(NifFileTest, DISABLED_benchmark)
+{
+    const int numShapes = 30;
+    NifWriter writer;
+    writer.writeHeader(numShapes);
+    for (int i = 0; i < numShapes; ++i)
+        writer.writeTriShapeData(30000);
+    writer.writeRoots({});
+
+    const boost::filesystem::path path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    boost::filesystem::ofstream(path, std::ios::binary) << writer.mData;
+
+    const int runs = 5;
+
+    const auto streamStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; ++i)
+    {
+        const Nif::NIFFile file(Files::openConstrainedFileStream(path.string().c_str()), path.string());
+    }
+    const std::chrono::duration<double> streamElapsed = std::chrono::steady_clock::now() - streamStart;
+
+    const auto mappedStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; ++i)
+    {
+        const Files::MappedFile mapped(path.string());
+        const Nif::NIFFile file(mapped.data(), mapped.size(), path.string());
+    }
+    const std::chrono::duration<double> mappedElapsed = std::chrono::steady_clock::now() - mappedStart;
+
+    boost::filesystem::remove(path);
+
+    std::cout << "Parsed a " << writer.mData.size() / (1024 * 1024) << " MiB file in "
+              << streamElapsed.count() * 1e3 / runs << " ms from a stream, "
+              << mappedElapsed.count() * 1e3 / runs << " ms from a mapping" << std::endl;
+}
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include "components/nifosg/controller.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    std::shared_ptr<Nif::FloatKeyMap> makeFloatKeys(const std::vector<std::pair<float, float> >& keys)
+    {
+        std::shared_ptr<Nif::FloatKeyMap> keyMap(new Nif::FloatKeyMap);
+        for (const auto& key : keys)
+        {
+            Nif::FloatKey value;
+            value.mValue = key.second;
+            keyMap->mTimes.push_back(key.first);
+            keyMap->mKeys.push_back(value);
+        }
+        keyMap->sortKeys();
+        return keyMap;
+    }
+
+    /// A bone turning around an axis, with a key every 1/30 s.
+    std::shared_ptr<Nif::QuaternionKeyMap> makeBoneTrack(int bone, int numKeys)
+    {
+        std::shared_ptr<Nif::QuaternionKeyMap> keyMap(new Nif::QuaternionKeyMap);
+        osg::Vec3f axis(1.f, bone % 3, bone % 5);
+        axis.normalize();
+        for (int i = 0; i < numKeys; ++i)
+        {
+            const float time = i / 30.f;
+
+            Nif::QuaternionKey rotation;
+            rotation.mValue = osg::Quat(std::sin(time + bone), axis);
+            keyMap->mTimes.push_back(time);
+            keyMap->mKeys.push_back(rotation);
+        }
+        return keyMap;
+    }
+
+    /// Samples a rotation the way it was done when keys were loaded into a std::map.
+    osg::Quat sampleMap(const std::map<float, osg::Quat>& keys, float time)
+    {
+        std::map<float, osg::Quat>::const_iterator high = keys.lower_bound(time);
+        if (high == keys.end())
+            return keys.rbegin()->second;
+        if (high == keys.begin())
+            return high->second;
+
+        std::map<float, osg::Quat>::const_iterator low = high;
+        --low;
+        osg::Quat result;
+        result.slerp((time - low->first) / (high->first - low->first), low->second, high->second);
+        return result;
+    }
+
+    std::map<float, osg::Quat> makeRotationMap(const Nif::QuaternionKeyMap& track)
+    {
+        std::map<float, osg::Quat> keys;
+        for (size_t i = 0; i < track.mTimes.size(); ++i)
+            keys[track.mTimes[i]] = track.mKeys[i].mValue;
+        return keys;
+    }
+}
+
+TEST(NifOsgValueInterpolator, should_clamp_and_interpolate)
+{
+    const NifOsg::FloatInterpolator interpolator(makeFloatKeys({ {0.f, 0.f}, {1.f, 10.f}, {3.f, 30.f} }), -1.f);
+
+    EXPECT_FLOAT_EQ(interpolator.interpKey(-1.f), 0.f);
+    EXPECT_FLOAT_EQ(interpolator.interpKey(0.f), 0.f);
+    EXPECT_FLOAT_EQ(interpolator.interpKey(0.5f), 5.f);
+    EXPECT_FLOAT_EQ(interpolator.interpKey(1.f), 10.f);
+    EXPECT_FLOAT_EQ(interpolator.interpKey(2.f), 20.f);
+    EXPECT_FLOAT_EQ(interpolator.interpKey(3.f), 30.f);
+    EXPECT_FLOAT_EQ(interpolator.interpKey(4.f), 30.f);
+    // Jumping backwards must not use the cached position
+    EXPECT_FLOAT_EQ(interpolator.interpKey(0.25f), 2.5f);
+    EXPECT_FLOAT_EQ(interpolator.interpKey(std::nan("")), 0.f);
+
+    EXPECT_FLOAT_EQ(NifOsg::FloatInterpolator(nullptr, -1.f).interpKey(1.f), -1.f);
+}
+
+TEST(NifOsgValueInterpolator, should_sort_keys_and_keep_last_of_equal_times)
+{
+    std::shared_ptr<Nif::FloatKeyMap> keys = makeFloatKeys({ {2.f, 20.f}, {0.f, 0.f}, {1.f, 5.f}, {1.f, 10.f} });
+
+    EXPECT_EQ(keys->mTimes, std::vector<float>({ 0.f, 1.f, 2.f }));
+    ASSERT_EQ(keys->mKeys.size(), 3u);
+    EXPECT_FLOAT_EQ(keys->mKeys[1].mValue, 10.f);
+}
+
+TEST(NifOsgValueInterpolator, should_sample_rotations_like_map_lookups)
+{
+    const std::shared_ptr<Nif::QuaternionKeyMap> track = makeBoneTrack(3, 30);
+    const std::map<float, osg::Quat> keys = makeRotationMap(*track);
+    const NifOsg::QuaternionInterpolator interpolator(track);
+
+    // Forwards, then backwards, then past either end
+    std::vector<float> times;
+    for (int i = 0; i < 100; ++i)
+        times.push_back(i / 99.f);
+    for (int i = 99; i >= 0; --i)
+        times.push_back(i / 99.f);
+    times.push_back(-1.f);
+    times.push_back(2.f);
+
+    for (float time : times)
+    {
+        const osg::Quat expected = sampleMap(keys, time);
+        const osg::Quat actual = interpolator.interpKey(time);
+        for (int i = 0; i < 4; ++i)
+            EXPECT_NEAR(actual[i], expected[i], 1e-5) << time;
+    }
+}
+
+TEST(NifOsgValueInterpolator, DISABLED_animation_update_benchmark)
+{
+    const int numActors = 100;
+    const int numBones = 50;
+    const int numKeys = 300;
+    const int numFrames = 100;
+
+    std::vector<std::shared_ptr<Nif::QuaternionKeyMap> > tracks;
+    for (int bone = 0; bone < numBones; ++bone)
+        tracks.push_back(makeBoneTrack(bone, numKeys));
+
+    // Each actor has its own interpolators over the shared tracks, like cloned KeyframeControllers do
+    std::vector<NifOsg::QuaternionInterpolator> rotations;
+    for (int actor = 0; actor < numActors; ++actor)
+    {
+        for (const std::shared_ptr<Nif::QuaternionKeyMap>& track : tracks)
+            rotations.emplace_back(track);
+    }
+
+    // The same tracks in the std::map layout the keys used to be loaded into
+    std::vector<std::map<float, osg::Quat> > rotationMaps;
+    for (const std::shared_ptr<Nif::QuaternionKeyMap>& track : tracks)
+        rotationMaps.push_back(makeRotationMap(*track));
+
+    const auto start = std::chrono::steady_clock::now();
+    double checksum = 0;
+    for (int frame = 0; frame < numFrames; ++frame)
+    {
+        for (size_t i = 0; i < rotations.size(); ++i)
+        {
+            // Actors are at different points of their animation
+            const float time = (frame + (i / numBones) * 7 % numKeys) / 30.f;
+            checksum += rotations[i].interpKey(time).w();
+        }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    const auto mapStart = std::chrono::steady_clock::now();
+    double mapChecksum = 0;
+    for (int frame = 0; frame < numFrames; ++frame)
+    {
+        for (size_t i = 0; i < rotations.size(); ++i)
+        {
+            const float time = (frame + (i / numBones) * 7 % numKeys) / 30.f;
+            mapChecksum += sampleMap(rotationMaps[i % numBones], time).w();
+        }
+    }
+    const std::chrono::duration<double> mapElapsed = std::chrono::steady_clock::now() - mapStart;
+
+    const double numSamples = static_cast<double>(rotations.size()) * numFrames;
+    std::cout << "Keyframes: " << numActors << " actors x " << numBones << " bones x " << numFrames << " frames: "
+              << elapsed.count() * 1e9 / numSamples << " ns per rotation, "
+              << mapElapsed.count() * 1e9 / numSamples << " ns with std::map lookups (checksums "
+              << checksum << " and " << mapChecksum << ")" << std::endl;
+}
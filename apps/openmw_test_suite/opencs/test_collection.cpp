@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+#include "apps/opencs/model/world/collection.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+    struct TestRecord
+    {
+        std::string mId;
+        int mValue;
+
+        void blank()
+        {
+            mValue = 0;
+        }
+    };
+
+    struct TestCollection : public CSMWorld::Collection<TestRecord>
+    {
+        using CSMWorld::Collection<TestRecord>::reorderRowsImp;
+    };
+
+    CSMWorld::Record<TestRecord> makeRecord(const std::string& id, int value)
+    {
+        CSMWorld::Record<TestRecord> record;
+        record.mState = CSMWorld::RecordBase::State_ModifiedOnly;
+        record.mModified.mId = id;
+        record.mModified.mValue = value;
+        return record;
+    }
+
+    std::string makeId(int number)
+    {
+        std::ostringstream stream;
+        stream << "Record" << number;
+        return stream.str();
+    }
+
+    void expectConsistent(const TestCollection& collection)
+    {
+        for (int row = 0; row < collection.getSize(); ++row)
+            EXPECT_EQ(collection.searchId(collection.getId(row)), row) << collection.getId(row);
+    }
+
+    TEST(CSMWorldCollectionTest, should_find_records_inserted_in_the_middle)
+    {
+        TestCollection collection;
+        collection.appendRecord(makeRecord("a", 1));
+        collection.appendRecord(makeRecord("c", 3));
+        collection.insertRecord(makeRecord("B", 2), 1);
+
+        EXPECT_EQ(collection.getSize(), 3);
+        EXPECT_EQ(collection.searchId("a"), 0);
+        EXPECT_EQ(collection.searchId("b"), 1);
+        EXPECT_EQ(collection.searchId("C"), 2);
+        EXPECT_EQ(collection.searchId("d"), -1);
+        EXPECT_EQ(collection.getRecord("b").get().mValue, 2);
+    }
+
+    TEST(CSMWorldCollectionTest, should_find_records_after_removing_rows)
+    {
+        TestCollection collection;
+        for (int i = 0; i < 10; ++i)
+            collection.appendRecord(makeRecord(makeId(i), i));
+
+        collection.removeRows(2, 3);
+
+        EXPECT_EQ(collection.getSize(), 7);
+        EXPECT_EQ(collection.searchId(makeId(3)), -1);
+        EXPECT_EQ(collection.searchId(makeId(5)), 2);
+        EXPECT_EQ(collection.searchId(makeId(9)), 6);
+        expectConsistent(collection);
+    }
+
+    TEST(CSMWorldCollectionTest, should_find_records_after_mixed_edits)
+    {
+        TestCollection collection;
+        for (int i = 0; i < 20; ++i)
+            collection.appendRecord(makeRecord(makeId(i), i));
+
+        collection.insertRecord(makeRecord("first", 0), 0);
+        EXPECT_EQ(collection.searchId(makeId(19)), 20);
+        collection.removeRows(5, 2);
+        collection.insertRecord(makeRecord("middle", 0), 10);
+        collection.removeRows(0, 1);
+        collection.appendRecord(makeRecord("last", 0));
+
+        EXPECT_EQ(collection.searchId("first"), -1);
+        EXPECT_EQ(collection.searchId(makeId(0)), 0);
+        EXPECT_EQ(collection.searchId("middle"), 9);
+        EXPECT_EQ(collection.searchId("last"), collection.getSize() - 1);
+        expectConsistent(collection);
+    }
+
+    TEST(CSMWorldCollectionTest, should_find_records_after_reordering_rows)
+    {
+        TestCollection collection;
+        for (int i = 0; i < 5; ++i)
+            collection.appendRecord(makeRecord(makeId(i), i));
+
+        std::vector<int> newOrder;
+        newOrder.push_back(2);
+        newOrder.push_back(0);
+        newOrder.push_back(1);
+
+        EXPECT_TRUE(collection.reorderRowsImp(1, newOrder));
+        EXPECT_EQ(collection.getId(1), makeId(2));
+        EXPECT_EQ(collection.getId(2), makeId(3));
+        EXPECT_EQ(collection.getId(3), makeId(1));
+        expectConsistent(collection);
+    }
+
+    TEST(CSMWorldCollectionTest, should_reuse_the_handles_of_removed_records)
+    {
+        TestCollection collection;
+        collection.appendRecord(makeRecord("a", 1));
+        collection.appendRecord(makeRecord("b", 2));
+        collection.removeRows(0, 1);
+        collection.insertRecord(makeRecord("c", 3), 0);
+
+        EXPECT_EQ(collection.searchId("a"), -1);
+        EXPECT_EQ(collection.searchId("c"), 0);
+        EXPECT_EQ(collection.searchId("b"), 1);
+    }
+
+    TEST(CSMWorldCollectionTest, should_list_ids_sorted)
+    {
+        TestCollection collection;
+        collection.appendRecord(makeRecord("b", 1));
+        collection.appendRecord(makeRecord("C", 2));
+        collection.insertRecord(makeRecord("a", 3), 1);
+
+        CSMWorld::Record<TestRecord> deleted = makeRecord("d", 4);
+        deleted.mState = CSMWorld::RecordBase::State_Deleted;
+        deleted.mBase = deleted.mModified;
+        collection.appendRecord(deleted);
+
+        std::vector<std::string> ids = collection.getIds();
+        ASSERT_EQ(ids.size(), 4u);
+        EXPECT_EQ(ids[0], "a");
+        EXPECT_EQ(ids[1], "b");
+        EXPECT_EQ(ids[2], "C");
+        EXPECT_EQ(ids[3], "d");
+
+        EXPECT_EQ(collection.getIds(false).size(), 3u);
+    }
+
+    TEST(CSMWorldCollectionTest, should_remove_deleted_records_on_merge)
+    {
+        TestCollection collection;
+        for (int i = 0; i < 6; ++i)
+            collection.appendRecord(makeRecord(makeId(i), i));
+
+        for (int row = 1; row < 6; row += 2)
+        {
+            CSMWorld::Record<TestRecord> record = collection.getRecord(row);
+            record.mBase = record.mModified;
+            record.mState = CSMWorld::RecordBase::State_Deleted;
+            collection.setRecord(row, record);
+        }
+
+        collection.merge();
+
+        EXPECT_EQ(collection.getSize(), 3);
+        EXPECT_EQ(collection.searchId(makeId(1)), -1);
+        EXPECT_EQ(collection.searchId(makeId(4)), 2);
+        EXPECT_EQ(collection.getIds().size(), 3u);
+        expectConsistent(collection);
+    }
+
+    TEST(CSMWorldCollectionTest, DISABLED_benchmark_bulk_edits)
+    {
+        const int count = 20000;
+
+        typedef std::chrono::steady_clock Clock;
+        TestCollection collection;
+
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < count; ++i)
+            collection.insertRecord(makeRecord(makeId(i), i), collection.getSize() / 2);
+        Clock::time_point inserted = Clock::now();
+
+        for (int i = 0; i < count; ++i)
+            collection.searchId(makeId(i));
+        Clock::time_point searched = Clock::now();
+
+        std::vector<int> newOrder(count / 2);
+        for (int i = 0; i < count / 2; ++i)
+            newOrder[i] = count / 2 - 1 - i;
+        for (int i = 0; i < 10; ++i)
+            collection.reorderRowsImp(count / 4, newOrder);
+        Clock::time_point reordered = Clock::now();
+
+        for (int i = 0; i < 100; ++i)
+            collection.getIds();
+        Clock::time_point listed = Clock::now();
+
+        while (collection.getSize() > 0)
+            collection.removeRows(collection.getSize() / 2, 1);
+        Clock::time_point removed = Clock::now();
+
+        typedef std::chrono::duration<double, std::milli> Milliseconds;
+        std::cout << count << " records: insert " << Milliseconds(inserted - start).count()
+                  << " ms, search " << Milliseconds(searched - inserted).count()
+                  << " ms, 10 reorders " << Milliseconds(reordered - searched).count()
+                  << " ms, 100 getIds " << Milliseconds(listed - reordered).count()
+                  << " ms, remove " << Milliseconds(removed - listed).count() << " ms" << std::endl;
+    }
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "components/openmw-mp/ChecksumCache.hpp"
+#include "components/openmw-mp/Utils.hpp"
+
+#include <boost/crc.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+    unsigned int boostCrc32(const std::string &data)
+    {
+        boost::crc_32_type crc32;
+        crc32.process_bytes(data.data(), data.size());
+        return crc32.checksum();
+    }
+
+    std::string makeData(size_t size, unsigned int seed)
+    {
+        std::string data(size, '\0');
+        for (size_t i = 0; i < size; ++i)
+        {
+            seed = seed * 1103515245 + 12345;
+            data[i] = static_cast<char>(seed >> 16);
+        }
+        return data;
+    }
+
+    void writeFile(const boost::filesystem::path &path, const std::string &data)
+    {
+        boost::filesystem::ofstream stream(path, std::ios_base::binary | std::ios_base::trunc);
+        stream.write(data.data(), data.size());
+    }
+
+    struct ChecksumCacheTest : public ::testing::Test
+    {
+        boost::filesystem::path mDirectory;
+
+        void SetUp()
+        {
+            mDirectory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+            boost::filesystem::create_directories(mDirectory);
+        }
+
+        void TearDown()
+        {
+            boost::filesystem::remove_all(mDirectory);
+        }
+    };
+}
+
+TEST(OpenmwMpUtilsCrc32, should_match_boost_crc_for_all_sizes_and_alignments)
+{
+    const std::string data = makeData(300, 1);
+    for (size_t offset = 0; offset < 8; ++offset)
+    {
+        for (size_t size = 0; size + offset <= data.size(); size += 7)
+        {
+            const std::string part = data.substr(offset, size);
+            EXPECT_EQ(Utils::crc32(part.data(), part.size()), boostCrc32(part)) << "offset " << offset << " size " << size;
+        }
+    }
+}
+
+TEST(OpenmwMpUtilsCrc32, should_continue_from_previous_checksum)
+{
+    const std::string data = makeData(1000, 2);
+    const unsigned int first = Utils::crc32(data.data(), 123);
+    EXPECT_EQ(Utils::crc32(data.data() + 123, data.size() - 123, first), boostCrc32(data));
+}
+
+TEST_F(ChecksumCacheTest, should_hash_files_and_reuse_cached_checksums)
+{
+    const boost::filesystem::path cacheFile = mDirectory / "cache" / "checksums.txt";
+
+    std::vector<boost::filesystem::path> files;
+    std::vector<std::string> contents;
+    for (unsigned int i = 0; i < 5; ++i)
+    {
+        contents.push_back(makeData(100000 + i * 1000, i));
+        files.push_back(mDirectory / ("file " + std::to_string(i) + ".esp"));
+        writeFile(files.back(), contents.back());
+    }
+
+    std::vector<unsigned int> expected;
+    for (const std::string &data : contents)
+        expected.push_back(boostCrc32(data));
+
+    {
+        mwmp::ChecksumCache cache(cacheFile);
+        EXPECT_EQ(cache.getChecksums(files), expected);
+    }
+    ASSERT_TRUE(boost::filesystem::exists(cacheFile));
+
+    // Swapping the content of a file without changing its size or time can only go unnoticed if the cache is used
+    const std::time_t modified = boost::filesystem::last_write_time(files[0]);
+    writeFile(files[0], makeData(contents[0].size(), 42));
+    boost::filesystem::last_write_time(files[0], modified);
+
+    {
+        mwmp::ChecksumCache cache(cacheFile);
+        EXPECT_EQ(cache.getChecksums(files), expected);
+    }
+
+    // A changed time makes the file get hashed again
+    boost::filesystem::last_write_time(files[0], modified + 10);
+    expected[0] = boostCrc32(makeData(contents[0].size(), 42));
+
+    mwmp::ChecksumCache cache(cacheFile);
+    EXPECT_EQ(cache.getChecksums(files), expected);
+}
+
+TEST_F(ChecksumCacheTest, should_return_zero_for_missing_files)
+{
+    mwmp::ChecksumCache cache(mDirectory / "checksums.txt");
+    const std::vector<boost::filesystem::path> files(1, mDirectory / "missing.esp");
+    EXPECT_EQ(cache.getChecksums(files), std::vector<unsigned int>(1, 0));
+}
@@ -0,0 +1,248 @@
+#include <gtest/gtest.h>
+#include "apps/openmw-mp/MapTileAtlas.hpp"
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <set>
+
+namespace
+{
+    mwmp::MapTile makeTile(int x, int y, unsigned int seed, size_t size = mwmp::maxImageDataSize)
+    {
+        mwmp::MapTile mapTile;
+        mapTile.x = x;
+        mapTile.y = y;
+        mapTile.imageData.resize(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            seed = seed * 1103515245 + 12345;
+            mapTile.imageData[i] = static_cast<char>(seed >> 16);
+        }
+        return mapTile;
+    }
+
+    struct MapTileAtlasTest : public ::testing::Test
+    {
+        boost::filesystem::path mDirectory;
+        std::string mPath;
+
+        void SetUp()
+        {
+            mDirectory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+            boost::filesystem::create_directories(mDirectory);
+            mPath = (mDirectory / "maptiles.atlas").string();
+        }
+
+        void TearDown()
+        {
+            boost::filesystem::remove_all(mDirectory);
+        }
+
+        // Writes a tile straight into a slot of the file, like a server that stopped halfway through storing it
+        void writeSlot(uint32_t index, const mwmp::MapTile &mapTile, uint32_t version)
+        {
+            const size_t headerSize = 16;
+            const size_t slotSize = 16 + mwmp::maxImageDataSize;
+
+            boost::filesystem::fstream stream(mPath, std::ios::in | std::ios::out | std::ios::binary);
+            stream.seekp(headerSize + index * slotSize);
+
+            const int32_t fields[] = {mapTile.x, mapTile.y};
+            const uint32_t sizes[] = {version, static_cast<uint32_t>(mapTile.imageData.size())};
+            stream.write(reinterpret_cast<const char*>(fields), sizeof(fields));
+            stream.write(reinterpret_cast<const char*>(sizes), sizeof(sizes));
+            stream.write(mapTile.imageData.data(), mapTile.imageData.size());
+        }
+    };
+}
+
+TEST_F(MapTileAtlasTest, should_send_only_tiles_that_are_unknown_or_newer)
+{
+    MapTileAtlas atlas(mPath);
+    const uint32_t first = atlas.store(makeTile(0, 0, 1));
+    atlas.store(makeTile(1, 0, 2));
+
+    // Storing the same image again keeps the version
+    EXPECT_EQ(atlas.store(makeTile(0, 0, 1)), first);
+
+    MapTileAtlas::KnownTiles known;
+    known.versions[MapTileAtlas::Coordinates(1, 0)] = atlas.store(makeTile(1, 0, 3));
+
+    std::vector<mwmp::MapTile> mapTiles;
+    EXPECT_FALSE(atlas.getUnknownTiles(known, mapTiles, 1024 * 1024));
+    ASSERT_EQ(mapTiles.size(), 1u);
+    EXPECT_EQ(mapTiles[0].x, 0);
+    EXPECT_EQ(mapTiles[0].imageData, makeTile(0, 0, 1).imageData);
+    EXPECT_FALSE(atlas.hasUnknownTiles(known));
+
+    atlas.store(makeTile(0, 0, 4));
+    EXPECT_TRUE(atlas.hasUnknownTiles(known));
+
+    mapTiles.clear();
+    atlas.getUnknownTiles(known, mapTiles, 1024 * 1024);
+    ASSERT_EQ(mapTiles.size(), 1u);
+    EXPECT_EQ(mapTiles[0].imageData, makeTile(0, 0, 4).imageData);
+}
+
+TEST_F(MapTileAtlasTest, should_keep_tiles_and_versions_when_reopened)
+{
+    uint32_t lastVersion = 0;
+    {
+        MapTileAtlas atlas(mPath);
+        for (int i = 0; i < 600; ++i)
+            lastVersion = atlas.store(makeTile(i % 40, i / 40, i, i % 2 ? mwmp::maxImageDataSize : 100));
+    }
+
+    MapTileAtlas atlas(mPath);
+    EXPECT_EQ(atlas.getTileCount(), 600u);
+    EXPECT_GT(atlas.store(makeTile(1000, 1000, 1)), lastVersion);
+
+    MapTileAtlas::KnownTiles known;
+    std::vector<mwmp::MapTile> mapTiles;
+    atlas.getUnknownTiles(known, mapTiles, std::numeric_limits<size_t>::max());
+    ASSERT_EQ(mapTiles.size(), 601u);
+    EXPECT_EQ(mapTiles[5].imageData, makeTile(5, 0, 5, mwmp::maxImageDataSize).imageData);
+    EXPECT_EQ(mapTiles[6].imageData.size(), 100u);
+}
+
+TEST_F(MapTileAtlasTest, should_reuse_the_slots_of_changed_tiles)
+{
+    {
+        MapTileAtlas atlas(mPath);
+        atlas.store(makeTile(1, 0, 1));
+        for (int i = 0; i < 1000; ++i)
+            atlas.store(makeTile(0, 0, i));
+    }
+    EXPECT_EQ(boost::filesystem::file_size(mPath), 16 + 256 * (16 + mwmp::maxImageDataSize));
+
+    MapTileAtlas atlas(mPath);
+    EXPECT_EQ(atlas.getTileCount(), 2u);
+
+    MapTileAtlas::KnownTiles known;
+    std::vector<mwmp::MapTile> mapTiles;
+    atlas.getUnknownTiles(known, mapTiles, std::numeric_limits<size_t>::max());
+    ASSERT_EQ(mapTiles.size(), 2u);
+    EXPECT_EQ(mapTiles[1].imageData, makeTile(0, 0, 999).imageData);
+}
+
+TEST_F(MapTileAtlasTest, should_keep_the_old_tile_when_a_change_was_only_partly_written)
+{
+    uint32_t version;
+    {
+        MapTileAtlas atlas(mPath);
+        version = atlas.store(makeTile(0, 0, 1));
+    }
+
+    // The new image data is in the next slot, but its version isn't
+    writeSlot(1, makeTile(0, 0, 2), 0);
+
+    MapTileAtlas atlas(mPath);
+    EXPECT_EQ(atlas.getTileCount(), 1u);
+    EXPECT_EQ(atlas.store(makeTile(0, 0, 1)), version);
+}
+
+TEST_F(MapTileAtlasTest, should_keep_the_newer_tile_when_the_old_slot_was_not_freed)
+{
+    {
+        MapTileAtlas atlas(mPath);
+        atlas.store(makeTile(0, 0, 1));
+    }
+
+    writeSlot(1, makeTile(0, 0, 2), 5);
+
+    {
+        MapTileAtlas atlas(mPath);
+        EXPECT_EQ(atlas.getTileCount(), 1u);
+        EXPECT_EQ(atlas.store(makeTile(0, 0, 2)), 5u);
+        EXPECT_GT(atlas.store(makeTile(1, 0, 3)), 5u);
+    }
+
+    MapTileAtlas atlas(mPath);
+    MapTileAtlas::KnownTiles known;
+    std::vector<mwmp::MapTile> mapTiles;
+    atlas.getUnknownTiles(known, mapTiles, std::numeric_limits<size_t>::max());
+    ASSERT_EQ(mapTiles.size(), 2u);
+    EXPECT_EQ(mapTiles[0].imageData, makeTile(0, 0, 2).imageData);
+    EXPECT_EQ(mapTiles[1].imageData, makeTile(1, 0, 3).imageData);
+}
+
+TEST_F(MapTileAtlasTest, should_reject_other_files)
+{
+    boost::filesystem::ofstream(mPath) << "not an atlas";
+    EXPECT_THROW(MapTileAtlas atlas(mPath), std::runtime_error);
+}
+
+TEST_F(MapTileAtlasTest, should_send_a_joining_player_every_unknown_tile_across_packets)
+{
+    const size_t packetSize = 16 * 1024;
+
+    MapTileAtlas atlas(mPath);
+    for (int i = 0; i < 200; ++i)
+        atlas.store(makeTile(i % 20, i / 20, i));
+
+    MapTileAtlas::KnownTiles known;
+    for (int i = 0; i < 200; i += 10)
+        known.versions[MapTileAtlas::Coordinates(i % 20, i / 20)] = std::numeric_limits<uint32_t>::max();
+
+    std::set<MapTileAtlas::Coordinates> sent;
+    std::vector<mwmp::MapTile> mapTiles;
+    bool left = true;
+    while (left)
+    {
+        mapTiles.clear();
+        left = atlas.getUnknownTiles(known, mapTiles, packetSize);
+
+        size_t bytes = 0;
+        for (const mwmp::MapTile &mapTile : mapTiles)
+        {
+            EXPECT_NE(mapTile.x % 10, 0);
+            EXPECT_TRUE(sent.insert(MapTileAtlas::Coordinates(mapTile.x, mapTile.y)).second);
+            bytes += mapTile.imageData.size();
+        }
+
+        // A packet only goes over its size by the last tile added to it
+        EXPECT_LT(bytes, packetSize + mwmp::maxImageDataSize);
+    }
+
+    EXPECT_EQ(sent.size(), 180u);
+    EXPECT_FALSE(atlas.hasUnknownTiles(known));
+}
+
+TEST_F(MapTileAtlasTest, DISABLED_joining_player_benchmark)
+{
+    const int numTiles = 5000;
+    const size_t packetSize = 16 * 1024;
+
+    MapTileAtlas atlas(mPath);
+    const auto storeStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < numTiles; ++i)
+        atlas.store(makeTile(i % 100 - 50, i / 100 - 25, i));
+    const std::chrono::duration<double> storeElapsed = std::chrono::steady_clock::now() - storeStart;
+
+    // The joining player explored a tenth of the map already
+    MapTileAtlas::KnownTiles known;
+    for (int i = 0; i < numTiles; i += 10)
+        known.versions[MapTileAtlas::Coordinates(i % 100 - 50, i / 100 - 25)] = std::numeric_limits<uint32_t>::max();
+
+    size_t sentTiles = 0;
+    size_t packets = 0;
+    const auto sendStart = std::chrono::steady_clock::now();
+    std::vector<mwmp::MapTile> mapTiles;
+    bool left = true;
+    while (left)
+    {
+        mapTiles.clear();
+        left = atlas.getUnknownTiles(known, mapTiles, packetSize);
+        sentTiles += mapTiles.size();
+        ++packets;
+    }
+    const std::chrono::duration<double> sendElapsed = std::chrono::steady_clock::now() - sendStart;
+
+    std::cout << "Map tile atlas: stored " << numTiles << " tiles in " << storeElapsed.count() * 1e3 << " ms, "
+              << "collected " << sentTiles << " unknown tiles in " << packets << " packets in "
+              << sendElapsed.count() * 1e3 << " ms" << std::endl;
+}
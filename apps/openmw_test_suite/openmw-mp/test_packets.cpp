@@ -0,0 +1,324 @@
+#include <gtest/gtest.h>
+#include "components/openmw-mp/Packets/Actor/PacketActorPosition.hpp"
+#include "components/openmw-mp/Packets/Object/PacketContainer.hpp"
+#include "components/openmw-mp/Packets/Player/PacketPlayerInventory.hpp"
+#include "components/openmw-mp/Packets/Worldstate/PacketWorldMap.hpp"
+
+#include <BitStream.h>
+#include <MessageIdentifiers.h>
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+    const int numIterations = 200;
+
+    std::string makeId(const std::string &prefix, int index)
+    {
+        std::ostringstream stream;
+        stream << prefix << index;
+        return stream.str();
+    }
+
+    // The networking code takes the packet ID and GUID off before a packet reads the rest
+    void read(mwmp::BasePacket &packet, RakNet::BitStream &written)
+    {
+        RakNet::BitStream stream(written.GetData(), written.GetNumberOfBytesUsed(), false);
+        stream.IgnoreBytes(sizeof(RakNet::MessageID));
+        stream.IgnoreBytes(RakNet::RakNetGUID::size());
+        packet.Packet(&stream, false);
+    }
+
+    template <class Function>
+    double measure(Function function)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < numIterations; ++i)
+            function();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() * 1e6 / numIterations;
+    }
+
+    // Times writing a packet with the data setSent gives it, and reading it into the data setReceived gives it
+    template <class SetSent, class SetReceived>
+    void printTimings(const std::string &name, mwmp::BasePacket &packet, SetSent setSent, SetReceived setReceived)
+    {
+        setSent();
+        RakNet::BitStream stream;
+        const double encode = measure([&] {
+            stream.Reset();
+            packet.Packet(&stream, true);
+        });
+
+        setReceived();
+        const double decode = measure([&] { read(packet, stream); });
+
+        std::cout << name << ": " << stream.GetNumberOfBytesUsed() << " bytes, encoded in " << encode
+                  << " us, decoded in " << decode << " us" << std::endl;
+    }
+
+    mwmp::BaseActorList makeActorList()
+    {
+        mwmp::BaseActorList actorList;
+        actorList.cell.mData.mX = 3;
+        actorList.cell.mData.mY = -7;
+        for (int i = 0; i < 1000; ++i)
+        {
+            mwmp::BaseActor actor;
+            actor.refNum = i;
+            actor.mpNum = i * 3;
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                actor.position.pos[axis] = i * 10.5f + axis;
+                actor.position.rot[axis] = axis * 0.25f;
+                actor.direction.pos[axis] = axis - 1.f;
+            }
+            actorList.baseActors.push_back(actor);
+        }
+        return actorList;
+    }
+
+    mwmp::BaseObjectList makeContainers()
+    {
+        mwmp::BaseObjectList objectList;
+        objectList.packetOrigin = 0;
+        objectList.action = mwmp::BaseObjectList::SET;
+        objectList.containerSubAction = 0;
+        objectList.cell.mName = "Balmora";
+        for (int i = 0; i < 100; ++i)
+        {
+            mwmp::BaseObject object;
+            object.refId = makeId("chest_", i);
+            object.refNum = i;
+            object.mpNum = 0;
+            for (int j = 0; j < 30; ++j)
+            {
+                mwmp::ContainerItem item;
+                item.refId = makeId("item_", j);
+                item.count = j + 1;
+                item.charge = -1;
+                item.enchantmentCharge = -1;
+                item.soul = j % 5 ? "" : "ancestor_ghost";
+                item.actionCount = 0;
+                object.containerItems.push_back(item);
+            }
+            objectList.baseObjects.push_back(object);
+        }
+        return objectList;
+    }
+
+    void makeInventory(mwmp::BasePlayer &player)
+    {
+        player.inventoryChanges.action = mwmp::InventoryChanges::SET;
+        for (int i = 0; i < 500; ++i)
+        {
+            mwmp::Item item;
+            item.refId = makeId("misc_item_", i);
+            item.count = i;
+            item.charge = i % 7;
+            item.enchantmentCharge = i * 0.5f;
+            item.soul = "";
+            player.inventoryChanges.items.push_back(item);
+        }
+    }
+
+    mwmp::BaseWorldstate makeWorldMap()
+    {
+        mwmp::BaseWorldstate worldstate;
+        for (int i = 0; i < 50; ++i)
+        {
+            mwmp::MapTile mapTile;
+            mapTile.x = i % 10 - 5;
+            mapTile.y = i / 10;
+            mapTile.imageData.resize(mwmp::maxImageDataSize);
+            for (size_t j = 0; j < mapTile.imageData.size(); ++j)
+                mapTile.imageData[j] = static_cast<char>(i * 31 + j);
+            worldstate.mapTiles.push_back(mapTile);
+        }
+        return worldstate;
+    }
+}
+
+TEST(MWMPPacketsTest, actor_position_round_trip)
+{
+    mwmp::BaseActorList actorList = makeActorList();
+
+    mwmp::PacketActorPosition packet(nullptr);
+    packet.setActorList(&actorList);
+    RakNet::BitStream stream;
+    packet.Packet(&stream, true);
+
+    mwmp::BaseActorList received;
+    packet.setActorList(&received);
+    read(packet, stream);
+
+    ASSERT_EQ(received.baseActors.size(), actorList.baseActors.size());
+    for (size_t i = 0; i < received.baseActors.size(); ++i)
+    {
+        EXPECT_EQ(received.baseActors[i].refNum, actorList.baseActors[i].refNum);
+        EXPECT_EQ(received.baseActors[i].mpNum, actorList.baseActors[i].mpNum);
+        EXPECT_EQ(received.baseActors[i].position.pos[0], actorList.baseActors[i].position.pos[0]);
+        EXPECT_EQ(received.baseActors[i].direction.pos[2], actorList.baseActors[i].direction.pos[2]);
+    }
+}
+
+TEST(MWMPPacketsTest, container_round_trip)
+{
+    mwmp::BaseObjectList objectList = makeContainers();
+
+    mwmp::PacketContainer packet(nullptr);
+    packet.setObjectList(&objectList);
+    RakNet::BitStream stream;
+    packet.Packet(&stream, true);
+
+    mwmp::BaseObjectList received;
+    packet.setObjectList(&received);
+    read(packet, stream);
+
+    ASSERT_EQ(received.baseObjects.size(), objectList.baseObjects.size());
+    for (size_t i = 0; i < received.baseObjects.size(); ++i)
+    {
+        const mwmp::BaseObject &object = received.baseObjects[i];
+        EXPECT_EQ(object.refId, objectList.baseObjects[i].refId);
+        ASSERT_EQ(object.containerItems.size(), objectList.baseObjects[i].containerItems.size());
+        for (size_t j = 0; j < object.containerItems.size(); ++j)
+        {
+            EXPECT_EQ(object.containerItems[j].refId, objectList.baseObjects[i].containerItems[j].refId);
+            EXPECT_EQ(object.containerItems[j].count, objectList.baseObjects[i].containerItems[j].count);
+            EXPECT_EQ(object.containerItems[j].soul, objectList.baseObjects[i].containerItems[j].soul);
+        }
+    }
+}
+
+TEST(MWMPPacketsTest, player_inventory_round_trip)
+{
+    mwmp::BasePlayer player;
+    makeInventory(player);
+
+    mwmp::PacketPlayerInventory packet(nullptr);
+    packet.setPlayer(&player);
+    RakNet::BitStream stream;
+    packet.Packet(&stream, true);
+
+    mwmp::BasePlayer received;
+    packet.setPlayer(&received);
+    read(packet, stream);
+
+    ASSERT_TRUE(packet.isPacketValid());
+    ASSERT_EQ(received.inventoryChanges.count, 500u);
+    ASSERT_EQ(received.inventoryChanges.items.size(), player.inventoryChanges.items.size());
+    for (size_t i = 0; i < received.inventoryChanges.items.size(); ++i)
+        EXPECT_TRUE(received.inventoryChanges.items[i] == player.inventoryChanges.items[i]);
+}
+
+TEST(MWMPPacketsTest, player_inventory_should_reject_count_beyond_packet_end)
+{
+    mwmp::BasePlayer player;
+    player.inventoryChanges.action = mwmp::InventoryChanges::ADD;
+
+    mwmp::PacketPlayerInventory packet(nullptr);
+    packet.setPlayer(&player);
+    RakNet::BitStream stream;
+    packet.Packet(&stream, true);
+
+    // Claim far more items than the packet holds
+    RakNet::BitStream corrupt;
+    corrupt.Write(stream.GetData(), stream.GetNumberOfBytesUsed() - sizeof(uint32_t));
+    corrupt.Write(uint32_t(0xFFFFFFFF));
+
+    mwmp::BasePlayer received;
+    packet.setPlayer(&received);
+    read(packet, corrupt);
+
+    EXPECT_FALSE(packet.isPacketValid());
+    EXPECT_EQ(received.inventoryChanges.count, 0u);
+    EXPECT_TRUE(received.inventoryChanges.items.empty());
+}
+
+TEST(MWMPPacketsTest, world_map_round_trip)
+{
+    mwmp::BaseWorldstate worldstate = makeWorldMap();
+
+    mwmp::PacketWorldMap packet(nullptr);
+    packet.setWorldstate(&worldstate);
+    RakNet::BitStream stream;
+    packet.Packet(&stream, true);
+
+    mwmp::BaseWorldstate received;
+    packet.setWorldstate(&received);
+    read(packet, stream);
+
+    ASSERT_TRUE(packet.isPacketValid());
+    ASSERT_EQ(received.mapTiles.size(), worldstate.mapTiles.size());
+    for (size_t i = 0; i < received.mapTiles.size(); ++i)
+    {
+        EXPECT_EQ(received.mapTiles[i].x, worldstate.mapTiles[i].x);
+        EXPECT_EQ(received.mapTiles[i].y, worldstate.mapTiles[i].y);
+        EXPECT_EQ(received.mapTiles[i].imageData, worldstate.mapTiles[i].imageData);
+    }
+}
+
+TEST(MWMPPacketsTest, world_map_should_reject_image_data_beyond_packet_end)
+{
+    mwmp::BaseWorldstate worldstate;
+    mwmp::MapTile mapTile;
+    mapTile.x = 1;
+    mapTile.y = 2;
+    mapTile.imageData.assign(100, 'a');
+    worldstate.mapTiles.push_back(mapTile);
+
+    mwmp::PacketWorldMap packet(nullptr);
+    packet.setWorldstate(&worldstate);
+    RakNet::BitStream stream;
+    packet.Packet(&stream, true);
+
+    // Cut the image data short
+    RakNet::BitStream corrupt;
+    corrupt.Write(stream.GetData(), stream.GetNumberOfBytesUsed() - 50);
+
+    mwmp::BaseWorldstate received;
+    packet.setWorldstate(&received);
+    read(packet, corrupt);
+
+    EXPECT_FALSE(packet.isPacketValid());
+    ASSERT_EQ(received.mapTiles.size(), 1u);
+    EXPECT_TRUE(received.mapTiles[0].imageData.empty());
+}
+
+TEST(MWMPPacketsTest, DISABLED_round_trip_benchmark)
+{
+    {
+        mwmp::BaseActorList actorList = makeActorList();
+        mwmp::BaseActorList received;
+        mwmp::PacketActorPosition packet(nullptr);
+        printTimings("ID_ACTOR_POSITION with 1000 actors", packet,
+                     [&] { packet.setActorList(&actorList); }, [&] { packet.setActorList(&received); });
+    }
+
+    {
+        mwmp::BaseObjectList objectList = makeContainers();
+        mwmp::BaseObjectList received;
+        mwmp::PacketContainer packet(nullptr);
+        printTimings("ID_CONTAINER with 100 containers of 30 items", packet,
+                     [&] { packet.setObjectList(&objectList); }, [&] { packet.setObjectList(&received); });
+    }
+
+    {
+        mwmp::BasePlayer player;
+        makeInventory(player);
+        mwmp::BasePlayer received;
+        mwmp::PacketPlayerInventory packet(nullptr);
+        printTimings("ID_PLAYER_INVENTORY with 500 items", packet,
+                     [&] { packet.setPlayer(&player); }, [&] { packet.setPlayer(&received); });
+    }
+
+    {
+        mwmp::BaseWorldstate worldstate = makeWorldMap();
+        mwmp::BaseWorldstate received;
+        mwmp::PacketWorldMap packet(nullptr);
+        printTimings("ID_WORLD_MAP with 50 tiles", packet,
+                     [&] { packet.setWorldstate(&worldstate); }, [&] { packet.setWorldstate(&received); });
+    }
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "components/resource/objectcache.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using Resource::ObjectCache;
+
+TEST(ResourceObjectCacheTest, should_let_one_thread_load_while_the_others_wait)
+{
+    osg::ref_ptr<ObjectCache> cache(new ObjectCache);
+    std::atomic<int> numLoads(0);
+    std::vector<osg::ref_ptr<osg::Object> > results(4);
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        threads.emplace_back([&, i] ()
+        {
+            osg::ref_ptr<osg::Object> object = cache->getRefFromObjectCacheOrStartLoading("mesh");
+            if (!object)
+            {
+                ++numLoads;
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                object = new osg::Node;
+                cache->addEntryToObjectCache("mesh", object);
+            }
+            results[i] = object;
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(numLoads, 1);
+    for (const osg::ref_ptr<osg::Object>& result : results)
+        EXPECT_EQ(result.get(), results[0].get());
+}
+
+TEST(ResourceObjectCacheTest, should_let_a_waiting_thread_load_when_loading_is_cancelled)
+{
+    osg::ref_ptr<ObjectCache> cache(new ObjectCache);
+    ASSERT_FALSE(cache->getRefFromObjectCacheOrStartLoading("mesh").valid());
+
+    std::atomic<bool> hasStarted(false);
+    std::atomic<bool> hasLoaded(false);
+    std::thread waiting([&] ()
+    {
+        hasStarted = true;
+        if (!cache->getRefFromObjectCacheOrStartLoading("mesh"))
+        {
+            cache->addEntryToObjectCache("mesh", new osg::Node);
+            hasLoaded = true;
+        }
+    });
+
+    while (!hasStarted)
+        std::this_thread::yield();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(hasLoaded);
+
+    cache->cancelLoading("mesh");
+    waiting.join();
+
+    EXPECT_TRUE(hasLoaded);
+    EXPECT_TRUE(cache->getRefFromObjectCacheOrStartLoading("mesh").valid());
+}
+
+TEST(ResourceObjectCacheTest, should_not_wait_for_a_load_of_the_same_thread)
+{
+    osg::ref_ptr<ObjectCache> cache(new ObjectCache);
+    EXPECT_FALSE(cache->getRefFromObjectCacheOrStartLoading("mesh").valid());
+    EXPECT_FALSE(cache->getRefFromObjectCacheOrStartLoading("mesh").valid());
+
+    cache->addEntryToObjectCache("mesh", new osg::Node);
+    EXPECT_TRUE(cache->getRefFromObjectCacheOrStartLoading("mesh").valid());
+}
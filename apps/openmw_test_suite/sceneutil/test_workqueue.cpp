@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include "components/sceneutil/workqueue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    class CountItem : public SceneUtil::WorkItem
+    {
+    public:
+        CountItem(std::atomic<unsigned int>& counter)
+            : mCounter(counter)
+        {
+        }
+
+        virtual void doWork()
+        {
+            ++mCounter;
+        }
+
+    private:
+        std::atomic<unsigned int>& mCounter;
+    };
+
+    /// Keeps a work thread busy until released.
+    class BlockingItem : public SceneUtil::WorkItem
+    {
+    public:
+        BlockingItem()
+            : mStarted(false)
+            , mReleased(false)
+        {
+        }
+
+        virtual void doWork()
+        {
+            mStarted = true;
+            while (!mReleased)
+                std::this_thread::yield();
+        }
+
+        void waitTillStarted()
+        {
+            while (!mStarted)
+                std::this_thread::yield();
+        }
+
+        void release()
+        {
+            mReleased = true;
+        }
+
+    private:
+        std::atomic<bool> mStarted;
+        std::atomic<bool> mReleased;
+    };
+
+    class RecordItem : public SceneUtil::WorkItem
+    {
+    public:
+        RecordItem(int id, std::mutex& mutex, std::vector<int>& order)
+            : mId(id)
+            , mMutex(mutex)
+            , mOrder(order)
+        {
+        }
+
+        virtual void doWork()
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mOrder.push_back(mId);
+        }
+
+    private:
+        int mId;
+        std::mutex& mMutex;
+        std::vector<int>& mOrder;
+    };
+}
+
+TEST(SceneUtilWorkQueue, should_complete_all_items)
+{
+    std::atomic<unsigned int> counter(0);
+    std::vector<osg::ref_ptr<SceneUtil::WorkItem> > items;
+    {
+        osg::ref_ptr<SceneUtil::WorkQueue> queue(new SceneUtil::WorkQueue(4));
+        for (int i = 0; i < 1000; ++i)
+        {
+            items.push_back(new CountItem(counter));
+            queue->addWorkItem(items.back(), i % 10 == 0);
+        }
+        for (const osg::ref_ptr<SceneUtil::WorkItem>& item : items)
+            item->waitTillDone();
+        EXPECT_EQ(queue->getNumItems(), 0u);
+    }
+    EXPECT_EQ(counter, 1000u);
+}
+
+TEST(SceneUtilWorkQueue, should_take_front_items_first_then_by_priority)
+{
+    std::mutex mutex;
+    std::vector<int> order;
+
+    osg::ref_ptr<SceneUtil::WorkQueue> queue(new SceneUtil::WorkQueue(1));
+    osg::ref_ptr<BlockingItem> blocker(new BlockingItem);
+    queue->addWorkItem(blocker);
+    blocker->waitTillStarted();
+
+    std::vector<osg::ref_ptr<SceneUtil::WorkItem> > items;
+    const float priorities[] = { 0.f, 2.f, 1.f, 2.f };
+    for (int i = 0; i < 4; ++i)
+    {
+        items.push_back(new RecordItem(i, mutex, order));
+        items.back()->setPriority(priorities[i]);
+        queue->addWorkItem(items.back());
+    }
+    items.push_back(new RecordItem(4, mutex, order));
+    queue->addWorkItem(items.back(), true);
+
+    // Priorities can change while queued
+    items[0]->setPriority(1.5f);
+
+    blocker->release();
+    for (const osg::ref_ptr<SceneUtil::WorkItem>& item : items)
+        item->waitTillDone();
+
+    EXPECT_EQ(order, std::vector<int>({ 4, 1, 3, 0, 2 }));
+}
+
+TEST(SceneUtilWorkQueue, cancelled_item_should_be_done_without_running)
+{
+    std::atomic<unsigned int> counter(0);
+
+    osg::ref_ptr<SceneUtil::WorkQueue> queue(new SceneUtil::WorkQueue(1));
+    osg::ref_ptr<BlockingItem> blocker(new BlockingItem);
+    queue->addWorkItem(blocker);
+    blocker->waitTillStarted();
+
+    osg::ref_ptr<SceneUtil::WorkItem> item(new CountItem(counter));
+    queue->addWorkItem(item);
+    EXPECT_EQ(queue->getNumItems(), 1u);
+
+    EXPECT_TRUE(queue->cancelWorkItem(item));
+    EXPECT_TRUE(item->isDone());
+    EXPECT_EQ(queue->getNumItems(), 0u);
+    EXPECT_FALSE(queue->cancelWorkItem(item));
+    EXPECT_FALSE(queue->cancelWorkItem(blocker));
+
+    blocker->release();
+    blocker->waitTillDone();
+    EXPECT_EQ(counter, 0u);
+}
+
+TEST(SceneUtilWorkQueue, DISABLED_throughput_by_thread_count)
+{
+    const unsigned int numItems = 20000;
+
+    for (int threads = 1; threads <= 8; threads *= 2)
+    {
+        std::atomic<unsigned int> counter(0);
+        std::vector<osg::ref_ptr<SceneUtil::WorkItem> > items;
+        items.reserve(numItems);
+        for (unsigned int i = 0; i < numItems; ++i)
+            items.push_back(new CountItem(counter));
+
+        osg::ref_ptr<SceneUtil::WorkQueue> queue(new SceneUtil::WorkQueue(threads));
+
+        const auto start = std::chrono::steady_clock::now();
+        for (const osg::ref_ptr<SceneUtil::WorkItem>& item : items)
+            queue->addWorkItem(item);
+        for (const osg::ref_ptr<SceneUtil::WorkItem>& item : items)
+            item->waitTillDone();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        EXPECT_EQ(counter, numItems);
+        std::cout << "WorkQueue: " << threads << " thread(s): " << numItems << " items in "
+                  << elapsed.count() * 1000 << " ms (" << numItems / elapsed.count() << " items/s)" << std::endl;
+    }
+}
@@ -182,3 +182,11 @@ Files::IStreamPtr BSAFile::getFile(const FileStruct *file)
 {
     return Files::openConstrainedFileStream (mFilename.c_str (), file->offset, file->fileSize);
 }
+
+Files::MappedFilePtr BSAFile::mapFile(const FileStruct *file) const
+{
+    // An empty region can't be mapped
+    if (file->fileSize == 0)
+        return Files::MappedFilePtr();
+    return std::make_shared<Files::MappedFile>(mFilename, file->offset, file->fileSize);
+}
@@ -32,6 +32,7 @@
 #include <components/misc/stringops.hpp>
 
 #include <components/files/constrainedfilestream.hpp>
+#include <components/files/mappedfile.hpp>
 
 
 namespace Bsa
@@ -132,6 +133,12 @@ public:
     */
     virtual Files::IStreamPtr getFile(const FileStruct* file);
 
+    /** Map a file contained in the archive into memory, or return null if it is not stored as is.
+     * @note Throws an exception if mapping fails.
+     * @note Thread safe.
+    */
+    virtual Files::MappedFilePtr mapFile(const FileStruct* file) const;
+
     /// Get a list of all files
     /// @note Thread safe.
     const FileList &getList() const
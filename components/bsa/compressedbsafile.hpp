@@ -92,6 +92,9 @@ namespace Bsa
        
         Files::IStreamPtr getFile(const char* filePath);
         Files::IStreamPtr getFile(const FileStruct* fileStruct);
+
+        /// Files may be compressed, so they are only read through getFile()
+        Files::MappedFilePtr mapFile(const FileStruct* /*fileStruct*/) const { return Files::MappedFilePtr(); }
         
     };
 }
@@ -48,6 +48,10 @@ namespace DetourNavigator
         , mShouldStop()
         , mNavMeshTilesCache(settings.mMaxNavMeshTilesCacheSize)
     {
+        if (settings.mEnableNavMeshDiskCache)
+            mNavMeshDiskCache.reset(new NavMeshDiskCache(settings, settings.mNavMeshDiskCachePath,
+                                                         settings.mMaxNavMeshDiskCacheSize));
+
         for (std::size_t i = 0; i < mSettings.get().mAsyncNavMeshUpdaterThreads; ++i)
             mThreads.emplace_back([&] { process(); });
     }
@@ -116,6 +120,9 @@ namespace DetourNavigator
         stats.setAttribute(frameNumber, "NavMesh UpdateJobs", jobs);
 
         mNavMeshTilesCache.reportStats(frameNumber, stats);
+
+        if (mNavMeshDiskCache)
+            mNavMeshDiskCache->reportStats(frameNumber, stats);
     }
 
     void AsyncNavMeshUpdater::process() throw()
@@ -159,7 +166,8 @@ namespace DetourNavigator
         const auto offMeshConnections = mOffMeshConnectionsManager.get().get(job.mChangedTile);
 
         const auto status = updateNavMesh(job.mAgentHalfExtents, recastMesh.get(), job.mChangedTile, playerTile,
-            offMeshConnections, mSettings, navMeshCacheItem, mNavMeshTilesCache);
+            offMeshConnections, mSettings, navMeshCacheItem, mNavMeshTilesCache,
+            mNavMeshDiskCache.get());
 
         const auto finish = std::chrono::steady_clock::now();
 
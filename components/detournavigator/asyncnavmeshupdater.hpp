@@ -6,6 +6,7 @@
 #include "tilecachedrecastmeshmanager.hpp"
 #include "tileposition.hpp"
 #include "navmeshtilescache.hpp"
+#include "navmeshdiskcache.hpp"
 
 #include <osg/Vec3f>
 
@@ -91,6 +92,7 @@ namespace DetourNavigator
         Misc::ScopeGuarded<TilePosition> mPlayerTile;
         Misc::ScopeGuarded<boost::optional<std::chrono::steady_clock::time_point>> mFirstStart;
         NavMeshTilesCache mNavMeshTilesCache;
+        std::unique_ptr<NavMeshDiskCache> mNavMeshDiskCache;
         Misc::ScopeGuarded<std::map<osg::Vec3f, std::map<TilePosition, std::thread::id>>> mProcessingTiles;
         std::map<std::thread::id, Queue> mThreadsQueues;
         std::vector<std::thread> mThreads;
@@ -486,7 +486,8 @@ namespace DetourNavigator
     UpdateNavMeshStatus updateNavMesh(const osg::Vec3f& agentHalfExtents, const RecastMesh* recastMesh,
         const TilePosition& changedTile, const TilePosition& playerTile,
         const std::vector<OffMeshConnection>& offMeshConnections, const Settings& settings,
-        const SharedNavMeshCacheItem& navMeshCacheItem, NavMeshTilesCache& navMeshTilesCache)
+        const SharedNavMeshCacheItem& navMeshCacheItem, NavMeshTilesCache& navMeshTilesCache,
+        NavMeshDiskCache* navMeshDiskCache)
     {
         Log(Debug::Debug) << std::fixed << std::setprecision(2) <<
             "Update NavMesh with multiple tiles:" <<
@@ -535,13 +536,25 @@ namespace DetourNavigator
             const osg::Vec3f tileBorderMin(tileBounds.mMin.x(), recastMeshBounds.mMin.y() - 1, tileBounds.mMin.y());
             const osg::Vec3f tileBorderMax(tileBounds.mMax.x(), recastMeshBounds.mMax.y() + 1, tileBounds.mMax.y());
 
-            auto navMeshData = makeNavMeshTileData(agentHalfExtents, *recastMesh, offMeshConnections, changedTile,
-                tileBorderMin, tileBorderMax, settings);
+            NavMeshData navMeshData;
+
+            if (navMeshDiskCache)
+                navMeshData = navMeshDiskCache->get(agentHalfExtents, changedTile, *recastMesh, offMeshConnections);
 
             if (!navMeshData.mValue)
             {
-                Log(Debug::Debug) << "Ignore add tile: NavMeshData is null";
-                return navMeshCacheItem->lock()->removeTile(changedTile);
+                navMeshData = makeNavMeshTileData(agentHalfExtents, *recastMesh, offMeshConnections, changedTile,
+                    tileBorderMin, tileBorderMax, settings);
+
+                if (!navMeshData.mValue)
+                {
+                    Log(Debug::Debug) << "Ignore add tile: NavMeshData is null";
+                    return navMeshCacheItem->lock()->removeTile(changedTile);
+                }
+
+                if (navMeshDiskCache)
+                    navMeshDiskCache->set(agentHalfExtents, changedTile, *recastMesh, offMeshConnections,
+                                          NavMeshDataRef {navMeshData.mValue.get(), navMeshData.mSize});
             }
 
             try
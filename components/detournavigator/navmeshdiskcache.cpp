@@ -0,0 +1,426 @@
+#include "navmeshdiskcache.hpp"
+#include "settings.hpp"
+
+#include <components/debug/debuglog.hpp>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <osg/Stats>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <tuple>
+
+namespace DetourNavigator
+{
+    namespace
+    {
+        const char fileMagic[8] = {'O', 'M', 'W', 'N', 'A', 'V', 'T', '\0'};
+        const std::uint32_t fileVersion = 1;
+        const char* const fileExtension = ".navmesh";
+        const std::size_t maxQueuedSize = 64 * 1024 * 1024;
+
+        struct FileHeader
+        {
+            char mMagic[8];
+            std::uint32_t mVersion;
+            std::uint32_t mDataSize;
+            std::uint64_t mKeyCheck;
+            std::uint64_t mKeySize;
+        };
+
+        /// Two unrelated 64-bit hashes over the same bytes: one names the file, the other is stored in it
+        /// and compared on read so that a name collision can't hand out a tile of another mesh
+        class KeyHash
+        {
+        public:
+            void addBytes(const void* data, std::size_t size)
+            {
+                const auto bytes = static_cast<const unsigned char*>(data);
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    mName = (mName ^ bytes[i]) * 1099511628211ull;
+                    mCheck = (mCheck ^ bytes[i]) * 0x9E3779B97F4A7C15ull;
+                    mCheck ^= mCheck >> 29;
+                }
+                mSize += size;
+            }
+
+            template <class T>
+            void add(const T& value)
+            {
+                addBytes(&value, sizeof(value));
+            }
+
+            template <class T>
+            void add(const std::vector<T>& values)
+            {
+                add(static_cast<std::uint64_t>(values.size()));
+                addBytes(values.data(), values.size() * sizeof(T));
+            }
+
+            void add(const osg::Vec3f& value)
+            {
+                add(value.x());
+                add(value.y());
+                add(value.z());
+            }
+
+            void add(const btVector3& value)
+            {
+                add(value.x());
+                add(value.y());
+                add(value.z());
+            }
+
+            std::uint64_t getName() const { return mName; }
+            std::uint64_t getCheck() const { return mCheck; }
+            std::uint64_t getSize() const { return mSize; }
+
+        private:
+            std::uint64_t mName = 14695981039346656037ull;
+            std::uint64_t mCheck = 0;
+            std::uint64_t mSize = 0;
+        };
+
+        std::uint64_t makeSettingsHash(const Settings& settings)
+        {
+            KeyHash hash;
+            hash.add(fileVersion);
+            hash.add(settings.mBorderSize);
+            hash.add(settings.mCellHeight);
+            hash.add(settings.mCellSize);
+            hash.add(settings.mDetailSampleDist);
+            hash.add(settings.mDetailSampleMaxError);
+            hash.add(settings.mMaxClimb);
+            hash.add(settings.mMaxSimplificationError);
+            hash.add(settings.mMaxSlope);
+            hash.add(settings.mRecastScaleFactor);
+            hash.add(settings.mSwimHeightScale);
+            hash.add(settings.mMaxEdgeLen);
+            hash.add(settings.mMaxPolys);
+            hash.add(settings.mMaxVertsPerPoly);
+            hash.add(settings.mRegionMergeSize);
+            hash.add(settings.mRegionMinSize);
+            hash.add(settings.mTileSize);
+            hash.add(static_cast<std::uint64_t>(settings.mTrianglesPerChunk));
+            return hash.getName();
+        }
+
+        bool parseFileName(const boost::filesystem::path& path, std::uint64_t& name)
+        {
+            if (path.extension() != fileExtension)
+                return false;
+            const auto stem = path.stem().string();
+            if (stem.size() != 16 || stem.find_first_not_of("0123456789abcdef") != std::string::npos)
+                return false;
+            name = std::stoull(stem, nullptr, 16);
+            return true;
+        }
+    }
+
+    NavMeshDiskCache::NavMeshDiskCache(const Settings& settings, const boost::filesystem::path& path, std::size_t maxSize)
+        : mPath(path)
+        , mMaxSize(maxSize)
+        , mSettingsHash(makeSettingsHash(settings))
+        , mHits(0)
+        , mShouldStop(false)
+        , mWriting(false)
+        , mQueuedSize(0)
+        , mFilesSize(0)
+        , mUseNumber(0)
+    {
+        mThread = std::thread([this] { run(); });
+    }
+
+    NavMeshDiskCache::~NavMeshDiskCache()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            mShouldStop = true;
+        }
+        mHasWrite.notify_all();
+        mThread.join();
+    }
+
+    NavMeshData NavMeshDiskCache::get(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+        const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections)
+    {
+        const auto key = makeKey(agentHalfExtents, changedTile, recastMesh, offMeshConnections);
+        const auto filePath = getFilePath(key.mName);
+
+        boost::filesystem::ifstream stream(filePath, std::ios_base::binary);
+        if (!stream)
+            return NavMeshData();
+
+        FileHeader header;
+        if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header))
+                || std::memcmp(header.mMagic, fileMagic, sizeof(fileMagic)) != 0
+                || header.mVersion != fileVersion
+                || header.mKeyCheck != key.mCheck
+                || header.mKeySize != key.mSize
+                || header.mDataSize == 0
+                || header.mDataSize > static_cast<std::uint32_t>(std::numeric_limits<int>::max()))
+            return NavMeshData();
+
+        // Detour takes ownership of the tile data and fixes it up in place, so it has to be a copy
+        // allocated the same way the generated tiles are
+        NavMeshData result(static_cast<unsigned char*>(dtAlloc(header.mDataSize, DT_ALLOC_PERM)),
+                           static_cast<int>(header.mDataSize));
+        if (!result.mValue || !stream.read(reinterpret_cast<char*>(result.mValue.get()), header.mDataSize))
+            return NavMeshData();
+
+        ++mHits;
+
+        const auto now = std::time(nullptr);
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            const auto file = mFiles.find(key.mName);
+            if (file != mFiles.end())
+            {
+                file->second.mLastUse = now;
+                file->second.mUseNumber = ++mUseNumber;
+            }
+        }
+        // So that the order of use is kept across restarts
+        boost::system::error_code error;
+        boost::filesystem::last_write_time(filePath, now, error);
+
+        return result;
+    }
+
+    void NavMeshDiskCache::set(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+        const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections,
+        const NavMeshDataRef& value)
+    {
+        const auto size = static_cast<std::size_t>(value.mSize);
+        if (size == 0 || size > mMaxSize)
+            return;
+
+        Write write;
+        write.mKey = makeKey(agentHalfExtents, changedTile, recastMesh, offMeshConnections);
+        write.mData.assign(value.mValue, value.mValue + size);
+
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            // Generation is faster than the disk only in rare cases, there is no point to keep up with it then
+            if (mQueuedSize + size > maxQueuedSize)
+                return;
+            mQueuedSize += size;
+            mWrites.push_back(std::move(write));
+        }
+        mHasWrite.notify_one();
+    }
+
+    void NavMeshDiskCache::wait()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mWritten.wait(lock, [&] { return mWrites.empty() && !mWriting; });
+    }
+
+    void NavMeshDiskCache::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        std::size_t diskTiles = 0;
+
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            diskTiles = mFiles.size();
+        }
+
+        stats.setAttribute(frameNumber, "NavMesh DiskTiles", diskTiles);
+        stats.setAttribute(frameNumber, "NavMesh DiskHits", mHits.load());
+    }
+
+    NavMeshDiskCache::Key NavMeshDiskCache::makeKey(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+        const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections) const
+    {
+        KeyHash hash;
+        hash.add(mSettingsHash);
+        hash.add(agentHalfExtents);
+        hash.add(changedTile.x());
+        hash.add(changedTile.y());
+        hash.add(recastMesh.getIndices());
+        hash.add(recastMesh.getVertices());
+        hash.add(recastMesh.getAreaTypes());
+        // Water and off mesh connections are hashed by fields to skip the padding bytes
+        hash.add(static_cast<std::uint64_t>(recastMesh.getWater().size()));
+        for (const auto& water : recastMesh.getWater())
+        {
+            hash.add(water.mCellSize);
+            hash.add(water.mTransform.getOrigin());
+            for (int i = 0; i < 3; ++i)
+                hash.add(water.mTransform.getBasis()[i]);
+        }
+        hash.add(static_cast<std::uint64_t>(offMeshConnections.size()));
+        for (const auto& connection : offMeshConnections)
+        {
+            hash.add(connection.mStart);
+            hash.add(connection.mEnd);
+        }
+        return Key {hash.getName(), hash.getCheck(), hash.getSize()};
+    }
+
+    boost::filesystem::path NavMeshDiskCache::getFilePath(std::uint64_t name) const
+    {
+        char fileName[32];
+        std::snprintf(fileName, sizeof(fileName), "%016llx%s", static_cast<unsigned long long>(name), fileExtension);
+        return mPath / fileName;
+    }
+
+    void NavMeshDiskCache::run()
+    {
+        loadFiles();
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        while (true)
+        {
+            mHasWrite.wait(lock, [&] { return mShouldStop || !mWrites.empty(); });
+
+            // Tiles that are already generated are worth writing even when stopping
+            if (mWrites.empty())
+                break;
+
+            const Write write = std::move(mWrites.front());
+            mWrites.pop_front();
+            mWriting = true;
+            lock.unlock();
+
+            try
+            {
+                writeFile(write);
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to write navmesh tile to disk cache: " << e.what();
+            }
+
+            lock.lock();
+            mQueuedSize -= write.mData.size();
+            mWriting = false;
+            mWritten.notify_all();
+        }
+    }
+
+    void NavMeshDiskCache::loadFiles()
+    {
+        std::map<std::uint64_t, File> files;
+        std::uintmax_t filesSize = 0;
+
+        try
+        {
+            boost::filesystem::create_directories(mPath);
+
+            for (boost::filesystem::directory_iterator it(mPath), end; it != end; ++it)
+            {
+                boost::system::error_code error;
+                std::uint64_t name = 0;
+                if (it->path().extension() == ".tmp")
+                {
+                    boost::filesystem::remove(it->path(), error);
+                    continue;
+                }
+                if (!parseFileName(it->path(), name))
+                    continue;
+
+                File file;
+                file.mSize = boost::filesystem::file_size(it->path(), error);
+                if (error)
+                    continue;
+                file.mLastUse = boost::filesystem::last_write_time(it->path(), error);
+                if (error)
+                    continue;
+                file.mUseNumber = 0;
+
+                files[name] = file;
+                filesSize += file.mSize;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read navmesh disk cache " << mPath << ": " << e.what();
+        }
+
+        Log(Debug::Info) << "Navmesh disk cache has " << files.size() << " tiles, " << filesSize << " bytes";
+
+        const std::lock_guard<std::mutex> lock(mMutex);
+        // Tiles used or written since the thread started are more recent than what is on the disk
+        for (const auto& file : files)
+        {
+            if (mFiles.emplace(file).second)
+                mFilesSize += file.second.mSize;
+        }
+        removeLeastRecentlyUsed();
+    }
+
+    void NavMeshDiskCache::writeFile(const Write& write)
+    {
+        const auto filePath = getFilePath(write.mKey.mName);
+        auto tmpPath = filePath;
+        tmpPath += ".tmp";
+
+        FileHeader header;
+        std::memcpy(header.mMagic, fileMagic, sizeof(fileMagic));
+        header.mVersion = fileVersion;
+        header.mDataSize = static_cast<std::uint32_t>(write.mData.size());
+        header.mKeyCheck = write.mKey.mCheck;
+        header.mKeySize = write.mKey.mSize;
+
+        {
+            boost::filesystem::ofstream stream(tmpPath, std::ios_base::binary | std::ios_base::trunc);
+            stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            stream.write(reinterpret_cast<const char*>(write.mData.data()), write.mData.size());
+            if (!stream)
+            {
+                boost::system::error_code error;
+                boost::filesystem::remove(tmpPath, error);
+                throw std::runtime_error("can't write " + tmpPath.string());
+            }
+        }
+
+        // Readers never see a partially written file
+        boost::filesystem::rename(tmpPath, filePath);
+
+        File file;
+        file.mSize = sizeof(header) + write.mData.size();
+        file.mLastUse = std::time(nullptr);
+
+        const std::lock_guard<std::mutex> lock(mMutex);
+        file.mUseNumber = ++mUseNumber;
+        auto& entry = mFiles[write.mKey.mName];
+        mFilesSize -= entry.mSize;
+        entry = file;
+        mFilesSize += file.mSize;
+        removeLeastRecentlyUsed();
+    }
+
+    void NavMeshDiskCache::removeLeastRecentlyUsed()
+    {
+        if (mFilesSize <= mMaxSize)
+            return;
+
+        // Go a bit below the limit to not do it again on the next write
+        const std::uintmax_t targetSize = mMaxSize - mMaxSize / 10;
+
+        // The file times only have a precision of seconds, so uses within a second are told apart by their order
+        std::vector<std::tuple<std::time_t, std::uint64_t, std::uint64_t>> byLastUse;
+        byLastUse.reserve(mFiles.size());
+        for (const auto& file : mFiles)
+            byLastUse.emplace_back(file.second.mLastUse, file.second.mUseNumber, file.first);
+        std::sort(byLastUse.begin(), byLastUse.end());
+
+        for (const auto& file : byLastUse)
+        {
+            if (mFilesSize <= targetSize)
+                break;
+            const auto name = std::get<2>(file);
+            boost::system::error_code error;
+            boost::filesystem::remove(getFilePath(name), error);
+            const auto it = mFiles.find(name);
+            mFilesSize -= it->second.mSize;
+            mFiles.erase(it);
+        }
+    }
+}
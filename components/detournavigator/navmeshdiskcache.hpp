@@ -0,0 +1,108 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVMESHDISKCACHE_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVMESHDISKCACHE_H
+
+#include "offmeshconnection.hpp"
+#include "navmeshdata.hpp"
+#include "navmeshtilescache.hpp"
+#include "recastmesh.hpp"
+#include "tileposition.hpp"
+
+#include <boost/filesystem/path.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace DetourNavigator
+{
+    struct Settings;
+
+    /// Keeps generated tiles in files named by a hash of everything the tile is generated from,
+    /// so they survive restarts and don't have to be generated again.
+    /// Files are written by a background thread, and the least recently used are removed
+    /// when the total size goes over the limit.
+    class NavMeshDiskCache
+    {
+    public:
+        NavMeshDiskCache(const Settings& settings, const boost::filesystem::path& path, std::size_t maxSize);
+
+        ~NavMeshDiskCache();
+
+        /// Returns empty NavMeshData if the tile is not cached
+        NavMeshData get(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+            const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections);
+
+        /// Copies the data and queues it to be written
+        void set(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+            const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections,
+            const NavMeshDataRef& value);
+
+        /// Waits until all queued tiles are written
+        void wait();
+
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
+    private:
+        struct Key
+        {
+            std::uint64_t mName;
+            std::uint64_t mCheck;
+            std::uint64_t mSize;
+        };
+
+        struct Write
+        {
+            Key mKey;
+            std::vector<unsigned char> mData;
+        };
+
+        struct File
+        {
+            std::uintmax_t mSize;
+            std::time_t mLastUse;
+            std::uint64_t mUseNumber;
+        };
+
+        const boost::filesystem::path mPath;
+        const std::size_t mMaxSize;
+        const std::uint64_t mSettingsHash;
+        std::atomic<std::size_t> mHits;
+        mutable std::mutex mMutex;
+        std::condition_variable mHasWrite;
+        std::condition_variable mWritten;
+        bool mShouldStop;
+        bool mWriting;
+        std::deque<Write> mWrites;
+        std::size_t mQueuedSize;
+        std::map<std::uint64_t, File> mFiles;
+        std::uintmax_t mFilesSize;
+        std::uint64_t mUseNumber;
+        std::thread mThread;
+
+        Key makeKey(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+            const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections) const;
+
+        boost::filesystem::path getFilePath(std::uint64_t name) const;
+
+        void run();
+
+        void loadFiles();
+
+        void writeFile(const Write& write);
+
+        void removeLeastRecentlyUsed();
+    };
+}
+
+#endif
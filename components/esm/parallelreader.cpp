@@ -0,0 +1,160 @@
+#include "parallelreader.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include <components/files/memorystream.hpp>
+
+namespace
+{
+    // The four character name, the size of the data, an unused field and the flags
+    const size_t recordHeaderSize = 16;
+
+    uint32_t getRecordSize(const char* header)
+    {
+        uint32_t size;
+        std::memcpy(&size, header + 4, sizeof(size));
+        return size;
+    }
+}
+
+namespace ESM
+{
+
+ParallelReader::ParallelReader(const std::string& filename, unsigned int threads)
+    : mFilename(filename)
+    , mFile(Files::openConstrainedFileStream(filename.c_str()))
+    , mLeft(0)
+    , mOffset(0)
+    , mThreads(threads != 0 ? threads : std::max(std::thread::hardware_concurrency(), 1u))
+    , mBatchSize(1024 * 1024)
+    , mHasEncoding(false)
+    , mEncoding(ToUTF8::WINDOWS_1252)
+{
+    mFile->seekg(0, std::ios::end);
+    const size_t fileSize = mFile->tellg();
+    mFile->seekg(0, std::ios::beg);
+
+    mHeader.resize(recordHeaderSize);
+    if (fileSize < recordHeaderSize || !mFile->read(mHeader.data(), recordHeaderSize)
+        || std::memcmp(mHeader.data(), "TES3", 4) != 0)
+        throw std::runtime_error("Not a valid Morrowind file: " + filename);
+
+    const uint32_t headerSize = getRecordSize(mHeader.data());
+    if (fileSize - recordHeaderSize < headerSize)
+        throw std::runtime_error("Header is larger than the file: " + filename);
+
+    mHeader.resize(recordHeaderSize + headerSize);
+    if (!mFile->read(mHeader.data() + recordHeaderSize, headerSize))
+        throw std::runtime_error("Failed to read the header of " + filename);
+
+    mOffset = mHeader.size();
+    mLeft = fileSize - mOffset;
+}
+
+void ParallelReader::setEncoding(ToUTF8::FromType encoding)
+{
+    mHasEncoding = true;
+    mEncoding = encoding;
+}
+
+void ParallelReader::setBatchSize(size_t bytes)
+{
+    mBatchSize = bytes;
+}
+
+std::shared_ptr<ParallelReader::Batch> ParallelReader::readBatch()
+{
+    if (mLeft == 0)
+        return std::shared_ptr<Batch>();
+
+    std::shared_ptr<Batch> batch = std::make_shared<Batch>();
+    batch->mData.reserve(mHeader.size() + mBatchSize);
+    batch->mData = mHeader;
+    batch->mOffset = mOffset - mHeader.size();
+
+    while (mLeft > 0 && batch->mData.size() - mHeader.size() < std::max<size_t>(mBatchSize, 1))
+    {
+        // Whatever follows the last whole record is left to the parser, which reports it like ESMReader does
+        if (mLeft < recordHeaderSize)
+        {
+            const size_t start = batch->mData.size();
+            batch->mData.resize(start + mLeft);
+            mFile->read(batch->mData.data() + start, mLeft);
+            mOffset += mLeft;
+            mLeft = 0;
+            break;
+        }
+
+        const size_t start = batch->mData.size();
+        batch->mData.resize(start + recordHeaderSize);
+        if (!mFile->read(batch->mData.data() + start, recordHeaderSize))
+            throw std::runtime_error("Failed to read a record header from " + mFilename);
+
+        const size_t recordSize = std::min<size_t>(getRecordSize(batch->mData.data() + start), mLeft - recordHeaderSize);
+        batch->mData.resize(start + recordHeaderSize + recordSize);
+        if (!mFile->read(batch->mData.data() + start + recordHeaderSize, recordSize))
+            throw std::runtime_error("Failed to read a record from " + mFilename);
+
+        mOffset += recordHeaderSize + recordSize;
+        mLeft -= recordHeaderSize + recordSize;
+    }
+
+    return batch;
+}
+
+void ParallelReader::openBatch(const Batch& batch, ESMReader& esm) const
+{
+    esm.open(std::make_shared<Files::IMemStream>(batch.mData.data(), batch.mData.size()), mFilename);
+}
+
+ParallelReader::WorkerPool::WorkerPool(unsigned int threads)
+    : mStopping(false)
+{
+    for (unsigned int i = 0; i < threads; ++i)
+        mThreads.emplace_back([this] () { run(); });
+}
+
+ParallelReader::WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+        mJobs.clear();
+    }
+    mHasJob.notify_all();
+
+    for (std::thread& thread : mThreads)
+        thread.join();
+}
+
+void ParallelReader::WorkerPool::post(const std::function<void ()>& job)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mJobs.push_back(job);
+    }
+    mHasJob.notify_one();
+}
+
+void ParallelReader::WorkerPool::run()
+{
+    while (true)
+    {
+        std::function<void ()> job;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mHasJob.wait(lock, [this] () { return mStopping || !mJobs.empty(); });
+            if (mStopping)
+                return;
+
+            job = mJobs.front();
+            mJobs.pop_front();
+        }
+
+        job();
+    }
+}
+
+}
@@ -0,0 +1,138 @@
+#ifndef OPENMW_ESM_PARALLELREADER_H
+#define OPENMW_ESM_PARALLELREADER_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <components/files/constrainedfilestream.hpp>
+#include <components/to_utf8/to_utf8.hpp>
+
+#include "esmreader.hpp"
+
+namespace ESM
+{
+
+/// @brief Parses the records of a content or save file on several threads.
+///
+/// The file is split at record boundaries into batches, which are parsed on a pool of threads. What is parsed
+/// from each batch is handed back on the calling thread in file order. Only a few batches are held in memory
+/// at a time, however large the file is.
+class ParallelReader
+{
+public:
+    /// @param threads How many threads parse batches, 0 for one per hardware thread
+    ParallelReader(const std::string& filename, unsigned int threads = 0);
+
+    /// Sets the encoding of the strings in the file. Without one, strings are not converted.
+    void setEncoding(ToUTF8::FromType encoding);
+
+    /// A batch holds whole records of at least this many bytes, unless it is the last one
+    void setBatchSize(size_t bytes);
+
+    /// Calls @a parse for every batch on one of the threads. Its reader is opened on the file's header followed
+    /// by the batch's records, so it reads records until hasMoreRecs() returns false. Adding the given offset to
+    /// getFileOffset() gives the offset in the file.
+    ///
+    /// Calls @a consume with every result of @a parse on the calling thread, in file order. Stops reading when it
+    /// returns false. Exceptions from either are thrown from here.
+    template <class Result>
+    void read(const std::function<Result (ESMReader& esm, size_t offset)>& parse,
+              const std::function<bool (Result& result)>& consume);
+
+private:
+    struct Batch
+    {
+        std::vector<char> mData; // The file's header, followed by the records
+        size_t mOffset;
+    };
+
+    /// Runs jobs on a fixed number of threads, and finishes or discards the remaining ones when destroyed
+    class WorkerPool
+    {
+    public:
+        WorkerPool(unsigned int threads);
+        ~WorkerPool();
+
+        void post(const std::function<void ()>& job);
+
+    private:
+        void run();
+
+        std::vector<std::thread> mThreads;
+        std::deque<std::function<void ()> > mJobs;
+        std::mutex mMutex;
+        std::condition_variable mHasJob;
+        bool mStopping;
+    };
+
+    std::shared_ptr<Batch> readBatch();
+    void openBatch(const Batch& batch, ESMReader& esm) const;
+
+    std::string mFilename;
+    Files::IStreamPtr mFile;
+    std::vector<char> mHeader;
+    size_t mLeft;
+    size_t mOffset;
+
+    unsigned int mThreads;
+    size_t mBatchSize;
+    bool mHasEncoding;
+    ToUTF8::FromType mEncoding;
+};
+
+template <class Result>
+void ParallelReader::read(const std::function<Result (ESMReader& esm, size_t offset)>& parse,
+                          const std::function<bool (Result& result)>& consume)
+{
+    // Enough batches to keep every thread busy while the oldest one is consumed
+    const size_t maxPending = mThreads * 2;
+
+    std::deque<std::future<Result> > pending;
+    WorkerPool pool(mThreads);
+
+    while (true)
+    {
+        while (pending.size() < maxPending)
+        {
+            std::shared_ptr<Batch> batch = readBatch();
+            if (!batch)
+                break;
+
+            std::shared_ptr<std::packaged_task<Result ()> > task = std::make_shared<std::packaged_task<Result ()> >(
+                [this, batch, &parse] ()
+                {
+                    std::unique_ptr<ToUTF8::Utf8Encoder> encoder;
+                    if (mHasEncoding)
+                        encoder.reset(new ToUTF8::Utf8Encoder(mEncoding));
+
+                    ESMReader esm;
+                    esm.setEncoder(encoder.get());
+                    openBatch(*batch, esm);
+                    return parse(esm, batch->mOffset);
+                });
+
+            pending.push_back(task->get_future());
+            pool.post([task] () { (*task)(); });
+        }
+
+        if (pending.empty())
+            break;
+
+        Result result = pending.front().get();
+        pending.pop_front();
+
+        if (!consume(result))
+            break;
+    }
+}
+
+}
+
+#endif
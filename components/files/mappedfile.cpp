@@ -0,0 +1,32 @@
+#include "mappedfile.hpp"
+
+#include <stdexcept>
+
+#include <boost/filesystem/operations.hpp>
+
+namespace Files
+{
+
+MappedFile::MappedFile(const std::string& filename, size_t start, size_t length)
+{
+    if (length == 0)
+    {
+        const boost::uintmax_t fileSize = boost::filesystem::file_size(filename);
+        if (start >= fileSize)
+            throw std::runtime_error("Nothing to map from " + filename);
+        length = static_cast<size_t>(fileSize - start);
+    }
+
+    // Mappings have to start at a multiple of the allocation granularity
+    const size_t alignment = static_cast<size_t>(boost::iostreams::mapped_file_source::alignment());
+    const size_t alignedStart = start - start % alignment;
+
+    mFile.open(filename, length + (start - alignedStart), static_cast<boost::iostreams::stream_offset>(alignedStart));
+    if (!mFile.is_open())
+        throw std::runtime_error("Failed to map " + filename);
+
+    mData = mFile.data() + (start - alignedStart);
+    mSize = length;
+}
+
+}
@@ -0,0 +1,34 @@
+#ifndef OPENMW_COMPONENTS_FILES_MAPPEDFILE_H
+#define OPENMW_COMPONENTS_FILES_MAPPEDFILE_H
+
+#include <memory>
+#include <string>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+namespace Files
+{
+
+/// @brief A read-only region of a file, mapped into memory.
+/// @note Throws an exception if the region can not be mapped, e.g. because it is empty.
+class MappedFile
+{
+public:
+    /// Maps @a length bytes from @a start on, or the rest of the file if @a length is 0.
+    MappedFile(const std::string& filename, size_t start = 0, size_t length = 0);
+
+    const char* data() const { return mData; }
+
+    size_t size() const { return mSize; }
+
+private:
+    boost::iostreams::mapped_file_source mFile;
+    const char* mData;
+    size_t mSize;
+};
+
+typedef std::shared_ptr<const MappedFile> MappedFilePtr;
+
+}
+
+#endif
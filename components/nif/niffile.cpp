@@ -13,7 +13,25 @@ NIFFile::NIFFile(Files::IStreamPtr stream, const std::string &name)
     , filename(name)
     , mUseSkinning(false)
 {
-    parse(stream);
+    stream->seekg(0, std::ios::end);
+    const std::streamoff size = stream->tellg();
+    stream->seekg(0, std::ios::beg);
+    if (size < 0)
+        fail("Failed to get the size of the file");
+
+    std::vector<char> data(static_cast<size_t>(size));
+    if (!stream->read(data.data(), data.size()))
+        fail("Failed to read the file");
+
+    parse(data.data(), data.size());
+}
+
+NIFFile::NIFFile(const char* data, size_t size, const std::string &name)
+    : ver(0)
+    , filename(name)
+    , mUseSkinning(false)
+{
+    parse(data, size);
 }
 
 NIFFile::~NIFFile()
@@ -132,9 +150,9 @@ std::string NIFFile::printVersion(unsigned int version)
     return stream.str();
 }
 
-void NIFFile::parse(Files::IStreamPtr stream)
+void NIFFile::parse(const char* data, size_t size)
 {
-    NIFStream nif (this, stream);
+    NIFStream nif (this, data, size);
 
     // Check the header string
     std::string head = nif.getVersionString();
@@ -149,6 +167,9 @@ void NIFFile::parse(Files::IStreamPtr stream)
         fail("Unsupported NIF version: " + printVersion(ver));
     // Number of records
     size_t recNum = nif.getInt();
+    // Each record starts with its type name's length at least
+    if (recNum > nif.remaining() / 4)
+        fail("Too many records: " + std::to_string(static_cast<int>(recNum)));
     records.resize(recNum);
 
     /* The format for 10.0.1.0 seems to be a bit different. After the
@@ -191,6 +212,8 @@ void NIFFile::parse(Files::IStreamPtr stream)
     }
 
     size_t rootNum = nif.getUInt();
+    if (rootNum > nif.remaining() / 4)
+        fail("Too many roots: " + std::to_string(rootNum));
     roots.resize(rootNum);
 
     //Determine which records are roots
@@ -53,8 +53,8 @@ class NIFFile final : public File
 
     bool mUseSkinning;
 
-    /// Parse the file
-    void parse(Files::IStreamPtr stream);
+    /// Parse the file from a buffer holding all of it
+    void parse(const char* data, size_t size);
 
     /// Get the file's version in a human readable form
     ///\returns A string containing a human readable NIF version number
@@ -80,7 +80,12 @@ public:
     }
 
     /// Open a NIF stream. The name is used for error messages.
+    /// @note The stream is read into memory before it is parsed.
     NIFFile(Files::IStreamPtr stream, const std::string &name);
+
+    /// Parse a NIF file from memory, e.g. a mapped file. The name is used for error messages.
+    /// @note The data is only used while constructing.
+    NIFFile(const char* data, size_t size, const std::string &name);
     ~NIFFile();
 
     /// Get a given record
@@ -5,8 +5,10 @@
 
 #include "nifstream.hpp"
 
+#include <algorithm>
 #include <sstream>
 #include <map>
+#include <vector>
 
 #include "niffile.hpp"
 
@@ -33,8 +35,6 @@ typedef KeyT<osg::Quat> QuaternionKey;
 
 template<typename T, T (NIFStream::*getValue)()>
 struct KeyMapT {
-    typedef std::map< float, KeyT<T> > MapType;
-
     typedef T ValueType;
     typedef KeyT<T> KeyType;
 
@@ -44,7 +44,11 @@ struct KeyMapT {
     static const unsigned int sXYZInterpolation = 4;
 
     unsigned int mInterpolationType;
-    MapType mKeys;
+
+    // Sorted by time, with no two keys at the same time. The times are kept apart from the keys
+    // so that searching for a time only touches one contiguous array of floats.
+    std::vector<float> mTimes;
+    std::vector<KeyType> mKeys;
 
     KeyMapT() : mInterpolationType(sLinearInterpolation) {}
 
@@ -59,6 +63,7 @@ struct KeyMapT {
         if(count == 0 && !force)
             return;
 
+        mTimes.clear();
         mKeys.clear();
 
         mInterpolationType = nif->getUInt();
@@ -72,7 +77,8 @@ struct KeyMapT {
             {
                 float time = nif->getFloat();
                 readValue(nifReference, key);
-                mKeys[time] = key;
+                mTimes.push_back(time);
+                mKeys.push_back(key);
             }
         }
         else if(mInterpolationType == sQuadraticInterpolation)
@@ -81,7 +87,8 @@ struct KeyMapT {
             {
                 float time = nif->getFloat();
                 readQuadratic(nifReference, key);
-                mKeys[time] = key;
+                mTimes.push_back(time);
+                mKeys.push_back(key);
             }
         }
         else if(mInterpolationType == sTBCInterpolation)
@@ -90,7 +97,8 @@ struct KeyMapT {
             {
                 float time = nif->getFloat();
                 readTBC(nifReference, key);
-                mKeys[time] = key;
+                mTimes.push_back(time);
+                mKeys.push_back(key);
             }
         }
         //XYZ keys aren't actually read here.
@@ -120,6 +128,41 @@ struct KeyMapT {
             error << "Unhandled interpolation type: " << mInterpolationType;
             nif->file->fail(error.str());
         }
+
+        sortKeys();
+    }
+
+    /// Sort the keys by time. Of several keys at the same time only the last one read is kept.
+    void sortKeys()
+    {
+        bool sorted = true;
+        for (size_t i = 1; i < mTimes.size() && sorted; ++i)
+            sorted = mTimes[i - 1] < mTimes[i];
+        if (sorted)
+            return;
+
+        std::vector<size_t> order(mTimes.size());
+        for (size_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [this] (size_t a, size_t b) { return mTimes[a] < mTimes[b]; });
+
+        std::vector<float> times;
+        std::vector<KeyType> keys;
+        times.reserve(order.size());
+        keys.reserve(order.size());
+        for (size_t index : order)
+        {
+            if (!times.empty() && times.back() == mTimes[index])
+                keys.back() = mKeys[index];
+            else
+            {
+                times.push_back(mTimes[index]);
+                keys.push_back(mKeys[index]);
+            }
+        }
+
+        mTimes.swap(times);
+        mKeys.swap(keys);
     }
 
 private:
@@ -2,12 +2,21 @@
 //For error reporting
 #include "niffile.hpp"
 
+#include <sstream>
+
 namespace Nif
 {
+    void NIFStream::overrun(size_t length) const
+    {
+        std::stringstream error;
+        error << "Tried to read " << length << " bytes at offset " << pos << ", but only " << size - pos << " are left";
+        file->fail(error.str());
+    }
+
     osg::Quat NIFStream::getQuaternion()
     {
         float f[4];
-        readLittleEndianBufferOfType<4, float,uint32_t>(inp, (float*)&f);
+        readLittleEndianBufferOfType<4, float,uint32_t>(take(4 * sizeof(float)), (float*)&f);
         osg::Quat quat;
         quat.w() = f[0];
         quat.x() = f[1];
@@ -3,13 +3,14 @@
 #ifndef OPENMW_COMPONENTS_NIF_NIFSTREAM_HPP
 #define OPENMW_COMPONENTS_NIF_NIFSTREAM_HPP
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <stdint.h>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
-#include <components/files/constrainedfilestream.hpp>
-
 #include <osg/Vec3f>
 #include <osg/Vec4f>
 #include <osg/Quat>
@@ -21,16 +22,15 @@ namespace Nif
 
 class NIFFile;
 
-/* 
+/*
     readLittleEndianBufferOfType: This template should only be used with non POD data types
 */
-template <uint32_t numInstances, typename T, typename IntegerT> inline void readLittleEndianBufferOfType(Files::IStreamPtr &pIStream, T* dest)
+template <uint32_t numInstances, typename T, typename IntegerT> inline void readLittleEndianBufferOfType(const char* src, T* dest)
 {
 #if defined(__x86_64__) || defined(_M_X64) || defined(__i386) || defined(_M_IX86)
-    pIStream->read((char*)dest, numInstances * sizeof(T));
+    std::memcpy(dest, src, numInstances * sizeof(T));
 #else
-    uint8_t* destByteBuffer = (uint8_t*)dest;
-    pIStream->read((char*)dest, numInstances * sizeof(T));
+    const uint8_t* srcByteBuffer = (const uint8_t*)src;
     /*
         Due to the loop iterations being known at compile time,
         this nested loop will most likely be unrolled
@@ -44,7 +44,7 @@ template <uint32_t numInstances, typename T, typename IntegerT> inline void read
     {
         u = { 0 };
         for (uint32_t byte = 0; byte < sizeof(T); byte++)
-            u.i |= (((IntegerT)destByteBuffer[i * sizeof(T) + byte]) << (byte * 8));
+            u.i |= (((IntegerT)srcByteBuffer[i * sizeof(T) + byte]) << (byte * 8));
         dest[i] = u.t;
     }
 #endif
@@ -53,101 +53,126 @@ template <uint32_t numInstances, typename T, typename IntegerT> inline void read
 /*
     readLittleEndianDynamicBufferOfType: This template should only be used with non POD data types
 */
-template <typename T, typename IntegerT> inline void readLittleEndianDynamicBufferOfType(Files::IStreamPtr &pIStream, T* dest, uint32_t numInstances)
+template <typename T, typename IntegerT> inline void readLittleEndianDynamicBufferOfType(const char* src, T* dest, size_t numInstances)
 {
 #if defined(__x86_64__) || defined(_M_X64) || defined(__i386) || defined(_M_IX86)
-    pIStream->read((char*)dest, numInstances * sizeof(T));
+    std::memcpy(dest, src, numInstances * sizeof(T));
 #else
-    uint8_t* destByteBuffer = (uint8_t*)dest;
-    pIStream->read((char*)dest, numInstances * sizeof(T));
+    const uint8_t* srcByteBuffer = (const uint8_t*)src;
     union {
         IntegerT i;
         T t;
     } u;
-    for (uint32_t i = 0; i < numInstances; i++)
+    for (size_t i = 0; i < numInstances; i++)
     {
         u.i = 0;
         for (uint32_t byte = 0; byte < sizeof(T); byte++)
-            u.i |= ((IntegerT)destByteBuffer[i * sizeof(T) + byte]) << (byte * 8);
+            u.i |= ((IntegerT)srcByteBuffer[i * sizeof(T) + byte]) << (byte * 8);
         dest[i] = u.t;
     }
 #endif
 }
-template<typename type, typename IntegerT> type inline readLittleEndianType(Files::IStreamPtr &pIStream)
+template<typename type, typename IntegerT> type inline readLittleEndianType(const char* src)
 {
     type val;
-    readLittleEndianBufferOfType<1,type,IntegerT>(pIStream, (type*)&val);
+    readLittleEndianBufferOfType<1,type,IntegerT>(src, (type*)&val);
     return val;
 }
 
 class NIFStream
 {
-    /// Input stream
-    Files::IStreamPtr inp;
+    /// Input buffer, which has to outlive the stream
+    const char* data;
+    size_t size;
+    size_t pos;
+
+    /// Fails with a message about reading @a length bytes past the end of the buffer
+    void overrun(size_t length) const;
+
+    /// Returns the next @a length bytes and moves past them
+    const char* take(size_t length)
+    {
+        if (length > size - pos)
+            overrun(length);
+        const char* result = data + pos;
+        pos += length;
+        return result;
+    }
+
+    /// Returns the next @a count elements of type T and moves past them
+    template <typename T> const char* takeArray(size_t count)
+    {
+        if (count > (size - pos) / sizeof(T))
+            overrun(count * sizeof(T));
+        return take(count * sizeof(T));
+    }
 
 public:
 
     NIFFile * const file;
 
-    NIFStream (NIFFile * file, Files::IStreamPtr inp): inp (inp), file (file) {}
+    NIFStream (NIFFile * file, const char* data, size_t size): data(data), size(size), pos(0), file (file) {}
+
+    void skip(size_t length) { take(length); }
 
-    void skip(size_t size) { inp->ignore(size); }
+    /// Number of bytes left to read
+    size_t remaining() const { return size - pos; }
 
     char getChar()
     {
-        return readLittleEndianType<char,char>(inp);
+        return readLittleEndianType<char,char>(take(sizeof(char)));
     }
 
     short getShort()
     {
-        return readLittleEndianType<short,short>(inp);
+        return readLittleEndianType<short,short>(take(sizeof(short)));
     }
 
     unsigned short getUShort()
     {
-        return readLittleEndianType<unsigned short,unsigned short>(inp);
+        return readLittleEndianType<unsigned short,unsigned short>(take(sizeof(unsigned short)));
     }
 
     int getInt()
     {
-        return readLittleEndianType<int,int>(inp);
+        return readLittleEndianType<int,int>(take(sizeof(int)));
     }
 
     unsigned int getUInt()
     {
-        return readLittleEndianType<unsigned int,unsigned int>(inp);
+        return readLittleEndianType<unsigned int,unsigned int>(take(sizeof(unsigned int)));
     }
 
     float getFloat()
     {
-        return readLittleEndianType<float,uint32_t>(inp);
+        return readLittleEndianType<float,uint32_t>(take(sizeof(float)));
     }
 
     osg::Vec2f getVector2()
     {
         osg::Vec2f vec;
-        readLittleEndianBufferOfType<2,float,uint32_t>(inp, (float*)&vec._v[0]);
+        readLittleEndianBufferOfType<2,float,uint32_t>(take(2 * sizeof(float)), (float*)&vec._v[0]);
         return vec;
     }
 
     osg::Vec3f getVector3()
     {
         osg::Vec3f vec;
-        readLittleEndianBufferOfType<3, float,uint32_t>(inp, (float*)&vec._v[0]);
+        readLittleEndianBufferOfType<3, float,uint32_t>(take(3 * sizeof(float)), (float*)&vec._v[0]);
         return vec;
     }
 
     osg::Vec4f getVector4()
     {
         osg::Vec4f vec;
-        readLittleEndianBufferOfType<4, float,uint32_t>(inp, (float*)&vec._v[0]);
+        readLittleEndianBufferOfType<4, float,uint32_t>(take(4 * sizeof(float)), (float*)&vec._v[0]);
         return vec;
     }
 
     Matrix3 getMatrix3()
     {
         Matrix3 mat;
-        readLittleEndianBufferOfType<9, float,uint32_t>(inp, (float*)&mat.mValues);
+        readLittleEndianBufferOfType<9, float,uint32_t>(take(9 * sizeof(float)), (float*)&mat.mValues);
         return mat;
     }
 
@@ -158,62 +183,69 @@ public:
     ///Read in a string of the given length
     std::string getString(size_t length)
     {
-        std::vector<char> str(length + 1, 0);
-
-        inp->read(str.data(), length);
-
-        return str.data();
+        const char* str = take(length);
+        // Anything after a null terminator is padding
+        return std::string(str, std::find(str, str + length, '\0'));
     }
     ///Read in a string of the length specified in the file
     std::string getString()
     {
-        size_t size = readLittleEndianType<uint32_t,uint32_t>(inp);
-        return getString(size);
+        size_t length = getUInt();
+        return getString(length);
     }
     ///This is special since the version string doesn't start with a number, and ends with "\n"
     std::string getVersionString()
     {
-        std::string result;
-        std::getline(*inp, result);
-        return result;
+        const char* str = data + pos;
+        const char* end = std::find(str, data + size, '\n');
+        pos = end - data + (end != data + size ? 1 : 0);
+        return std::string(str, end);
     }
 
-    void getUShorts(std::vector<unsigned short> &vec, size_t size)
+    void getUShorts(std::vector<unsigned short> &vec, size_t count)
     {
-        vec.resize(size);
-        readLittleEndianDynamicBufferOfType<unsigned short,unsigned short>(inp, vec.data(), size);
+        const char* src = takeArray<unsigned short>(count);
+        vec.resize(count);
+        readLittleEndianDynamicBufferOfType<unsigned short,unsigned short>(src, vec.data(), count);
     }
 
-    void getFloats(std::vector<float> &vec, size_t size)
+    void getFloats(std::vector<float> &vec, size_t count)
     {
-        vec.resize(size);
-        readLittleEndianDynamicBufferOfType<float,uint32_t>(inp, vec.data(), size);
+        const char* src = takeArray<float>(count);
+        vec.resize(count);
+        readLittleEndianDynamicBufferOfType<float,uint32_t>(src, vec.data(), count);
     }
 
-    void getVector2s(std::vector<osg::Vec2f> &vec, size_t size)
+    void getVector2s(std::vector<osg::Vec2f> &vec, size_t count)
     {
-        vec.resize(size);
+        const char* src = takeArray<osg::Vec2f>(count);
+        vec.resize(count);
         /* The packed storage of each Vec2f is 2 floats exactly */
-        readLittleEndianDynamicBufferOfType<float,uint32_t>(inp,(float*)vec.data(), size*2);
+        readLittleEndianDynamicBufferOfType<float,uint32_t>(src, (float*)vec.data(), count*2);
     }
 
-    void getVector3s(std::vector<osg::Vec3f> &vec, size_t size)
+    void getVector3s(std::vector<osg::Vec3f> &vec, size_t count)
     {
-        vec.resize(size);
+        const char* src = takeArray<osg::Vec3f>(count);
+        vec.resize(count);
         /* The packed storage of each Vec3f is 3 floats exactly */
-        readLittleEndianDynamicBufferOfType<float,uint32_t>(inp, (float*)vec.data(), size*3);
+        readLittleEndianDynamicBufferOfType<float,uint32_t>(src, (float*)vec.data(), count*3);
     }
 
-    void getVector4s(std::vector<osg::Vec4f> &vec, size_t size)
+    void getVector4s(std::vector<osg::Vec4f> &vec, size_t count)
     {
-        vec.resize(size);
+        const char* src = takeArray<osg::Vec4f>(count);
+        vec.resize(count);
         /* The packed storage of each Vec4f is 4 floats exactly */
-        readLittleEndianDynamicBufferOfType<float,uint32_t>(inp, (float*)vec.data(), size*4);
+        readLittleEndianDynamicBufferOfType<float,uint32_t>(src, (float*)vec.data(), count*4);
     }
 
-    void getQuaternions(std::vector<osg::Quat> &quat, size_t size)
+    void getQuaternions(std::vector<osg::Quat> &quat, size_t count)
     {
-        quat.resize(size);
+        // Stored as 4 floats each
+        if (count > remaining() / (4 * sizeof(float)))
+            overrun(count * 4 * sizeof(float));
+        quat.resize(count);
         for (size_t i = 0;i < quat.size();i++)
             quat[i] = getQuaternion();
     }
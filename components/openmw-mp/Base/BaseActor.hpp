@@ -17,6 +17,7 @@ namespace mwmp
         {
             hasPositionData = false;
             hasStatsDynamicData = false;
+            positionTime = 0;
         }
 
         std::string refId;
@@ -25,6 +26,7 @@ namespace mwmp
 
         ESM::Position position;
         ESM::Position direction;
+        uint32_t positionTime; // When the server relayed the position, in its milliseconds
 
         ESM::Cell cell;
 
@@ -54,7 +56,7 @@ namespace mwmp
         bool hasPositionData;
         bool hasStatsDynamicData;
 
-        Item equipmentItems[19];
+        Item equipmentItems[equipmentSlots];
     };
 
     class BaseActorList
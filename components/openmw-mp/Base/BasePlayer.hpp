@@ -224,6 +224,7 @@ namespace mwmp
             displayCreatureName = false;
             resetStats = false;
             enforcedLogLevel = -1;
+            positionTime = 0;
         }
 
         BasePlayer()
@@ -284,6 +285,7 @@ namespace mwmp
 
         ESM::Position position;
         ESM::Position direction;
+        uint32_t positionTime; // When the server relayed the position, in its milliseconds
         ESM::Position previousCellPosition;
         ESM::Position momentum;
         ESM::Cell cell;
@@ -292,7 +294,7 @@ namespace mwmp
         ESM::Creature creature;
         ESM::CreatureStats creatureStats;
         ESM::Class charClass;
-        Item equipmentItems[19];
+        Item equipmentItems[equipmentSlots];
         Attack attack;
         std::string birthsign;
         std::string chatMessage;
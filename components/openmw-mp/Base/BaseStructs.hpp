@@ -45,6 +45,9 @@ namespace mwmp
                 enchantmentCharge == rhs.enchantmentCharge && soul == rhs.soul;
         }
     };
+
+    // The number of equipment slots, which has to match MWWorld::InventoryStore::Slots
+    static const int equipmentSlots = 19;
     
     struct Target
     {
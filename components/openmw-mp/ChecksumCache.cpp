@@ -0,0 +1,139 @@
+#include "ChecksumCache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <thread>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <components/openmw-mp/MWMPLog.hpp>
+#include <components/openmw-mp/Utils.hpp>
+
+using namespace mwmp;
+
+namespace
+{
+    const char *const cacheHeader = "tes3mp checksum cache 1";
+}
+
+ChecksumCache::ChecksumCache(const boost::filesystem::path &cacheFile) : cacheFile(cacheFile)
+{
+    load();
+}
+
+std::vector<unsigned int> ChecksumCache::getChecksums(const std::vector<boost::filesystem::path> &files)
+{
+    std::vector<unsigned int> checksums(files.size(), 0);
+    std::vector<Entry> fileEntries(files.size());
+    std::vector<bool> cacheable(files.size(), true);
+    std::vector<size_t> filesToHash;
+
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        boost::system::error_code sizeError, timeError;
+        Entry &fileEntry = fileEntries[i];
+        fileEntry.size = boost::filesystem::file_size(files[i], sizeError);
+        fileEntry.modified = boost::filesystem::last_write_time(files[i], timeError);
+
+        // Files we can't get the size or time of are hashed every time
+        if (sizeError || timeError)
+            cacheable[i] = false;
+        else
+        {
+            auto it = entries.find(files[i].string());
+            if (it != entries.end() && it->second.size == fileEntry.size && it->second.modified == fileEntry.modified)
+            {
+                checksums[i] = it->second.checksum;
+                continue;
+            }
+        }
+
+        filesToHash.push_back(i);
+    }
+
+    if (filesToHash.empty())
+        return checksums;
+
+    // Every thread takes the next file that nobody has started on yet
+    std::atomic<size_t> nextFile(0);
+    auto hashFiles = [&]()
+    {
+        for (size_t n = nextFile++; n < filesToHash.size(); n = nextFile++)
+            checksums[filesToHash[n]] = Utils::crc32Checksum(files[filesToHash[n]].string());
+    };
+
+    const size_t numThreads = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), filesToHash.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < numThreads; ++i)
+        threads.emplace_back(hashFiles);
+    hashFiles();
+    for (std::thread &thread : threads)
+        thread.join();
+
+    for (size_t i : filesToHash)
+    {
+        if (!cacheable[i])
+            continue;
+
+        fileEntries[i].checksum = checksums[i];
+        entries[files[i].string()] = fileEntries[i];
+    }
+
+    save();
+    return checksums;
+}
+
+void ChecksumCache::load()
+{
+    boost::filesystem::ifstream stream(cacheFile);
+    if (!stream)
+        return;
+
+    std::string line;
+    if (!std::getline(stream, line) || line != cacheHeader)
+        return;
+
+    // Every line has the checksum, size and modification time, followed by the path that may contain spaces
+    while (std::getline(stream, line))
+    {
+        std::istringstream lineStream(line);
+        Entry entry;
+        long long modified;
+        std::string path;
+
+        if (!(lineStream >> std::hex >> entry.checksum >> std::dec >> entry.size >> modified) || lineStream.get() != ' ' ||
+            !std::getline(lineStream, path) || path.empty())
+            continue;
+
+        entry.modified = static_cast<std::time_t>(modified);
+        entries[path] = entry;
+    }
+}
+
+void ChecksumCache::save() const
+{
+    boost::system::error_code error;
+    if (cacheFile.has_parent_path())
+        boost::filesystem::create_directories(cacheFile.parent_path(), error);
+
+    boost::filesystem::ofstream stream(cacheFile, std::ios_base::trunc);
+    if (!stream)
+    {
+        LOG_MESSAGE_SIMPLE(MWMPLog::LOG_WARN, "Could not write checksum cache to %s", cacheFile.string().c_str());
+        return;
+    }
+
+    stream << cacheHeader << "\n";
+
+    for (const auto &entry : entries)
+    {
+        // Forget about files that no longer exist
+        if (!boost::filesystem::exists(entry.first, error))
+            continue;
+
+        stream << std::hex << entry.second.checksum << std::dec << " " << entry.second.size << " "
+               << static_cast<long long>(entry.second.modified) << " " << entry.first << "\n";
+    }
+}
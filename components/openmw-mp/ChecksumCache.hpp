@@ -0,0 +1,44 @@
+#ifndef OPENMW_CHECKSUMCACHE_HPP
+#define OPENMW_CHECKSUMCACHE_HPP
+
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/filesystem/path.hpp>
+
+namespace mwmp
+{
+    /*
+        CRC32 checksums of data files that are remembered across launches in a cache file
+
+        A file is only hashed again when its size or modification time has changed since it was last hashed,
+        and files that do need hashing are hashed on several threads at once
+    */
+    class ChecksumCache
+    {
+    public:
+        explicit ChecksumCache(const boost::filesystem::path &cacheFile);
+
+        // Returns the checksums in the same order as the files, and saves the cache file if any had to be hashed
+        std::vector<unsigned int> getChecksums(const std::vector<boost::filesystem::path> &files);
+
+    private:
+        struct Entry
+        {
+            boost::uintmax_t size;
+            std::time_t modified;
+            unsigned int checksum;
+        };
+
+        void load();
+        void save() const;
+
+        boost::filesystem::path cacheFile;
+        std::map<std::string, Entry> entries;
+    };
+}
+
+#endif //OPENMW_CHECKSUMCACHE_HPP
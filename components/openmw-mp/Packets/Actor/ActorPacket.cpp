@@ -30,20 +30,15 @@ void ActorPacket::Packet(RakNet::BitStream *bs, bool send)
     if (!PacketHeader(bs, send))
         return;
 
-    BaseActor actor;
+    if (!send)
+        actorList->baseActors.resize(actorList->count);
 
-    for (unsigned int i = 0; i < actorList->count; i++)
+    for (auto &&actor : actorList->baseActors)
     {
-        if (send)
-            actor = actorList->baseActors.at(i);
-
         RW(actor.refNum, send);
         RW(actor.mpNum, send);
 
         Actor(actor, send);
-
-        if (!send)
-            actorList->baseActors.push_back(actor);
     }
 }
 
@@ -52,7 +47,7 @@ bool ActorPacket::PacketHeader(RakNet::BitStream *bs, bool send)
     BasePacket::Packet(bs, send);
 
     RW(actorList->cell.mData, send, true);
-    RW(actorList->cell.mName, send, true);
+    RWIndexed(actorList->cell.mName, send);
 
     if (send)
         actorList->count = (unsigned int)(actorList->baseActors.size());
@@ -61,7 +56,8 @@ bool ActorPacket::PacketHeader(RakNet::BitStream *bs, bool send)
 
     RW(actorList->count, send);
 
-    if (actorList->count > maxActors)
+    // Every actor starts with its refNum and mpNum
+    if (actorList->count > maxActors || (!send && !isCountReadable(actorList->count, 2 * 32)))
     {
         actorList->isValid = false;
         return false;
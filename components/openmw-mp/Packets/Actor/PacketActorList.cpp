@@ -15,13 +15,11 @@ void PacketActorList::Packet(RakNet::BitStream *bs, bool send)
 
     RW(actorList->action, send);
 
-    BaseActor actor;
+    if (!send)
+        actorList->baseActors.resize(actorList->count);
 
-    for (unsigned int i = 0; i < actorList->count; i++)
+    for (auto &&actor : actorList->baseActors)
     {
-        if (send)
-            actor = actorList->baseActors.at(i);
-
         RW(actor.refId, send);
         RW(actor.refNum, send);
         RW(actor.mpNum, send);
@@ -31,8 +29,5 @@ void PacketActorList::Packet(RakNet::BitStream *bs, bool send)
             actorList->isValid = false;
             return;
         }
-
-        if (!send)
-            actorList->baseActors.push_back(actor);
     }
 }
@@ -1,4 +1,6 @@
+#include <vector>
 #include <components/openmw-mp/NetworkMessages.hpp>
+#include <components/openmw-mp/MWMPLog.hpp>
 #include <PacketPriority.h>
 #include <RakPeer.h>
 #include "BasePacket.hpp"
@@ -12,6 +14,7 @@ BasePacket::BasePacket(RakNet::RakPeerInterface *peer)
     reliability = RELIABLE_ORDERED;
     orderChannel = CHANNEL_SYSTEM;
     this->peer = peer;
+    sendStringTable = nullptr;
 }
 
 void BasePacket::Packet(RakNet::BitStream *bs, bool send)
@@ -54,16 +57,196 @@ uint32_t BasePacket::RequestData(RakNet::RakNetGUID guid)
 
 uint32_t BasePacket::Send(RakNet::AddressOrGUID destination)
 {
-    bsSend->ResetWritePointer();
-    Packet(bsSend, true);
-    return peer->Send(bsSend, priority, reliability, orderChannel, destination, false);
+    return SendWithStringTable(destination, false);
 }
 
 uint32_t BasePacket::Send(bool toOther)
 {
+    return SendWithStringTable(guid, toOther);
+}
+
+uint32_t BasePacket::SendWithStringTable(const RakNet::AddressOrGUID &destination, bool broadcast)
+{
+    // Indices are only understood by the recipient if it reads every packet of this type in order
+    RakNet::RakNetGUID recipient;
+    if (reliability == RELIABLE_ORDERED && getSingleRecipient(destination, broadcast, recipient) &&
+        canIndexStringsFor(recipient))
+    {
+        sendStringTable = PacketStringTables::getOutgoing(recipient, packetID);
+        sendStringTableOwner = recipient;
+    }
+
+    uint32_t tableSize = sendStringTable != nullptr ? sendStringTable->size() : 0;
+
     bsSend->ResetWritePointer();
     Packet(bsSend, true);
-    return peer->Send(bsSend, priority, reliability, orderChannel, guid, toOther);
+    uint32_t result = peer->Send(bsSend, priority, reliability, orderChannel, destination, broadcast);
+
+    // The strings added while writing never reached the recipient, so forget them again
+    if (result == 0 && sendStringTable != nullptr)
+        sendStringTable->truncate(tableSize);
+
+    sendStringTable = nullptr;
+    return result;
+}
+
+bool BasePacket::getSingleRecipient(const RakNet::AddressOrGUID &destination, bool broadcast, RakNet::RakNetGUID &recipient) const
+{
+    if (!broadcast)
+    {
+        recipient = destination.rakNetGuid != RakNet::UNASSIGNED_RAKNET_GUID ? destination.rakNetGuid :
+            peer->GetGuidFromSystemAddress(destination.systemAddress);
+        return recipient != RakNet::UNASSIGNED_RAKNET_GUID;
+    }
+
+    // A broadcast excludes the destination, which leaves a single recipient on a client connected to a server
+    // or on a server with just one other player online
+    unsigned short numberOfSystems = 0;
+    peer->GetConnectionList(nullptr, &numberOfSystems);
+    if (numberOfSystems == 0 || numberOfSystems > 2)
+        return false;
+
+    std::vector<RakNet::SystemAddress> systems(numberOfSystems);
+    peer->GetConnectionList(systems.data(), &numberOfSystems);
+
+    bool found = false;
+    for (unsigned short i = 0; i < numberOfSystems; ++i)
+    {
+        RakNet::RakNetGUID systemGuid = peer->GetGuidFromSystemAddress(systems[i]);
+        if (systemGuid == destination.rakNetGuid || (destination.rakNetGuid == RakNet::UNASSIGNED_RAKNET_GUID &&
+            systems[i] == destination.systemAddress))
+            continue;
+        if (found)
+            return false;
+        recipient = systemGuid;
+        found = true;
+    }
+    return found;
+}
+
+bool BasePacket::canIndexStringsFor(const RakNet::RakNetGUID &/*recipient*/) const
+{
+    return true;
+}
+
+bool BasePacket::RWVarint(uint32_t &value, bool write)
+{
+    if (write)
+    {
+        uint32_t remaining = value;
+        do
+        {
+            uint8_t byte = remaining & 0x7F;
+            remaining >>= 7;
+            if (remaining != 0)
+                byte |= 0x80;
+            bs->Write(byte);
+        } while (remaining != 0);
+        return true;
+    }
+
+    value = 0;
+    for (unsigned int shift = 0; shift < 35; shift += 7)
+    {
+        uint8_t byte;
+        if (!bs->Read(byte))
+            return false;
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+namespace
+{
+    // Codes written in front of an indexed string, indices are stored offset by FIRST_INDEX_CODE
+    enum IndexedStringCode : uint32_t
+    {
+        STRING_LITERAL = 0,
+        STRING_DEFINITION = 1,
+        FIRST_INDEX_CODE = 2
+    };
+}
+
+bool BasePacket::RWIndexed(std::string &str, bool write)
+{
+    if (write)
+    {
+        const RakNet::BitSize_t startBits = bs->GetNumberOfBitsUsed();
+        uint32_t index;
+        uint32_t code;
+
+        if (sendStringTable == nullptr || str.empty() || str.size() > PacketStringTable::maxStringLength)
+        {
+            code = STRING_LITERAL;
+            RWVarint(code, true);
+            return RW(str, true, true);
+        }
+        else if (sendStringTable->find(str, index))
+        {
+            code = index + FIRST_INDEX_CODE;
+            RWVarint(code, true);
+
+            // One byte for the literal code plus the literal itself
+            PacketStringTables::addSentBits(sendStringTableOwner, 8 + sendStringTable->getLiteralBits(index),
+                bs->GetNumberOfBitsUsed() - startBits);
+            return true;
+        }
+
+        index = sendStringTable->size();
+        code = index < PacketStringTable::maxEntries ? STRING_DEFINITION : STRING_LITERAL;
+        RWVarint(code, true);
+        if (code == STRING_DEFINITION)
+            RWVarint(index, true);
+
+        const RakNet::BitSize_t literalStartBits = bs->GetNumberOfBitsUsed();
+        RW(str, true, true);
+        const uint32_t literalBits = bs->GetNumberOfBitsUsed() - literalStartBits;
+
+        if (code == STRING_DEFINITION)
+        {
+            sendStringTable->add(str, literalBits);
+            PacketStringTables::addSentBits(sendStringTableOwner, 8 + literalBits, bs->GetNumberOfBitsUsed() - startBits);
+        }
+        return true;
+    }
+
+    uint32_t code;
+    if (!RWVarint(code, false))
+    {
+        str = std::string();
+        return false;
+    }
+
+    if (code == STRING_LITERAL)
+        return RW(str, false, true);
+
+    PacketStringTable &table = PacketStringTables::getIncoming(PacketStringTables::getSender(), packetID);
+
+    if (code == STRING_DEFINITION)
+    {
+        uint32_t index;
+        if (!RWVarint(index, false) || !RW(str, false, true, PacketStringTable::maxStringLength) || !table.set(index, str))
+        {
+            LOG_MESSAGE_SIMPLE(MWMPLog::LOG_ERROR, "Invalid string table entry in packet %i", packetID);
+            str = std::string();
+            packetValid = false;
+            return false;
+        }
+        return true;
+    }
+
+    const std::string *stored = table.get(code - FIRST_INDEX_CODE);
+    if (stored == nullptr)
+    {
+        LOG_MESSAGE_SIMPLE(MWMPLog::LOG_ERROR, "Unknown string table index %u in packet %i", code - FIRST_INDEX_CODE, packetID);
+        str = std::string();
+        packetValid = false;
+        return false;
+    }
+    str = *stored;
+    return true;
 }
 
 void BasePacket::Read()
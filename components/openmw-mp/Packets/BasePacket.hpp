@@ -2,10 +2,13 @@
 #define OPENMW_BASEPACKET_HPP
 
 #include <string>
+#include <type_traits>
+#include <vector>
 #include <RakNetTypes.h>
 #include <BitStream.h>
 #include <PacketPriority.h>
 
+#include "PacketStringTable.hpp"
 
 namespace mwmp
 {
@@ -119,6 +122,92 @@ namespace mwmp
             return res;
         }
 
+        // Whether count elements of at least minBitsPerElement each can still be read from the stream,
+        // so a corrupt count can't make the reader allocate or loop far beyond the end of the packet
+        bool isCountReadable(uint32_t count, uint32_t minBitsPerElement) const
+        {
+            return static_cast<uint64_t>(count) * minBitsPerElement <= bs->GetNumberOfUnreadBits();
+        }
+
+        // The number of elements in a list, ahead of the elements themselves. When reading, the list is resized
+        // to the number read, so the elements can then be read in place by reference just like they're written
+        template<class containerType>
+        bool RWCount(containerType &container, uint32_t &count, bool write, uint32_t minBitsPerElement = 1)
+        {
+            if (write)
+            {
+                count = static_cast<uint32_t>(container.size());
+                bs->Write(count);
+                return true;
+            }
+
+            container.clear();
+
+            if (!bs->Read(count) || !isCountReadable(count, minBitsPerElement))
+            {
+                count = 0;
+                packetValid = false;
+                return false;
+            }
+
+            container.resize(count);
+            return true;
+        }
+
+        // Byte arrays, with their size in front, read and written in one go rather than byte by byte. Wider
+        // elements are left out on purpose, RakNet swaps the bytes of the scalars it writes on little endian
+        // machines and a plain copy would not
+        template<class templateType>
+        bool RW(std::vector<templateType> &data, bool write, uint32_t maxSize)
+        {
+            static_assert(sizeof(templateType) == 1 && std::is_trivially_copyable<templateType>::value,
+                "Only arrays of bytes can be copied in one go");
+
+            uint32_t size;
+
+            if (write)
+            {
+                size = data.size() > maxSize ? maxSize : static_cast<uint32_t>(data.size());
+                bs->Write(size);
+                if (size != 0)
+                    bs->Write(reinterpret_cast<const char *>(data.data()), size);
+                return true;
+            }
+
+            if (!bs->Read(size) || size > maxSize || !isCountReadable(size, 8))
+            {
+                data.clear();
+                packetValid = false;
+                return false;
+            }
+
+            data.resize(size);
+            if (size != 0 && !bs->Read(reinterpret_cast<char *>(data.data()), size))
+            {
+                data.clear();
+                packetValid = false;
+                return false;
+            }
+
+            return true;
+        }
+
+        // Variable-length unsigned integer, 7 bits per byte
+        bool RWVarint(uint32_t &value, bool write);
+
+        // Strings that are likely to repeat, such as refIds and cell names, are sent in full only the
+        // first time they are used for this packet type on a connection with string tables enabled,
+        // and as indices into the connection's PacketStringTable afterwards
+        bool RWIndexed(std::string &str, bool write);
+
+        // Whether a packet sent to this recipient will always be read by it, which is required for the
+        // recipient to keep track of the strings stored in the sender's string table
+        virtual bool canIndexStringsFor(const RakNet::RakNetGUID &recipient) const;
+
+    private:
+        bool getSingleRecipient(const RakNet::AddressOrGUID &destination, bool broadcast, RakNet::RakNetGUID &recipient) const;
+        uint32_t SendWithStringTable(const RakNet::AddressOrGUID &destination, bool broadcast);
+
     protected:
         uint8_t packetID;
         PacketReliability reliability;
@@ -128,6 +217,9 @@ namespace mwmp
         RakNet::RakPeerInterface *peer;
         RakNet::RakNetGUID guid;
         bool packetValid;
+
+        PacketStringTable *sendStringTable;
+        RakNet::RakNetGUID sendStringTableOwner;
     };
 }
 
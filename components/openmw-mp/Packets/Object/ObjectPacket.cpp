@@ -31,17 +31,11 @@ void ObjectPacket::Packet(RakNet::BitStream *bs, bool send)
     if (!PacketHeader(bs, send))
         return;
 
-    BaseObject baseObject;
-    for (unsigned int i = 0; i < objectList->baseObjectCount; i++)
-    {
-        if (send)
-            baseObject = objectList->baseObjects.at(i);
+    if (!send)
+        objectList->baseObjects.resize(objectList->baseObjectCount);
 
+    for (auto &&baseObject : objectList->baseObjects)
         Object(baseObject, send);
-
-        if (!send)
-            objectList->baseObjects.push_back(baseObject);
-    }
 }
 
 bool ObjectPacket::PacketHeader(RakNet::BitStream *bs, bool send)
@@ -62,7 +56,7 @@ bool ObjectPacket::PacketHeader(RakNet::BitStream *bs, bool send)
 
     RW(objectList->baseObjectCount, send);
 
-    if (objectList->baseObjectCount > maxObjects)
+    if (objectList->baseObjectCount > maxObjects || (!send && !isCountReadable(objectList->baseObjectCount, 1)))
     {
         objectList->isValid = false;
         return false;
@@ -71,7 +65,7 @@ bool ObjectPacket::PacketHeader(RakNet::BitStream *bs, bool send)
     if (hasCellData)
     {
         RW(objectList->cell.mData, send, true);
-        RW(objectList->cell.mName, send, true);
+        RWIndexed(objectList->cell.mName, send);
     }
 
     return true;
@@ -79,7 +73,7 @@ bool ObjectPacket::PacketHeader(RakNet::BitStream *bs, bool send)
 
 void ObjectPacket::Object(BaseObject &baseObject, bool send)
 {
-    RW(baseObject.refId, send);
+    RWIndexed(baseObject.refId, send);
     RW(baseObject.refNum, send);
     RW(baseObject.mpNum, send);
 }
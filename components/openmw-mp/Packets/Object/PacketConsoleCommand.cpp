@@ -15,20 +15,16 @@ void PacketConsoleCommand::Packet(RakNet::BitStream *bs, bool send)
 
     RW(objectList->consoleCommand, send);
 
-    BaseObject baseObject;
-    for (unsigned int i = 0; i < objectList->baseObjectCount; i++)
-    {
-        if (send)
-            baseObject = objectList->baseObjects.at(i);
+    if (!send)
+        objectList->baseObjects.resize(objectList->baseObjectCount);
 
+    for (auto &&baseObject : objectList->baseObjects)
+    {
         RW(baseObject.isPlayer, send);
 
         if (baseObject.isPlayer)
             RW(baseObject.guid, send);
         else
             Object(baseObject, send);
-
-        if (!send)
-            objectList->baseObjects.push_back(baseObject);
     }
 }
@@ -18,16 +18,13 @@ void PacketContainer::Packet(RakNet::BitStream *bs, bool send)
     RW(objectList->action, send);
     RW(objectList->containerSubAction, send);
 
-    BaseObject baseObject;
-    for (unsigned int i = 0; i < objectList->baseObjectCount; i++)
+    if (!send)
+        objectList->baseObjects.resize(objectList->baseObjectCount);
+
+    for (auto &&baseObject : objectList->baseObjects)
     {
         if (send)
-        {
-            baseObject = objectList->baseObjects.at(i);
             baseObject.containerItemCount = (unsigned int) (baseObject.containerItems.size());
-        }
-        else
-            baseObject.containerItems.clear();
 
         Object(baseObject, send);
 
@@ -39,24 +36,17 @@ void PacketContainer::Packet(RakNet::BitStream *bs, bool send)
             return;
         }
 
-        ContainerItem containerItem;
+        if (!send)
+            baseObject.containerItems.resize(baseObject.containerItemCount);
 
-        for (unsigned int j = 0; j < baseObject.containerItemCount; j++)
+        for (auto &&containerItem : baseObject.containerItems)
         {
-            if (send)
-                containerItem = baseObject.containerItems.at(j);
-
-            RW(containerItem.refId, send, true);
+            RWIndexed(containerItem.refId, send);
             RW(containerItem.count, send);
             RW(containerItem.charge, send);
             RW(containerItem.enchantmentCharge, send);
-            RW(containerItem.soul, send, true);
+            RWIndexed(containerItem.soul, send);
             RW(containerItem.actionCount, send);
-
-            if (!send)
-                baseObject.containerItems.push_back(containerItem);
         }
-        if (!send)
-            objectList->baseObjects.push_back(baseObject);
     }
 }
@@ -14,12 +14,11 @@ void PacketObjectActivate::Packet(RakNet::BitStream *bs, bool send)
     if (!PacketHeader(bs, send))
         return;
 
-    BaseObject baseObject;
-    for (unsigned int i = 0; i < objectList->baseObjectCount; i++)
-    {
-        if (send)
-            baseObject = objectList->baseObjects.at(i);
+    if (!send)
+        objectList->baseObjects.resize(objectList->baseObjectCount);
 
+    for (auto &&baseObject : objectList->baseObjects)
+    {
         RW(baseObject.isPlayer, send);
 
         if (baseObject.isPlayer)
@@ -41,8 +40,5 @@ void PacketObjectActivate::Packet(RakNet::BitStream *bs, bool send)
 
             RW(baseObject.activatingActor.name, send);
         }
-
-        if (!send)
-            objectList->baseObjects.push_back(baseObject);
     }
 }
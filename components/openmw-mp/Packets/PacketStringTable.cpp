@@ -0,0 +1,131 @@
+#include <components/openmw-mp/MWMPLog.hpp>
+#include "PacketStringTable.hpp"
+
+using namespace mwmp;
+
+std::unordered_map<RakNet::RakNetGUID, PacketStringTables::Connection, PacketStringTables::GuidHash> PacketStringTables::connections;
+RakNet::RakNetGUID PacketStringTables::sender = RakNet::UNASSIGNED_RAKNET_GUID;
+
+bool PacketStringTable::find(const std::string &str, uint32_t &index) const
+{
+    auto it = indices.find(str);
+    if (it == indices.end())
+        return false;
+    index = it->second;
+    return true;
+}
+
+const std::string *PacketStringTable::get(uint32_t index) const
+{
+    if (index >= entries.size() || entries[index].str.empty())
+        return nullptr;
+    return &entries[index].str;
+}
+
+bool PacketStringTable::add(const std::string &str, uint32_t literalBits)
+{
+    if (entries.size() >= maxEntries)
+        return false;
+
+    indices[str] = static_cast<uint32_t>(entries.size());
+    entries.push_back({str, literalBits});
+    return true;
+}
+
+bool PacketStringTable::set(uint32_t index, const std::string &str)
+{
+    if (index >= maxEntries)
+        return false;
+
+    if (index >= entries.size())
+        entries.resize(index + 1);
+    entries[index].str = str;
+    return true;
+}
+
+uint32_t PacketStringTable::getLiteralBits(uint32_t index) const
+{
+    return index < entries.size() ? entries[index].literalBits : 0;
+}
+
+uint32_t PacketStringTable::size() const
+{
+    return static_cast<uint32_t>(entries.size());
+}
+
+void PacketStringTable::truncate(uint32_t size)
+{
+    while (entries.size() > size)
+    {
+        indices.erase(entries.back().str);
+        entries.pop_back();
+    }
+}
+
+PacketStringTables::Connection::Connection() : enabled(false), literalBits(0), sentBits(0)
+{
+
+}
+
+size_t PacketStringTables::GuidHash::operator()(const RakNet::RakNetGUID &guid) const
+{
+    return std::hash<uint64_t>()(guid.g);
+}
+
+void PacketStringTables::enable(RakNet::RakNetGUID guid)
+{
+    connections[guid].enabled = true;
+}
+
+void PacketStringTables::remove(RakNet::RakNetGUID guid)
+{
+    auto it = connections.find(guid);
+    if (it == connections.end())
+        return;
+
+    const Connection &connection = it->second;
+    if (connection.literalBits > 0)
+    {
+        LOG_MESSAGE_SIMPLE(MWMPLog::LOG_INFO, "Indexed strings sent to %lu took %llu bytes instead of %llu",
+            guid.g, (unsigned long long) (connection.sentBits + 7) / 8, (unsigned long long) (connection.literalBits + 7) / 8);
+    }
+
+    connections.erase(it);
+}
+
+void PacketStringTables::clear()
+{
+    connections.clear();
+}
+
+PacketStringTable *PacketStringTables::getOutgoing(RakNet::RakNetGUID guid, uint8_t packetID)
+{
+    auto it = connections.find(guid);
+    if (it == connections.end() || !it->second.enabled)
+        return nullptr;
+    return &it->second.outgoing[packetID];
+}
+
+PacketStringTable &PacketStringTables::getIncoming(RakNet::RakNetGUID guid, uint8_t packetID)
+{
+    return connections[guid].incoming[packetID];
+}
+
+void PacketStringTables::setSender(RakNet::RakNetGUID guid)
+{
+    sender = guid;
+}
+
+RakNet::RakNetGUID PacketStringTables::getSender()
+{
+    return sender;
+}
+
+void PacketStringTables::addSentBits(RakNet::RakNetGUID guid, uint32_t literalBits, uint32_t sentBits)
+{
+    auto it = connections.find(guid);
+    if (it == connections.end())
+        return;
+    it->second.literalBits += literalBits;
+    it->second.sentBits += sentBits;
+}
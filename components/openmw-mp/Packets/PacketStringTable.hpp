@@ -0,0 +1,93 @@
+#ifndef OPENMW_PACKETSTRINGTABLE_HPP
+#define OPENMW_PACKETSTRINGTABLE_HPP
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <RakNetTypes.h>
+
+namespace mwmp
+{
+    /*
+        Strings that have already been sent for one packet type over one connection,
+        allowing repeated strings such as refIds to be sent as indices
+    */
+    class PacketStringTable
+    {
+    public:
+        bool find(const std::string &str, uint32_t &index) const;
+        const std::string *get(uint32_t index) const;
+
+        // Adds the string as the next index, returns false if the table is full
+        bool add(const std::string &str, uint32_t literalBits);
+        // Stores a string under the index chosen by the sender, returns false if the index is out of range
+        bool set(uint32_t index, const std::string &str);
+
+        uint32_t getLiteralBits(uint32_t index) const;
+
+        uint32_t size() const;
+        void truncate(uint32_t size);
+
+        const static uint32_t maxEntries = 16 * 1024;
+        const static uint32_t maxStringLength = 256;
+
+    private:
+        struct Entry
+        {
+            std::string str;
+            uint32_t literalBits;
+        };
+
+        std::vector<Entry> entries;
+        std::unordered_map<std::string, uint32_t> indices;
+    };
+
+    /*
+        Per-connection string tables
+
+        A sender only uses indices for a connection after enable() was called for it, which should
+        happen once the other side is guaranteed to read every packet that can carry indexed strings.
+        The receiving side learns each table from the packets themselves, so it needs no setup beyond
+        setSender() being called for every received packet.
+    */
+    class PacketStringTables
+    {
+    public:
+        static void enable(RakNet::RakNetGUID guid);
+        static void remove(RakNet::RakNetGUID guid);
+        static void clear();
+
+        // Returns nullptr if indexed strings are not enabled for this connection
+        static PacketStringTable *getOutgoing(RakNet::RakNetGUID guid, uint8_t packetID);
+        static PacketStringTable &getIncoming(RakNet::RakNetGUID guid, uint8_t packetID);
+
+        static void setSender(RakNet::RakNetGUID guid);
+        static RakNet::RakNetGUID getSender();
+
+        // Track how many bits the strings of a connection took compared to sending them literally
+        static void addSentBits(RakNet::RakNetGUID guid, uint32_t literalBits, uint32_t sentBits);
+
+    private:
+        struct Connection
+        {
+            Connection();
+
+            bool enabled;
+            uint64_t literalBits;
+            uint64_t sentBits;
+            std::unordered_map<uint8_t, PacketStringTable> outgoing;
+            std::unordered_map<uint8_t, PacketStringTable> incoming;
+        };
+
+        struct GuidHash
+        {
+            size_t operator()(const RakNet::RakNetGUID &guid) const;
+        };
+
+        static std::unordered_map<RakNet::RakNetGUID, Connection, GuidHash> connections;
+        static RakNet::RakNetGUID sender;
+    };
+}
+
+#endif //OPENMW_PACKETSTRINGTABLE_HPP
@@ -0,0 +1,181 @@
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_streambuf.hpp>
+
+#include <components/openmw-mp/NetworkMessages.hpp>
+#include <components/openmw-mp/MWMPLog.hpp>
+#include "PacketWorldSnapshot.hpp"
+
+using namespace mwmp;
+
+namespace
+{
+    void appendVarint(std::string &str, uint32_t value)
+    {
+        do
+        {
+            char byte = value & 0x7F;
+            value >>= 7;
+            if (value != 0)
+                byte |= 0x80;
+            str.push_back(byte);
+        } while (value != 0);
+    }
+
+    bool readVarint(const std::string &str, uint32_t &offset, uint32_t &value)
+    {
+        value = 0;
+        for (unsigned int shift = 0; shift < 35 && offset < str.size(); shift += 7)
+        {
+            const uint8_t byte = static_cast<uint8_t>(str[offset++]);
+            value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                return true;
+        }
+        return false;
+    }
+
+    std::string compress(const std::string &data)
+    {
+        std::string compressed;
+        boost::iostreams::filtering_streambuf<boost::iostreams::output> outputStreamBuf;
+        outputStreamBuf.push(boost::iostreams::zlib_compressor());
+        outputStreamBuf.push(boost::iostreams::back_inserter(compressed));
+        boost::iostreams::copy(boost::iostreams::array_source(data.data(), data.size()), outputStreamBuf);
+        return compressed;
+    }
+
+    // Never produces more than expectedSize bytes, throws if the data is corrupt
+    std::string decompress(const std::string &compressed, uint32_t expectedSize)
+    {
+        std::string data(expectedSize, '\0');
+        boost::iostreams::filtering_streambuf<boost::iostreams::input> inputStreamBuf;
+        inputStreamBuf.push(boost::iostreams::zlib_decompressor());
+        inputStreamBuf.push(boost::iostreams::array_source(compressed.data(), compressed.size()));
+        const std::streamsize size = boost::iostreams::copy(inputStreamBuf, boost::iostreams::array_sink(&data[0], data.size()));
+        data.resize(static_cast<std::string::size_type>(size));
+        return data;
+    }
+}
+
+PacketWorldSnapshot::PacketWorldSnapshot(RakNet::RakPeerInterface *peer) : BasePacket(peer)
+{
+    packetID = ID_WORLD_SNAPSHOT;
+    orderChannel = CHANNEL_PLAYER; // Keep it in order with the updates sent about the same players
+    chunkIndex = 0;
+    isLastChunk = true;
+}
+
+void PacketWorldSnapshot::Packet(RakNet::BitStream *bs, bool send)
+{
+    BasePacket::Packet(bs, send);
+
+    RW(chunkIndex, send);
+    RW(isLastChunk, send);
+
+    uint32_t dataSize = static_cast<uint32_t>(data.size());
+    RWVarint(dataSize, send);
+
+    if (send)
+    {
+        const std::string compressed = compress(data);
+        uint32_t compressedSize = static_cast<uint32_t>(compressed.size());
+        RWVarint(compressedSize, send);
+        bs->Write(compressed.data(), compressedSize);
+        return;
+    }
+
+    clear();
+
+    uint32_t compressedSize;
+    if (!RWVarint(compressedSize, send) || dataSize > maxDataSize || compressedSize > BITS_TO_BYTES(bs->GetNumberOfUnreadBits()))
+    {
+        LOG_MESSAGE_SIMPLE(MWMPLog::LOG_ERROR, "Invalid size of world snapshot chunk %u", chunkIndex);
+        packetValid = false;
+        return;
+    }
+
+    std::string compressed(compressedSize, '\0');
+    if (compressedSize > 0 && !bs->Read(&compressed[0], compressedSize))
+    {
+        packetValid = false;
+        return;
+    }
+
+    try
+    {
+        data = decompress(compressed, dataSize);
+    }
+    catch (std::exception &e)
+    {
+        LOG_MESSAGE_SIMPLE(MWMPLog::LOG_ERROR, "Failed to decompress world snapshot chunk %u: %s", chunkIndex, e.what());
+        packetValid = false;
+        return;
+    }
+
+    if (data.size() != dataSize)
+    {
+        LOG_MESSAGE_SIMPLE(MWMPLog::LOG_ERROR, "World snapshot chunk %u has %u bytes instead of %u", chunkIndex,
+            (uint32_t) data.size(), dataSize);
+        clear();
+        packetValid = false;
+        return;
+    }
+
+    uint32_t offset = 0;
+    while (offset < data.size())
+    {
+        Entry entry;
+        if (!readVarint(data, offset, entry.length) || entry.length < headerSize() || entry.length > data.size() - offset)
+        {
+            LOG_MESSAGE_SIMPLE(MWMPLog::LOG_ERROR, "Invalid packet in world snapshot chunk %u", chunkIndex);
+            clear();
+            packetValid = false;
+            return;
+        }
+        entry.offset = offset;
+        entries.push_back(entry);
+        offset += entry.length;
+    }
+}
+
+void PacketWorldSnapshot::clear()
+{
+    data.clear();
+    entries.clear();
+}
+
+void PacketWorldSnapshot::addPacket(RakNet::BitStream &packetStream)
+{
+    const uint32_t length = packetStream.GetNumberOfBytesUsed();
+    appendVarint(data, length);
+
+    Entry entry;
+    entry.offset = static_cast<uint32_t>(data.size());
+    entry.length = length;
+    entries.push_back(entry);
+
+    data.append(reinterpret_cast<const char *>(packetStream.GetData()), length);
+}
+
+uint32_t PacketWorldSnapshot::getNumberOfPackets() const
+{
+    return static_cast<uint32_t>(entries.size());
+}
+
+const unsigned char *PacketWorldSnapshot::getPacketData(uint32_t index) const
+{
+    return reinterpret_cast<const unsigned char *>(data.data()) + entries[index].offset;
+}
+
+uint32_t PacketWorldSnapshot::getPacketLength(uint32_t index) const
+{
+    return entries[index].length;
+}
+
+uint32_t PacketWorldSnapshot::getDataSize() const
+{
+    return static_cast<uint32_t>(data.size());
+}
@@ -0,0 +1,53 @@
+#ifndef OPENMW_PACKETWORLDSNAPSHOT_HPP
+#define OPENMW_PACKETWORLDSNAPSHOT_HPP
+
+#include <string>
+#include <vector>
+#include "BasePacket.hpp"
+
+namespace mwmp
+{
+    /*
+        A chunk of the state a newly joined client needs about the rest of the world, made up of regular
+        packets that the client processes as if it had received them one by one
+
+        The packets of a chunk are compressed together, which removes most of the data they have in common,
+        such as the header of every packet and repeated refIds
+    */
+    class PacketWorldSnapshot : public BasePacket
+    {
+    public:
+        PacketWorldSnapshot(RakNet::RakPeerInterface *peer);
+
+        virtual void Packet(RakNet::BitStream *bs, bool send);
+
+        void clear();
+
+        // Appends a packet that has been written to packetStream, including its header
+        void addPacket(RakNet::BitStream &packetStream);
+
+        uint32_t getNumberOfPackets() const;
+        const unsigned char *getPacketData(uint32_t index) const;
+        uint32_t getPacketLength(uint32_t index) const;
+
+        // Size of the packets before compression
+        uint32_t getDataSize() const;
+
+        uint16_t chunkIndex;
+        bool isLastChunk;
+
+        const static uint32_t maxDataSize = 1024 * 1024; // 1 MiB
+
+    private:
+        struct Entry
+        {
+            uint32_t offset;
+            uint32_t length;
+        };
+
+        std::string data;
+        std::vector<Entry> entries;
+    };
+}
+
+#endif //OPENMW_PACKETWORLDSNAPSHOT_HPP
@@ -24,16 +24,8 @@ void PacketPlayerAttribute::Packet(RakNet::BitStream *bs, bool send)
     {
         uint32_t count;
 
-        if (send)
-            count = static_cast<uint32_t>(player->attributeIndexChanges.size());
-
-        RW(count, send);
-
-        if (!send)
-        {
-            player->attributeIndexChanges.clear();
-            player->attributeIndexChanges.resize(count);
-        }
+        if (!RWCount(player->attributeIndexChanges, count, send, 8))
+            return;
 
         for (auto &&attributeIndex : player->attributeIndexChanges)
         {
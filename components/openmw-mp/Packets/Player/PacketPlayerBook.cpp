@@ -13,23 +13,11 @@ void PacketPlayerBook::Packet(RakNet::BitStream *bs, bool send)
 {
     PlayerPacket::Packet(bs, send);
 
-    if (send)
-        player->bookChanges.count = (unsigned int)(player->bookChanges.books.size());
-    else
-        player->bookChanges.books.clear();
+    if (!RWCount(player->bookChanges.books, player->bookChanges.count, send, 1))
+        return;
 
-    RW(player->bookChanges.count, send);
-
-    for (unsigned int i = 0; i < player->bookChanges.count; i++)
+    for (auto &&book : player->bookChanges.books)
     {
-        Book book;
-
-        if (send)
-            book = player->bookChanges.books.at(i);
-
         RW(book.bookId, send, true);
-
-        if (!send)
-            player->bookChanges.books.push_back(book);
     }
 }
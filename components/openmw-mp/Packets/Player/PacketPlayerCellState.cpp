@@ -13,25 +13,13 @@ void mwmp::PacketPlayerCellState::Packet(RakNet::BitStream *bs, bool send)
 {
     PlayerPacket::Packet(bs, send);
 
-    if (send)
-        player->cellStateChanges.count = (unsigned int)(player->cellStateChanges.cellStates.size());
-    else
-        player->cellStateChanges.cellStates.clear();
+    if (!RWCount(player->cellStateChanges.cellStates, player->cellStateChanges.count, send, 1))
+        return;
 
-    RW(player->cellStateChanges.count, send);
-
-    for (unsigned int i = 0; i < player->cellStateChanges.count; i++)
+    for (auto &&cellState : player->cellStateChanges.cellStates)
     {
-        CellState cellState;
-
-        if (send)
-            cellState = player->cellStateChanges.cellStates.at(i);
-        
         RW(cellState.type, send);
         RW(cellState.cell.mData, send, true);
         RW(cellState.cell.mName, send, true);
-
-        if (!send)
-            player->cellStateChanges.cellStates.push_back(cellState);
     }
 }
@@ -25,20 +25,20 @@ void PacketPlayerEquipment::Packet(RakNet::BitStream *bs, bool send)
     else
     {
         uint32_t count;
-        if (send)
-            count = static_cast<uint32_t>(player->equipmentIndexChanges.size());
 
-        RW(count, send);
-
-        if (!send)
-        {
-            player->equipmentIndexChanges.clear();
-            player->equipmentIndexChanges.resize(count);
-        }
+        if (!RWCount(player->equipmentIndexChanges, count, send, 32))
+            return;
 
         for (auto &&equipmentIndex : player->equipmentIndexChanges)
         {
             RW(equipmentIndex, send);
+
+            if (equipmentIndex < 0 || equipmentIndex >= equipmentSlots)
+            {
+                packetValid = false;
+                return;
+            }
+
             ExchangeItemInformation(player->equipmentItems[equipmentIndex], send);
         }
     }
@@ -46,7 +46,7 @@ void PacketPlayerEquipment::Packet(RakNet::BitStream *bs, bool send)
 
 void PacketPlayerEquipment::ExchangeItemInformation(Item &item, bool send)
 {
-    RW(item.refId, send, true);
+    RWIndexed(item.refId, send);
     RW(item.count, send);
     RW(item.charge, send);
     RW(item.enchantmentCharge, send);
@@ -15,20 +15,11 @@ void PacketPlayerFaction::Packet(RakNet::BitStream *bs, bool send)
 
     RW(player->factionChanges.action, send);
 
-    if (send)
-        player->factionChanges.count = (unsigned int)(player->factionChanges.factions.size());
-    else
-        player->factionChanges.factions.clear();
+    if (!RWCount(player->factionChanges.factions, player->factionChanges.count, send, 1))
+        return;
 
-    RW(player->factionChanges.count, send);
-
-    for (unsigned int i = 0; i < player->factionChanges.count; i++)
+    for (auto &&faction : player->factionChanges.factions)
     {
-        Faction faction;
-
-        if (send)
-            faction = player->factionChanges.factions.at(i);
-
         RW(faction.factionId, send, true);
 
         if (player->factionChanges.action == FactionChanges::RANK)
@@ -39,8 +30,5 @@ void PacketPlayerFaction::Packet(RakNet::BitStream *bs, bool send)
 
         if (player->factionChanges.action == FactionChanges::REPUTATION)
             RW(faction.reputation, send);
-
-        if (!send)
-            player->factionChanges.factions.push_back(faction);
     }
 }
@@ -19,27 +19,15 @@ void PacketPlayerInventory::Packet(RakNet::BitStream *bs, bool send)
 
     RW(player->inventoryChanges.action, send);
 
-    if (send)
-        player->inventoryChanges.count = (unsigned int) (player->inventoryChanges.items.size());
-    else
-        player->inventoryChanges.items.clear();
+    if (!RWCount(player->inventoryChanges.items, player->inventoryChanges.count, send, 3 * 32))
+        return;
 
-    RW(player->inventoryChanges.count, send);
-
-    for (unsigned int i = 0; i < player->inventoryChanges.count; i++)
+    for (auto &&item : player->inventoryChanges.items)
     {
-        Item item;
-
-        if (send)
-            item = player->inventoryChanges.items.at(i);
-
-        RW(item.refId, send, true);
+        RWIndexed(item.refId, send);
         RW(item.count, send);
         RW(item.charge, send);
         RW(item.enchantmentCharge, send);
-        RW(item.soul, send, true);
-
-        if (!send)
-            player->inventoryChanges.items.push_back(item);
+        RWIndexed(item.soul, send);
     }
 }
@@ -13,20 +13,11 @@ void PacketPlayerJournal::Packet(RakNet::BitStream *bs, bool send)
 {
     PlayerPacket::Packet(bs, send);
 
-    if (send)
-        player->journalChanges.count = (unsigned int)(player->journalChanges.journalItems.size());
-    else
-        player->journalChanges.journalItems.clear();
+    if (!RWCount(player->journalChanges.journalItems, player->journalChanges.count, send, 1))
+        return;
 
-    RW(player->journalChanges.count, send);
-
-    for (unsigned int i = 0; i < player->journalChanges.count; i++)
+    for (auto &&journalItem : player->journalChanges.journalItems)
     {
-        JournalItem journalItem;
-
-        if (send)
-            journalItem = player->journalChanges.journalItems.at(i);
-
         RW(journalItem.type, send);
         RW(journalItem.quest, send, true);
         RW(journalItem.index, send);
@@ -44,8 +35,5 @@ void PacketPlayerJournal::Packet(RakNet::BitStream *bs, bool send)
                 RW(journalItem.timestamp.day, send);
             }
         }
-
-        if (!send)
-            player->journalChanges.journalItems.push_back(journalItem);
     }
 }
@@ -21,4 +21,5 @@ void PacketPlayerPosition::Packet(RakNet::BitStream *bs, bool send)
 
     RW(player->position, send, 1);
     RW(player->direction, send, 1);
+    RW(player->positionTime, send);
 }
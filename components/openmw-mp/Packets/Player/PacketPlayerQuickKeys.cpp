@@ -13,28 +13,16 @@ void PacketPlayerQuickKeys::Packet(RakNet::BitStream *bs, bool send)
 {
     PlayerPacket::Packet(bs, send);
 
-    if (send)
-        player->quickKeyChanges.count = (unsigned int) (player->quickKeyChanges.quickKeys.size());
-    else
-        player->quickKeyChanges.quickKeys.clear();
+    if (!RWCount(player->quickKeyChanges.quickKeys, player->quickKeyChanges.count, send, 1))
+        return;
 
-    RW(player->quickKeyChanges.count, send);
-
-    for (unsigned int i = 0; i < player->quickKeyChanges.count; i++)
+    for (auto &&quickKey : player->quickKeyChanges.quickKeys)
     {
-        QuickKey quickKey;
-
-        if (send)
-            quickKey = player->quickKeyChanges.quickKeys.at(i);
-
         RW(quickKey.type, send);
         RW(quickKey.slot, send);
 
         if (quickKey.type != QuickKey::UNASSIGNED)
             RW(quickKey.itemId, send);
-
-        if (!send)
-            player->quickKeyChanges.quickKeys.push_back(quickKey);
     }
 
 }
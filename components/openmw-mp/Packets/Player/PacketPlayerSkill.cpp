@@ -24,16 +24,8 @@ void PacketPlayerSkill::Packet(RakNet::BitStream *bs, bool send)
     {
         uint32_t count;
 
-        if (send)
-            count = static_cast<uint32_t>(player->skillIndexChanges.size());
-
-        RW(count, send);
-
-        if (!send)
-        {
-            player->skillIndexChanges.clear();
-            player->skillIndexChanges.resize(count);
-        }
+        if (!RWCount(player->skillIndexChanges, count, send, 8))
+            return;
 
         for (auto &&skillId : player->skillIndexChanges)
         {
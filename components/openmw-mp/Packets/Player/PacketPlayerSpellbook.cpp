@@ -15,24 +15,12 @@ void PacketPlayerSpellbook::Packet(RakNet::BitStream *bs, bool send)
 
     RW(player->spellbookChanges.action, send);
 
-    if (send)
-        player->spellbookChanges.count = (unsigned int) (player->spellbookChanges.spells.size());
-    else
-        player->spellbookChanges.spells.clear();
+    if (!RWCount(player->spellbookChanges.spells, player->spellbookChanges.count, send, 1))
+        return;
 
-    RW(player->spellbookChanges.count, send);
-
-    for (unsigned int i = 0; i < player->spellbookChanges.count; i++)
+    for (auto &&spell : player->spellbookChanges.spells)
     {
-        ESM::Spell spell;
-
-        if (send)
-            spell = player->spellbookChanges.spells.at(i);
-
-        RW(spell.mId, send, true);
-
-        if (!send)
-            player->spellbookChanges.spells.push_back(spell);
+        RWIndexed(spell.mId, send);
     }
 
 }
@@ -23,16 +23,8 @@ void PacketPlayerStatsDynamic::Packet(RakNet::BitStream *bs, bool send)
     {
         uint32_t count;
 
-        if (send)
-            count = static_cast<uint32_t>(player->statsDynamicIndexChanges.size());
-
-        RW(count, send);
-
-        if (!send)
-        {
-            player->statsDynamicIndexChanges.clear();
-            player->statsDynamicIndexChanges.resize(count);
-        }
+        if (!RWCount(player->statsDynamicIndexChanges, count, send, 8))
+            return;
 
         for (auto &&statsDynamicIndex : player->statsDynamicIndexChanges)
         {
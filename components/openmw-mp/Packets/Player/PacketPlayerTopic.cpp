@@ -13,23 +13,11 @@ void PacketPlayerTopic::Packet(RakNet::BitStream *bs, bool send)
 {
     PlayerPacket::Packet(bs, send);
 
-    if (send)
-        player->topicChanges.count = (unsigned int)(player->topicChanges.topics.size());
-    else
-        player->topicChanges.topics.clear();
+    if (!RWCount(player->topicChanges.topics, player->topicChanges.count, send, 1))
+        return;
 
-    RW(player->topicChanges.count, send);
-
-    for (unsigned int i = 0; i < player->topicChanges.count; i++)
+    for (auto &&topic : player->topicChanges.topics)
     {
-        Topic topic;
-
-        if (send)
-            topic = player->topicChanges.topics.at(i);
-
         RW(topic.topicId, send, true);
-
-        if (!send)
-            player->topicChanges.topics.push_back(topic);
     }
 }
@@ -10,24 +10,12 @@ void mwmp::PacketWorldKillCount::Packet(RakNet::BitStream *bs, bool send)
 {
     PlayerPacket::Packet(bs, send);
 
-    if (send)
-        player->killChanges.count = (unsigned int)(player->killChanges.kills.size());
-    else
-        player->killChanges.kills.clear();
+    if (!RWCount(player->killChanges.kills, player->killChanges.count, send, 32))
+        return;
 
-    RW(player->killChanges.count, send);
-
-    for (unsigned int i = 0; i < player->killChanges.count; i++)
+    for (auto &&kill : player->killChanges.kills)
     {
-        Kill kill;
-
-        if (send)
-            kill = player->killChanges.kills.at(i);
-
         RW(kill.refId, send, true);
         RW(kill.number, send);
-
-        if (!send)
-            player->killChanges.kills.push_back(kill);
     }
 }
@@ -29,3 +29,8 @@ BasePlayer *PlayerPacket::getPlayer()
 {
     return player;
 }
+
+bool PlayerPacket::canIndexStringsFor(const RakNet::RakNetGUID &recipient) const
+{
+    return recipient == guid;
+}
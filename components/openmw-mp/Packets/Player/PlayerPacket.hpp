@@ -22,6 +22,9 @@ namespace mwmp
         BasePlayer *getPlayer();
 
     protected:
+        // Packets about other players can be skipped by a client that doesn't know about them yet
+        virtual bool canIndexStringsFor(const RakNet::RakNetGUID &recipient) const;
+
         BasePlayer *player;
 
     };
@@ -16,46 +16,22 @@ void PacketWorldMap::Packet(RakNet::BitStream *bs, bool send)
 
     uint32_t changesCount;
 
-    if (send)
-        changesCount = static_cast<uint32_t>(worldstate->mapTiles.size());
-
-    RW(changesCount, send);
-
-    if (!send)
-    {
-        worldstate->mapTiles.clear();
-        worldstate->mapTiles.resize(changesCount);
-    }
+    // Two coordinates and the size of the image data
+    if (!RWCount(worldstate->mapTiles, changesCount, send, 3 * 32))
+        return;
 
     for (auto &&mapTile : worldstate->mapTiles)
     {
         RW(mapTile.x, send);
         RW(mapTile.y, send);
 
-        uint32_t imageDataSize;
-
-        if (send)
-            imageDataSize = static_cast<uint32_t>(mapTile.imageData.size());
-
-        RW(imageDataSize, send);
-
-        if (imageDataSize > mwmp::maxImageDataSize)
+        if ((send && mapTile.imageData.size() > mwmp::maxImageDataSize) ||
+            !RW(mapTile.imageData, send, mwmp::maxImageDataSize))
         {
-            LOG_MESSAGE_SIMPLE(MWMPLog::LOG_ERROR, "Processed invalid ID_WORLD_MAP packet where tile %i, %i had an imageDataSize of %i",
-                mapTile.x, mapTile.y, imageDataSize);
+            LOG_MESSAGE_SIMPLE(MWMPLog::LOG_ERROR, "Processed invalid ID_WORLD_MAP packet where tile %i, %i had more than %i bytes of image data",
+                mapTile.x, mapTile.y, mwmp::maxImageDataSize);
             LOG_APPEND(MWMPLog::LOG_ERROR, "- The packet was ignored after that point");
             return;
         }
-
-        if (!send)
-        {
-            mapTile.imageData.clear();
-            mapTile.imageData.resize(imageDataSize);
-        }
-
-        for (auto &&imageChar : mapTile.imageData)
-        {
-            RW(imageChar, send);
-        }
     }
 }
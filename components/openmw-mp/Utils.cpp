@@ -1,13 +1,14 @@
 #include "Utils.hpp"
 
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <ctime>
 #include <cmath>
 #include <memory>
+#include <vector>
 #include <iostream>
 #include <sstream>
-#include <boost/crc.hpp>
 #include <boost/filesystem/fstream.hpp>
 #include <iomanip>
 
@@ -158,21 +159,73 @@ long int Utils::getFileLength(const char* file)
     return size;
 }
 
+namespace
+{
+    // Lookup tables for processing 8 bytes at a time ("slice-by-8"), table[0] is the regular bytewise table
+    struct Crc32Tables
+    {
+        uint32_t table[8][256];
+
+        Crc32Tables()
+        {
+            for (uint32_t i = 0; i < 256; ++i)
+            {
+                uint32_t crc = i;
+                for (int bit = 0; bit < 8; ++bit)
+                    crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+                table[0][i] = crc;
+            }
+
+            for (uint32_t i = 0; i < 256; ++i)
+            {
+                for (int slice = 1; slice < 8; ++slice)
+                    table[slice][i] = (table[slice - 1][i] >> 8) ^ table[0][table[slice - 1][i] & 0xFF];
+            }
+        }
+    };
+
+    const Crc32Tables &getCrc32Tables()
+    {
+        static const Crc32Tables tables;
+        return tables;
+    }
+}
+
+unsigned int ::Utils::crc32(const void *data, std::size_t size, unsigned int previousChecksum)
+{
+    const uint32_t (&table)[8][256] = getCrc32Tables().table;
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    uint32_t crc = ~static_cast<uint32_t>(previousChecksum);
+
+    for (; size >= 8; size -= 8, bytes += 8)
+    {
+        const uint32_t low = crc ^ (bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<uint32_t>(bytes[3]) << 24));
+        const uint32_t high = bytes[4] | (bytes[5] << 8) | (bytes[6] << 16) | (static_cast<uint32_t>(bytes[7]) << 24);
+
+        crc = table[7][low & 0xFF] ^ table[6][(low >> 8) & 0xFF] ^ table[5][(low >> 16) & 0xFF] ^ table[4][low >> 24] ^
+              table[3][high & 0xFF] ^ table[2][(high >> 8) & 0xFF] ^ table[1][(high >> 16) & 0xFF] ^ table[0][high >> 24];
+    }
+
+    for (; size > 0; --size, ++bytes)
+        crc = (crc >> 8) ^ table[0][(crc ^ *bytes) & 0xFF];
+
+    return ~crc;
+}
+
 unsigned int ::Utils::crc32Checksum(const std::string &file)
 {
-    boost::crc_32_type  crc32;
-    boost::filesystem::ifstream  ifs(file, std::ios_base::binary);
+    unsigned int checksum = 0;
+    boost::filesystem::ifstream ifs(file, std::ios_base::binary);
     if (ifs)
     {
+        std::vector<char> buffer(1024 * 1024);
         do
         {
-            char buffer[1024];
-
-            ifs.read(buffer, 1024);
-            crc32.process_bytes( buffer, ifs.gcount() );
+            ifs.read(buffer.data(), buffer.size());
+            checksum = crc32(buffer.data(), static_cast<std::size_t>(ifs.gcount()), checksum);
         } while (ifs);
     }
-    return crc32.checksum();
+    return checksum;
 }
 
 std::string Utils::getOperatingSystemType()
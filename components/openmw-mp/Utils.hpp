@@ -6,6 +6,7 @@
 #define UTILS_HPP
 
 #include <algorithm>
+#include <cstddef>
 #include <string>
 #include <sstream>
 #include <vector>
@@ -58,6 +59,8 @@ namespace Utils
 
     long int getFileLength(const char *file);
 
+    // Same CRC32 as boost::crc_32_type, pass the result of a previous call as previousChecksum to continue it
+    unsigned int crc32(const void *data, std::size_t size, unsigned int previousChecksum = 0);
     unsigned int crc32Checksum(const std::string &file);
 
     std::string getOperatingSystemType();
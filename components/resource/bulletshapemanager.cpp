@@ -113,40 +113,53 @@ osg::ref_ptr<const BulletShape> BulletShapeManager::getShape(const std::string &
     std::string normalized = name;
     mVFS->normalizeFilename(normalized);
 
-    osg::ref_ptr<BulletShape> shape;
-    osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(normalized);
+    // Threads asking for a shape that is being loaded wait for it, rather than loading it as well
+    osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCacheOrStartLoading(normalized);
     if (obj)
-        shape = osg::ref_ptr<BulletShape>(static_cast<BulletShape*>(obj.get()));
-    else
+        return osg::ref_ptr<BulletShape>(static_cast<BulletShape*>(obj.get()));
+
+    osg::ref_ptr<BulletShape> shape;
+    try
+    {
+        shape = loadShape(normalized);
+    }
+    catch (...)
     {
-        size_t extPos = normalized.find_last_of('.');
-        std::string ext;
-        if (extPos != std::string::npos && extPos+1 < normalized.size())
-            ext = normalized.substr(extPos+1);
-
-        if (ext == "nif")
-        {
-            NifBullet::BulletNifLoader loader;
-            shape = loader.load(*mNifFileManager->get(normalized));
-        }
-        else
-        {
-            // TODO: support .bullet shape files
-
-            osg::ref_ptr<const osg::Node> constNode (mSceneManager->getTemplate(normalized));
-            osg::ref_ptr<osg::Node> node (const_cast<osg::Node*>(constNode.get())); // const-trickery required because there is no const version of NodeVisitor
-            NodeToShapeVisitor visitor;
-            node->accept(visitor);
-            shape = visitor.getShape();
-            if (!shape)
-                return osg::ref_ptr<BulletShape>();
-        }
+        mCache->cancelLoading(normalized);
+        throw;
+    }
 
+    if (shape)
         mCache->addEntryToObjectCache(normalized, shape);
-    }
+    else
+        mCache->cancelLoading(normalized);
     return shape;
 }
 
+osg::ref_ptr<BulletShape> BulletShapeManager::loadShape(const std::string &normalized)
+{
+    size_t extPos = normalized.find_last_of('.');
+    std::string ext;
+    if (extPos != std::string::npos && extPos+1 < normalized.size())
+        ext = normalized.substr(extPos+1);
+
+    if (ext == "nif")
+    {
+        NifBullet::BulletNifLoader loader;
+        return loader.load(*mNifFileManager->get(normalized));
+    }
+    else
+    {
+        // TODO: support .bullet shape files
+
+        osg::ref_ptr<const osg::Node> constNode (mSceneManager->getTemplate(normalized));
+        osg::ref_ptr<osg::Node> node (const_cast<osg::Node*>(constNode.get())); // const-trickery required because there is no const version of NodeVisitor
+        NodeToShapeVisitor visitor;
+        node->accept(visitor);
+        return visitor.getShape();
+    }
+}
+
 osg::ref_ptr<BulletShapeInstance> BulletShapeManager::cacheInstance(const std::string &name)
 {
     std::string normalized = name;
@@ -29,6 +29,7 @@ namespace Resource
         ~BulletShapeManager();
 
         /// @note May return a null pointer if the object has no shape.
+        /// @note If another thread is loading the same shape, waits for it instead of loading it again.
         osg::ref_ptr<const BulletShape> getShape(const std::string& name);
 
         /// Create an instance of the given shape and cache it for later use, so that future calls to getInstance() can simply return
@@ -49,6 +50,8 @@ namespace Resource
     private:
         osg::ref_ptr<BulletShapeInstance> createInstance(const std::string& name);
 
+        osg::ref_ptr<BulletShape> loadShape(const std::string& normalized);
+
         osg::ref_ptr<MultiObjectCache> mInstanceCache;
         SceneManager* mSceneManager;
         NifFileManager* mNifFileManager;
@@ -27,7 +27,10 @@ namespace Resource
         else
         {
             osg::ref_ptr<NifOsg::KeyframeHolder> loaded (new NifOsg::KeyframeHolder);
-            NifOsg::Loader::loadKf(Nif::NIFFilePtr(new Nif::NIFFile(mVFS->getNormalized(normalized), normalized)), *loaded.get());
+            Files::MappedFilePtr mapped = mVFS->mapNormalized(normalized);
+            Nif::NIFFilePtr file (mapped ? new Nif::NIFFile(mapped->data(), mapped->size(), normalized)
+                                         : new Nif::NIFFile(mVFS->getNormalized(normalized), normalized));
+            NifOsg::Loader::loadKf(file, *loaded.get());
 
             mCache->addEntryToObjectCache(normalized, loaded);
             return loaded;
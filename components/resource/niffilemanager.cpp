@@ -44,12 +44,25 @@ namespace Resource
 
     Nif::NIFFilePtr NifFileManager::get(const std::string &name)
     {
-        osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(name);
+        // The scene and the shape of a mesh may be converted on different threads, which then share one parse
+        osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCacheOrStartLoading(name);
         if (obj)
             return static_cast<NifFileHolder*>(obj.get())->mNifFile;
         else
         {
-            Nif::NIFFilePtr file (new Nif::NIFFile(mVFS->get(name), name));
+            Nif::NIFFilePtr file;
+            try
+            {
+                // Parsing straight from a mapping avoids copying the file through a stream first
+                Files::MappedFilePtr mapped = mVFS->map(name);
+                file.reset(mapped ? new Nif::NIFFile(mapped->data(), mapped->size(), name)
+                                  : new Nif::NIFFile(mVFS->get(name), name));
+            }
+            catch (...)
+            {
+                mCache->cancelLoading(name);
+                throw;
+            }
             obj = new NifFileHolder(file);
             mCache->addEntryToObjectCache(name, obj);
             return file;
@@ -3,6 +3,7 @@
 // - removeExpiredObjectsInCache no longer keeps a lock while the unref happens.
 // - template allows customized KeyType.
 // - objects with uninitialized time stamp are not removed.
+// - objects can be marked as loading, so other threads wait for them instead of loading them again.
 
 /* -*-c++-*- OpenSceneGraph - Copyright (C) 1998-2006 Robert Osfield
  *
@@ -24,8 +25,12 @@
 #include <osg/ref_ptr>
 #include <osg/Node>
 
+#include <OpenThreads/Condition>
+#include <OpenThreads/Mutex>
+
 #include <string>
 #include <map>
+#include <thread>
 
 namespace osg
 {
@@ -96,11 +101,51 @@ class GenericObjectCache : public osg::Referenced
             _objectCache.clear();
         }
 
-        /** Add a key,object,timestamp triple to the Registry::ObjectCache.*/
+        /** Add a key,object,timestamp triple to the Registry::ObjectCache.
+          * Wakes up the threads waiting for the key if it was being loaded.*/
         void addEntryToObjectCache(const KeyType& key, osg::Object* object, double timestamp = 0.0)
         {
             OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_objectCacheMutex);
             _objectCache[key]=ObjectTimeStampPair(object,timestamp);
+            if (_loadingObjects.erase(key))
+                _loadingCondition.broadcast();
+        }
+
+        /** Get an ref_ptr<Object> from the object cache, or mark the key as being loaded by the calling thread.
+          * If another thread is loading the key, waits until it has added the object or given up.
+          * Returns null if the caller has to load the object, in which case it must call either
+          * addEntryToObjectCache() or cancelLoading() for the key.*/
+        osg::ref_ptr<osg::Object> getRefFromObjectCacheOrStartLoading(const KeyType& key)
+        {
+            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_objectCacheMutex);
+            while (true)
+            {
+                typename ObjectCacheMap::iterator itr = _objectCache.find(key);
+                if (itr!=_objectCache.end())
+                    return itr->second.first;
+
+                typename LoadingMap::iterator loading = _loadingObjects.find(key);
+                if (loading == _loadingObjects.end())
+                {
+                    _loadingObjects[key] = std::this_thread::get_id();
+                    return 0;
+                }
+
+                // An object that (indirectly) requires itself is loaded again rather than waiting forever
+                if (loading->second == std::this_thread::get_id())
+                    return 0;
+
+                _loadingCondition.wait(&_objectCacheMutex);
+            }
+        }
+
+        /** Give up loading a key marked by getRefFromObjectCacheOrStartLoading(), e.g. because loading failed.
+          * One of the waiting threads then tries to load it instead.*/
+        void cancelLoading(const KeyType& key)
+        {
+            OpenThreads::ScopedLock<OpenThreads::Mutex> lock(_objectCacheMutex);
+            if (_loadingObjects.erase(key))
+                _loadingCondition.broadcast();
         }
 
         /** Remove Object from cache.*/
@@ -184,7 +229,11 @@ class GenericObjectCache : public osg::Referenced
         typedef std::pair<osg::ref_ptr<osg::Object>, double >           ObjectTimeStampPair;
         typedef std::map<KeyType, ObjectTimeStampPair >             ObjectCacheMap;
 
+        typedef std::map<KeyType, std::thread::id >                 LoadingMap;
+
         ObjectCacheMap                          _objectCache;
+        LoadingMap                              _loadingObjects;
+        OpenThreads::Condition                  _loadingCondition;
         mutable OpenThreads::Mutex              _objectCacheMutex;
 
 };
@@ -471,72 +471,91 @@ namespace Resource
         std::string normalized = name;
         mVFS->normalizeFilename(normalized);
 
-        osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(normalized);
+        // Threads asking for a template that is being loaded wait for it, rather than loading it as well
+        osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCacheOrStartLoading(normalized);
         if (obj)
             return osg::ref_ptr<const osg::Node>(static_cast<osg::Node*>(obj.get()));
-        else
+
+        std::string loadedName = normalized;
+        osg::ref_ptr<osg::Node> loaded;
+        try
         {
-            osg::ref_ptr<osg::Node> loaded;
-            try
-            {
-                Files::IStreamPtr file = mVFS->get(normalized);
+            loaded = loadTemplate(name, loadedName);
+        }
+        catch (...)
+        {
+            mCache->cancelLoading(normalized);
+            throw;
+        }
 
-                loaded = load(file, normalized, mImageManager, mNifFileManager);
-            }
-            catch (std::exception& e)
-            {
-                static const char * const sMeshTypes[] = { "nif", "osg", "osgt", "osgb", "osgx", "osg2" };
+        mCache->addEntryToObjectCache(loadedName, loaded);
+        // The error marker is cached under its own name
+        if (loadedName != normalized)
+            mCache->cancelLoading(normalized);
+        return loaded;
+    }
+
+    osg::ref_ptr<osg::Node> SceneManager::loadTemplate(const std::string &name, std::string &normalized)
+    {
+        osg::ref_ptr<osg::Node> loaded;
+        try
+        {
+            Files::IStreamPtr file = mVFS->get(normalized);
+
+            loaded = load(file, normalized, mImageManager, mNifFileManager);
+        }
+        catch (std::exception& e)
+        {
+            static const char * const sMeshTypes[] = { "nif", "osg", "osgt", "osgb", "osgx", "osg2" };
 
-                for (unsigned int i=0; i<sizeof(sMeshTypes)/sizeof(sMeshTypes[0]); ++i)
+            for (unsigned int i=0; i<sizeof(sMeshTypes)/sizeof(sMeshTypes[0]); ++i)
+            {
+                normalized = "meshes/marker_error." + std::string(sMeshTypes[i]);
+                if (mVFS->exists(normalized))
                 {
-                    normalized = "meshes/marker_error." + std::string(sMeshTypes[i]);
-                    if (mVFS->exists(normalized))
-                    {
-                        Log(Debug::Error) << "Failed to load '" << name << "': " << e.what() << ", using marker_error." << sMeshTypes[i] << " instead";
-                        Files::IStreamPtr file = mVFS->get(normalized);
-                        loaded = load(file, normalized, mImageManager, mNifFileManager);
-                        break;
-                    }
+                    Log(Debug::Error) << "Failed to load '" << name << "': " << e.what() << ", using marker_error." << sMeshTypes[i] << " instead";
+                    Files::IStreamPtr file = mVFS->get(normalized);
+                    loaded = load(file, normalized, mImageManager, mNifFileManager);
+                    break;
                 }
-
-                if (!loaded)
-                    throw;
             }
 
-            // set filtering settings
-            SetFilterSettingsVisitor setFilterSettingsVisitor(mMinFilter, mMagFilter, mMaxAnisotropy);
-            loaded->accept(setFilterSettingsVisitor);
-            SetFilterSettingsControllerVisitor setFilterSettingsControllerVisitor(mMinFilter, mMagFilter, mMaxAnisotropy);
-            loaded->accept(setFilterSettingsControllerVisitor);
-
-            osg::ref_ptr<Shader::ShaderVisitor> shaderVisitor (createShaderVisitor());
-            loaded->accept(*shaderVisitor);
+            if (!loaded)
+                throw;
+        }
 
-            // share state
-            // do this before optimizing so the optimizer will be able to combine nodes more aggressively
-            // note, because StateSets will be shared at this point, StateSets can not be modified inside the optimizer
-            mSharedStateMutex.lock();
-            mSharedStateManager->share(loaded.get());
-            mSharedStateMutex.unlock();
+        // set filtering settings
+        SetFilterSettingsVisitor setFilterSettingsVisitor(mMinFilter, mMagFilter, mMaxAnisotropy);
+        loaded->accept(setFilterSettingsVisitor);
+        SetFilterSettingsControllerVisitor setFilterSettingsControllerVisitor(mMinFilter, mMagFilter, mMaxAnisotropy);
+        loaded->accept(setFilterSettingsControllerVisitor);
 
-            if (canOptimize(normalized))
-            {
-                SceneUtil::Optimizer optimizer;
-                optimizer.setIsOperationPermissibleForObjectCallback(new CanOptimizeCallback);
+        osg::ref_ptr<Shader::ShaderVisitor> shaderVisitor (createShaderVisitor());
+        loaded->accept(*shaderVisitor);
 
-                static const unsigned int options = getOptimizationOptions();
+        // share state
+        // do this before optimizing so the optimizer will be able to combine nodes more aggressively
+        // note, because StateSets will be shared at this point, StateSets can not be modified inside the optimizer
+        mSharedStateMutex.lock();
+        mSharedStateManager->share(loaded.get());
+        mSharedStateMutex.unlock();
 
-                optimizer.optimize(loaded, options);
-            }
+        if (canOptimize(normalized))
+        {
+            SceneUtil::Optimizer optimizer;
+            optimizer.setIsOperationPermissibleForObjectCallback(new CanOptimizeCallback);
 
-            if (mIncrementalCompileOperation)
-                mIncrementalCompileOperation->add(loaded);
-            else
-                loaded->getBound();
+            static const unsigned int options = getOptimizationOptions();
 
-            mCache->addEntryToObjectCache(normalized, loaded);
-            return loaded;
+            optimizer.optimize(loaded, options);
         }
+
+        if (mIncrementalCompileOperation)
+            mIncrementalCompileOperation->add(loaded);
+        else
+            loaded->getBound();
+
+        return loaded;
     }
 
     osg::ref_ptr<osg::Node> SceneManager::cacheInstance(const std::string &name)
@@ -80,7 +80,7 @@ namespace Resource
         /// Get a read-only copy of this scene "template"
         /// @note If the given filename does not exist or fails to load, an error marker mesh will be used instead.
         ///  If even the error marker mesh can not be found, an exception is thrown.
-        /// @note Thread safe.
+        /// @note Thread safe. If another thread is loading the same template, waits for it instead of loading it again.
         osg::ref_ptr<const osg::Node> getTemplate(const std::string& name);
 
         /// Create an instance of the given scene template and cache it for later use, so that future calls to getInstance() can simply
@@ -147,6 +147,10 @@ namespace Resource
 
         Shader::ShaderVisitor* createShaderVisitor();
 
+        /// Load and prepare a scene template, or the error marker if it fails to load.
+        /// @param normalized The normalized name, replaced with the error marker's name if that is loaded instead.
+        osg::ref_ptr<osg::Node> loadTemplate(const std::string& name, std::string& normalized);
+
         std::unique_ptr<Shader::ShaderManager> mShaderManager;
         bool mForceShaders;
         bool mClampLighting;
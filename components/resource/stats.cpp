@@ -274,6 +274,9 @@ void StatsHandler::setUpScene(osgViewer::ViewerBase *viewer)
             "Compiling",
             "WorkQueue",
             "WorkThread",
+            "Preload Cells",
+            "Preload Pending",
+            "Preload Dropped",
             "",
             "Texture",
             "StateSet",
@@ -296,6 +299,8 @@ void StatsHandler::setUpScene(osgViewer::ViewerBase *viewer)
             "NavMesh CacheSize",
             "NavMesh UsedTiles",
             "NavMesh CachedTiles",
+            "NavMesh DiskTiles",
+            "NavMesh DiskHits",
         });
 
         static const auto longest = std::max_element(statNames.begin(), statNames.end(),
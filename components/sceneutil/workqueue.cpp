@@ -1,32 +1,54 @@
 #include "workqueue.hpp"
 
+#include <algorithm>
+
 #include <components/debug/debuglog.hpp>
 
+namespace
+{
+    // Shared by all work items, so that a WorkItem does not need its own mutex and condition.
+    // signalDone() only touches these when someone is actually waiting.
+    std::mutex sDoneMutex;
+    std::condition_variable sDoneCondition;
+    std::atomic<unsigned int> sNumWaiters(0);
+
+    // Bumped whenever a work item's priority changes, so that queues know to reorder
+    std::atomic<unsigned int> sPriorityGeneration(0);
+}
+
 namespace SceneUtil
 {
 
 void WorkItem::waitTillDone()
 {
-    if (mDone > 0)
+    if (mDone)
         return;
 
-    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
-    while (mDone == 0)
+    ++sNumWaiters;
     {
-        mCondition.wait(&mMutex);
+        std::unique_lock<std::mutex> lock(sDoneMutex);
+        sDoneCondition.wait(lock, [this] { return mDone.load(); });
     }
+    --sNumWaiters;
 }
 
 void WorkItem::signalDone()
 {
+    mDone = true;
+
+    if (sNumWaiters > 0)
     {
-        OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
-        mDone.exchange(1);
+        // Synchronize with a waiter that has checked mDone but not started waiting yet
+        {
+            std::lock_guard<std::mutex> lock(sDoneMutex);
+        }
+        sDoneCondition.notify_all();
     }
-    mCondition.broadcast();
 }
 
 WorkItem::WorkItem()
+    : mDone(false)
+    , mPriority(0.f)
 {
 }
 
@@ -36,15 +58,116 @@ WorkItem::~WorkItem()
 
 bool WorkItem::isDone() const
 {
-    return (mDone > 0);
+    return mDone;
+}
+
+void WorkItem::setPriority(float priority)
+{
+    if (mPriority.exchange(priority) != priority)
+        ++sPriorityGeneration;
+}
+
+float WorkItem::getPriority() const
+{
+    return mPriority;
+}
+
+bool WorkQueue::QueuedItem::operator<(const QueuedItem& other) const
+{
+    if (mPriority != other.mPriority)
+        return mPriority < other.mPriority;
+    return mSequence > other.mSequence;
+}
+
+WorkQueue::ThreadQueue::ThreadQueue()
+    : mNextSequence(0)
+    , mPriorityGeneration(sPriorityGeneration)
+{
+}
+
+void WorkQueue::ThreadQueue::push(const osg::ref_ptr<WorkItem>& item)
+{
+    QueuedItem queued;
+    queued.mPriority = item->getPriority();
+    queued.mSequence = mNextSequence++;
+    queued.mItem = item;
+    mHeap.push_back(queued);
+    std::push_heap(mHeap.begin(), mHeap.end());
+}
+
+bool WorkQueue::ThreadQueue::remove(const osg::ref_ptr<WorkItem>& item)
+{
+    std::deque<osg::ref_ptr<WorkItem> >::iterator foundFront = std::find(mFrontQueue.begin(), mFrontQueue.end(), item);
+    if (foundFront != mFrontQueue.end())
+    {
+        mFrontQueue.erase(foundFront);
+        return true;
+    }
+
+    for (std::vector<QueuedItem>::iterator it = mHeap.begin(); it != mHeap.end(); ++it)
+    {
+        if (it->mItem == item)
+        {
+            mHeap.erase(it);
+            std::make_heap(mHeap.begin(), mHeap.end());
+            return true;
+        }
+    }
+    return false;
+}
+
+osg::ref_ptr<WorkItem> WorkQueue::ThreadQueue::take()
+{
+    if (!mFrontQueue.empty())
+    {
+        osg::ref_ptr<WorkItem> item = mFrontQueue.front();
+        mFrontQueue.pop_front();
+        return item;
+    }
+    else if (!mHeap.empty())
+    {
+        // Priorities may have changed while the items were queued, reorder if so
+        unsigned int generation = sPriorityGeneration;
+        if (generation != mPriorityGeneration)
+        {
+            for (QueuedItem& queued : mHeap)
+                queued.mPriority = queued.mItem->getPriority();
+            std::make_heap(mHeap.begin(), mHeap.end());
+            mPriorityGeneration = generation;
+        }
+
+        std::pop_heap(mHeap.begin(), mHeap.end());
+        osg::ref_ptr<WorkItem> item = mHeap.back().mItem;
+        mHeap.pop_back();
+        return item;
+    }
+    else
+        return nullptr;
+}
+
+std::size_t WorkQueue::ThreadQueue::size() const
+{
+    return mFrontQueue.size() + mHeap.size();
+}
+
+void WorkQueue::ThreadQueue::clear()
+{
+    mFrontQueue.clear();
+    mHeap.clear();
 }
 
 WorkQueue::WorkQueue(int workerThreads)
     : mIsReleased(false)
+    , mNumItems(0)
+    , mNextQueue(0)
 {
+    // Keep at least one queue so that items can still be added without any worker threads
+    for (int i=0; i<std::max(workerThreads, 1); ++i)
+        mQueues.emplace_back(new ThreadQueue);
+
     for (int i=0; i<workerThreads; ++i)
     {
-        WorkThread* thread = new WorkThread(this);
+        WorkThread* thread = new WorkThread(this, i);
         mThreads.push_back(thread);
         thread->startThread();
     }
@@ -52,13 +175,18 @@ WorkQueue::WorkQueue(int workerThreads)
 
 WorkQueue::~WorkQueue()
 {
+    for (const std::unique_ptr<ThreadQueue>& queue : mQueues)
     {
-        OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
-        while (!mQueue.empty())
-            mQueue.pop_back();
+        std::lock_guard<std::mutex> lock(queue->mMutex);
+        mNumItems -= queue->size();
+        queue->clear();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
         mIsReleased = true;
-        mCondition.broadcast();
     }
+    mSleepCondition.notify_all();
 
     for (unsigned int i=0; i<mThreads.size(); ++i)
     {
@@ -75,35 +203,79 @@ void WorkQueue::addWorkItem(osg::ref_ptr<WorkItem> item, bool front)
         return;
     }
 
-    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
-    if (front)
-        mQueue.push_front(item);
-    else
-        mQueue.push_back(item);
-    mCondition.signal();
+    ThreadQueue& queue = *mQueues[mNextQueue++ % mQueues.size()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mMutex);
+        if (front)
+            queue.mFrontQueue.push_front(item);
+        else
+            queue.push(item);
+        ++mNumItems;
+    }
+
+    // Make sure a thread that has just found the queues empty is waiting before it gets notified
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+    }
+    mSleepCondition.notify_one();
 }
 
-osg::ref_ptr<WorkItem> WorkQueue::removeWorkItem()
+bool WorkQueue::cancelWorkItem(const osg::ref_ptr<WorkItem>& item)
 {
-    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
-    while (mQueue.empty() && !mIsReleased)
+    bool found = false;
+    for (const std::unique_ptr<ThreadQueue>& queue : mQueues)
     {
-        mCondition.wait(&mMutex);
+        std::lock_guard<std::mutex> lock(queue->mMutex);
+        if (queue->remove(item))
+        {
+            --mNumItems;
+            found = true;
+            break;
+        }
     }
-    if (!mQueue.empty())
+
+    if (!found)
+        return false;
+
+    // Wake up anyone waiting in waitTillDone()
+    item->signalDone();
+    return true;
+}
+
+osg::ref_ptr<WorkItem> WorkQueue::tryTake(unsigned int thread)
+{
+    // Own queue first, then steal from the others
+    for (unsigned int i=0; i<mQueues.size(); ++i)
     {
-        osg::ref_ptr<WorkItem> item = mQueue.front();
-        mQueue.pop_front();
-        return item;
+        ThreadQueue& queue = *mQueues[(thread + i) % mQueues.size()];
+        std::lock_guard<std::mutex> lock(queue.mMutex);
+        osg::ref_ptr<WorkItem> item = queue.take();
+        if (item)
+        {
+            --mNumItems;
+            return item;
+        }
     }
-    else
-        return nullptr;
+    return nullptr;
+}
+
+osg::ref_ptr<WorkItem> WorkQueue::removeWorkItem(unsigned int thread)
+{
+    while (!mIsReleased)
+    {
+        osg::ref_ptr<WorkItem> item = tryTake(thread);
+        if (item)
+            return item;
+
+        std::unique_lock<std::mutex> lock(mSleepMutex);
+        mSleepCondition.wait(lock, [this] { return mNumItems > 0 || mIsReleased; });
+    }
+    return nullptr;
 }
 
 unsigned int WorkQueue::getNumItems() const
 {
-    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
-    return mQueue.size();
+    return mNumItems;
 }
 
 unsigned int WorkQueue::getNumActiveThreads() const
@@ -117,8 +289,9 @@ unsigned int WorkQueue::getNumActiveThreads() const
     return count;
 }
 
-WorkThread::WorkThread(WorkQueue *workQueue)
+WorkThread::WorkThread(WorkQueue *workQueue, unsigned int index)
     : mWorkQueue(workQueue)
+    , mIndex(index)
     , mActive(false)
 {
 }
@@ -127,7 +300,7 @@ void WorkThread::run()
 {
     while (true)
     {
-        osg::ref_ptr<WorkItem> item = mWorkQueue->removeWorkItem();
+        osg::ref_ptr<WorkItem> item = mWorkQueue->removeWorkItem(mIndex);
         if (!item)
             return;
         mActive = true;
@@ -1,16 +1,17 @@
 #ifndef OPENMW_COMPONENTS_SCENEUTIL_WORKQUEUE_H
 #define OPENMW_COMPONENTS_SCENEUTIL_WORKQUEUE_H
 
-#include <OpenThreads/Atomic>
-#include <OpenThreads/Mutex>
-#include <OpenThreads/Condition>
 #include <OpenThreads/Thread>
 
 #include <osg/Referenced>
 #include <osg/ref_ptr>
 
 #include <atomic>
-#include <queue>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace SceneUtil
 {
@@ -35,17 +36,25 @@ namespace SceneUtil
         /// Set abort flag in order to return from doWork() as soon as possible. May not be respected by all WorkItems.
         virtual void abort() {}
 
+        /// Items with a higher priority are taken from the queue first. May be changed while the item is queued.
+        void setPriority(float priority);
+
+        float getPriority() const;
+
     protected:
-        OpenThreads::Atomic mDone;
-        OpenThreads::Mutex mMutex;
-        OpenThreads::Condition mCondition;
+        std::atomic<bool> mDone;
+        std::atomic<float> mPriority;
     };
 
     class WorkThread;
 
     /// @brief A work queue that users can push work items onto, to be completed by one or more background threads.
-    /// @note Work items will be processed in the order that they were given in, however
-    /// if multiple work threads are involved then it is possible for a later item to complete before earlier items.
+    /// @note Each work thread has its own queue. New items are spread over the threads' queues, and a thread that
+    /// runs out of work steals from the others, so threads rarely contend for the same lock.
+    /// Work items added to the front are processed first. The remaining items of a thread's queue are processed by
+    /// descending priority, items of equal priority in the order that they were given in. There is no strict ordering
+    /// between items in different queues, and if multiple work threads are involved then it is possible for a later
+    /// item to complete before earlier items.
     class WorkQueue : public osg::Referenced
     {
     public:
@@ -57,21 +66,64 @@ namespace SceneUtil
         /// @param front If true, add item to the front of the queue. If false (default), add to the back.
         void addWorkItem(osg::ref_ptr<WorkItem> item, bool front=false);
 
-        /// Get the next work item from the front of the queue. If the queue is empty, waits until a new item is added.
+        /// Remove a work item that has not been started yet from the queue and mark it as done.
+        /// @return false if the item is not queued, i.e. it is already being processed or has completed.
+        bool cancelWorkItem(const osg::ref_ptr<WorkItem>& item);
+
+        /// Get the next work item for the given thread, stealing from other threads' queues if its own is empty.
+        /// If no work is available, waits until a new item is added.
         /// If the workqueue is in the process of being destroyed, may return nullptr.
         /// @par Used internally by the WorkThread.
-        osg::ref_ptr<WorkItem> removeWorkItem();
+        osg::ref_ptr<WorkItem> removeWorkItem(unsigned int thread);
 
         unsigned int getNumItems() const;
 
         unsigned int getNumActiveThreads() const;
 
     private:
-        bool mIsReleased;
-        std::deque<osg::ref_ptr<WorkItem> > mQueue;
+        struct QueuedItem
+        {
+            float mPriority;
+            unsigned long long mSequence;
+            osg::ref_ptr<WorkItem> mItem;
+
+            /// Heap order: lower priority, then later sequence, is "less".
+            bool operator<(const QueuedItem& other) const;
+        };
+
+        struct ThreadQueue
+        {
+            ThreadQueue();
+
+            std::mutex mMutex;
+            std::deque<osg::ref_ptr<WorkItem> > mFrontQueue;
+            std::vector<QueuedItem> mHeap;
+            unsigned long long mNextSequence;
+            unsigned int mPriorityGeneration;
+
+            void push(const osg::ref_ptr<WorkItem>& item);
+
+            bool remove(const osg::ref_ptr<WorkItem>& item);
+
+            /// Take the item that should run next, or nullptr if the queue is empty. Expects mMutex to be locked.
+            osg::ref_ptr<WorkItem> take();
+
+            std::size_t size() const;
+
+            void clear();
+        };
+
+        osg::ref_ptr<WorkItem> tryTake(unsigned int thread);
+
+        std::atomic<bool> mIsReleased;
+        std::atomic<unsigned int> mNumItems;
+        std::atomic<unsigned int> mNextQueue;
+
+        std::vector<std::unique_ptr<ThreadQueue> > mQueues;
 
-        mutable OpenThreads::Mutex mMutex;
-        OpenThreads::Condition mCondition;
+        // Only used to put idle threads to sleep, never held while queueing or taking work
+        std::mutex mSleepMutex;
+        std::condition_variable mSleepCondition;
 
         std::vector<WorkThread*> mThreads;
     };
@@ -80,7 +132,7 @@ namespace SceneUtil
     class WorkThread : public OpenThreads::Thread
     {
     public:
-        WorkThread(WorkQueue* workQueue);
+        WorkThread(WorkQueue* workQueue, unsigned int index);
 
         virtual void run();
 
@@ -88,6 +140,7 @@ namespace SceneUtil
 
     private:
         WorkQueue* mWorkQueue;
+        unsigned int mIndex;
         std::atomic<bool> mActive;
     };
 
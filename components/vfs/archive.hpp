@@ -4,6 +4,7 @@
 #include <map>
 
 #include <components/files/constrainedfilestream.hpp>
+#include <components/files/mappedfile.hpp>
 
 namespace VFS
 {
@@ -14,6 +15,10 @@ namespace VFS
         virtual ~File() {}
 
         virtual Files::IStreamPtr open() = 0;
+
+        /// Map the file's contents into memory, or return null if the archive doesn't support it.
+        /// @note Throws an exception if mapping fails.
+        virtual Files::MappedFilePtr map() { return Files::MappedFilePtr(); }
     };
 
     class Archive
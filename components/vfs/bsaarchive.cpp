@@ -53,4 +53,9 @@ Files::IStreamPtr BsaArchiveFile::open()
     return mFile->getFile(mInfo);
 }
 
+Files::MappedFilePtr BsaArchiveFile::map()
+{
+    return mFile->mapFile(mInfo);
+}
+
 }
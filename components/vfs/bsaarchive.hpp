@@ -14,6 +14,8 @@ namespace VFS
 
         virtual Files::IStreamPtr open();
 
+        virtual Files::MappedFilePtr map();
+
         const Bsa::BSAFile::FileStruct* mInfo;
         Bsa::BSAFile* mFile;
     };
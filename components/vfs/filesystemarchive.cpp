@@ -65,4 +65,9 @@ namespace VFS
         return Files::openConstrainedFileStream(mPath.c_str());
     }
 
+    Files::MappedFilePtr FileSystemArchiveFile::map()
+    {
+        return std::make_shared<Files::MappedFile>(mPath);
+    }
+
 }
@@ -13,6 +13,8 @@ namespace VFS
 
         virtual Files::IStreamPtr open();
 
+        virtual Files::MappedFilePtr map();
+
     private:
         std::string mPath;
 
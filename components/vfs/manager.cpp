@@ -78,6 +78,31 @@ namespace VFS
         return found->second->open();
     }
 
+    Files::MappedFilePtr Manager::map(const std::string &name) const
+    {
+        std::string normalized = name;
+        normalize_path(normalized, mStrict);
+
+        return mapNormalized(normalized);
+    }
+
+    Files::MappedFilePtr Manager::mapNormalized(const std::string &normalizedName) const
+    {
+        std::map<std::string, File*>::const_iterator found = mIndex.find(normalizedName);
+        if (found == mIndex.end())
+            throw std::runtime_error("Resource '" + normalizedName + "' not found");
+
+        try
+        {
+            return found->second->map();
+        }
+        catch (std::exception&)
+        {
+            // E.g. an empty file, or one the platform can't map. It can still be streamed.
+            return Files::MappedFilePtr();
+        }
+    }
+
     bool Manager::exists(const std::string &name) const
     {
         std::string normalized = name;
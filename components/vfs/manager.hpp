@@ -2,6 +2,7 @@
 #define OPENMW_COMPONENTS_RESOURCEMANAGER_H
 
 #include <components/files/constrainedfilestream.hpp>
+#include <components/files/mappedfile.hpp>
 
 #include <vector>
 #include <map>
@@ -58,6 +59,16 @@ namespace VFS
         /// @note May be called from any thread once the index has been built.
         Files::IStreamPtr getNormalized(const std::string& normalizedName) const;
 
+        /// Map a file into memory by name, or return null if its archive can not map it. Use get() then.
+        /// @note Throws an exception if the file can not be found.
+        /// @note May be called from any thread once the index has been built.
+        Files::MappedFilePtr map(const std::string& name) const;
+
+        /// Map a file into memory by name (name is already normalized), or return null if its archive can not map it.
+        /// @note Throws an exception if the file can not be found.
+        /// @note May be called from any thread once the index has been built.
+        Files::MappedFilePtr mapNormalized(const std::string& normalizedName) const;
+
     private:
         bool mStrict;
 